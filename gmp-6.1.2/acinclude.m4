@@ -3272,6 +3272,59 @@ and __attribute__ ((alias))])
 fi
 ])
 
+dnl  GMP_C_THREAD_LOCAL
+dnl  ------------------
+dnl  Check for gcc style __thread thread local storage, used by the arena
+dnl  allocator to keep per-thread free lists, and for pthread_key_create in
+dnl  the libraries already used, so it can free a thread's lists when the
+dnl  thread exits.
+
+AC_DEFUN([GMP_C_THREAD_LOCAL],
+[AC_CACHE_CHECK([whether the compiler supports __thread],
+                gmp_cv_c_thread_local,
+[AC_TRY_LINK([static __thread int x;],
+[x = 1; return x;], gmp_cv_c_thread_local=yes, gmp_cv_c_thread_local=no)
+])
+if test $gmp_cv_c_thread_local = yes; then
+  AC_DEFINE(HAVE_THREAD_LOCAL, 1,
+  [Define to 1 if the compiler accepts gcc style __thread])
+fi
+AC_CACHE_CHECK([for pthread_key_create],
+                gmp_cv_func_pthread_key_create,
+[AC_TRY_LINK([#include <pthread.h>
+static pthread_key_t k;],
+[return pthread_key_create (&k, 0);],
+  gmp_cv_func_pthread_key_create=yes, gmp_cv_func_pthread_key_create=no)
+])
+if test $gmp_cv_func_pthread_key_create = yes; then
+  AC_DEFINE(HAVE_PTHREAD_KEY_CREATE, 1,
+  [Define to 1 if pthread_key_create links without extra libraries])
+fi
+])
+
+dnl  GMP_C_AVX512IFMA([ACTION-IF-YES][,ACTION-IF-NO])
+dnl  -------------------------------------------------
+dnl  Check whether the compiler has the AVX-512 IFMA intrinsics, in a
+dnl  function with a gcc style target attribute, as used by mpn/x86_64/ifma.
+dnl  No particular CFLAGS are needed.
+
+AC_DEFUN([GMP_C_AVX512IFMA],
+[AC_CACHE_CHECK([whether the compiler supports AVX-512 IFMA intrinsics],
+                gmp_cv_c_avx512ifma,
+[AC_TRY_COMPILE([#include <immintrin.h>
+__attribute__ ((__target__ ("avx512f,avx512ifma"))) __m512i
+foo (__m512i a, __m512i b, __m512i c)
+{
+  return _mm512_madd52hi_epu64 (a, b, c);
+}], , gmp_cv_c_avx512ifma=yes, gmp_cv_c_avx512ifma=no)
+])
+if test $gmp_cv_c_avx512ifma = yes; then
+  ifelse([$1],,:,[$1])
+else
+  ifelse([$2],,:,[$2])
+fi
+])
+
 dnl  GMP_C_DOUBLE_FORMAT
 dnl  -------------------
 dnl  Determine the floating point format.
@@ -0,0 +1,302 @@
+/* Caching allocator for mp_set_arena.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <string.h> /* for memcpy */
+
+#if HAVE_THREAD_LOCAL && HAVE_PTHREAD_KEY_CREATE
+#include <pthread.h>
+#define ARENA_PER_THREAD 1
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* Blocks freed while the arena is installed are kept on free lists for the
+   next allocation of the same size class, instead of going back to the
+   underlying allocator.  Sizes up to ARENA_MIN are one class, and above that
+   each power of 2 is split into 4 classes, so a block is at most 25% bigger
+   than asked for.  Blocks above 2^ARENA_MAX_BITS bytes pass straight
+   through.
+
+   GMP always passes the size of a block back to the free and reallocate
+   functions, so no header is needed, the size gives the class.  A free block
+   holds the pointer to the next one in the list.
+
+   The lists and counters are per thread, in thread local storage.  A block
+   freed by a different thread than allocated it just moves to the other
+   thread's lists.  The cache in each thread is limited to __gmp_arena_limit
+   bytes, beyond that freed blocks go to the underlying free function.  A
+   thread finding itself over the limit, because another lowered it, trims
+   its cache on its next free.
+
+   The first block a thread caches sets a pthread key for it, whose
+   destructor frees the cache when the thread exits.  Without __thread and
+   pthread_key_create the lists could only be shared, needing a lock on
+   every allocation, so mp_set_arena then does nothing and the arena is
+   never installed.
+
+   The underlying functions are those in effect when mp_set_arena installed
+   the arena, so an application's own allocator or the test suite's memory
+   checker still sees every block.  */
+
+#if ARENA_PER_THREAD
+#define ARENA_TLS  __thread
+#else
+#define ARENA_TLS
+#endif
+
+#define ARENA_MIN       64
+#define ARENA_MAX_BITS  26
+#define ARENA_CLASSES   (1 + 4 * (ARENA_MAX_BITS - 6))
+
+#define ARENA_DEFAULT_LIMIT  ((size_t) 64 << 20)
+
+struct arena_cache
+{
+  void   *head[ARENA_CLASSES];
+  size_t cached;
+  size_t allocated;
+  size_t reused;
+  int    registered;
+};
+
+static ARENA_TLS struct arena_cache arena;
+
+size_t __gmp_arena_limit = ARENA_DEFAULT_LIMIT;
+
+static void * (*arena_allocate_func) (size_t) = __gmp_default_allocate;
+static void * (*arena_reallocate_func) (void *, size_t, size_t)
+  = __gmp_default_reallocate;
+static void   (*arena_free_func) (void *, size_t) = __gmp_default_free;
+
+
+/* Return the class for SIZE, or -1 if it's too big to cache, and store the
+   size of blocks in that class to *CLASS_SIZE.  */
+static int
+arena_class (size_t size, size_t *class_size)
+{
+  mp_limb_t  s;
+  int        cnt, k, sub;
+
+  if (size <= ARENA_MIN)
+    {
+      *class_size = ARENA_MIN;
+      return 0;
+    }
+  if (size > ((size_t) 1 << ARENA_MAX_BITS))
+    return -1;
+
+  /* 2^(k-1) <= s < 2^k, with k >= 7, and sub the top 3 bits of s.  */
+  s = size - 1;
+  count_leading_zeros (cnt, s);
+  k = GMP_LIMB_BITS - cnt;
+  sub = s >> (k - 3);
+  *class_size = (size_t) (sub + 1) << (k - 3);
+  return 1 + 4 * (k - 7) + (sub - 4);
+}
+
+/* The block size of class C, the inverse of the above.  */
+static size_t
+arena_class_size (int c)
+{
+  return c == 0 ? ARENA_MIN : (size_t) (5 + (c - 1) % 4) << ((c - 1) / 4 + 4);
+}
+
+/* Free cached blocks of the calling thread, biggest first, until at most
+   LIMIT bytes are left.  */
+static void
+arena_trim (size_t limit)
+{
+  void  *p;
+  int   c;
+
+  for (c = ARENA_CLASSES - 1; c >= 0 && arena.cached > limit; c--)
+    while (arena.cached > limit && (p = arena.head[c]) != NULL)
+      {
+	arena.head[c] = *(void **) p;
+	arena.cached -= arena_class_size (c);
+	(*arena_free_func) (p, arena_class_size (c));
+      }
+}
+
+#if ARENA_PER_THREAD
+static pthread_key_t   arena_key;
+static pthread_once_t  arena_key_once = PTHREAD_ONCE_INIT;
+
+static void
+arena_thread_exit (void *dummy)
+{
+  arena_trim (0);
+}
+
+static void
+arena_key_create (void)
+{
+  pthread_key_create (&arena_key, arena_thread_exit);
+}
+
+/* Arrange for arena_thread_exit to run when the calling thread exits.  The
+   key's value is unused, it only has to be non-null.  */
+static void
+arena_register (void)
+{
+  pthread_once (&arena_key_once, arena_key_create);
+  pthread_setspecific (arena_key, &arena);
+  arena.registered = 1;
+}
+#endif
+
+void *
+__gmp_arena_allocate (size_t size)
+{
+  size_t  csize;
+  void    *p;
+  int     c;
+
+  c = arena_class (size, &csize);
+  if (c < 0)
+    {
+      arena.allocated += size;
+      return (*arena_allocate_func) (size);
+    }
+
+  p = arena.head[c];
+  if (p != NULL)
+    {
+      arena.head[c] = *(void **) p;
+      arena.cached -= csize;
+      arena.reused += csize;
+      return p;
+    }
+
+  arena.allocated += csize;
+  return (*arena_allocate_func) (csize);
+}
+
+void
+__gmp_arena_free (void *p, size_t size)
+{
+  size_t  csize;
+  int     c;
+
+  c = arena_class (size, &csize);
+  if (c < 0 || arena.cached + csize > __gmp_arena_limit)
+    {
+      (*arena_free_func) (p, c < 0 ? size : csize);
+      if (arena.cached > __gmp_arena_limit)
+	arena_trim (__gmp_arena_limit);
+      return;
+    }
+
+#if ARENA_PER_THREAD
+  if (UNLIKELY (! arena.registered))
+    arena_register ();
+#endif
+  *(void **) p = arena.head[c];
+  arena.head[c] = p;
+  arena.cached += csize;
+}
+
+void *
+__gmp_arena_reallocate (void *p, size_t old_size, size_t new_size)
+{
+  size_t  old_csize, new_csize;
+  int     old_c, new_c;
+  void    *q;
+
+  old_c = arena_class (old_size, &old_csize);
+  new_c = arena_class (new_size, &new_csize);
+
+  if (old_c == new_c)
+    {
+      if (old_c >= 0)
+	return p;
+      if (new_size > old_size)
+	arena.allocated += new_size - old_size;
+      return (*arena_reallocate_func) (p, old_size, new_size);
+    }
+
+  q = __gmp_arena_allocate (new_size);
+  memcpy (q, p, MIN (old_size, new_size));
+  __gmp_arena_free (p, old_size);
+  return q;
+}
+
+
+void
+mp_arena_release (void) __GMP_NOTHROW
+{
+  arena_trim (0);
+}
+
+void
+mp_set_arena (size_t limit) __GMP_NOTHROW
+{
+#if ARENA_PER_THREAD
+  if (limit == 0)
+    {
+      if (__gmp_allocate_func == __gmp_arena_allocate)
+	{
+	  mp_arena_release ();
+	  __gmp_allocate_func = arena_allocate_func;
+	  __gmp_reallocate_func = arena_reallocate_func;
+	  __gmp_free_func = arena_free_func;
+	}
+      return;
+    }
+
+  if (__gmp_allocate_func != __gmp_arena_allocate)
+    {
+      arena_allocate_func = __gmp_allocate_func;
+      arena_reallocate_func = __gmp_reallocate_func;
+      arena_free_func = __gmp_free_func;
+      __gmp_allocate_func = __gmp_arena_allocate;
+      __gmp_reallocate_func = __gmp_arena_reallocate;
+      __gmp_free_func = __gmp_arena_free;
+    }
+  __gmp_arena_limit = limit;
+  arena_trim (limit);
+#endif
+}
+
+void
+mp_get_arena_stats (size_t *allocated, size_t *reused, size_t *cached) __GMP_NOTHROW
+{
+  if (allocated != NULL)
+    *allocated = arena.allocated;
+  if (reused != NULL)
+    *reused = arena.reused;
+  if (cached != NULL)
+    *cached = arena.cached;
+}
@@ -0,0 +1,273 @@
+/* gmp_array_map, gmp_array_unmap -- use an array file in place.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if HAVE_MMAP && HAVE_SYS_MMAN_H && HAVE_SYS_STAT_H && HAVE_FCNTL_H \
+  && HAVE_UNISTD_H
+#define USE_MMAP 1
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* See array_out.c for the file format.
+
+   The file is mapped read-only and private, and the views made by
+   mpz_roinit_array etc point straight at its limbs, so nothing is read
+   until used.  A file written with the other limb byte order is instead read
+   into memory and byte swapped.  So is any file when there's no mmap.
+
+   The header and the whole index are checked here, so that a bad file can
+   never send a view outside the file.  The high limb of each value is also
+   checked to be non-zero, since GMP functions rely on that.  */
+
+static int
+get_word (const unsigned char *p, size_t *r)
+{
+  size_t  x;
+  int     i;
+
+  x = 0;
+  for (i = 0; i < 8; i++)
+    {
+      if (x > (~(size_t) 0) >> 8)
+	return 0;
+      x = (x << 8) | p[i];
+    }
+  *r = x;
+  return 1;
+}
+
+/* Get a twos complement word as its absolute value and sign.  */
+static int
+get_signed (const unsigned char *p, size_t *r, int *neg)
+{
+  unsigned char  q[8];
+  int            i;
+
+  *neg = p[0] >> 7;
+  if (! *neg)
+    return get_word (p, r);
+
+  for (i = 0; i < 8; i++)
+    q[i] = ~p[i];
+  if (! get_word (q, r) || *r == ~(size_t) 0)
+    return 0;
+  (*r)++;
+  return 1;
+}
+
+/* Check the file at p, and set up a for it.  Limbs in the other byte order
+   are swapped if writable is non-zero.  Return 0 for success, 1 if the limbs
+   need swapping but writable is zero, or -1 for a bad file.  */
+static int
+array_check (gmp_array_ptr a, unsigned char *p, size_t bytes, int writable)
+{
+  size_t          w[8], count, avail, off, size, exp, prec, i, k;
+  unsigned char   *ep;
+  mp_ptr          dp;
+  int             parts, c, swap, neg, eneg;
+
+  if (bytes < GMP_ARRAY_HEADER_BYTES
+      || memcmp (p, GMP_ARRAY_MAGIC, 8) != 0)
+    return -1;
+  for (i = 1; i < 8; i++)
+    if (! get_word (p + 8 * i, &w[i]))
+      return -1;
+  if (w[1] != GMP_ARRAY_VERSION
+      || (w[2] != GMP_ARRAY_MPZ && w[2] != GMP_ARRAY_MPQ
+	  && w[2] != GMP_ARRAY_MPF)
+      || w[4] != GMP_LIMB_BITS || w[5] != GMP_NAIL_BITS || w[6] > 1)
+    return -1;
+
+  swap = (w[6] != gmp_array_limb_order ());
+  if (swap && ! writable)
+    return 1;
+
+  count = w[3];
+  parts = (w[2] == GMP_ARRAY_MPQ ? 2 : 1);
+  if (count > (bytes - GMP_ARRAY_HEADER_BYTES) / GMP_ARRAY_ENTRY_BYTES / parts
+      || w[7] < GMP_ARRAY_HEADER_BYTES + count * parts * GMP_ARRAY_ENTRY_BYTES
+      || w[7] > bytes || w[7] % GMP_ARRAY_ALIGN != 0)
+    return -1;
+
+  dp = (mp_ptr) (p + w[7]);
+  avail = (bytes - w[7]) / GMP_LIMB_BYTES;
+
+  ep = p + GMP_ARRAY_HEADER_BYTES;
+  for (i = 0; i < count; i++)
+    for (c = 0; c < parts; c++)
+      {
+	if (! get_signed (ep, &size, &neg)
+	    || ! get_signed (ep + 8, &exp, &eneg)
+	    || ! get_word (ep + 16, &prec)
+	    || ! get_word (ep + 24, &off))
+	  return -1;
+	ep += GMP_ARRAY_ENTRY_BYTES;
+
+	if (size > INT_MAX || exp > MP_EXP_T_MAX || prec > INT_MAX
+	    || off > avail || size > avail - off)
+	  return -1;
+	if (c == 1 && (neg || size == 0))
+	  return -1;		/* mpq denominator */
+	if (w[2] == GMP_ARRAY_MPF && (prec == 0 || size > prec + 1))
+	  return -1;
+
+	if (swap)
+	  for (k = 0; k < size; k++)
+	    BSWAP_LIMB (dp[off + k], dp[off + k]);
+	if (size != 0 && dp[off + size - 1] == 0)
+	  return -1;
+      }
+
+  a->_mp_base = p;
+  a->_mp_bytes = bytes;
+  a->_mp_count = count;
+  a->_mp_kind = w[2];
+  a->_mp_d = dp;
+  return 0;
+}
+
+int
+gmp_array_map (gmp_array_ptr a, const char *filename)
+{
+  unsigned char  *p;
+  size_t         bytes;
+  long           pos;
+  FILE           *fp;
+
+#if USE_MMAP
+  struct stat    st;
+  void           *m;
+  int            fd, r;
+
+  fd = open (filename, O_RDONLY);
+  if (fd < 0)
+    return -1;
+  if (fstat (fd, &st) != 0 || st.st_size < GMP_ARRAY_HEADER_BYTES
+      || (off_t) (size_t) st.st_size != st.st_size)
+    {
+      close (fd);
+      return -1;
+    }
+  bytes = st.st_size;
+  m = mmap (NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (m != MAP_FAILED)
+    {
+      r = array_check (a, (unsigned char *) m, bytes, 0);
+      if (r == 0)
+	{
+	  a->_mp_mapped = 1;
+	  return 0;
+	}
+      munmap (m, bytes);
+      if (r < 0)
+	return -1;
+    }
+#endif
+
+  fp = fopen (filename, "rb");
+  if (fp == NULL)
+    return -1;
+  if (fseek (fp, 0L, SEEK_END) != 0 || (pos = ftell (fp)) < 0
+      || pos < GMP_ARRAY_HEADER_BYTES || fseek (fp, 0L, SEEK_SET) != 0)
+    {
+      fclose (fp);
+      return -1;
+    }
+  bytes = pos;
+  p = __GMP_ALLOCATE_FUNC_TYPE (bytes, unsigned char);
+  if (fread (p, bytes, 1, fp) != 1 || array_check (a, p, bytes, 1) != 0)
+    {
+      fclose (fp);
+      (*__gmp_free_func) (p, bytes);
+      return -1;
+    }
+  fclose (fp);
+  a->_mp_mapped = 0;
+  return 0;
+}
+
+void
+gmp_array_unmap (gmp_array_ptr a)
+{
+#if USE_MMAP
+  if (a->_mp_mapped)
+    {
+      munmap (a->_mp_base, a->_mp_bytes);
+      return;
+    }
+#endif
+  (*__gmp_free_func) (a->_mp_base, a->_mp_bytes);
+}
+
+size_t
+gmp_array_count (gmp_array_srcptr a)
+{
+  return a->_mp_count;
+}
+
+int
+gmp_array_kind (gmp_array_srcptr a)
+{
+  return a->_mp_kind;
+}
+
+/* Get index entry j, which has been checked by array_check.  */
+mp_ptr
+__gmp_array_entry (gmp_array_srcptr a, size_t j,
+		   mp_size_t *size, mp_exp_t *exp, mp_size_t *prec)
+{
+  const unsigned char  *ep;
+  size_t               x;
+  int                  neg;
+
+  ep = (const unsigned char *) a->_mp_base
+    + GMP_ARRAY_HEADER_BYTES + j * GMP_ARRAY_ENTRY_BYTES;
+  get_signed (ep, &x, &neg);
+  *size = (neg ? - (mp_size_t) x : (mp_size_t) x);
+  get_signed (ep + 8, &x, &neg);
+  *exp = (neg ? - (mp_exp_t) x : (mp_exp_t) x);
+  get_word (ep + 16, &x);
+  *prec = x;
+  get_word (ep + 24, &x);
+  return a->_mp_d + x;
+}
@@ -0,0 +1,185 @@
+/* __gmp_array_out -- write an array file.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <string.h>
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The format is the 8 byte magic GMP_ARRAY_MAGIC, then seven 8-byte big
+   endian words, the format version, the kind of values, their count,
+   GMP_LIMB_BITS, GMP_NAIL_BITS, the limb byte order (0 for little endian, 1
+   for big endian) and the byte offset of the limb data.
+
+   The index follows, for each mpz or mpf, and for the numerator then the
+   denominator of each mpq, four 8-byte big endian words, the _mp_size, the
+   _mp_exp (0 for mpz and mpq), the _mp_prec (0 for mpz and mpq), and the
+   offset of the limbs from the start of the limb data, in limbs.  Signed
+   words are twos complement.
+
+   The limbs are written as they are in memory, which is what lets
+   gmp_array_map use them in place.  The limb data starts at a multiple of
+   GMP_ARRAY_ALIGN bytes so it's aligned when the file is mapped.  */
+
+static void
+put_word (unsigned char *p, size_t x)
+{
+  int  i;
+  for (i = 7; i >= 0; i--)
+    {
+      p[i] = x & 0xff;
+      x >>= 8;
+    }
+}
+
+static void
+put_signed (unsigned char *p, long x)
+{
+  int  i;
+  if (x >= 0)
+    put_word (p, (size_t) x);
+  else
+    {
+      /* -(x+1) doesn't overflow for x == LONG_MIN */
+      put_word (p, (size_t) -(x + 1));
+      for (i = 0; i < 8; i++)
+	p[i] = ~p[i];
+    }
+}
+
+/* Get part c of value i of the array x of the given kind.  */
+static mp_srcptr
+array_part (int kind, const void *x, size_t i, int c,
+	    mp_size_t *size, mp_exp_t *exp, mp_size_t *prec)
+{
+  mpz_srcptr  z;
+  mpf_srcptr  f;
+
+  switch (kind)
+    {
+    case GMP_ARRAY_MPZ:
+      z = (mpz_srcptr) x + i;
+      break;
+    case GMP_ARRAY_MPQ:
+      z = (c == 0 ? NUM ((mpq_srcptr) x + i) : DEN ((mpq_srcptr) x + i));
+      break;
+    default:
+      f = (mpf_srcptr) x + i;
+      *size = SIZ(f);
+      *exp = EXP(f);
+      *prec = PREC(f);
+      return PTR(f);
+    }
+  *size = SIZ(z);
+  *exp = 0;
+  *prec = 0;
+  return PTR(z);
+}
+
+/* Index entries are written through a buffer of this many.  */
+#define ENTRY_BUFFER  128
+
+size_t
+__gmp_array_out (FILE *fp, int kind, const void *x, size_t count)
+{
+  unsigned char  buf[ENTRY_BUFFER * GMP_ARRAY_ENTRY_BYTES];
+  unsigned char  *ep;
+  size_t         dsize, i, off, n;
+  mp_size_t      size, prec;
+  mp_exp_t       exp;
+  mp_srcptr      xp;
+  int            parts, c;
+
+  ASSERT (kind == GMP_ARRAY_MPZ || kind == GMP_ARRAY_MPQ
+	  || kind == GMP_ARRAY_MPF);
+  ASSERT_ALWAYS (GMP_ARRAY_HEADER_BYTES <= sizeof (buf));
+  ASSERT_ALWAYS (GMP_ARRAY_ALIGN <= sizeof (buf));
+
+  if (fp == 0)
+    fp = stdout;
+
+  parts = (kind == GMP_ARRAY_MPQ ? 2 : 1);
+  dsize = ROUND_UP_MULTIPLE ((size_t) GMP_ARRAY_HEADER_BYTES
+			     + count * parts * GMP_ARRAY_ENTRY_BYTES,
+			     (size_t) GMP_ARRAY_ALIGN);
+
+  memcpy (buf, GMP_ARRAY_MAGIC, 8);
+  put_word (buf + 8, GMP_ARRAY_VERSION);
+  put_word (buf + 16, kind);
+  put_word (buf + 24, count);
+  put_word (buf + 32, GMP_LIMB_BITS);
+  put_word (buf + 40, GMP_NAIL_BITS);
+  put_word (buf + 48, gmp_array_limb_order ());
+  put_word (buf + 56, dsize);
+  if (fwrite (buf, GMP_ARRAY_HEADER_BYTES, 1, fp) != 1)
+    return 0;
+
+  ep = buf;
+  off = 0;
+  for (i = 0; i < count; i++)
+    for (c = 0; c < parts; c++)
+      {
+	array_part (kind, x, i, c, &size, &exp, &prec);
+	put_signed (ep, size);
+	put_signed (ep + 8, exp);
+	put_word (ep + 16, prec);
+	put_word (ep + 24, off);
+	ep += GMP_ARRAY_ENTRY_BYTES;
+	off += ABS (size);
+	if (ep == buf + sizeof (buf))
+	  {
+	    if (fwrite (buf, sizeof (buf), 1, fp) != 1)
+	      return 0;
+	    ep = buf;
+	  }
+      }
+
+  n = ep - buf;
+  if (n != 0 && fwrite (buf, n, 1, fp) != 1)
+    return 0;
+
+  /* zeros up to the limb data */
+  n = dsize - GMP_ARRAY_HEADER_BYTES - count * parts * GMP_ARRAY_ENTRY_BYTES;
+  memset (buf, 0, n);
+  if (n != 0 && fwrite (buf, n, 1, fp) != 1)
+    return 0;
+
+  for (i = 0; i < count; i++)
+    for (c = 0; c < parts; c++)
+      {
+	xp = array_part (kind, x, i, c, &size, &exp, &prec);
+	n = ABS (size);
+	if (n != 0 && fwrite (xp, GMP_LIMB_BYTES, n, fp) != n)
+	  return 0;
+      }
+
+  return dsize + off * GMP_LIMB_BYTES;
+}
@@ -0,0 +1,405 @@
+/* Factoring with the elliptic curve method.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program.  If not, see https://www.gnu.org/licenses/.  */
+
+
+/* Curves are in Montgomery form b*y^2 = x^3 + a*x^2 + x, with points as
+   projective (X:Z), so only the x coordinate is carried, and a point can be
+   added to another only when their difference is known.  The curve comes
+   from Suyama's parametrization by sigma, which makes the group order
+   divisible by 12.
+
+   Stage 1 multiplies the starting point by the product E of all the prime
+   powers up to B1, with a Montgomery ladder, which takes about ten modular
+   multiplications for each bit of E.
+
+   Stage 2 covers one more prime q up to B2, with a baby-step giant-step
+   approach.  Each q is written as k*D +/- j, with D = 2*3*5*7*11 and
+   j < D/2 coprime to D.  The baby steps [j]Q are precomputed and made
+   affine, the giant steps [k*D]Q stepped with one addition each, and
+   [q]Q = O mod p becomes X([k*D]Q) - x([j]Q) Z([k*D]Q) = 0 mod p, one
+   multiplication each to form and accumulate.  q = k*D+j and q' = k*D-j
+   share their term.
+
+   All the arithmetic is mpz_mulmod_ctx and friends with one mpz_modctx_t,
+   which for the sizes ECM is used on saves most of the cost of the
+   reductions over mpz_mod.  */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gmp.h"
+#include "factor.h"
+
+#define ECM_D     2310
+#define ECM_HALF  (ECM_D / 2)
+
+struct ecm_curve
+{
+  mpz_modctx_t ctx;
+  mpz_srcptr n;
+  mpz_t a24;			/* (A+2)/4 */
+  mpz_t t1, t2, t3, t4;
+};
+
+static void
+mod_add (mpz_ptr r, mpz_srcptr a, mpz_srcptr b, struct ecm_curve *c)
+{
+  mpz_add (r, a, b);
+  if (mpz_cmp (r, c->n) >= 0)
+    mpz_sub (r, r, c->n);
+}
+
+static void
+mod_sub (mpz_ptr r, mpz_srcptr a, mpz_srcptr b, struct ecm_curve *c)
+{
+  mpz_sub (r, a, b);
+  if (mpz_sgn (r) < 0)
+    mpz_add (r, r, c->n);
+}
+
+/* (X2:Z2) = 2 (X:Z) */
+static void
+xdbl (mpz_ptr x2, mpz_ptr z2, mpz_srcptr x, mpz_srcptr z, struct ecm_curve *c)
+{
+  mod_add (c->t1, x, z, c);
+  mpz_sqrmod_ctx (c->t1, c->t1, c->ctx);
+  mod_sub (c->t2, x, z, c);
+  mpz_sqrmod_ctx (c->t2, c->t2, c->ctx);
+  mpz_mulmod_ctx (x2, c->t1, c->t2, c->ctx);
+  mod_sub (c->t3, c->t1, c->t2, c);
+  mpz_mulmod_ctx (c->t4, c->a24, c->t3, c->ctx);
+  mod_add (c->t4, c->t4, c->t2, c);
+  mpz_mulmod_ctx (z2, c->t3, c->t4, c->ctx);
+}
+
+/* (X3:Z3) = (XP:ZP) + (XQ:ZQ), where (XD:ZD) = P - Q, which mustn't be
+   the point at infinity.  X3 and Z3 can be the same variables as any of
+   the inputs.  */
+static void
+xadd (mpz_ptr x3, mpz_ptr z3, mpz_srcptr xp, mpz_srcptr zp,
+      mpz_srcptr xq, mpz_srcptr zq, mpz_srcptr xd, mpz_srcptr zd,
+      struct ecm_curve *c)
+{
+  mod_sub (c->t1, xp, zp, c);
+  mod_add (c->t2, xq, zq, c);
+  mpz_mulmod_ctx (c->t1, c->t1, c->t2, c->ctx);
+  mod_add (c->t2, xp, zp, c);
+  mod_sub (c->t3, xq, zq, c);
+  mpz_mulmod_ctx (c->t2, c->t2, c->t3, c->ctx);
+  mod_add (c->t3, c->t1, c->t2, c);
+  mpz_sqrmod_ctx (c->t3, c->t3, c->ctx);
+  mod_sub (c->t4, c->t1, c->t2, c);
+  mpz_sqrmod_ctx (c->t4, c->t4, c->ctx);
+  mpz_mulmod_ctx (c->t1, zd, c->t3, c->ctx);
+  mpz_mulmod_ctx (z3, xd, c->t4, c->ctx);
+  mpz_swap (x3, c->t1);
+}
+
+/* (XR:ZR) = K (X:Z), for K >= 1, by a Montgomery ladder.  XR and ZR must
+   not be X and Z.  */
+static void
+ladder (mpz_ptr xr, mpz_ptr zr, mpz_srcptr k, mpz_srcptr x, mpz_srcptr z,
+	struct ecm_curve *c)
+{
+  mpz_t x1, z1;
+  mp_bitcnt_t i;
+
+  mpz_init (x1);
+  mpz_init (z1);
+  mpz_set (xr, x);
+  mpz_set (zr, z);
+  xdbl (x1, z1, x, z, c);
+
+  /* Invariant (x1:z1) - (xr:zr) = (x:z).  */
+  for (i = mpz_sizeinbase (k, 2) - 1; i-- > 0; )
+    {
+      if (mpz_tstbit (k, i))
+	{
+	  xadd (xr, zr, x1, z1, xr, zr, x, z, c);
+	  xdbl (x1, z1, x1, z1, c);
+	}
+      else
+	{
+	  xadd (x1, z1, x1, z1, xr, zr, x, z, c);
+	  xdbl (xr, zr, xr, zr, c);
+	}
+    }
+  mpz_clear (x1);
+  mpz_clear (z1);
+}
+
+static void
+ladder_ui (mpz_ptr xr, mpz_ptr zr, unsigned long k, mpz_srcptr x, mpz_srcptr z,
+	   struct ecm_curve *c)
+{
+  mpz_t kz;
+  mpz_init_set_ui (kz, k);
+  ladder (xr, zr, kz, x, z, c);
+  mpz_clear (kz);
+}
+
+/* Set F to gcd(A, N) and return 1 if that's a proper factor.  */
+static int
+proper_gcd (mpz_ptr f, mpz_srcptr a, mpz_srcptr n)
+{
+  mpz_gcd (f, a, n);
+  return mpz_cmp_ui (f, 1) > 0 && mpz_cmp (f, n) < 0;
+}
+
+/* Set E to the product of the prime powers up to B1, that is the highest
+   power of each prime p <= B1 which is still <= B1.  */
+void
+factor_stage1_exponent (mpz_ptr e, unsigned long b1)
+{
+  gmp_primeiter_t it;
+  unsigned long *v, q;
+  size_t n, alloc;
+  mp_limb_t p;
+
+  alloc = 1024;
+  v = malloc (alloc * sizeof (v[0]));
+  n = 0;
+  gmp_primeiter_init (it, 2, (mp_limb_t) b1 + 1);
+  while ((p = gmp_primeiter_next (it)) != 0)
+    {
+      for (q = p; q <= b1 / p; q *= p)
+	;
+      if (n == alloc)
+	{
+	  alloc *= 2;
+	  v = realloc (v, alloc * sizeof (v[0]));
+	}
+      v[n++] = q;
+    }
+  gmp_primeiter_clear (it);
+  mpz_prod_ui_array (e, v, n);
+  free (v);
+}
+
+/* Stage 2 for the point (X:Z), primes B1 < q <= B2.  */
+static int
+stage2 (mpz_ptr f, mpz_srcptr x, mpz_srcptr z, unsigned long b1,
+	unsigned long b2, struct ecm_curve *c)
+{
+  mpz_t *bx, *bz, *pre, xd, zd, xg, zg, xh, zh, xa, za, xb, zb, g, t;
+  short idx[ECM_HALF];
+  unsigned char used[ECM_HALF];
+  gmp_primeiter_t it;
+  unsigned long k, kcur, j, start;
+  mp_limb_t q;
+  int nb, i, found;
+
+  /* Primes below D/2 aren't on any window, leave them out.  */
+  start = b1 + 1;
+  if (start <= ECM_HALF)
+    start = ECM_HALF + 1;
+  if (b2 < start)
+    return 0;
+
+  mpz_init (xd); mpz_init (zd);
+  mpz_init (xg); mpz_init (zg);
+  mpz_init (xh); mpz_init (zh);
+  mpz_init (xa); mpz_init (za);
+  mpz_init (xb); mpz_init (zb);
+  mpz_init (g);
+  mpz_init (t);
+
+  /* Baby steps [j]Q, j odd and coprime to D, from [j+2]Q = [j]Q + [2]Q
+     with difference [j-2]Q.  (xd:zd) is [2]Q for now.  */
+  bx = malloc (ECM_HALF * sizeof (mpz_t));
+  bz = malloc (ECM_HALF * sizeof (mpz_t));
+  pre = malloc (ECM_HALF * sizeof (mpz_t));
+  nb = 0;
+  xdbl (xd, zd, x, z, c);
+  mpz_set (xa, x);		/* [j-2]Q, for j = 1 that's [-1]Q = Q */
+  mpz_set (za, z);
+  mpz_set (xb, x);		/* [j]Q */
+  mpz_set (zb, z);
+  for (j = 1; j < ECM_HALF; j += 2)
+    {
+      idx[j] = -1;
+      if (j % 3 != 0 && j % 5 != 0 && j % 7 != 0 && j % 11 != 0)
+	{
+	  mpz_init_set (bx[nb], xb);
+	  mpz_init_set (bz[nb], zb);
+	  mpz_init (pre[nb]);
+	  idx[j] = nb++;
+	}
+      xadd (xg, zg, xb, zb, xd, zd, xa, za, c);
+      mpz_swap (xa, xb);
+      mpz_swap (za, zb);
+      mpz_swap (xb, xg);
+      mpz_swap (zb, zg);
+    }
+
+  /* Make the baby steps affine, with one inversion of the product of all
+     the Z's.  */
+  mpz_set (pre[0], bz[0]);
+  for (i = 1; i < nb; i++)
+    mpz_mulmod_ctx (pre[i], pre[i - 1], bz[i], c->ctx);
+  if (! mpz_invert_ctx (g, pre[nb - 1], c->ctx))
+    {
+      found = proper_gcd (f, pre[nb - 1], c->n);
+      goto done;
+    }
+  for (i = nb - 1; i > 0; i--)
+    {
+      mpz_mulmod_ctx (t, g, pre[i - 1], c->ctx);	/* 1/Zi */
+      mpz_mulmod_ctx (g, g, bz[i], c->ctx);
+      mpz_mulmod_ctx (bx[i], bx[i], t, c->ctx);
+    }
+  mpz_mulmod_ctx (bx[0], bx[0], g, c->ctx);
+
+  /* Giant steps [k*D]Q, from (xg:zg) = [k*D]Q and (xh:zh) = [(k-1)*D]Q,
+     with (xd:zd) = [D]Q as the step.  */
+  kcur = (start + ECM_HALF - 1) / ECM_D;
+  if (kcur == 0)
+    kcur = 1;
+  ladder_ui (xd, zd, ECM_D, x, z, c);
+  ladder_ui (xg, zg, kcur * ECM_D, x, z, c);
+  if (kcur > 1)
+    ladder_ui (xh, zh, (kcur - 1) * ECM_D, x, z, c);
+
+  memset (used, 0, sizeof (used));
+  mpz_set_ui (g, 1);
+  gmp_primeiter_init (it, start, (mp_limb_t) b2 + 1);
+  while ((q = gmp_primeiter_next (it)) != 0)
+    {
+      k = (q + ECM_HALF) / ECM_D;
+      while (kcur < k)
+	{
+	  /* [(k+1)D]Q = [kD]Q + [D]Q, difference [(k-1)D]Q, or for k = 1
+	     where that difference is the point at infinity, 2 [D]Q.  */
+	  if (kcur == 1)
+	    xdbl (xh, zh, xg, zg, c);
+	  else
+	    xadd (xh, zh, xg, zg, xd, zd, xh, zh, c);
+	  mpz_swap (xg, xh);
+	  mpz_swap (zg, zh);
+	  kcur++;
+	  memset (used, 0, sizeof (used));
+	}
+      j = q > k * ECM_D ? q - k * ECM_D : k * ECM_D - q;
+      if (! used[j])
+	{
+	  used[j] = 1;
+	  mpz_mulmod_ctx (t, bx[idx[j]], zg, c->ctx);
+	  mod_sub (t, xg, t, c);
+	  mpz_mulmod_ctx (g, g, t, c->ctx);
+	}
+    }
+  gmp_primeiter_clear (it);
+
+  found = proper_gcd (f, g, c->n);
+
+ done:
+  for (i = 0; i < nb; i++)
+    {
+      mpz_clear (bx[i]);
+      mpz_clear (bz[i]);
+      mpz_clear (pre[i]);
+    }
+  free (bx);
+  free (bz);
+  free (pre);
+  mpz_clear (xd); mpz_clear (zd);
+  mpz_clear (xg); mpz_clear (zg);
+  mpz_clear (xh); mpz_clear (zh);
+  mpz_clear (xa); mpz_clear (za);
+  mpz_clear (xb); mpz_clear (zb);
+  mpz_clear (g);
+  mpz_clear (t);
+  return found;
+}
+
+/* Run one curve, with Suyama parameter SIGMA >= 6, on the odd N, which
+   must not be a perfect power.  Return 1 with a factor 1 < F < N if one
+   was found.  */
+int
+factor_using_ecm (mpz_ptr f, mpz_srcptr n, unsigned long b1, unsigned long b2,
+		  unsigned long sigma)
+{
+  struct ecm_curve c;
+  mpz_t u, v, x, z, e, xr, zr, num, den;
+  int found;
+
+  mpz_modctx_init (c.ctx, n);
+  c.n = n;
+  mpz_init (c.a24);
+  mpz_init (c.t1);
+  mpz_init (c.t2);
+  mpz_init (c.t3);
+  mpz_init (c.t4);
+  mpz_inits (u, v, x, z, e, xr, zr, num, den, NULL);
+
+  /* u = sigma^2 - 5, v = 4 sigma, starting point (u^3 : v^3), and
+     (A+2)/4 = (v-u)^3 (3u+v) / (16 u^3 v).  */
+  mpz_set_ui (u, sigma);
+  mpz_mul_ui (u, u, sigma);
+  mpz_sub_ui (u, u, 5);
+  mpz_mod_ctx (u, u, c.ctx);
+  mpz_set_ui (v, sigma);
+  mpz_mul_ui (v, v, 4);
+  mpz_mod_ctx (v, v, c.ctx);
+
+  mpz_sqrmod_ctx (x, u, c.ctx);
+  mpz_mulmod_ctx (x, x, u, c.ctx);		/* u^3 */
+  mpz_sqrmod_ctx (z, v, c.ctx);
+  mpz_mulmod_ctx (z, z, v, c.ctx);		/* v^3 */
+
+  mod_sub (num, v, u, &c);
+  mpz_sqrmod_ctx (e, num, c.ctx);
+  mpz_mulmod_ctx (num, num, e, c.ctx);		/* (v-u)^3 */
+  mpz_mul_ui (e, u, 3);
+  mpz_add (e, e, v);
+  mpz_mulmod_ctx (num, num, e, c.ctx);		/* (v-u)^3 (3u+v) */
+  mpz_mul_ui (den, x, 16);
+  mpz_mulmod_ctx (den, den, v, c.ctx);		/* 16 u^3 v */
+
+  /* One inversion gives both x = u^3/v^3 and (A+2)/4.  */
+  mpz_mulmod_ctx (e, den, z, c.ctx);
+  if (! mpz_invert_ctx (e, e, c.ctx))
+    {
+      mpz_mulmod_ctx (e, den, z, c.ctx);
+      found = proper_gcd (f, e, n);
+      goto done;
+    }
+  mpz_mulmod_ctx (x, x, den, c.ctx);
+  mpz_mulmod_ctx (x, x, e, c.ctx);
+  mpz_mulmod_ctx (c.a24, num, z, c.ctx);
+  mpz_mulmod_ctx (c.a24, c.a24, e, c.ctx);
+  mpz_set_ui (z, 1);
+
+  /* Stage 1.  */
+  factor_stage1_exponent (e, b1);
+  ladder (xr, zr, e, x, z, &c);
+  found = proper_gcd (f, zr, n);
+  if (found || mpz_cmp (f, n) == 0)
+    goto done;
+
+  /* Stage 2.  */
+  found = stage2 (f, xr, zr, b1, b2, &c);
+
+ done:
+  mpz_clears (u, v, x, z, e, xr, zr, num, den, NULL);
+  mpz_clear (c.a24);
+  mpz_clear (c.t1);
+  mpz_clear (c.t2);
+  mpz_clear (c.t3);
+  mpz_clear (c.t4);
+  mpz_modctx_clear (c.ctx);
+  return found;
+}
@@ -0,0 +1,503 @@
+/* The factoring engine of factorize: trial division, Pollard rho, p-1 and ECM.
+
+Copyright 1995, 1997-2003, 2005, 2009, 2012, 2015, 2026 Free Software
+Foundation, Inc.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program.  If not, see https://www.gnu.org/licenses/.  */
+
+
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "factor.h"
+
+static unsigned char primes_diff[] = {
+#define P(a,b,c) a,
+#include "primes.h"
+#undef P
+};
+#define PRIMES_PTAB_ENTRIES (sizeof(primes_diff) / sizeof(primes_diff[0]))
+
+/* Rho products between gcds.  */
+#define RHO_BATCH 64
+
+const struct factor_ecm_level factor_ecm_levels[] = {
+  { 15,     2000,    25 },
+  { 20,    11000,    90 },
+  { 25,    50000,   300 },
+  { 30,   250000,   700 },
+  { 35,  1000000,  1800 },
+  { 40,  3000000,  5100 },
+  { 45, 11000000, 10600 },
+  { 50, 43000000, 19300 },
+  {  0,        0,     0 }
+};
+
+static const char *const method_names[] = {
+  "none", "division", "rho", "pm1", "ecm", "prime"
+};
+
+void
+factor_params_init (struct factor_params *params)
+{
+  params->verbose = 0;
+  params->prove = 1;
+  params->rho_iters = 100000;
+  params->pm1_b1 = 100000;
+  params->pm1_b2 = 100 * params->pm1_b1;
+  params->ecm_max_b1 = 3000000;
+  params->ecm_sigma = 7;
+}
+
+void
+factor_init (struct factors *factors)
+{
+  factors->p = malloc (1);
+  factors->e = malloc (1);
+  factors->method = malloc (1);
+  factors->nfactors = 0;
+  factors->curves = 0;
+  factors->ecm_b1 = 0;
+}
+
+void
+factor_clear (struct factors *factors)
+{
+  int i;
+
+  for (i = 0; i < factors->nfactors; i++)
+    mpz_clear (factors->p[i]);
+
+  free (factors->p);
+  free (factors->e);
+  free (factors->method);
+}
+
+void
+factor_insert (struct factors *factors, mpz_srcptr prime,
+	       enum factor_method method)
+{
+  long    nfactors  = factors->nfactors;
+  mpz_t         *p  = factors->p;
+  unsigned long *e  = factors->e;
+  enum factor_method *m = factors->method;
+  long i, j;
+
+  /* Locate position for insert new or increment e.  */
+  for (i = nfactors - 1; i >= 0; i--)
+    {
+      if (mpz_cmp (p[i], prime) <= 0)
+	break;
+    }
+
+  if (i < 0 || mpz_cmp (p[i], prime) != 0)
+    {
+      p = realloc (p, (nfactors + 1) * sizeof p[0]);
+      e = realloc (e, (nfactors + 1) * sizeof e[0]);
+      m = realloc (m, (nfactors + 1) * sizeof m[0]);
+
+      mpz_init (p[nfactors]);
+      for (j = nfactors - 1; j > i; j--)
+	{
+	  mpz_set (p[j + 1], p[j]);
+	  e[j + 1] = e[j];
+	  m[j + 1] = m[j];
+	}
+      mpz_set (p[i + 1], prime);
+      e[i + 1] = 1;
+      m[i + 1] = method;
+
+      factors->p = p;
+      factors->e = e;
+      factors->method = m;
+      factors->nfactors = nfactors + 1;
+    }
+  else
+    {
+      e[i] += 1;
+    }
+}
+
+void
+factor_insert_ui (struct factors *factors, unsigned long prime,
+		  enum factor_method method)
+{
+  mpz_t pz;
+
+  mpz_init_set_ui (pz, prime);
+  factor_insert (factors, pz, method);
+  mpz_clear (pz);
+}
+
+void
+factor_using_division (mpz_ptr t, struct factors *factors)
+{
+  unsigned long int p;
+  int i;
+
+  p = mpz_scan1 (t, 0);
+  mpz_fdiv_q_2exp (t, t, p);
+  while (p)
+    {
+      factor_insert_ui (factors, 2, FACTOR_METHOD_DIVISION);
+      --p;
+    }
+
+  p = 3;
+  for (i = 1; i <= PRIMES_PTAB_ENTRIES;)
+    {
+      if (! mpz_divisible_ui_p (t, p))
+	{
+	  p += primes_diff[i++];
+	  if (mpz_cmp_ui (t, p * p) < 0)
+	    break;
+	}
+      else
+	{
+	  mpz_tdiv_q_ui (t, t, p);
+	  factor_insert_ui (factors, p, FACTOR_METHOD_DIVISION);
+	}
+    }
+}
+
+/* BPSW first, which finds composites quickly and has no known failures, then
+   when proving, Lucas' theorem: n is prime if some a has a^(n-1) = 1 but
+   a^((n-1)/q) != 1 for each prime q dividing n-1.  This needs n-1 factored,
+   which is done recursively.  If that gives up on a composite, the answer is
+   left as BPSW's.  */
+int
+factor_prime_p (mpz_srcptr n, int prove)
+{
+  struct factor_params params;
+  struct factors factors;
+  mpz_t a, nm1, tmp;
+  int r, i, is_prime;
+
+  if (mpz_cmp_ui (n, 1) <= 0)
+    return 0;
+
+  is_prime = mpz_bpsw_p (n);
+  if (is_prime != 1 || ! prove)
+    return is_prime != 0;
+
+  mpz_inits (a, nm1, tmp, NULL);
+  mpz_sub_ui (nm1, n, 1);
+
+  factor_params_init (&params);
+  factor_init (&factors);
+  if (! factor (&factors, nm1, &params))
+    goto ret;
+
+  mpz_set_ui (a, 2);
+  for (r = 0; r < PRIMES_PTAB_ENTRIES; r++)
+    {
+      mpz_powm (tmp, a, nm1, n);
+      if (mpz_cmp_ui (tmp, 1) != 0)
+	{
+	  is_prime = 0;
+	  goto ret;
+	}
+
+      is_prime = 1;
+      for (i = 0; i < factors.nfactors && is_prime; i++)
+	{
+	  mpz_divexact (tmp, nm1, factors.p[i]);
+	  mpz_powm (tmp, a, tmp, n);
+	  is_prime = mpz_cmp_ui (tmp, 1) != 0;
+	}
+      if (is_prime)
+	goto ret;
+
+      mpz_add_ui (a, a, primes_diff[r]);	/* Establish new base.  */
+    }
+
+  fprintf (stderr, "Lucas prime test failure.  This should not happen\n");
+  abort ();
+
+ ret:
+  factor_clear (&factors);
+  mpz_clears (a, nm1, tmp, NULL);
+  return is_prime;
+}
+
+/* Brent's variant of Pollard rho, iterating x -> x^2 + A, with the
+   differences multiplied up RHO_BATCH at a time between gcds.  Give up after
+   ITERS iterations, or if the cycle closes without a proper factor.  */
+int
+factor_using_pollard_rho (mpz_ptr f, mpz_srcptr n, unsigned long a,
+			  unsigned long iters)
+{
+  mpz_modctx_t ctx;
+  mpz_t x, y, ys, q, t;
+  unsigned long r, k, i, m, done;
+  int found;
+
+  mpz_modctx_init (ctx, n);
+  mpz_inits (x, ys, q, t, NULL);
+  mpz_init_set_ui (y, 2);
+  mpz_set_ui (q, 1);
+  mpz_set_ui (f, 1);
+  done = 0;
+
+  for (r = 1; mpz_cmp_ui (f, 1) == 0 && done < iters; r *= 2)
+    {
+      mpz_set (x, y);
+      for (i = 0; i < r; i++)
+	{
+	  mpz_sqrmod_ctx (y, y, ctx);
+	  mpz_add_ui (y, y, a);
+	}
+      for (k = 0; k < r && mpz_cmp_ui (f, 1) == 0; k += m)
+	{
+	  mpz_set (ys, y);
+	  m = r - k < RHO_BATCH ? r - k : RHO_BATCH;
+	  for (i = 0; i < m; i++)
+	    {
+	      mpz_sqrmod_ctx (y, y, ctx);
+	      mpz_add_ui (y, y, a);
+	      mpz_sub (t, x, y);
+	      mpz_mulmod_ctx (q, q, t, ctx);
+	    }
+	  mpz_gcd (f, q, n);
+	  done += r + m;
+	}
+    }
+
+  /* The batch overshot to q = 0, step through it one at a time.  */
+  if (mpz_cmp (f, n) == 0)
+    {
+      do
+	{
+	  mpz_sqrmod_ctx (ys, ys, ctx);
+	  mpz_add_ui (ys, ys, a);
+	  mpz_sub (t, x, ys);
+	  mpz_gcd (f, t, n);
+	}
+      while (mpz_cmp_ui (f, 1) == 0);
+    }
+
+  found = mpz_cmp_ui (f, 1) > 0 && mpz_cmp (f, n) < 0;
+
+  mpz_clears (x, y, ys, q, t, NULL);
+  mpz_modctx_clear (ctx);
+  return found;
+}
+
+struct ecm_batch
+{
+  mpz_srcptr n;
+  unsigned long b1, b2, sigma;
+  mpz_t *f;
+  int *found;
+};
+
+static void
+ecm_task (void *data, int i)
+{
+  struct ecm_batch *b = data;
+  b->found[i] = factor_using_ecm (b->f[i], b->n, b->b1, b->b2, b->sigma + i);
+}
+
+/* Run up to CURVES curves on N, a batch of one per thread at a time through
+   the parallel function.  Return 1 with a proper factor in F when one is
+   found, after finishing the batch.  */
+static int
+ecm_curves (mpz_ptr f, mpz_srcptr n, unsigned long b1, unsigned long curves,
+	    struct factors *factors, const struct factor_params *params)
+{
+  void (*run) (void (*) (void *, int), void *, int);
+  struct ecm_batch b;
+  unsigned long c;
+  int nthreads, i, found;
+
+  mp_get_parallel_function (&run, &nthreads);
+
+  b.n = n;
+  b.b1 = b1;
+  b.b2 = 100 * b1;
+  b.f = malloc (nthreads * sizeof (mpz_t));
+  b.found = malloc (nthreads * sizeof (int));
+  for (i = 0; i < nthreads; i++)
+    mpz_init (b.f[i]);
+
+  found = 0;
+  for (c = 0; c < curves && ! found; c += nthreads)
+    {
+      b.sigma = params->ecm_sigma + factors->curves;
+      (*run) (ecm_task, &b, nthreads);
+      factors->curves += nthreads;
+
+      for (i = 0; i < nthreads; i++)
+	if (b.found[i])
+	  {
+	    /* Prefer the smallest, most likely prime.  */
+	    if (! found || mpz_cmp (b.f[i], f) < 0)
+	      mpz_set (f, b.f[i]);
+	    found = 1;
+	  }
+    }
+  factors->ecm_b1 = b1;
+
+  for (i = 0; i < nthreads; i++)
+    mpz_clear (b.f[i]);
+  free (b.f);
+  free (b.found);
+  return found;
+}
+
+static int split (struct factors *, mpz_srcptr, enum factor_method,
+		  const struct factor_params *);
+
+/* Split T into F and T/F, and factor both.  */
+static int
+split_at (struct factors *factors, mpz_srcptr t, mpz_srcptr f,
+	  enum factor_method method, const struct factor_params *params)
+{
+  mpz_t q;
+  int res;
+
+  mpz_init (q);
+  mpz_divexact (q, t, f);
+  res = split (factors, f, method, params);
+  res &= split (factors, q, method, params);
+  mpz_clear (q);
+  return res;
+}
+
+/* Factor the odd T > 1, with no factors below FIRST_OMITTED_PRIME.  METHOD
+   is recorded for T if it turns out to be prime.  */
+static int
+split (struct factors *factors, mpz_srcptr t, enum factor_method method,
+       const struct factor_params *params)
+{
+  const struct factor_ecm_level *l;
+  mpz_t f;
+  unsigned long k, i;
+  int res;
+
+  if (mpz_cmp_ui (t, 1) == 0)
+    return 1;
+
+  if (params->verbose)
+    gmp_fprintf (stderr, "[is %Zd prime?]\n", t);
+  if (factor_prime_p (t, params->prove))
+    {
+      factor_insert (factors, t, method);
+      return 1;
+    }
+
+  mpz_init (f);
+
+  /* Perfect powers defeat p-1 and ECM, each factor then divides every
+     gcd.  A root which is itself a power is split again.  */
+  if (mpz_perfect_power_p (t))
+    for (k = 2; ; k++)
+      if (mpz_root (f, t, k))
+	{
+	  if (params->verbose)
+	    gmp_fprintf (stderr, "[perfect power %Zd^%lu]\n", f, k);
+	  res = 1;
+	  for (i = 0; i < k; i++)
+	    res &= split (factors, f, method, params);
+	  goto done;
+	}
+
+  if (params->rho_iters != 0)
+    {
+      if (params->verbose)
+	fprintf (stderr, "[pollard-rho, %lu iterations]\n", params->rho_iters);
+      if (factor_using_pollard_rho (f, t, 1, params->rho_iters))
+	{
+	  res = split_at (factors, t, f, FACTOR_METHOD_RHO, params);
+	  goto done;
+	}
+    }
+
+  if (params->pm1_b1 != 0)
+    {
+      if (params->verbose)
+	fprintf (stderr, "[pollard p-1, B1=%lu B2=%lu]\n",
+		 params->pm1_b1, params->pm1_b2);
+      if (factor_using_pm1 (f, t, params->pm1_b1, params->pm1_b2))
+	{
+	  res = split_at (factors, t, f, FACTOR_METHOD_PM1, params);
+	  goto done;
+	}
+    }
+
+  for (l = factor_ecm_levels;
+       l->digits != 0 && l->b1 <= params->ecm_max_b1; l++)
+    {
+      if (params->verbose)
+	fprintf (stderr, "[ecm, %d digits, B1=%lu, %lu curves]\n",
+		 l->digits, l->b1, l->curves);
+      if (ecm_curves (f, t, l->b1, l->curves, factors, params))
+	{
+	  res = split_at (factors, t, f, FACTOR_METHOD_ECM, params);
+	  goto done;
+	}
+    }
+
+  if (params->verbose)
+    gmp_fprintf (stderr, "[giving up on %Zd]\n", t);
+  factor_insert (factors, t, FACTOR_METHOD_NONE);
+  res = 0;
+
+ done:
+  mpz_clear (f);
+  return res;
+}
+
+int
+factor (struct factors *factors, mpz_srcptr n, const struct factor_params *params)
+{
+  mpz_t t;
+  int res;
+
+  res = 1;
+  mpz_init (t);
+  mpz_abs (t, n);
+
+  if (mpz_sgn (t) != 0)
+    {
+      if (params->verbose)
+	fprintf (stderr, "[trial division]\n");
+      factor_using_division (t, factors);
+      res = split (factors, t, FACTOR_METHOD_PRIME, params);
+    }
+
+  mpz_clear (t);
+  return res;
+}
+
+void
+factor_report (FILE *stream, mpz_srcptr n, const struct factors *factors,
+	       int complete, double seconds)
+{
+  long i;
+
+  gmp_fprintf (stream, "{\"n\":\"%Zd\",\"factors\":[", n);
+  for (i = 0; i < factors->nfactors; i++)
+    gmp_fprintf (stream, "%s{\"p\":\"%Zd\",\"e\":%lu,\"method\":\"%s\"}",
+		 i == 0 ? "" : ",", factors->p[i], factors->e[i],
+		 method_names[factors->method[i]]);
+  fprintf (stream, "],\"complete\":%s,\"curves\":%lu",
+	   complete ? "true" : "false", factors->curves);
+  if (factors->curves != 0)
+    fprintf (stream, ",\"ecm_b1\":%lu", factors->ecm_b1);
+  if (seconds >= 0)
+    fprintf (stream, ",\"seconds\":%.3f", seconds);
+  fprintf (stream, "}\n");
+}
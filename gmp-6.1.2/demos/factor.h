@@ -0,0 +1,105 @@
+/* Header for the factoring engine of factorize.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program.  If not, see https://www.gnu.org/licenses/.  */
+
+
+#ifndef __FACTOR_H__
+#define __FACTOR_H__
+
+#include <stdio.h>
+#include "gmp.h"
+
+/* How a factor was found.  FACTOR_METHOD_NONE is a composite given up on,
+   when the work limits in the parameters were reached.  */
+enum factor_method
+{
+  FACTOR_METHOD_NONE,
+  FACTOR_METHOD_DIVISION,
+  FACTOR_METHOD_RHO,
+  FACTOR_METHOD_PM1,
+  FACTOR_METHOD_ECM,
+  FACTOR_METHOD_PRIME		/* a cofactor left over and found prime */
+};
+
+/* Work limits and options.  factor_params_init sets defaults suitable for
+   factors up to about 40 digits.  */
+struct factor_params
+{
+  int verbose;			/* progress to stderr */
+  int prove;			/* prove primality, rather than BPSW */
+  unsigned long rho_iters;	/* Pollard rho iterations, per composite */
+  unsigned long pm1_b1;		/* Pollard p-1 stage 1 bound, or 0 */
+  unsigned long pm1_b2;		/* and stage 2 bound */
+  unsigned long ecm_max_b1;	/* ECM goes up to this B1, or 0 for none */
+  unsigned long ecm_sigma;	/* first Suyama parameter */
+};
+
+struct factors
+{
+  mpz_t         *p;
+  unsigned long *e;
+  enum factor_method *method;
+  long nfactors;
+
+  /* Statistics.  */
+  unsigned long curves;		/* ECM curves run */
+  unsigned long ecm_b1;		/* last B1 used */
+};
+
+void factor_params_init (struct factor_params *);
+
+void factor_init (struct factors *);
+void factor_clear (struct factors *);
+void factor_insert (struct factors *, mpz_srcptr, enum factor_method);
+void factor_insert_ui (struct factors *, unsigned long, enum factor_method);
+
+/* Factor N into FACTORS, which must have been initialized.  Return 1 if the
+   factorization is complete, or 0 if a composite was left.  */
+int factor (struct factors *, mpz_srcptr, const struct factor_params *);
+
+/* Set T to T with its factors below FIRST_OMITTED_PRIME removed, and
+   insert them in FACTORS.  */
+void factor_using_division (mpz_ptr, struct factors *);
+
+/* Each of these looks for a factor of the odd composite N, and on success
+   sets F to a factor 1 < F < N and returns 1.  */
+int factor_using_pollard_rho (mpz_ptr, mpz_srcptr, unsigned long, unsigned long);
+int factor_using_pm1 (mpz_ptr, mpz_srcptr, unsigned long, unsigned long);
+int factor_using_ecm (mpz_ptr, mpz_srcptr, unsigned long, unsigned long,
+		      unsigned long);
+
+/* Set E to the product of the largest powers <= B1 of the primes <= B1,
+   the stage 1 exponent of p-1 and ECM.  */
+void factor_stage1_exponent (mpz_ptr, unsigned long);
+
+/* Return non-zero if N is prime.  With PROVE the answer is certain, by a
+   Lucas n-1 test, otherwise N is a BPSW probable prime.  */
+int factor_prime_p (mpz_srcptr, int);
+
+/* Print FACTORS of N to STREAM as a one line JSON object.  SECONDS is
+   included if it's not negative.  */
+void factor_report (FILE *, mpz_srcptr, const struct factors *, int, double);
+
+/* The usual bound pairs for ECM, to find factors of about DIGITS digits,
+   and how many curves that takes.  */
+struct factor_ecm_level
+{
+  int digits;
+  unsigned long b1;
+  unsigned long curves;
+};
+extern const struct factor_ecm_level factor_ecm_levels[];
+
+#endif
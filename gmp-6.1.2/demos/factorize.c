@@ -1,6 +1,6 @@
-/* Factoring with Pollard's rho method.
+/* Factoring with trial division, Pollard's rho and p-1, and ECM.
 
-Copyright 1995, 1997-2003, 2005, 2009, 2012, 2015 Free Software
+Copyright 1995, 1997-2003, 2005, 2009, 2012, 2015, 2026 Free Software
 Foundation, Inc.
 
 This program is free software; you can redistribute it and/or modify it under
@@ -16,388 +16,191 @@ You should have received a copy of the GNU General Public License along with
 this program.  If not, see https://www.gnu.org/licenses/.  */
 
 
+/* Usage: factorize [-v] [-w] [-j] [-s] [-t threads] [-B1 bound] [number...]
+
+   Numbers are read from stdin when none are given.  Options are
+
+     -v        progress reports on stderr
+     -w        BPSW probable primes, without proving primality
+     -j        a JSON line per number, see factor_report
+     -s        time taken and ECM curves run, on stderr
+     -t N      run ECM curves on N threads, when built with POSIX threads;
+               link with -lpthread if the system needs it
+     -B1 n     the largest ECM B1, default 3000000
+
+   The factoring itself is in factor.c, pm1.c and ecm.c, with the interface
+   in factor.h.  */
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <inttypes.h>
+#include <time.h>
+
+#if defined (__unix__) || defined (__APPLE__)
+#include <unistd.h>
+#include <sys/time.h>
+#define HAVE_GETTIMEOFDAY 1
+#endif
+#if defined (_POSIX_THREADS) && _POSIX_THREADS > 0
+#include <pthread.h>
+#define USE_PTHREADS 1
+#endif
 
 #include "gmp.h"
+#include "factor.h"
 
-static unsigned char primes_diff[] = {
-#define P(a,b,c) a,
-#include "primes.h"
-#undef P
-};
-#define PRIMES_PTAB_ENTRIES (sizeof(primes_diff) / sizeof(primes_diff[0]))
+int flag_json = 0;
+int flag_stats = 0;
 
-int flag_verbose = 0;
+#if USE_PTHREADS
+/* A parallel function for mp_set_parallel_function.  Each call starts
+   threads which share out the N tasks between themselves and the caller.
+   Calls from within tasks simply start more threads.  */
 
-/* Prove primality or run probabilistic tests.  */
-int flag_prove_primality = 1;
+int num_threads = 1;
 
-/* Number of Miller-Rabin tests to run when not proving primality. */
-#define MR_REPS 25
-
-struct factors
+struct run
 {
-  mpz_t         *p;
-  unsigned long *e;
-  long nfactors;
+  void (*task) (void *, int);
+  void *data;
+  int n, next;
+  pthread_mutex_t lock;
 };
 
-void factor (mpz_t, struct factors *);
-
-void
-factor_init (struct factors *factors)
-{
-  factors->p = malloc (1);
-  factors->e = malloc (1);
-  factors->nfactors = 0;
-}
-
-void
-factor_clear (struct factors *factors)
+static void *
+run_worker (void *arg)
 {
+  struct run *r = arg;
   int i;
 
-  for (i = 0; i < factors->nfactors; i++)
-    mpz_clear (factors->p[i]);
-
-  free (factors->p);
-  free (factors->e);
-}
-
-void
-factor_insert (struct factors *factors, mpz_t prime)
-{
-  long    nfactors  = factors->nfactors;
-  mpz_t         *p  = factors->p;
-  unsigned long *e  = factors->e;
-  long i, j;
-
-  /* Locate position for insert new or increment e.  */
-  for (i = nfactors - 1; i >= 0; i--)
+  for (;;)
     {
-      if (mpz_cmp (p[i], prime) <= 0)
+      pthread_mutex_lock (&r->lock);
+      i = r->next++;
+      pthread_mutex_unlock (&r->lock);
+      if (i >= r->n)
 	break;
+      (*r->task) (r->data, i);
     }
-
-  if (i < 0 || mpz_cmp (p[i], prime) != 0)
-    {
-      p = realloc (p, (nfactors + 1) * sizeof p[0]);
-      e = realloc (e, (nfactors + 1) * sizeof e[0]);
-
-      mpz_init (p[nfactors]);
-      for (j = nfactors - 1; j > i; j--)
-	{
-	  mpz_set (p[j + 1], p[j]);
-	  e[j + 1] = e[j];
-	}
-      mpz_set (p[i + 1], prime);
-      e[i + 1] = 1;
-
-      factors->p = p;
-      factors->e = e;
-      factors->nfactors = nfactors + 1;
-    }
-  else
-    {
-      e[i] += 1;
-    }
-}
-
-void
-factor_insert_ui (struct factors *factors, unsigned long prime)
-{
-  mpz_t pz;
-
-  mpz_init_set_ui (pz, prime);
-  factor_insert (factors, pz);
-  mpz_clear (pz);
+  return NULL;
 }
 
-
-void
-factor_using_division (mpz_t t, struct factors *factors)
+static void
+run_parallel (void (*task) (void *, int), void *data, int n)
 {
-  mpz_t q;
-  unsigned long int p;
-  int i;
-
-  if (flag_verbose > 0)
-    {
-      printf ("[trial division] ");
-    }
-
-  mpz_init (q);
-
-  p = mpz_scan1 (t, 0);
-  mpz_fdiv_q_2exp (t, t, p);
-  while (p)
-    {
-      factor_insert_ui (factors, 2);
-      --p;
-    }
-
-  p = 3;
-  for (i = 1; i <= PRIMES_PTAB_ENTRIES;)
-    {
-      if (! mpz_divisible_ui_p (t, p))
-	{
-	  p += primes_diff[i++];
-	  if (mpz_cmp_ui (t, p * p) < 0)
-	    break;
-	}
-      else
-	{
-	  mpz_tdiv_q_ui (t, t, p);
-	  factor_insert_ui (factors, p);
-	}
-    }
-
-  mpz_clear (q);
+  struct run r;
+  pthread_t *tid;
+  int i, nt;
+
+  if (n == 1)
+    {
+      (*task) (data, 0);
+      return;
+    }
+
+  r.task = task;
+  r.data = data;
+  r.n = n;
+  r.next = 0;
+  pthread_mutex_init (&r.lock, NULL);
+
+  nt = (n < num_threads ? n : num_threads) - 1;
+  tid = malloc (nt * sizeof (pthread_t) + 1);
+  for (i = 0; i < nt; i++)
+    if (pthread_create (&tid[i], NULL, run_worker, &r) != 0)
+      break;
+  nt = i;
+  run_worker (&r);
+  for (i = 0; i < nt; i++)
+    pthread_join (tid[i], NULL);
+
+  free (tid);
+  pthread_mutex_destroy (&r.lock);
 }
+#endif
 
-static int
-mp_millerrabin (mpz_srcptr n, mpz_srcptr nm1, mpz_ptr x, mpz_ptr y,
-		mpz_srcptr q, unsigned long int k)
+/* Elapsed time, rather than CPU time which would add up the threads.  */
+double
+wall_seconds (void)
 {
-  unsigned long int i;
-
-  mpz_powm (y, x, q, n);
-
-  if (mpz_cmp_ui (y, 1) == 0 || mpz_cmp (y, nm1) == 0)
-    return 1;
-
-  for (i = 1; i < k; i++)
-    {
-      mpz_powm_ui (y, y, 2, n);
-      if (mpz_cmp (y, nm1) == 0)
-	return 1;
-      if (mpz_cmp_ui (y, 1) == 0)
-	return 0;
-    }
-  return 0;
-}
-
-int
-mp_prime_p (mpz_t n)
-{
-  int k, r, is_prime;
-  mpz_t q, a, nm1, tmp;
-  struct factors factors;
-
-  if (mpz_cmp_ui (n, 1) <= 0)
-    return 0;
-
-  /* We have already casted out small primes. */
-  if (mpz_cmp_ui (n, (long) FIRST_OMITTED_PRIME * FIRST_OMITTED_PRIME) < 0)
-    return 1;
-
-  mpz_inits (q, a, nm1, tmp, NULL);
-
-  /* Precomputation for Miller-Rabin.  */
-  mpz_sub_ui (nm1, n, 1);
-
-  /* Find q and k, where q is odd and n = 1 + 2**k * q.  */
-  k = mpz_scan1 (nm1, 0);
-  mpz_tdiv_q_2exp (q, nm1, k);
-
-  mpz_set_ui (a, 2);
-
-  /* Perform a Miller-Rabin test, finds most composites quickly.  */
-  if (!mp_millerrabin (n, nm1, a, tmp, q, k))
-    {
-      is_prime = 0;
-      goto ret2;
-    }
-
-  if (flag_prove_primality)
-    {
-      /* Factor n-1 for Lucas.  */
-      mpz_set (tmp, nm1);
-      factor (tmp, &factors);
-    }
-
-  /* Loop until Lucas proves our number prime, or Miller-Rabin proves our
-     number composite.  */
-  for (r = 0; r < PRIMES_PTAB_ENTRIES; r++)
-    {
-      int i;
-
-      if (flag_prove_primality)
-	{
-	  is_prime = 1;
-	  for (i = 0; i < factors.nfactors && is_prime; i++)
-	    {
-	      mpz_divexact (tmp, nm1, factors.p[i]);
-	      mpz_powm (tmp, a, tmp, n);
-	      is_prime = mpz_cmp_ui (tmp, 1) != 0;
-	    }
-	}
-      else
-	{
-	  /* After enough Miller-Rabin runs, be content. */
-	  is_prime = (r == MR_REPS - 1);
-	}
-
-      if (is_prime)
-	goto ret1;
-
-      mpz_add_ui (a, a, primes_diff[r]);	/* Establish new base.  */
-
-      if (!mp_millerrabin (n, nm1, a, tmp, q, k))
-	{
-	  is_prime = 0;
-	  goto ret1;
-	}
-    }
-
-  fprintf (stderr, "Lucas prime test failure.  This should not happen\n");
-  abort ();
-
- ret1:
-  if (flag_prove_primality)
-    factor_clear (&factors);
- ret2:
-  mpz_clears (q, a, nm1, tmp, NULL);
-
-  return is_prime;
+#if HAVE_GETTIMEOFDAY
+  struct timeval tv;
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+#else
+  return (double) clock () / CLOCKS_PER_SEC;
+#endif
 }
 
 void
-factor_using_pollard_rho (mpz_t n, unsigned long a, struct factors *factors)
+factor_and_print (mpz_t t, const struct factor_params *params)
 {
-  mpz_t x, z, y, P;
-  mpz_t t, t2;
-  unsigned long long k, l, i;
-
-  if (flag_verbose > 0)
+  struct factors factors;
+  double start, seconds;
+  int complete;
+  long j;
+  unsigned long k;
+
+  start = wall_seconds ();
+  factor_init (&factors);
+  complete = factor (&factors, t, params);
+  seconds = wall_seconds () - start;
+
+  if (flag_json)
+    factor_report (stdout, t, &factors, complete, flag_stats ? seconds : -1.0);
+  else
     {
-      printf ("[pollard-rho (%lu)] ", a);
+      gmp_printf ("%Zd:", t);
+      for (j = 0; j < factors.nfactors; j++)
+	for (k = 0; k < factors.e[j]; k++)
+	  gmp_printf (" %Zd", factors.p[j]);
+      puts (complete ? "" : " (incomplete)");
     }
 
-  mpz_inits (t, t2, NULL);
-  mpz_init_set_si (y, 2);
-  mpz_init_set_si (x, 2);
-  mpz_init_set_si (z, 2);
-  mpz_init_set_ui (P, 1);
-  k = 1;
-  l = 1;
-
-  while (mpz_cmp_ui (n, 1) != 0)
-    {
-      for (;;)
-	{
-	  do
-	    {
-	      mpz_mul (t, x, x);
-	      mpz_mod (x, t, n);
-	      mpz_add_ui (x, x, a);
-
-	      mpz_sub (t, z, x);
-	      mpz_mul (t2, P, t);
-	      mpz_mod (P, t2, n);
-
-	      if (k % 32 == 1)
-		{
-		  mpz_gcd (t, P, n);
-		  if (mpz_cmp_ui (t, 1) != 0)
-		    goto factor_found;
-		  mpz_set (y, x);
-		}
-	    }
-	  while (--k != 0);
-
-	  mpz_set (z, x);
-	  k = l;
-	  l = 2 * l;
-	  for (i = 0; i < k; i++)
-	    {
-	      mpz_mul (t, x, x);
-	      mpz_mod (x, t, n);
-	      mpz_add_ui (x, x, a);
-	    }
-	  mpz_set (y, x);
-	}
-
-    factor_found:
-      do
-	{
-	  mpz_mul (t, y, y);
-	  mpz_mod (y, t, n);
-	  mpz_add_ui (y, y, a);
-
-	  mpz_sub (t, z, y);
-	  mpz_gcd (t, t, n);
-	}
-      while (mpz_cmp_ui (t, 1) == 0);
-
-      mpz_divexact (n, n, t);	/* divide by t, before t is overwritten */
+  if (flag_stats)
+    fprintf (stderr, "%.3f seconds, %lu ECM curves\n",
+	     seconds, factors.curves);
 
-      if (!mp_prime_p (t))
-	{
-	  if (flag_verbose > 0)
-	    {
-	      printf ("[composite factor--restarting pollard-rho] ");
-	    }
-	  factor_using_pollard_rho (t, a + 1, factors);
-	}
-      else
-	{
-	  factor_insert (factors, t);
-	}
-
-      if (mp_prime_p (n))
-	{
-	  factor_insert (factors, n);
-	  break;
-	}
-
-      mpz_mod (x, x, n);
-      mpz_mod (z, z, n);
-      mpz_mod (y, y, n);
-    }
-
-  mpz_clears (P, t2, t, z, x, y, NULL);
-}
-
-void
-factor (mpz_t t, struct factors *factors)
-{
-  factor_init (factors);
-
-  if (mpz_sgn (t) != 0)
-    {
-      factor_using_division (t, factors);
-
-      if (mpz_cmp_ui (t, 1) != 0)
-	{
-	  if (flag_verbose > 0)
-	    {
-	      printf ("[is number prime?] ");
-	    }
-	  if (mp_prime_p (t))
-	    factor_insert (factors, t);
-	  else
-	    factor_using_pollard_rho (t, 1, factors);
-	}
-    }
+  factor_clear (&factors);
 }
 
 int
 main (int argc, char *argv[])
 {
+  struct factor_params params;
   mpz_t t;
-  int i, j, k;
-  struct factors factors;
+  int i;
+
+  factor_params_init (&params);
 
   while (argc > 1)
     {
       if (!strcmp (argv[1], "-v"))
-	flag_verbose = 1;
+	params.verbose = 1;
       else if (!strcmp (argv[1], "-w"))
-	flag_prove_primality = 0;
+	params.prove = 0;
+      else if (!strcmp (argv[1], "-j"))
+	flag_json = 1;
+      else if (!strcmp (argv[1], "-s"))
+	flag_stats = 1;
+      else if (!strcmp (argv[1], "-t") && argc > 2)
+	{
+#if USE_PTHREADS
+	  num_threads = atoi (argv[2]);
+	  if (num_threads > 1)
+	    mp_set_parallel_function (run_parallel, num_threads);
+#else
+	  fprintf (stderr, "factorize: no thread support, -t ignored\n");
+#endif
+	  argv++;
+	  argc--;
+	}
+      else if (!strcmp (argv[1], "-B1") && argc > 2)
+	{
+	  params.ecm_max_b1 = strtoul (argv[2], NULL, 0);
+	  argv++;
+	  argc--;
+	}
       else
 	break;
 
@@ -411,16 +214,7 @@ main (int argc, char *argv[])
       for (i = 1; i < argc; i++)
 	{
 	  mpz_set_str (t, argv[i], 0);
-
-	  gmp_printf ("%Zd:", t);
-	  factor (t, &factors);
-
-	  for (j = 0; j < factors.nfactors; j++)
-	    for (k = 0; k < factors.e[j]; k++)
-	      gmp_printf (" %Zd", factors.p[j]);
-
-	  puts ("");
-	  factor_clear (&factors);
+	  factor_and_print (t, &params);
 	}
     }
   else
@@ -430,16 +224,7 @@ main (int argc, char *argv[])
 	  mpz_inp_str (t, stdin, 0);
 	  if (feof (stdin))
 	    break;
-
-	  gmp_printf ("%Zd:", t);
-	  factor (t, &factors);
-
-	  for (j = 0; j < factors.nfactors; j++)
-	    for (k = 0; k < factors.e[j]; k++)
-	      gmp_printf (" %Zd", factors.p[j]);
-
-	  puts ("");
-	  factor_clear (&factors);
+	  factor_and_print (t, &params);
 	}
     }
 
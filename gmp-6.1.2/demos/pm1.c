@@ -0,0 +1,101 @@
+/* Factoring with Pollard's p-1 method.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program.  If not, see https://www.gnu.org/licenses/.  */
+
+
+
+/* Stage 1 raises a = 3 to the product E of the prime powers up to B1, so a
+   prime p with p-1 dividing E shows up in gcd(a-1, N).  Stage 2 allows one
+   more prime q up to B2, accumulating (a^q - 1) for each q, with a^q
+   stepped from the previous prime's by the gap between them, from a table
+   of a^d for the small even d.  */
+
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "factor.h"
+
+#define PM1_GAPS  256		/* a^d table for even d up to this */
+
+int
+factor_using_pm1 (mpz_ptr f, mpz_srcptr n, unsigned long b1, unsigned long b2)
+{
+  mpz_modctx_t ctx;
+  mpz_t a, x, g, t, *tab;
+  gmp_primeiter_t it;
+  mp_limb_t p, prev;
+  int i, found;
+
+  mpz_modctx_init (ctx, n);
+  mpz_inits (a, x, g, t, NULL);
+
+  /* Stage 1.  */
+  factor_stage1_exponent (t, b1);
+  mpz_set_ui (a, 3);
+  mpz_powm_ctx (a, a, t, ctx);
+  mpz_sub_ui (t, a, 1);
+  mpz_gcd (f, t, n);
+  found = mpz_cmp_ui (f, 1) > 0 && mpz_cmp (f, n) < 0;
+  if (found || mpz_cmp (f, n) == 0 || b2 <= b1)
+    goto done;
+
+  /* Stage 2.  */
+  tab = malloc ((PM1_GAPS / 2 + 1) * sizeof (mpz_t));
+  mpz_init_set_ui (tab[0], 1);
+  mpz_init (tab[1]);
+  mpz_sqrmod_ctx (tab[1], a, ctx);
+  for (i = 2; i <= PM1_GAPS / 2; i++)
+    {
+      mpz_init (tab[i]);
+      mpz_mulmod_ctx (tab[i], tab[i - 1], tab[1], ctx);
+    }
+
+  mpz_set_ui (g, 1);
+  prev = 0;
+  gmp_primeiter_init (it, (mp_limb_t) b1 + 1, (mp_limb_t) b2 + 1);
+  while ((p = gmp_primeiter_next (it)) != 0)
+    {
+      if (prev == 0)
+	{
+	  mpz_set_ui (t, (unsigned long) p);
+	  mpz_powm_ctx (x, a, t, ctx);
+	}
+      else if (p - prev <= PM1_GAPS)
+	mpz_mulmod_ctx (x, x, tab[(p - prev) / 2], ctx);
+      else
+	{
+	  mpz_set_ui (t, (unsigned long) (p - prev));
+	  mpz_powm_ctx (t, a, t, ctx);
+	  mpz_mulmod_ctx (x, x, t, ctx);
+	}
+      prev = p;
+
+      mpz_sub_ui (t, x, 1);
+      mpz_mulmod_ctx (g, g, t, ctx);
+    }
+  gmp_primeiter_clear (it);
+
+  for (i = 0; i <= PM1_GAPS / 2; i++)
+    mpz_clear (tab[i]);
+  free (tab);
+
+  mpz_gcd (f, g, n);
+  found = mpz_cmp_ui (f, 1) > 0 && mpz_cmp (f, n) < 0;
+
+ done:
+  mpz_clears (a, x, g, t, NULL);
+  mpz_modctx_clear (ctx);
+  return found;
+}
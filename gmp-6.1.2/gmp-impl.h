@@ -131,6 +131,8 @@ see https://www.gnu.org/licenses/.  */
   __GMP_DECLSPEC mp_limb_t name (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_srcptr)
 #define DECL_rshift(name) \
   DECL_lshift (name)
+#define DECL_sec_powm_lanes(name) \
+  __GMP_DECLSPEC void name (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_bitcnt_t, mp_srcptr, mp_size_t, int, mp_ptr)
 #define DECL_sqr_basecase(name) \
   __GMP_DECLSPEC void name (mp_ptr, mp_srcptr, mp_size_t)
 #define DECL_sub_n(name) \
@@ -146,7 +148,7 @@ see https://www.gnu.org/licenses/.  */
 #include "fib_table.h"
 #include "fac_table.h"
 #include "mp_bases.h"
-#if WANT_FAT_BINARY
+#if WANT_FAT_BINARY && ! TUNING_DEFAULTS_BUILD
 #include "fat.h"
 #endif
 #endif
@@ -701,6 +703,91 @@ __GMP_DECLSPEC void *__gmp_default_allocate (size_t);
 __GMP_DECLSPEC void *__gmp_default_reallocate (void *, size_t, size_t);
 __GMP_DECLSPEC void __gmp_default_free (void *, size_t);
 
+__GMP_DECLSPEC void *__gmp_arena_allocate (size_t);
+__GMP_DECLSPEC void *__gmp_arena_reallocate (void *, size_t, size_t);
+__GMP_DECLSPEC void __gmp_arena_free (void *, size_t);
+__GMP_DECLSPEC extern size_t __gmp_arena_limit;
+
+__GMP_DECLSPEC extern void (*__gmp_parallel_func) (void (*) (void *, int), void *, int);
+__GMP_DECLSPEC extern int  __gmp_parallel_threads;
+
+__GMP_DECLSPEC void __gmp_default_parallel (void (*) (void *, int), void *, int);
+
+/* Run TASK (DATA, i) for 0 <= i < N through the application's parallel
+   function.  Callers test MPN_PARALLEL_P first, the split into tasks usually
+   costs scratch space which is pointless when everything runs serially.  */
+#define MPN_PARALLEL_P(n, thresh)					\
+  (__GMP_UNLIKELY (__gmp_parallel_threads > 1) && (n) >= (thresh))
+#define MPN_PARALLEL_RUN(task, data, n)					\
+  ((*__gmp_parallel_func) (task, data, n))
+
+/* Array files, as written by mpz_out_array, mpq_out_array and mpf_out_array
+   and read by gmp_array_map.  The header is GMP_ARRAY_HEADER_BYTES, then
+   the index has GMP_ARRAY_ENTRY_BYTES per mpz or mpf and twice that per mpq,
+   then at a 64 byte boundary come the limbs.  See array_out.c.  */
+#define GMP_ARRAY_MAGIC         "GMPARRAY"
+#define GMP_ARRAY_VERSION       1
+#define GMP_ARRAY_HEADER_BYTES  64
+#define GMP_ARRAY_ENTRY_BYTES   32
+#define GMP_ARRAY_ALIGN         64
+
+/* The header's limb byte order word, 1 if the most significant byte of a
+   limb comes first in memory, 0 if the least significant does.  */
+static inline int
+gmp_array_limb_order (void)
+{
+  mp_limb_t  one = 1;
+  return *(unsigned char *) &one == 0;
+}
+
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t __gmp_array_out (FILE *, int, const void *, size_t);
+#endif
+__GMP_DECLSPEC mp_ptr __gmp_array_entry (gmp_array_srcptr, size_t, mp_size_t *, mp_exp_t *, mp_size_t *);
+
+/* Dispatch statistics, per --enable-stats.  Each GMP_STATS_ value is one
+   algorithm choice in an mpn dispatch function, GMP_STATS_COUNT records a
+   call taking it along with the operand size the choice was made on.  The
+   names printed by gmp_stats_dump are in stats.c, in the same order.
+   Nothing is counted until gmp_stats_enable, before that the cost is a test
+   of __gmp_stats_enabled.  */
+enum {
+  GMP_STATS_MUL_BASECASE, GMP_STATS_MUL_TOOMX2, GMP_STATS_MUL_TOOMX3,
+  GMP_STATS_MUL_TOOM44, GMP_STATS_MUL_TOOM6H, GMP_STATS_MUL_TOOM8H,
+  GMP_STATS_MUL_FFT,
+  GMP_STATS_MUL_N_BASECASE, GMP_STATS_MUL_N_TOOM22, GMP_STATS_MUL_N_TOOM33,
+  GMP_STATS_MUL_N_TOOM44, GMP_STATS_MUL_N_TOOM6H, GMP_STATS_MUL_N_TOOM8H,
+  GMP_STATS_MUL_N_FFT,
+  GMP_STATS_SQR_MUL_BASECASE, GMP_STATS_SQR_BASECASE, GMP_STATS_SQR_TOOM2,
+  GMP_STATS_SQR_TOOM3, GMP_STATS_SQR_TOOM4, GMP_STATS_SQR_TOOM6,
+  GMP_STATS_SQR_TOOM8, GMP_STATS_SQR_FFT,
+  GMP_STATS_TDIV_QR_1, GMP_STATS_TDIV_QR_2, GMP_STATS_TDIV_QR_SBPI1,
+  GMP_STATS_TDIV_QR_DCPI1, GMP_STATS_TDIV_QR_MU,
+  GMP_STATS_DIV_Q_1, GMP_STATS_DIV_Q_2, GMP_STATS_DIV_Q_SBPI1,
+  GMP_STATS_DIV_Q_DCPI1, GMP_STATS_DIV_Q_MU, GMP_STATS_DIV_Q_SBPI1_APPR,
+  GMP_STATS_DIV_Q_DCPI1_APPR, GMP_STATS_DIV_Q_MU_APPR,
+  GMP_STATS_GCD_LEHMER, GMP_STATS_GCD_DC,
+  GMP_STATS_POWM_REDC_1, GMP_STATS_POWM_REDC_2, GMP_STATS_POWM_REDC_N,
+  GMP_STATS_N
+};
+
+/* Operand sizes are counted by bit length, 1 limb in bucket 1, 2 or 3 limbs
+   in bucket 2, and so on.  */
+#define GMP_STATS_BUCKETS  GMP_LIMB_BITS
+
+#if WANT_STATS
+__GMP_DECLSPEC extern int __gmp_stats_enabled;
+__GMP_DECLSPEC extern unsigned long __gmp_stats_table[GMP_STATS_N][GMP_STATS_BUCKETS];
+__GMP_DECLSPEC void __gmp_stats_count (int, mp_size_t);
+#define GMP_STATS_COUNT(what, n)					\
+  do {									\
+    if (UNLIKELY (__gmp_stats_enabled))					\
+      __gmp_stats_count (what, n);					\
+  } while (0)
+#else
+#define GMP_STATS_COUNT(what, n)  do {} while (0)
+#endif
+
 #define __GMP_ALLOCATE_FUNC_TYPE(n,type) \
   ((type *) (*__gmp_allocate_func) ((n) * sizeof (type)))
 #define __GMP_ALLOCATE_FUNC_LIMBS(n)   __GMP_ALLOCATE_FUNC_TYPE (n, mp_limb_t)
@@ -1556,6 +1643,19 @@ __GMP_DECLSPEC mp_limb_t mpn_bdiv_dbm1c (mp_ptr, mp_srcptr, mp_size_t, mp_limb_t
 
 #define   mpn_powm __MPN(powm)
 __GMP_DECLSPEC void      mpn_powm (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, mp_size_t, mp_ptr);
+#define   mpn_powm_batch __MPN(powm_batch)
+__GMP_DECLSPEC void      mpn_powm_batch (mp_ptr, mp_srcptr, mp_srcptr *, const mp_size_t *, mp_size_t, mp_srcptr, mp_size_t, mp_ptr);
+#define   mpn_powm_batch_init __MPN(powm_batch_init)
+__GMP_DECLSPEC int       mpn_powm_batch_init (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_ptr);
+#define   mpn_powm_batch_pre __MPN(powm_batch_pre)
+__GMP_DECLSPEC void      mpn_powm_batch_pre (mp_ptr, mp_srcptr, mp_srcptr *, const mp_size_t *, mp_size_t, mp_srcptr, mp_size_t, mp_srcptr, int, mp_srcptr, mp_ptr);
+#define   mpn_powm_batch_redc __MPN(powm_batch_redc)
+__GMP_DECLSPEC void      mpn_powm_batch_redc (mp_ptr, mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, int);
+
+/* The form of REDC inverse from mpn_powm_batch_init.  */
+#define POWM_BATCH_REDC_1  1
+#define POWM_BATCH_REDC_2  2
+#define POWM_BATCH_REDC_N  3
 #define   mpn_powlo __MPN(powlo)
 __GMP_DECLSPEC void      mpn_powlo (mp_ptr, mp_srcptr, mp_srcptr, mp_size_t, mp_size_t, mp_ptr);
 
@@ -1564,6 +1664,42 @@ __GMP_DECLSPEC mp_limb_t mpn_sec_pi1_div_qr (mp_ptr, mp_ptr, mp_size_t, mp_srcpt
 #define mpn_sec_pi1_div_r __MPN(sec_pi1_div_r)
 __GMP_DECLSPEC void mpn_sec_pi1_div_r (mp_ptr, mp_size_t, mp_srcptr, mp_size_t, mp_limb_t, mp_ptr);
 
+/* mpn_sec_powm_multi goes to mpn_sec_powm_lanes with up to SEC_POWM_LANES
+   tuples at a time.  Native code may hold the numbers of each tuple in up to
+   SEC_POWM_LANES_LIMBS(n) limbs, with a table of 2^sec_powm_lanes_win(enb)
+   powers, and mpn_sec_powm_lanes_itch allows for that.  */
+#define SEC_POWM_LANES  8
+#define SEC_POWM_LANES_LIMBS(n)  ((n) + (n) / 4 + 2)
+
+#ifndef mpn_sec_powm_lanes  /* if not done with cpuvec in a fat binary */
+#define mpn_sec_powm_lanes __MPN(sec_powm_lanes)
+__GMP_DECLSPEC void mpn_sec_powm_lanes (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_bitcnt_t, mp_srcptr, mp_size_t, int, mp_ptr);
+#endif
+
+/* Window size minimizing enb/w + 2^w, the multiplies in the exponentiation
+   and in building the table.  It's at most enb.  */
+static inline int
+sec_powm_lanes_win (mp_bitcnt_t enb)
+{
+  return enb <= 4 ? 1 : enb <= 24 ? 2 : enb <= 96 ? 3
+    : enb <= 320 ? 4 : enb <= 960 ? 5 : 6;
+}
+
+static inline mp_size_t
+mpn_sec_powm_lanes_itch (mp_size_t bn, mp_bitcnt_t enb, mp_size_t n)
+{
+  mp_size_t s, tn, itch;
+
+  /* Per lane, the modulus, the table, two operands and a double length
+     product, then space to convert the base.  */
+  s = SEC_POWM_LANES_LIMBS (n);
+  tn = s + bn + 1;
+  itch = SEC_POWM_LANES * ((((mp_size_t) 1 << sec_powm_lanes_win (enb)) + 5)
+			   * s + 1)
+    + tn + mpn_sec_div_r_itch (tn, n);
+  return MAX (itch, mpn_sec_powm_itch (bn, enb, n));
+}
+
 
 /* Override mpn_addlsh1_n, mpn_addlsh2_n, mpn_sublsh1_n, etc with mpn_addlsh_n,
    etc when !HAVE_NATIVE the former but HAVE_NATIVE_ the latter.  We then lie
@@ -1666,6 +1802,99 @@ __GMP_DECLSPEC mp_size_t mpz_prodlimbs (mpz_ptr, mp_ptr, mp_size_t);
 #define mpz_oddfac_1  __gmpz_oddfac_1
 __GMP_DECLSPEC void mpz_oddfac_1 (mpz_ptr, mp_limb_t, unsigned);
 
+/* The limbs of an mpz_modctx_t are the normalized modulus, then the mu
+   inverse for mpn_preinv_mu_div_qr if any, then for an odd modulus the REDC
+   inverse and B^2n mod M as from mpn_powm_batch_init, with _mp_redc the
+   form of that inverse.  */
+#define MODCTX_SIZE(c)   SIZ(&(c)->_mp_mod)
+#define MODCTX_DP(c)     ((c)->_mp_d)
+#define MODCTX_IP(c)     ((c)->_mp_d + MODCTX_SIZE(c))
+#define MODCTX_MIP(c)    (MODCTX_IP(c) + (c)->_mp_in)
+#define MODCTX_R2P(c)    (MODCTX_MIP(c) + MODCTX_SIZE(c))
+#define MODCTX_ODD_P(c)  ((PTR(&(c)->_mp_mod)[0] & 1) != 0)
+#define MODCTX_ALLOC(c)							\
+  ((MODCTX_ODD_P(c) ? 3 : 1) * MODCTX_SIZE(c) + (c)->_mp_in)
+
+#define mpz_modctx_reduce  __gmpz_modctx_reduce
+__GMP_DECLSPEC void    mpz_modctx_reduce (mp_ptr, mp_srcptr, mp_size_t, mpz_modctx_srcptr);
+
+/* A product tree over the values v[0] to v[count-1], for mpz_prodtree and
+   mpz_remtree.  The range [lo,hi) splits into [lo,mid) and [mid,hi) with
+   mid = (lo+hi)/2, and the product of a range of more than one value is at
+   t[mid-1].  At each leaf mpz_remtree calls leaf (p, i, r) with r = (P /
+   v[i]) mod v[i], P the product of all the values, and returns 0 if any
+   call returned 0.  Unless keep is set, mpz_remtree frees the products
+   below the root as it goes.  Ranges with products of thresh limbs or more
+   are split over the parallel function.  */
+struct prodtree
+{
+  mpz_srcptr *v;
+  mpz_ptr t;
+  int (*leaf) (const struct prodtree *, size_t, mpz_ptr);
+  void *data;
+  mp_size_t thresh;
+  int keep;
+};
+
+#define PRODTREE_NODE(p, lo, hi)					\
+  ((hi) - (lo) == 1							\
+   ? (p)->v[lo]								\
+   : (mpz_srcptr) ((p)->t + ((lo) + (hi)) / 2 - 1))
+
+#define mpz_prodtree  __gmpz_prodtree
+__GMP_DECLSPEC void mpz_prodtree (const struct prodtree *, size_t, size_t);
+#define mpz_remtree  __gmpz_remtree
+__GMP_DECLSPEC int mpz_remtree (const struct prodtree *, size_t, size_t, mpz_ptr);
+
+/* The leaves of an mpz_crtctx_t tree are the moduli, in _mp_tree[0] to
+   _mp_tree[count-1], and the rest is the mpz_prodtree products, so the
+   product of the range [lo,hi) split at mid is at _mp_tree[count+mid-1].  */
+#define CRTCTX_NODE(c, lo, hi)						\
+  ((hi) - (lo) == 1							\
+   ? (c)->_mp_tree + (lo)						\
+   : (c)->_mp_tree + (c)->_mp_count + ((lo) + (hi)) / 2 - 1)
+
+/* An mpz_fixedbase_t table has _mp_blocks rows of 2^_mp_teeth-1 entries,
+   the powers for comb values 1 to 2^_mp_teeth-1, in REDC form for an odd
+   modulus.  */
+#define FIXEDBASE_ALIGN  64	/* bytes */
+#define FIXEDBASE_ENTRIES(fb)						\
+  (((mp_size_t) (fb)->_mp_blocks << (fb)->_mp_teeth) - (fb)->_mp_blocks)
+#define FIXEDBASE_ENTRY(fb, s, j)					\
+  ((fb)->_mp_d								\
+   + (((mp_size_t) (s) << (fb)->_mp_teeth) - (s) + (j) - 1) * (fb)->_mp_stride)
+
+#define mpz_fixedbase_alloc  __gmpz_fixedbase_alloc
+__GMP_DECLSPEC void    mpz_fixedbase_alloc (mpz_fixedbase_ptr, mpz_srcptr, mpz_srcptr, mp_bitcnt_t, int, mp_bitcnt_t);
+
+/* A series for mpf_bsplit, being the sum over n1 <= k < n2 of
+
+       a(k)   p(n1) * p(n1+1) * ... * p(k)
+       ---- * ---------------------------------------------
+       b(k)   q(n1) * q(n1+1) * ... * q(k) * 2^(qshift*(k-n1+1))
+
+   TERM sets p(k) and q(k), and a(k) and b(k) when BSPLIT_A and BSPLIT_B are
+   in FLAGS, the a and b arguments are NULL otherwise.  TERM may be called
+   from several threads at once if a parallel function is installed.  */
+struct bsplit_series
+{
+  void (*term) (mpz_ptr, mpz_ptr, mpz_ptr, mpz_ptr, unsigned long, const void *);
+  const void *data;
+  mp_bitcnt_t qshift;
+  int flags;
+};
+#define BSPLIT_A  1
+#define BSPLIT_B  2
+
+#define mpf_bsplit  __gmpf_bsplit
+__GMP_DECLSPEC void    mpf_bsplit (mpf_ptr, const struct bsplit_series *, unsigned long, unsigned long);
+
+#define mpf_const_pi  __gmpf_const_pi
+__GMP_DECLSPEC void    mpf_const_pi (mpf_ptr);
+
+#define mpf_const_log2  __gmpf_const_log2
+__GMP_DECLSPEC void    mpf_const_log2 (mpf_ptr);
+
 #define mpz_inp_str_nowhite __gmpz_inp_str_nowhite
 #ifdef _GMP_H_HAVE_FILE
 __GMP_DECLSPEC size_t  mpz_inp_str_nowhite (mpz_ptr, FILE *, int, int, size_t);
@@ -2081,8 +2310,20 @@ __GMP_DECLSPEC mp_limb_t gmp_primesieve (mp_ptr, mp_limb_t);
 
 /* MUL_TOOM22_THRESHOLD_LIMIT is the maximum for MUL_TOOM22_THRESHOLD.  In a
    normal build MUL_TOOM22_THRESHOLD is a constant and we use that.  In a fat
-   binary or tune program build MUL_TOOM22_THRESHOLD is a variable and a
-   separate hard limit will have been defined.  Similarly for TOOM3.  */
+   binary, runtime tuning or tune program build MUL_TOOM22_THRESHOLD is a
+   variable and a separate hard limit will have been defined.  Similarly for
+   TOOM3.  */
+#if WANT_RUNTIME_TUNING
+#ifndef MUL_TOOM22_THRESHOLD_LIMIT
+#define MUL_TOOM22_THRESHOLD_LIMIT  700
+#endif
+#ifndef MUL_TOOM33_THRESHOLD_LIMIT
+#define MUL_TOOM33_THRESHOLD_LIMIT  700
+#endif
+#ifndef SQR_TOOM3_THRESHOLD_LIMIT
+#define SQR_TOOM3_THRESHOLD_LIMIT   400
+#endif
+#endif
 #ifndef MUL_TOOM22_THRESHOLD_LIMIT
 #define MUL_TOOM22_THRESHOLD_LIMIT  MUL_TOOM22_THRESHOLD
 #endif
@@ -2269,6 +2510,13 @@ __GMP_DECLSPEC mp_limb_t gmp_primesieve (mp_ptr, mp_limb_t);
 #define SQR_FFT_THRESHOLD   (SQR_FFT_MODF_THRESHOLD * 10)
 #endif
 
+/* Size pl, in limbs, from which mpn_mul_fft splits its transforms and
+   pointwise products into tasks for the parallel function, when one is
+   installed.  Below this the thread handoff costs more than it gains.  */
+#ifndef FFT_PARALLEL_THRESHOLD
+#define FFT_PARALLEL_THRESHOLD   (MUL_FFT_MODF_THRESHOLD * 30)
+#endif
+
 /* Table of thresholds for successive modF FFT "k"s.  The first entry is
    where FFT_FIRST_K+1 should be used, the second FFT_FIRST_K+2,
    etc.  See mpn_fft_best_k(). */
@@ -2326,6 +2574,29 @@ struct fft_table_nk
 #define SET_STR_PRECOMPUTE_THRESHOLD   2000
 #endif
 
+/* Sizes from which a divide-and-conquer conversion splits its two halves
+   across the parallel function, in limbs for get_str and in digits for
+   set_str.  */
+#ifndef GET_STR_PARALLEL_THRESHOLD
+#define GET_STR_PARALLEL_THRESHOLD     4000
+#endif
+
+#ifndef SET_STR_PARALLEL_THRESHOLD
+#define SET_STR_PARALLEL_THRESHOLD    80000
+#endif
+
+/* Size in limbs of a node of an mpz_crtctx_t tree from which its two
+   halves go to the parallel function.  */
+#ifndef CRT_PARALLEL_THRESHOLD
+#define CRT_PARALLEL_THRESHOLD  (MUL_TOOM33_THRESHOLD * 16)
+#endif
+
+/* Number of terms from which mpf_bsplit sums the two halves of a series
+   under the parallel function.  */
+#ifndef BSPLIT_PARALLEL_THRESHOLD
+#define BSPLIT_PARALLEL_THRESHOLD  2000
+#endif
+
 #ifndef FAC_ODD_THRESHOLD
 #define FAC_ODD_THRESHOLD    35
 #endif
@@ -4308,6 +4579,19 @@ __GMP_DECLSPEC mp_size_t mpn_dc_set_str (mp_ptr, const unsigned char *, size_t,
 __GMP_DECLSPEC mp_size_t mpn_bc_set_str (mp_ptr, const unsigned char *, size_t, int);
 #define   mpn_set_str_compute_powtab __MPN(set_str_compute_powtab)
 __GMP_DECLSPEC void      mpn_set_str_compute_powtab (powers_t *, mp_ptr, mp_size_t, int);
+#define   mpn_set_str_pre __MPN(set_str_pre)
+__GMP_DECLSPEC mp_size_t mpn_set_str_pre (mp_ptr, const unsigned char *, size_t, const powers_t *);
+#define   mpn_get_str_pre __MPN(get_str_pre)
+__GMP_DECLSPEC size_t    mpn_get_str_pre (unsigned char *, mp_ptr, mp_size_t, const powers_t *);
+#define   mpn_out_str_func __MPN(out_str_func)
+__GMP_DECLSPEC size_t    mpn_out_str_func (void (*) (void *, unsigned char *, size_t), void *, int, mp_ptr, mp_size_t);
+
+/* The powers in an mpz_basectx_t are big_base^(2^i), at _mp_tab[i] for
+   0 <= i < _mp_levels.  mpz_basectx_powtab extends the table as needed and
+   returns the smallest i with 2*digits_in_base >= DIGITS.  */
+#define BASECTX_POWTAB(c)  ((powers_t *) (c)->_mp_tab)
+#define   mpz_basectx_powtab __gmpz_basectx_powtab
+__GMP_DECLSPEC int       mpz_basectx_powtab (mpz_basectx_ptr, size_t);
 
 
 /* __GMPF_BITS_TO_PREC applies a minimum 53 bits, rounds upwards to a whole
@@ -4635,6 +4919,7 @@ struct cpuvec_t {
   DECL_redc_1          ((*redc_1));
   DECL_redc_2          ((*redc_2));
   DECL_rshift          ((*rshift));
+  DECL_sec_powm_lanes  ((*sec_powm_lanes));
   DECL_sqr_basecase    ((*sqr_basecase));
   DECL_sub_n           ((*sub_n));
   DECL_sublsh1_n       ((*sublsh1_n));
@@ -4647,6 +4932,17 @@ struct cpuvec_t {
 };
 __GMP_DECLSPEC extern struct cpuvec_t __gmpn_cpuvec;
 __GMP_DECLSPEC extern int __gmpn_cpuvec_initialized;
+
+/* The functions the mpn/x86_64/ifma code goes to for sizes it doesn't
+   take, being what __gmpn_cpuvec would have had without it.  */
+struct cpuvec_ifma_t {
+  DECL_mul_basecase    ((*mul_basecase));
+  DECL_redc_1          ((*redc_1));
+  DECL_redc_2          ((*redc_2));
+  DECL_sec_powm_lanes  ((*sec_powm_lanes));
+  DECL_sqr_basecase    ((*sqr_basecase));
+};
+__GMP_DECLSPEC extern struct cpuvec_ifma_t __gmpn_cpuvec_ifma;
 #endif /* x86 fat binary */
 
 __GMP_DECLSPEC void __gmpn_cpuvec_init (void);
@@ -4687,6 +4983,132 @@ mpn_sub_nc (mp_ptr rp, mp_srcptr up, mp_srcptr vp, mp_size_t n, mp_limb_t ci)
 }
 #endif
 
+#if WANT_RUNTIME_TUNING
+/* With --enable-runtime-tuning the thresholds below are read from
+   __gmp_tuning, which starts out with the compiled-in values and can be
+   changed with gmp_set_tuning or gmp_read_tuning.  Each is a single load,
+   so the BELOW_THRESHOLD tests stay as predictable as with constants.
+
+   In a fat binary MUL_TOOM22, MUL_TOOM33 and SQR_TOOM3 are already
+   variables in __gmpn_cpuvec, and gmp_set_tuning stores those there
+   instead.  tuning.c is compiled with TUNING_DEFAULTS_BUILD so that it
+   sees the constants to initialize __gmp_tuning from (in a fat binary
+   those of the fat gmp-mparam.h, without fat.h).  */
+struct tuning_t {
+#if ! WANT_FAT_BINARY
+  mp_size_t  mul_toom22_threshold;
+  mp_size_t  mul_toom33_threshold;
+#endif
+  mp_size_t  mul_toom44_threshold;
+  mp_size_t  mul_toom6h_threshold;
+  mp_size_t  mul_toom8h_threshold;
+  mp_size_t  mul_toom32_to_toom43_threshold;
+  mp_size_t  mul_toom32_to_toom53_threshold;
+  mp_size_t  mul_toom42_to_toom53_threshold;
+  mp_size_t  mul_toom42_to_toom63_threshold;
+  mp_size_t  mul_toom43_to_toom54_threshold;
+  mp_size_t  mul_fft_threshold;
+#if ! WANT_FAT_BINARY
+  mp_size_t  sqr_toom3_threshold;
+#endif
+  mp_size_t  sqr_toom4_threshold;
+  mp_size_t  sqr_toom6_threshold;
+  mp_size_t  sqr_toom8_threshold;
+  mp_size_t  sqr_fft_threshold;
+  mp_size_t  dc_div_qr_threshold;
+  mp_size_t  dc_divappr_q_threshold;
+  mp_size_t  mu_div_qr_threshold;
+  mp_size_t  mu_divappr_q_threshold;
+  mp_size_t  mupi_div_qr_threshold;
+  mp_size_t  hgcd_threshold;
+  mp_size_t  gcd_dc_threshold;
+  mp_size_t  gcdext_dc_threshold;
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+  mp_size_t  redc_1_to_redc_2_threshold;
+  mp_size_t  redc_2_to_redc_n_threshold;
+#else
+  mp_size_t  redc_1_to_redc_n_threshold;
+#endif
+  mp_size_t  get_str_dc_threshold;
+  mp_size_t  set_str_dc_threshold;
+  mp_size_t  set_str_precompute_threshold;
+};
+__GMP_DECLSPEC extern struct tuning_t __gmp_tuning;
+
+#define TUNING_THRESHOLD(field)  (__gmp_tuning.field)
+
+#if ! TUNE_PROGRAM_BUILD && ! TUNING_DEFAULTS_BUILD
+#if ! WANT_FAT_BINARY
+#undef  MUL_TOOM22_THRESHOLD
+#define MUL_TOOM22_THRESHOLD  TUNING_THRESHOLD (mul_toom22_threshold)
+#undef  MUL_TOOM33_THRESHOLD
+#define MUL_TOOM33_THRESHOLD  TUNING_THRESHOLD (mul_toom33_threshold)
+#endif
+#undef  MUL_TOOM44_THRESHOLD
+#define MUL_TOOM44_THRESHOLD  TUNING_THRESHOLD (mul_toom44_threshold)
+#undef  MUL_TOOM6H_THRESHOLD
+#define MUL_TOOM6H_THRESHOLD  TUNING_THRESHOLD (mul_toom6h_threshold)
+#undef  MUL_TOOM8H_THRESHOLD
+#define MUL_TOOM8H_THRESHOLD  TUNING_THRESHOLD (mul_toom8h_threshold)
+#undef  MUL_TOOM32_TO_TOOM43_THRESHOLD
+#define MUL_TOOM32_TO_TOOM43_THRESHOLD  TUNING_THRESHOLD (mul_toom32_to_toom43_threshold)
+#undef  MUL_TOOM32_TO_TOOM53_THRESHOLD
+#define MUL_TOOM32_TO_TOOM53_THRESHOLD  TUNING_THRESHOLD (mul_toom32_to_toom53_threshold)
+#undef  MUL_TOOM42_TO_TOOM53_THRESHOLD
+#define MUL_TOOM42_TO_TOOM53_THRESHOLD  TUNING_THRESHOLD (mul_toom42_to_toom53_threshold)
+#undef  MUL_TOOM42_TO_TOOM63_THRESHOLD
+#define MUL_TOOM42_TO_TOOM63_THRESHOLD  TUNING_THRESHOLD (mul_toom42_to_toom63_threshold)
+#undef  MUL_TOOM43_TO_TOOM54_THRESHOLD
+#define MUL_TOOM43_TO_TOOM54_THRESHOLD  TUNING_THRESHOLD (mul_toom43_to_toom54_threshold)
+#undef  MUL_FFT_THRESHOLD
+#define MUL_FFT_THRESHOLD  TUNING_THRESHOLD (mul_fft_threshold)
+#if ! WANT_FAT_BINARY
+#undef  SQR_TOOM3_THRESHOLD
+#define SQR_TOOM3_THRESHOLD  TUNING_THRESHOLD (sqr_toom3_threshold)
+#endif
+#undef  SQR_TOOM4_THRESHOLD
+#define SQR_TOOM4_THRESHOLD  TUNING_THRESHOLD (sqr_toom4_threshold)
+#undef  SQR_TOOM6_THRESHOLD
+#define SQR_TOOM6_THRESHOLD  TUNING_THRESHOLD (sqr_toom6_threshold)
+#undef  SQR_TOOM8_THRESHOLD
+#define SQR_TOOM8_THRESHOLD  TUNING_THRESHOLD (sqr_toom8_threshold)
+#undef  SQR_FFT_THRESHOLD
+#define SQR_FFT_THRESHOLD  TUNING_THRESHOLD (sqr_fft_threshold)
+#undef  DC_DIV_QR_THRESHOLD
+#define DC_DIV_QR_THRESHOLD  TUNING_THRESHOLD (dc_div_qr_threshold)
+#undef  DC_DIVAPPR_Q_THRESHOLD
+#define DC_DIVAPPR_Q_THRESHOLD  TUNING_THRESHOLD (dc_divappr_q_threshold)
+#undef  MU_DIV_QR_THRESHOLD
+#define MU_DIV_QR_THRESHOLD  TUNING_THRESHOLD (mu_div_qr_threshold)
+#undef  MU_DIVAPPR_Q_THRESHOLD
+#define MU_DIVAPPR_Q_THRESHOLD  TUNING_THRESHOLD (mu_divappr_q_threshold)
+#undef  MUPI_DIV_QR_THRESHOLD
+#define MUPI_DIV_QR_THRESHOLD  TUNING_THRESHOLD (mupi_div_qr_threshold)
+#undef  HGCD_THRESHOLD
+#define HGCD_THRESHOLD  TUNING_THRESHOLD (hgcd_threshold)
+#undef  GCD_DC_THRESHOLD
+#define GCD_DC_THRESHOLD  TUNING_THRESHOLD (gcd_dc_threshold)
+#undef  GCDEXT_DC_THRESHOLD
+#define GCDEXT_DC_THRESHOLD  TUNING_THRESHOLD (gcdext_dc_threshold)
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+#undef  REDC_1_TO_REDC_2_THRESHOLD
+#define REDC_1_TO_REDC_2_THRESHOLD  TUNING_THRESHOLD (redc_1_to_redc_2_threshold)
+#undef  REDC_2_TO_REDC_N_THRESHOLD
+#define REDC_2_TO_REDC_N_THRESHOLD  TUNING_THRESHOLD (redc_2_to_redc_n_threshold)
+#else
+#undef  REDC_1_TO_REDC_N_THRESHOLD
+#define REDC_1_TO_REDC_N_THRESHOLD  TUNING_THRESHOLD (redc_1_to_redc_n_threshold)
+#endif
+#undef  GET_STR_DC_THRESHOLD
+#define GET_STR_DC_THRESHOLD  TUNING_THRESHOLD (get_str_dc_threshold)
+#undef  SET_STR_DC_THRESHOLD
+#define SET_STR_DC_THRESHOLD  TUNING_THRESHOLD (set_str_dc_threshold)
+#undef  SET_STR_PRECOMPUTE_THRESHOLD
+#define SET_STR_PRECOMPUTE_THRESHOLD  TUNING_THRESHOLD (set_str_precompute_threshold)
+#endif /* ! TUNE_PROGRAM_BUILD && ! TUNING_DEFAULTS_BUILD */
+#endif /* WANT_RUNTIME_TUNING */
+
+
 #if TUNE_PROGRAM_BUILD
 /* Some extras wanted when recompiling some .c files for use by the tune
    program.  Not part of a normal build.
@@ -4744,6 +5166,10 @@ extern mp_size_t			mul_fft_threshold;
 #define MUL_FFT_MODF_THRESHOLD		mul_fft_modf_threshold
 extern mp_size_t			mul_fft_modf_threshold;
 
+#undef	FFT_PARALLEL_THRESHOLD
+#define FFT_PARALLEL_THRESHOLD		fft_parallel_threshold
+extern mp_size_t			fft_parallel_threshold;
+
 #undef	MUL_FFT_TABLE
 #define MUL_FFT_TABLE			{ 0 }
 
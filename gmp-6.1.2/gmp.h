@@ -219,6 +219,42 @@ typedef struct
 } __gmp_randstate_struct;
 typedef __gmp_randstate_struct gmp_randstate_t[1];
 
+/* Segmented prime sieve state, for gmp_primeiter_next.  */
+typedef struct
+{
+  mp_limb_t _mp_end;		/* Primes are below this.  */
+  mp_limb_t _mp_small;		/* Next of 2 and 3 to return, else 5.  */
+  mp_limb_t _mp_off;		/* Sieve bit number of _mp_d[0] bit 0.  */
+  mp_limb_t _mp_pos;		/* Next bit to look at in _mp_d.  */
+  mp_size_t _mp_size;		/* Limbs sieved in _mp_d.  */
+  mp_size_t _mp_alloc;		/* Limbs allocated at _mp_d.  */
+  mp_limb_t *_mp_d;		/* Sieved segments.  */
+  mp_limb_t *_mp_seed;		/* Sieve of primes up to sqrt(_mp_end).  */
+  mp_limb_t _mp_seed_bits;	/* Last bit number in _mp_seed.  */
+} __gmp_primeiter_struct;
+
+typedef __gmp_primeiter_struct gmp_primeiter_t[1];
+
+/* Kinds of values in an array file.  */
+#define GMP_ARRAY_MPZ  1
+#define GMP_ARRAY_MPQ  2
+#define GMP_ARRAY_MPF  3
+
+/* An array file opened by gmp_array_map.  */
+typedef struct
+{
+  void *_mp_base;		/* File contents, mapped or read in.  */
+  size_t _mp_bytes;		/* Size of the file.  */
+  size_t _mp_count;		/* Number of values.  */
+  int _mp_kind;			/* GMP_ARRAY_MPZ, GMP_ARRAY_MPQ or GMP_ARRAY_MPF.  */
+  int _mp_mapped;		/* Nonzero if _mp_base is from mmap.  */
+  mp_limb_t *_mp_d;		/* Start of the limb data.  */
+} __gmp_array_struct;
+
+typedef __gmp_array_struct gmp_array_t[1];
+typedef const __gmp_array_struct *gmp_array_srcptr;
+typedef __gmp_array_struct *gmp_array_ptr;
+
 /* Types for function declarations in gmp files.  */
 /* ??? Should not pollute user name space with these ??? */
 typedef const __mpz_struct *mpz_srcptr;
@@ -228,6 +264,62 @@ typedef __mpf_struct *mpf_ptr;
 typedef const __mpq_struct *mpq_srcptr;
 typedef __mpq_struct *mpq_ptr;
 
+/* Precomputed data for a fixed modulus, for mpz_powm_ctx etc.  */
+typedef struct
+{
+  __mpz_struct _mp_mod;		/* The modulus, made positive.  */
+  mp_limb_t *_mp_d;		/* Normalized modulus and its inverses.  */
+  mp_size_t _mp_in;		/* Limbs in the mu inverse, or 0 if none.  */
+  mp_limb_t _mp_dinv;		/* Inverse of the normalized high limbs.  */
+  int _mp_shift;		/* Normalization shift.  */
+  int _mp_redc;			/* REDC form of the inverse, if odd.  */
+} __mpz_modctx_struct;
+
+typedef __mpz_modctx_struct mpz_modctx_t[1];
+typedef const __mpz_modctx_struct *mpz_modctx_srcptr;
+typedef __mpz_modctx_struct *mpz_modctx_ptr;
+
+/* Table of powers of a fixed base, for mpz_powm_fixed_base.  */
+typedef struct
+{
+  __mpz_modctx_struct _mp_ctx;	/* The modulus.  */
+  __mpz_struct _mp_base;	/* The base, reduced mod the modulus.  */
+  void *_mp_alloc;		/* Block holding the table.  */
+  mp_limb_t *_mp_d;		/* The table, cache line aligned.  */
+  mp_size_t _mp_stride;		/* Limbs per table entry.  */
+  mp_bitcnt_t _mp_spacing;	/* Exponent bits per tooth.  */
+  mp_bitcnt_t _mp_width;	/* Comb columns per block.  */
+  int _mp_teeth;		/* Teeth of the comb.  */
+  int _mp_blocks;		/* Blocks of columns.  */
+} __mpz_fixedbase_struct;
+
+typedef __mpz_fixedbase_struct mpz_fixedbase_t[1];
+typedef const __mpz_fixedbase_struct *mpz_fixedbase_srcptr;
+typedef __mpz_fixedbase_struct *mpz_fixedbase_ptr;
+
+/* Cached powers of a radix, for mpz_get_str_ctx and mpz_set_str_ctx.  */
+typedef struct
+{
+  int _mp_base;			/* The radix, negative for upper case.  */
+  int _mp_levels;		/* Number of powers computed so far.  */
+  void *_mp_tab;		/* The powers.  */
+} __mpz_basectx_struct;
+
+typedef __mpz_basectx_struct mpz_basectx_t[1];
+typedef __mpz_basectx_struct *mpz_basectx_ptr;
+
+/* Product tree over a set of moduli, for mpz_multi_mod and mpz_crt.  */
+typedef struct
+{
+  size_t _mp_count;		/* Number of moduli.  */
+  __mpz_struct *_mp_tree;	/* The moduli, then the tree's products.  */
+  __mpz_struct *_mp_coef;	/* CRT coefficients, or NULL if none.  */
+} __mpz_crtctx_struct;
+
+typedef __mpz_crtctx_struct mpz_crtctx_t[1];
+typedef const __mpz_crtctx_struct *mpz_crtctx_srcptr;
+typedef __mpz_crtctx_struct *mpz_crtctx_ptr;
+
 
 #if __GMP_LIBGMP_DLL
 #ifdef __GMP_WITHIN_GMPXX
@@ -479,6 +571,23 @@ __GMP_DECLSPEC void mp_get_memory_functions (void *(**) (size_t),
 				      void *(**) (void *, size_t, size_t),
 				      void (**) (void *, size_t)) __GMP_NOTHROW;
 
+#define mp_set_parallel_function __gmp_set_parallel_function
+__GMP_DECLSPEC void mp_set_parallel_function (void (*) (void (*) (void *, int), void *, int),
+				       int) __GMP_NOTHROW;
+
+#define mp_get_parallel_function __gmp_get_parallel_function
+__GMP_DECLSPEC void mp_get_parallel_function (void (**) (void (*) (void *, int), void *, int),
+				       int *) __GMP_NOTHROW;
+
+#define mp_set_arena __gmp_set_arena
+__GMP_DECLSPEC void mp_set_arena (size_t) __GMP_NOTHROW;
+
+#define mp_arena_release __gmp_arena_release
+__GMP_DECLSPEC void mp_arena_release (void) __GMP_NOTHROW;
+
+#define mp_get_arena_stats __gmp_get_arena_stats
+__GMP_DECLSPEC void mp_get_arena_stats (size_t *, size_t *, size_t *) __GMP_NOTHROW;
+
 #define mp_bits_per_limb __gmp_bits_per_limb
 __GMP_DECLSPEC extern const int mp_bits_per_limb;
 
@@ -526,6 +635,61 @@ __GMP_DECLSPEC unsigned long gmp_urandomb_ui (gmp_randstate_t, unsigned long);
 __GMP_DECLSPEC unsigned long gmp_urandomm_ui (gmp_randstate_t, unsigned long);
 
 
+/**************** Prime iteration.  ****************/
+
+#define gmp_primeiter_init __gmp_primeiter_init
+__GMP_DECLSPEC void gmp_primeiter_init (gmp_primeiter_t, mp_limb_t, mp_limb_t);
+
+#define gmp_primeiter_next __gmp_primeiter_next
+__GMP_DECLSPEC mp_limb_t gmp_primeiter_next (gmp_primeiter_t);
+
+#define gmp_primeiter_clear __gmp_primeiter_clear
+__GMP_DECLSPEC void gmp_primeiter_clear (gmp_primeiter_t);
+
+
+/**************** Array files.  ****************/
+
+#define gmp_array_map __gmp_array_map
+__GMP_DECLSPEC int gmp_array_map (gmp_array_ptr, const char *);
+
+#define gmp_array_unmap __gmp_array_unmap
+__GMP_DECLSPEC void gmp_array_unmap (gmp_array_ptr);
+
+#define gmp_array_count __gmp_array_count
+__GMP_DECLSPEC size_t gmp_array_count (gmp_array_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
+
+#define gmp_array_kind __gmp_array_kind
+__GMP_DECLSPEC int gmp_array_kind (gmp_array_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
+
+
+/**************** Dispatch statistics.  ****************/
+
+#define gmp_stats_enable __gmp_stats_enable
+__GMP_DECLSPEC int gmp_stats_enable (int) __GMP_NOTHROW;
+
+#define gmp_stats_reset __gmp_stats_reset
+__GMP_DECLSPEC void gmp_stats_reset (void) __GMP_NOTHROW;
+
+#ifdef _GMP_H_HAVE_FILE
+#define gmp_stats_dump __gmp_stats_dump
+__GMP_DECLSPEC void gmp_stats_dump (FILE *);
+#endif
+
+
+/**************** Runtime tuning.  ****************/
+
+#define gmp_set_tuning __gmp_set_tuning
+__GMP_DECLSPEC int gmp_set_tuning (const char *, long);
+
+#define gmp_get_tuning __gmp_get_tuning
+__GMP_DECLSPEC long gmp_get_tuning (const char *);
+
+#ifdef _GMP_H_HAVE_FILE
+#define gmp_read_tuning __gmp_read_tuning
+__GMP_DECLSPEC int gmp_read_tuning (FILE *);
+#endif
+
+
 /**************** Formatted output routines.  ****************/
 
 #define gmp_asprintf __gmp_asprintf
@@ -639,12 +803,27 @@ __GMP_DECLSPEC void mpz_and (mpz_ptr, mpz_srcptr, mpz_srcptr);
 #define mpz_array_init __gmpz_array_init
 __GMP_DECLSPEC void mpz_array_init (mpz_ptr, mp_size_t, mp_size_t);
 
+#define mpz_basectx_clear __gmpz_basectx_clear
+__GMP_DECLSPEC void mpz_basectx_clear (mpz_basectx_ptr);
+
+#define mpz_basectx_init __gmpz_basectx_init
+__GMP_DECLSPEC void mpz_basectx_init (mpz_basectx_ptr, int);
+
+#define mpz_basectx_init2 __gmpz_basectx_init2
+__GMP_DECLSPEC void mpz_basectx_init2 (mpz_basectx_ptr, int, size_t);
+
+#define mpz_batch_gcd __gmpz_batch_gcd
+__GMP_DECLSPEC void mpz_batch_gcd (mpz_ptr *, mpz_srcptr *, size_t);
+
 #define mpz_bin_ui __gmpz_bin_ui
 __GMP_DECLSPEC void mpz_bin_ui (mpz_ptr, mpz_srcptr, unsigned long int);
 
 #define mpz_bin_uiui __gmpz_bin_uiui
 __GMP_DECLSPEC void mpz_bin_uiui (mpz_ptr, unsigned long int, unsigned long int);
 
+#define mpz_bpsw_p __gmpz_bpsw_p
+__GMP_DECLSPEC int mpz_bpsw_p (mpz_srcptr) __GMP_ATTRIBUTE_PURE;
+
 #define mpz_cdiv_q __gmpz_cdiv_q
 __GMP_DECLSPEC void mpz_cdiv_q (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -717,6 +896,18 @@ __GMP_DECLSPEC int mpz_congruent_2exp_p (mpz_srcptr, mpz_srcptr, mp_bitcnt_t) __
 #define mpz_congruent_ui_p __gmpz_congruent_ui_p
 __GMP_DECLSPEC int mpz_congruent_ui_p (mpz_srcptr, unsigned long, unsigned long) __GMP_ATTRIBUTE_PURE;
 
+#define mpz_crt __gmpz_crt
+__GMP_DECLSPEC void mpz_crt (mpz_ptr, mpz_srcptr *, mpz_crtctx_srcptr);
+
+#define mpz_crtctx_clear __gmpz_crtctx_clear
+__GMP_DECLSPEC void mpz_crtctx_clear (mpz_crtctx_ptr);
+
+#define mpz_crtctx_init __gmpz_crtctx_init
+__GMP_DECLSPEC int mpz_crtctx_init (mpz_crtctx_ptr, mpz_srcptr *, size_t);
+
+#define mpz_crtctx_product __gmpz_crtctx_product
+__GMP_DECLSPEC mpz_srcptr mpz_crtctx_product (mpz_crtctx_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
+
 #define mpz_divexact __gmpz_divexact
 __GMP_DECLSPEC void mpz_divexact (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -750,6 +941,9 @@ __GMP_DECLSPEC void mpz_mfac_uiui (mpz_ptr, unsigned long int, unsigned long int
 #define mpz_primorial_ui __gmpz_primorial_ui
 __GMP_DECLSPEC void mpz_primorial_ui (mpz_ptr, unsigned long int);
 
+#define mpz_prod_ui_array __gmpz_prod_ui_array
+__GMP_DECLSPEC void mpz_prod_ui_array (mpz_ptr, const unsigned long int *, size_t);
+
 #define mpz_fdiv_q __gmpz_fdiv_q
 __GMP_DECLSPEC void mpz_fdiv_q (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -807,6 +1001,22 @@ __GMP_DECLSPEC int mpz_fits_ulong_p (mpz_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_P
 __GMP_DECLSPEC int mpz_fits_ushort_p (mpz_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 #endif
 
+#define mpz_fixedbase_clear __gmpz_fixedbase_clear
+__GMP_DECLSPEC void mpz_fixedbase_clear (mpz_fixedbase_ptr);
+
+#define mpz_fixedbase_init __gmpz_fixedbase_init
+__GMP_DECLSPEC void mpz_fixedbase_init (mpz_fixedbase_ptr, mpz_srcptr, mpz_srcptr, mp_bitcnt_t, int, unsigned long);
+
+#define mpz_fixedbase_inp_raw __gmpz_fixedbase_inp_raw
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t mpz_fixedbase_inp_raw (mpz_fixedbase_ptr, FILE *);
+#endif
+
+#define mpz_fixedbase_out_raw __gmpz_fixedbase_out_raw
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t mpz_fixedbase_out_raw (FILE *, mpz_fixedbase_srcptr);
+#endif
+
 #define mpz_gcd __gmpz_gcd
 __GMP_DECLSPEC void mpz_gcd (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -828,6 +1038,9 @@ __GMP_DECLSPEC /* signed */ long int mpz_get_si (mpz_srcptr) __GMP_NOTHROW __GMP
 #define mpz_get_str __gmpz_get_str
 __GMP_DECLSPEC char *mpz_get_str (char *, int, mpz_srcptr);
 
+#define mpz_get_str_ctx __gmpz_get_str_ctx
+__GMP_DECLSPEC char *mpz_get_str_ctx (char *, mpz_srcptr, mpz_basectx_ptr);
+
 #define mpz_get_ui __gmpz_get_ui
 #if __GMP_INLINE_PROTOTYPES || defined (__GMP_FORCE_mpz_get_ui)
 __GMP_DECLSPEC unsigned long int mpz_get_ui (mpz_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
@@ -881,6 +1094,9 @@ __GMP_DECLSPEC size_t mpz_inp_str (mpz_ptr, FILE *, int);
 #define mpz_invert __gmpz_invert
 __GMP_DECLSPEC int mpz_invert (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
+#define mpz_invert_ctx __gmpz_invert_ctx
+__GMP_DECLSPEC int mpz_invert_ctx (mpz_ptr, mpz_srcptr, mpz_modctx_srcptr);
+
 #define mpz_ior __gmpz_ior
 __GMP_DECLSPEC void mpz_ior (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -921,8 +1137,23 @@ __GMP_DECLSPEC int mpz_millerrabin (mpz_srcptr, int) __GMP_ATTRIBUTE_PURE;
 #define mpz_mod __gmpz_mod
 __GMP_DECLSPEC void mpz_mod (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
+#define mpz_mod_ctx __gmpz_mod_ctx
+__GMP_DECLSPEC void mpz_mod_ctx (mpz_ptr, mpz_srcptr, mpz_modctx_srcptr);
+
+#define mpz_modctx_clear __gmpz_modctx_clear
+__GMP_DECLSPEC void mpz_modctx_clear (mpz_modctx_ptr);
+
+#define mpz_modctx_init __gmpz_modctx_init
+__GMP_DECLSPEC void mpz_modctx_init (mpz_modctx_ptr, mpz_srcptr);
+
+#define mpz_mulmod_ctx __gmpz_mulmod_ctx
+__GMP_DECLSPEC void mpz_mulmod_ctx (mpz_ptr, mpz_srcptr, mpz_srcptr, mpz_modctx_srcptr);
+
 #define mpz_mod_ui mpz_fdiv_r_ui /* same as fdiv_r because divisor unsigned */
 
+#define mpz_multi_mod __gmpz_multi_mod
+__GMP_DECLSPEC void mpz_multi_mod (mpz_ptr *, mpz_srcptr, mpz_crtctx_srcptr);
+
 #define mpz_mul __gmpz_mul
 __GMP_DECLSPEC void mpz_mul (mpz_ptr, mpz_srcptr, mpz_srcptr);
 
@@ -943,6 +1174,14 @@ __GMP_DECLSPEC void mpz_neg (mpz_ptr, mpz_srcptr);
 #define mpz_nextprime __gmpz_nextprime
 __GMP_DECLSPEC void mpz_nextprime (mpz_ptr, mpz_srcptr);
 
+#define mpz_nextprime_range __gmpz_nextprime_range
+__GMP_DECLSPEC size_t mpz_nextprime_range (mpz_ptr *, size_t, mpz_srcptr, mpz_srcptr);
+
+#define mpz_out_array __gmpz_out_array
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t mpz_out_array (FILE *, mpz_srcptr, size_t);
+#endif
+
 #define mpz_out_raw __gmpz_out_raw
 #ifdef _GMP_H_HAVE_FILE
 __GMP_DECLSPEC size_t mpz_out_raw (FILE *, mpz_srcptr);
@@ -953,6 +1192,9 @@ __GMP_DECLSPEC size_t mpz_out_raw (FILE *, mpz_srcptr);
 __GMP_DECLSPEC size_t mpz_out_str (FILE *, int, mpz_srcptr);
 #endif
 
+#define mpz_out_str_func __gmpz_out_str_func
+__GMP_DECLSPEC size_t mpz_out_str_func (void (*) (void *, const char *, size_t), void *, int, mpz_srcptr);
+
 #define mpz_perfect_power_p __gmpz_perfect_power_p
 __GMP_DECLSPEC int mpz_perfect_power_p (mpz_srcptr) __GMP_ATTRIBUTE_PURE;
 
@@ -972,6 +1214,15 @@ __GMP_DECLSPEC void mpz_pow_ui (mpz_ptr, mpz_srcptr, unsigned long int);
 #define mpz_powm __gmpz_powm
 __GMP_DECLSPEC void mpz_powm (mpz_ptr, mpz_srcptr, mpz_srcptr, mpz_srcptr);
 
+#define mpz_powm_batch __gmpz_powm_batch
+__GMP_DECLSPEC void mpz_powm_batch (mpz_ptr *, mpz_srcptr *, mpz_srcptr *, size_t, mpz_srcptr);
+
+#define mpz_powm_ctx __gmpz_powm_ctx
+__GMP_DECLSPEC void mpz_powm_ctx (mpz_ptr, mpz_srcptr, mpz_srcptr, mpz_modctx_srcptr);
+
+#define mpz_powm_fixed_base __gmpz_powm_fixed_base
+__GMP_DECLSPEC void mpz_powm_fixed_base (mpz_ptr, mpz_srcptr, mpz_fixedbase_srcptr);
+
 #define mpz_powm_sec __gmpz_powm_sec
 __GMP_DECLSPEC void mpz_powm_sec (mpz_ptr, mpz_srcptr, mpz_srcptr, mpz_srcptr);
 
@@ -1028,6 +1279,9 @@ __GMP_DECLSPEC void mpz_set_si (mpz_ptr, signed long int);
 #define mpz_set_str __gmpz_set_str
 __GMP_DECLSPEC int mpz_set_str (mpz_ptr, const char *, int);
 
+#define mpz_set_str_ctx __gmpz_set_str_ctx
+__GMP_DECLSPEC int mpz_set_str_ctx (mpz_ptr, const char *, mpz_basectx_ptr);
+
 #define mpz_set_ui __gmpz_set_ui
 __GMP_DECLSPEC void mpz_set_ui (mpz_ptr, unsigned long int);
 
@@ -1042,6 +1296,9 @@ __GMP_DECLSPEC size_t mpz_size (mpz_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 #define mpz_sizeinbase __gmpz_sizeinbase
 __GMP_DECLSPEC size_t mpz_sizeinbase (mpz_srcptr, int) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 
+#define mpz_sqrmod_ctx __gmpz_sqrmod_ctx
+__GMP_DECLSPEC void mpz_sqrmod_ctx (mpz_ptr, mpz_srcptr, mpz_modctx_srcptr);
+
 #define mpz_sqrt __gmpz_sqrt
 __GMP_DECLSPEC void mpz_sqrt (mpz_ptr, mpz_srcptr);
 
@@ -1121,6 +1378,9 @@ __GMP_DECLSPEC mp_ptr mpz_limbs_modify (mpz_ptr, mp_size_t);
 #define mpz_limbs_finish __gmpz_limbs_finish
 __GMP_DECLSPEC void mpz_limbs_finish (mpz_ptr, mp_size_t);
 
+#define mpz_roinit_array __gmpz_roinit_array
+__GMP_DECLSPEC mpz_srcptr mpz_roinit_array (mpz_ptr, gmp_array_srcptr, size_t);
+
 #define mpz_roinit_n __gmpz_roinit_n
 __GMP_DECLSPEC mpz_srcptr mpz_roinit_n (mpz_ptr, mp_srcptr, mp_size_t);
 
@@ -1203,11 +1463,19 @@ __GMP_DECLSPEC void mpq_mul_2exp (mpq_ptr, mpq_srcptr, mp_bitcnt_t);
 __GMP_DECLSPEC void mpq_neg (mpq_ptr, mpq_srcptr);
 #endif
 
+#define mpq_out_array __gmpq_out_array
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t mpq_out_array (FILE *, mpq_srcptr, size_t);
+#endif
+
 #define mpq_out_str __gmpq_out_str
 #ifdef _GMP_H_HAVE_FILE
 __GMP_DECLSPEC size_t mpq_out_str (FILE *, int, mpq_srcptr);
 #endif
 
+#define mpq_roinit_array __gmpq_roinit_array
+__GMP_DECLSPEC mpq_srcptr mpq_roinit_array (mpq_ptr, gmp_array_srcptr, size_t);
+
 #define mpq_set __gmpq_set
 __GMP_DECLSPEC void mpq_set (mpq_ptr, mpq_srcptr);
 
@@ -1252,6 +1520,9 @@ __GMP_DECLSPEC void mpf_add (mpf_ptr, mpf_srcptr, mpf_srcptr);
 
 #define mpf_add_ui __gmpf_add_ui
 __GMP_DECLSPEC void mpf_add_ui (mpf_ptr, mpf_srcptr, unsigned long int);
+#define mpf_atan __gmpf_atan
+__GMP_DECLSPEC void mpf_atan (mpf_ptr, mpf_srcptr);
+
 #define mpf_ceil __gmpf_ceil
 __GMP_DECLSPEC void mpf_ceil (mpf_ptr, mpf_srcptr);
 
@@ -1276,6 +1547,9 @@ __GMP_DECLSPEC int mpf_cmp_si (mpf_srcptr, signed long int) __GMP_NOTHROW __GMP_
 #define mpf_cmp_ui __gmpf_cmp_ui
 __GMP_DECLSPEC int mpf_cmp_ui (mpf_srcptr, unsigned long int) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 
+#define mpf_cos __gmpf_cos
+__GMP_DECLSPEC void mpf_cos (mpf_ptr, mpf_srcptr);
+
 #define mpf_div __gmpf_div
 __GMP_DECLSPEC void mpf_div (mpf_ptr, mpf_srcptr, mpf_srcptr);
 
@@ -1291,6 +1565,9 @@ __GMP_DECLSPEC void mpf_dump (mpf_srcptr);
 #define mpf_eq __gmpf_eq
 __GMP_DECLSPEC int mpf_eq (mpf_srcptr, mpf_srcptr, mp_bitcnt_t) __GMP_ATTRIBUTE_PURE;
 
+#define mpf_exp __gmpf_exp
+__GMP_DECLSPEC void mpf_exp (mpf_ptr, mpf_srcptr);
+
 #define mpf_fits_sint_p __gmpf_fits_sint_p
 __GMP_DECLSPEC int mpf_fits_sint_p (mpf_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 
@@ -1365,6 +1642,9 @@ __GMP_DECLSPEC size_t mpf_inp_str (mpf_ptr, FILE *, int);
 #define mpf_integer_p __gmpf_integer_p
 __GMP_DECLSPEC int mpf_integer_p (mpf_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 
+#define mpf_log __gmpf_log
+__GMP_DECLSPEC void mpf_log (mpf_ptr, mpf_srcptr);
+
 #define mpf_mul __gmpf_mul
 __GMP_DECLSPEC void mpf_mul (mpf_ptr, mpf_srcptr, mpf_srcptr);
 
@@ -1377,6 +1657,11 @@ __GMP_DECLSPEC void mpf_mul_ui (mpf_ptr, mpf_srcptr, unsigned long int);
 #define mpf_neg __gmpf_neg
 __GMP_DECLSPEC void mpf_neg (mpf_ptr, mpf_srcptr);
 
+#define mpf_out_array __gmpf_out_array
+#ifdef _GMP_H_HAVE_FILE
+__GMP_DECLSPEC size_t mpf_out_array (FILE *, mpf_srcptr, size_t);
+#endif
+
 #define mpf_out_str __gmpf_out_str
 #ifdef _GMP_H_HAVE_FILE
 __GMP_DECLSPEC size_t mpf_out_str (FILE *, int, size_t, mpf_srcptr);
@@ -1391,6 +1676,9 @@ __GMP_DECLSPEC void mpf_random2 (mpf_ptr, mp_size_t, mp_exp_t);
 #define mpf_reldiff __gmpf_reldiff
 __GMP_DECLSPEC void mpf_reldiff (mpf_ptr, mpf_srcptr, mpf_srcptr);
 
+#define mpf_roinit_array __gmpf_roinit_array
+__GMP_DECLSPEC mpf_srcptr mpf_roinit_array (mpf_ptr, gmp_array_srcptr, size_t);
+
 #define mpf_set __gmpf_set
 __GMP_DECLSPEC void mpf_set (mpf_ptr, mpf_srcptr);
 
@@ -1421,6 +1709,9 @@ __GMP_DECLSPEC void mpf_set_ui (mpf_ptr, unsigned long int);
 #define mpf_set_z __gmpf_set_z
 __GMP_DECLSPEC void mpf_set_z (mpf_ptr, mpz_srcptr);
 
+#define mpf_sin __gmpf_sin
+__GMP_DECLSPEC void mpf_sin (mpf_ptr, mpf_srcptr);
+
 #define mpf_size __gmpf_size
 __GMP_DECLSPEC size_t mpf_size (mpf_srcptr) __GMP_NOTHROW __GMP_ATTRIBUTE_PURE;
 
@@ -1669,6 +1960,11 @@ __GMP_DECLSPEC void mpn_sec_powm (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_bi
 #define mpn_sec_powm_itch __MPN(sec_powm_itch)
 __GMP_DECLSPEC mp_size_t mpn_sec_powm_itch (mp_size_t, mp_bitcnt_t, mp_size_t) __GMP_ATTRIBUTE_PURE;
 
+#define mpn_sec_powm_multi __MPN(sec_powm_multi)
+__GMP_DECLSPEC void mpn_sec_powm_multi (mp_ptr, mp_srcptr, mp_size_t, mp_srcptr, mp_bitcnt_t, mp_srcptr, mp_size_t, int, mp_ptr);
+#define mpn_sec_powm_multi_itch __MPN(sec_powm_multi_itch)
+__GMP_DECLSPEC mp_size_t mpn_sec_powm_multi_itch (mp_size_t, mp_bitcnt_t, mp_size_t) __GMP_ATTRIBUTE_PURE;
+
 #define mpn_sec_tabselect __MPN(sec_tabselect)
 __GMP_DECLSPEC void mpn_sec_tabselect (volatile mp_limb_t *, volatile const mp_limb_t *, mp_size_t, mp_size_t, mp_size_t);
 
@@ -1489,7 +1489,7 @@ public:
 
   __gmp_expr(const __gmp_expr &z) { mpz_init_set(mp, z.mp); }
 #if __GMPXX_USE_CXX11
-  __gmp_expr(__gmp_expr &&z)
+  __gmp_expr(__gmp_expr &&z) noexcept
   { *mp = *z.mp; mpz_init(z.mp); }
 #endif
   template <class T>
@@ -2762,6 +2762,225 @@ __GMPZQ_DEFINE_EXPR(__gmp_binary_plus)
 __GMPZQ_DEFINE_EXPR(__gmp_binary_minus)
 
 
+/* Sums and differences with a product of two mpz_class's, such as a + b*c,
+   a*b - c*d, or chains like a*b + c*d + e*f, are accumulated in the
+   destination with mpz_addmul and mpz_submul, instead of evaluating the
+   product into a temporary.  x is the other operand, either an mpz_class or
+   an expression evaluated directly into the destination, and the forms with
+   the product first, b*c - x, are done as -(x - b*c).  When the destination
+   is one of the product's factors it is clobbered by the accumulation, so a
+   plain multiply is done first, still without a temporary unless x is an
+   expression.  (x*y) % m and (a*b + c*d) % m need nothing special, they
+   already evaluate in place.  */
+
+typedef __gmp_expr<mpz_t, __gmp_binary_expr<mpz_class, mpz_class,
+  __gmp_binary_multiplies> > __gmpz_product_expr;
+
+template <class Op>
+struct __gmpz_fma_function;
+
+template <>
+struct __gmpz_fma_function<__gmp_binary_plus>
+{
+  // p = p + a*b
+  static void eval(mpz_ptr p, mpz_srcptr a, mpz_srcptr b)
+  { mpz_addmul(p, a, b); }
+  // p = a*b + p
+  static void eval_rev(mpz_ptr p, mpz_srcptr a, mpz_srcptr b)
+  { mpz_addmul(p, a, b); }
+};
+
+template <>
+struct __gmpz_fma_function<__gmp_binary_minus>
+{
+  // p = p - a*b
+  static void eval(mpz_ptr p, mpz_srcptr a, mpz_srcptr b)
+  { mpz_submul(p, a, b); }
+  // p = a*b - p
+  static void eval_rev(mpz_ptr p, mpz_srcptr a, mpz_srcptr b)
+  { mpz_submul(p, a, b); mpz_neg(p, p); }
+};
+
+#define __GMPZ_DEFINE_FMA_EXPR(eval_fun)                                    \
+                                                                            \
+template <>                                                                 \
+class __gmp_expr<mpz_t, __gmp_binary_expr                                   \
+<mpz_class, __gmpz_product_expr, eval_fun> >                                \
+{                                                                           \
+private:                                                                    \
+  typedef mpz_class val1_type;                                              \
+  typedef __gmpz_product_expr val2_type;                                    \
+                                                                            \
+  __gmp_binary_expr<val1_type, val2_type, eval_fun> expr;                   \
+public:                                                                     \
+  __gmp_expr(const val1_type &val1, const val2_type &val2)                  \
+    : expr(val1, val2) { }                                                  \
+  void eval(mpz_ptr p) const                                                \
+  {                                                                         \
+    mpz_srcptr x = expr.val1.get_mpz_t();                                   \
+    mpz_srcptr a = expr.val2.get_val1().get_mpz_t();                        \
+    mpz_srcptr b = expr.val2.get_val2().get_mpz_t();                        \
+    if (p == x || (p != a && p != b))                                       \
+      {                                                                     \
+	if (p != x)                                                         \
+	  mpz_set(p, x);                                                    \
+	__gmpz_fma_function<eval_fun>::eval(p, a, b);                       \
+      }                                                                     \
+    else                                                                    \
+      {                                                                     \
+	mpz_mul(p, a, b);                                                   \
+	eval_fun::eval(p, x, p);                                            \
+      }                                                                     \
+  }                                                                         \
+  const val1_type & get_val1() const { return expr.val1; }                  \
+  const val2_type & get_val2() const { return expr.val2; }                  \
+  mp_bitcnt_t get_prec() const { return mpf_get_default_prec(); }           \
+};                                                                          \
+                                                                            \
+template <>                                                                 \
+class __gmp_expr<mpz_t, __gmp_binary_expr                                   \
+<__gmpz_product_expr, mpz_class, eval_fun> >                                \
+{                                                                           \
+private:                                                                    \
+  typedef __gmpz_product_expr val1_type;                                    \
+  typedef mpz_class val2_type;                                              \
+                                                                            \
+  __gmp_binary_expr<val1_type, val2_type, eval_fun> expr;                   \
+public:                                                                     \
+  __gmp_expr(const val1_type &val1, const val2_type &val2)                  \
+    : expr(val1, val2) { }                                                  \
+  void eval(mpz_ptr p) const                                                \
+  {                                                                         \
+    mpz_srcptr a = expr.val1.get_val1().get_mpz_t();                        \
+    mpz_srcptr b = expr.val1.get_val2().get_mpz_t();                        \
+    mpz_srcptr x = expr.val2.get_mpz_t();                                   \
+    if (p == x || (p != a && p != b))                                       \
+      {                                                                     \
+	if (p != x)                                                         \
+	  mpz_set(p, x);                                                    \
+	__gmpz_fma_function<eval_fun>::eval_rev(p, a, b);                   \
+      }                                                                     \
+    else                                                                    \
+      {                                                                     \
+	mpz_mul(p, a, b);                                                   \
+	eval_fun::eval(p, p, x);                                            \
+      }                                                                     \
+  }                                                                         \
+  const val1_type & get_val1() const { return expr.val1; }                  \
+  const val2_type & get_val2() const { return expr.val2; }                  \
+  mp_bitcnt_t get_prec() const { return mpf_get_default_prec(); }           \
+};                                                                          \
+                                                                            \
+template <class T>                                                          \
+class __gmp_expr<mpz_t, __gmp_binary_expr                                   \
+<__gmp_expr<mpz_t, T>, __gmpz_product_expr, eval_fun> >                     \
+{                                                                           \
+private:                                                                    \
+  typedef __gmp_expr<mpz_t, T> val1_type;                                   \
+  typedef __gmpz_product_expr val2_type;                                    \
+                                                                            \
+  __gmp_binary_expr<val1_type, val2_type, eval_fun> expr;                   \
+public:                                                                     \
+  __gmp_expr(const val1_type &val1, const val2_type &val2)                  \
+    : expr(val1, val2) { }                                                  \
+  void eval(mpz_ptr p) const                                                \
+  {                                                                         \
+    mpz_srcptr a = expr.val2.get_val1().get_mpz_t();                        \
+    mpz_srcptr b = expr.val2.get_val2().get_mpz_t();                        \
+    if (p != a && p != b)                                                   \
+      {                                                                     \
+	expr.val1.eval(p);                                                  \
+	__gmpz_fma_function<eval_fun>::eval(p, a, b);                       \
+      }                                                                     \
+    else                                                                    \
+      {                                                                     \
+	__gmp_temp<mpz_t> temp(expr.val1, p);                               \
+	mpz_mul(p, a, b);                                                   \
+	eval_fun::eval(p, temp.__get_mp(), p);                              \
+      }                                                                     \
+  }                                                                         \
+  const val1_type & get_val1() const { return expr.val1; }                  \
+  const val2_type & get_val2() const { return expr.val2; }                  \
+  mp_bitcnt_t get_prec() const { return mpf_get_default_prec(); }           \
+};                                                                          \
+                                                                            \
+template <class T>                                                          \
+class __gmp_expr<mpz_t, __gmp_binary_expr                                   \
+<__gmpz_product_expr, __gmp_expr<mpz_t, T>, eval_fun> >                     \
+{                                                                           \
+private:                                                                    \
+  typedef __gmpz_product_expr val1_type;                                    \
+  typedef __gmp_expr<mpz_t, T> val2_type;                                   \
+                                                                            \
+  __gmp_binary_expr<val1_type, val2_type, eval_fun> expr;                   \
+public:                                                                     \
+  __gmp_expr(const val1_type &val1, const val2_type &val2)                  \
+    : expr(val1, val2) { }                                                  \
+  void eval(mpz_ptr p) const                                                \
+  {                                                                         \
+    mpz_srcptr a = expr.val1.get_val1().get_mpz_t();                        \
+    mpz_srcptr b = expr.val1.get_val2().get_mpz_t();                        \
+    if (p != a && p != b)                                                   \
+      {                                                                     \
+	expr.val2.eval(p);                                                  \
+	__gmpz_fma_function<eval_fun>::eval_rev(p, a, b);                   \
+      }                                                                     \
+    else                                                                    \
+      {                                                                     \
+	__gmp_temp<mpz_t> temp(expr.val2, p);                               \
+	mpz_mul(p, a, b);                                                   \
+	eval_fun::eval(p, p, temp.__get_mp());                              \
+      }                                                                     \
+  }                                                                         \
+  const val1_type & get_val1() const { return expr.val1; }                  \
+  const val2_type & get_val2() const { return expr.val2; }                  \
+  mp_bitcnt_t get_prec() const { return mpf_get_default_prec(); }           \
+};                                                                          \
+                                                                            \
+template <>                                                                 \
+class __gmp_expr<mpz_t, __gmp_binary_expr                                   \
+<__gmpz_product_expr, __gmpz_product_expr, eval_fun> >                      \
+{                                                                           \
+private:                                                                    \
+  typedef __gmpz_product_expr val1_type;                                    \
+  typedef __gmpz_product_expr val2_type;                                    \
+                                                                            \
+  __gmp_binary_expr<val1_type, val2_type, eval_fun> expr;                   \
+public:                                                                     \
+  __gmp_expr(const val1_type &val1, const val2_type &val2)                  \
+    : expr(val1, val2) { }                                                  \
+  void eval(mpz_ptr p) const                                                \
+  {                                                                         \
+    mpz_srcptr a = expr.val1.get_val1().get_mpz_t();                        \
+    mpz_srcptr b = expr.val1.get_val2().get_mpz_t();                        \
+    mpz_srcptr c = expr.val2.get_val1().get_mpz_t();                        \
+    mpz_srcptr d = expr.val2.get_val2().get_mpz_t();                        \
+    if (p != c && p != d)                                                   \
+      {                                                                     \
+	mpz_mul(p, a, b);                                                   \
+	__gmpz_fma_function<eval_fun>::eval(p, c, d);                       \
+      }                                                                     \
+    else if (p != a && p != b)                                              \
+      {                                                                     \
+	mpz_mul(p, c, d);                                                   \
+	__gmpz_fma_function<eval_fun>::eval_rev(p, a, b);                   \
+      }                                                                     \
+    else                                                                    \
+      {                                                                     \
+	__gmp_temp<mpz_t> temp(expr.val2, p);                               \
+	mpz_mul(p, a, b);                                                   \
+	eval_fun::eval(p, p, temp.__get_mp());                              \
+      }                                                                     \
+  }                                                                         \
+  const val1_type & get_val1() const { return expr.val1; }                  \
+  const val2_type & get_val2() const { return expr.val2; }                  \
+  mp_bitcnt_t get_prec() const { return mpf_get_default_prec(); }           \
+};
+
+__GMPZ_DEFINE_FMA_EXPR(__gmp_binary_plus)
+__GMPZ_DEFINE_FMA_EXPR(__gmp_binary_minus)
+
+
 
 /**************** Macros for defining functions ****************/
 /* Results of operators and functions are instances of __gmp_expr<T, U>.
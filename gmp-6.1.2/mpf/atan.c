@@ -0,0 +1,166 @@
+/* mpf_atan -- inverse tangent.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* |x| > 1 goes to atan(x) = pi/2 - atan(1/x), and then
+
+       atan(z) = 2 * atan(z / (1 + sqrt(1 + z^2)))
+
+   is applied until z < 2^-ATAN_HALVINGS_BITS.  After that it's a bit-burst
+   like mpf_exp, but with the remainder recalculated for each piece,
+
+       atan(z) = atan(zi) + atan((z - zi) / (1 + z*zi))
+
+   with zi the leading bits of z, as many as there are zero bits after the
+   point.  The new z is below 2^-hi, so the pieces double in size.
+   atan(zi)/zi - 1 is a series for mpf_bsplit with p(k) = -p^2, q(k) = 1,
+   b(k) = 2k+1 and 2^(2*hi) as the shift, converging by 2*e bits a term for
+   zi < 2^-e.  Once z^2 is below the working precision z is its own atan
+   and is simply added on.
+
+   z - zi loses the leading bits of z, but its absolute error stays that of
+   the original z, and the error in the sum is relative to that.  */
+
+#define ATAN_HALVINGS_BITS  4
+
+static void
+atan_term (mpz_ptr p, mpz_ptr q, mpz_ptr a, mpz_ptr b,
+	   unsigned long k, const void *data)
+{
+  mpz_set (p, (mpz_srcptr) data);
+  mpz_set_ui (q, 1);
+  mpz_set_ui (b, 2 * k + 1);
+}
+
+void
+mpf_atan (mpf_ptr r, mpf_srcptr x)
+{
+  struct bsplit_series  ser;
+  mpf_t  z, u, v, sum;
+  mpz_t  p, p2;
+  mp_bitcnt_t  wbits, hi, e;
+  signed long  ez;
+  unsigned long  halvings;
+  int  inv;
+
+  if (SIZ (x) == 0)
+    {
+      SIZ (r) = 0;
+      EXP (r) = 0;
+      return;
+    }
+
+  /* all PREC(r)+1 limbs of r, and two guard limbs */
+  wbits = mpf_get_prec (r) + 4 * GMP_NUMB_BITS;
+
+  mpf_init2 (z, wbits);
+  mpf_init2 (u, wbits);
+  mpf_init2 (v, wbits);
+  mpf_init2 (sum, wbits);
+  mpz_init (p);
+  mpz_init (p2);
+
+  mpf_abs (z, x);
+  inv = mpf_cmp_ui (z, 1) > 0;
+  if (inv)
+    mpf_ui_div (z, 1, z);
+
+  halvings = 0;
+  for (;;)
+    {
+      mpf_get_d_2exp (&ez, z);
+      if (ez <= - ATAN_HALVINGS_BITS)
+	break;
+      mpf_mul (u, z, z);
+      mpf_add_ui (u, u, 1);
+      mpf_sqrt (u, u);
+      mpf_add_ui (u, u, 1);
+      mpf_div (z, z, u);
+      halvings++;
+    }
+
+  ser.term = atan_term;
+  ser.data = p2;
+  ser.flags = BSPLIT_B;
+
+  mpf_set_ui (sum, 0);
+  while (SIZ (z) != 0)
+    {
+      mpf_get_d_2exp (&ez, z);
+      if ((mp_bitcnt_t) -ez >= wbits / 2)
+	{
+	  mpf_add (sum, sum, z);
+	  break;
+	}
+
+      hi = 2 * (mp_bitcnt_t) -ez;
+      mpf_mul_2exp (u, z, hi);
+      mpz_set_f (p, u);
+      e = hi - mpz_sizeinbase (p, 2);
+
+      mpz_mul (p2, p, p);
+      mpz_neg (p2, p2);
+      ser.qshift = 2 * hi;
+      mpf_bsplit (u, &ser, 1, (wbits + 1) / (2 * e) + 2);
+      mpf_add_ui (u, u, 1);
+      mpf_set_z (v, p);
+      mpf_div_2exp (v, v, hi);
+      mpf_mul (u, u, v);
+      mpf_add (sum, sum, u);
+
+      /* z = (z - zi) / (1 + z*zi) */
+      mpf_mul (u, z, v);
+      mpf_add_ui (u, u, 1);
+      mpf_sub (z, z, v);
+      mpf_div (z, z, u);
+    }
+
+  mpf_mul_2exp (sum, sum, halvings);
+  if (inv)
+    {
+      mpf_const_pi (u);
+      mpf_div_2exp (u, u, 1);
+      mpf_sub (sum, u, sum);
+    }
+  if (SIZ (x) < 0)
+    mpf_neg (r, sum);
+  else
+    mpf_set (r, sum);
+
+  mpf_clear (z);
+  mpf_clear (u);
+  mpf_clear (v);
+  mpf_clear (sum);
+  mpz_clear (p);
+  mpz_clear (p2);
+}
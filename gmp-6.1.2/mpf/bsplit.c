@@ -0,0 +1,209 @@
+/* mpf_bsplit -- sum a hypergeometric-type series by binary splitting.
+
+THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.
+IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
+IN FACT, IT IS ALMOST GUARANTEED THAT IT WILL CHANGE OR
+DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The range n1 <= k < n2 of the series gives integers P, Q, B and T with
+
+       P = p(n1) * ... * p(n2-1)
+       Q = q(n1) * ... * q(n2-1)
+       B = b(n1) * ... * b(n2-1)
+       T / (B * Q * 2^(qshift*(n2-n1))) = the sum over the range
+
+   and splitting at m, with 1 for [n1,m) and 2 for [m,n2),
+
+       P = P1 * P2,   Q = Q1 * Q2,   B = B1 * B2,
+       T = B2 * Q2 * 2^(qshift*(n2-m)) * T1 + B1 * P1 * T2.
+
+   The halves are of about equal size, so the products at the top of the
+   tree are balanced and get the full benefit of toom and FFT
+   multiplication, for O(M(n) log n) overall.  Those two halves are
+   independent, and with a parallel function they're done at the same time.
+
+   P is only needed for the left half of a split, so NEED_P is 0 down the
+   right edge of the tree, saving the largest of the P products.  B is
+   NULL when the series has no b(k).  */
+
+struct bsplit_par
+{
+  mpz_ptr P, Q, B, T;
+  unsigned long n1, n2;
+  int need_p;
+  const struct bsplit_series *s;
+};
+
+static void bsplit (mpz_ptr, mpz_ptr, mpz_ptr, mpz_ptr,
+		    unsigned long, unsigned long, int,
+		    const struct bsplit_series *);
+
+static void
+bsplit_task (void *data, int i)
+{
+  struct bsplit_par *d = (struct bsplit_par *) data + i;
+  bsplit (d->P, d->Q, d->B, d->T, d->n1, d->n2, d->need_p, d->s);
+}
+
+static void
+bsplit (mpz_ptr P, mpz_ptr Q, mpz_ptr B, mpz_ptr T,
+	unsigned long n1, unsigned long n2, int need_p,
+	const struct bsplit_series *s)
+{
+  mpz_t P2, Q2, B2, T2;
+  mpz_ptr b2;
+  unsigned long m;
+
+  ASSERT (n2 > n1);
+
+  if (n2 - n1 == 1)
+    {
+      if (s->flags & BSPLIT_A)
+	{
+	  (*s->term) (P, Q, T, B, n1, s->data);
+	  mpz_mul (T, T, P);
+	}
+      else
+	{
+	  (*s->term) (P, Q, NULL, B, n1, s->data);
+	  mpz_set (T, P);
+	}
+      return;
+    }
+
+  m = n1 + (n2 - n1) / 2;
+
+  mpz_init (P2);
+  mpz_init (Q2);
+  mpz_init (T2);
+  b2 = NULL;
+  if (B != NULL)
+    {
+      mpz_init (B2);
+      b2 = B2;
+    }
+
+  if (MPN_PARALLEL_P (n2 - n1, BSPLIT_PARALLEL_THRESHOLD))
+    {
+      struct bsplit_par par[2];
+
+      par[0].P = P;
+      par[0].Q = Q;
+      par[0].B = B;
+      par[0].T = T;
+      par[0].n1 = n1;
+      par[0].n2 = m;
+      par[0].need_p = 1;
+      par[0].s = s;
+      par[1].P = P2;
+      par[1].Q = Q2;
+      par[1].B = b2;
+      par[1].T = T2;
+      par[1].n1 = m;
+      par[1].n2 = n2;
+      par[1].need_p = need_p;
+      par[1].s = s;
+      MPN_PARALLEL_RUN (bsplit_task, par, 2);
+    }
+  else
+    {
+      bsplit (P, Q, B, T, n1, m, 1, s);
+      bsplit (P2, Q2, b2, T2, m, n2, need_p, s);
+    }
+
+  mpz_mul (T, T, Q2);
+  mpz_mul_2exp (T, T, s->qshift * (n2 - m));
+  mpz_mul (T2, T2, P);
+  if (B != NULL)
+    {
+      mpz_mul (T, T, B2);
+      mpz_mul (T2, T2, B);
+      mpz_mul (B, B, B2);
+      mpz_clear (B2);
+    }
+  mpz_add (T, T, T2);
+  mpz_mul (Q, Q, Q2);
+  if (need_p)
+    mpz_mul (P, P, P2);
+
+  mpz_clear (P2);
+  mpz_clear (Q2);
+  mpz_clear (T2);
+}
+
+/* Set r to the sum of series S over n1 <= k < n2, to the precision of r.
+   The only rounding is in the final division, so the result is good to
+   about one unit in the last limb.  */
+void
+mpf_bsplit (mpf_ptr r, const struct bsplit_series *s,
+	    unsigned long n1, unsigned long n2)
+{
+  mpz_t P, Q, B, T;
+  mpf_t t, u;
+
+  if (n2 <= n1)
+    {
+      SIZ (r) = 0;
+      EXP (r) = 0;
+      return;
+    }
+
+  mpz_init (P);
+  mpz_init (Q);
+  mpz_init (T);
+  if (s->flags & BSPLIT_B)
+    {
+      mpz_init (B);
+      bsplit (P, Q, B, T, n1, n2, 0, s);
+      mpz_mul (Q, Q, B);
+      mpz_clear (B);
+    }
+  else
+    bsplit (P, Q, NULL, T, n1, n2, 0, s);
+
+  mpf_init2 (t, mpf_get_prec (r));
+  mpf_init2 (u, mpf_get_prec (r));
+  mpf_set_z (t, T);
+  mpf_set_z (u, Q);
+  mpf_div (r, t, u);
+  mpf_div_2exp (r, r, s->qshift * (n2 - n1));
+
+  mpf_clear (t);
+  mpf_clear (u);
+  mpz_clear (P);
+  mpz_clear (Q);
+  mpz_clear (T);
+}
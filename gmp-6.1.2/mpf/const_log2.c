@@ -0,0 +1,81 @@
+/* mpf_const_log2 -- set an mpf to log(2).
+
+THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.
+IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
+IN FACT, IT IS ALMOST GUARANTEED THAT IT WILL CHANGE OR
+DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The series
+
+                    3   inf          (k!)^2
+         log(2)  =  -   sum  (-1)^k ------------
+                    4   k=0         2^k (2k+1)!
+
+   has term ratio -k / (4 * (2k+1)), less than 1/8, so 3 bits per term.
+   mpf_bsplit sums k >= 1 with p(k) = -k, q(k) = 2k+1 and the 4 as a shift,
+   then log(2) = 3/4 * (1 + sum).  The terms alternate, so stopping at term
+   n leaves an error less than term n.  */
+
+static void
+log2_term (mpz_ptr p, mpz_ptr q, mpz_ptr a, mpz_ptr b,
+	   unsigned long k, const void *data)
+{
+  mpz_set_si (p, - (long) k);
+  mpz_set_ui (q, 2 * k + 1);
+}
+
+void
+mpf_const_log2 (mpf_ptr r)
+{
+  struct bsplit_series  s;
+  mpf_t  t;
+  mp_bitcnt_t  prec;
+
+  prec = mpf_get_prec (r) + 3 * GMP_NUMB_BITS;
+  mpf_init2 (t, prec);
+
+  s.term = log2_term;
+  s.data = NULL;
+  s.qshift = 2;
+  s.flags = 0;
+  mpf_bsplit (t, &s, 1, prec / 3 + 2);
+  mpf_add_ui (t, t, 1);
+  mpf_mul_ui (t, t, 3);
+  mpf_div_2exp (t, t, 2);
+  mpf_set (r, t);
+
+  mpf_clear (t);
+}
@@ -0,0 +1,104 @@
+/* mpf_const_pi -- set an mpf to pi.
+
+THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.
+IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
+IN FACT, IT IS ALMOST GUARANTEED THAT IT WILL CHANGE OR
+DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The Chudnovsky series
+
+              1       12   inf   (-1)^k (6k)! (13591409 + 545140134 k)
+             --  =  ------ sum  ---------------------------------------
+             pi     C^3/2  k=0      (3k)! (k!)^3 C^3k
+
+   with C = 640320, gives about 47.11 bits per term.  The ratio of term k to
+   term k-1 is p(k)/q(k) below, with C^3/24 = 640320^2 * 26680, so after
+   summing k >= 1 with mpf_bsplit
+
+       pi = 426880 * sqrt(10005) / (13591409 + sum).
+
+   The terms alternate and decrease, so the error from stopping at term n
+   is less than term n.  The few roundings are covered by a guard limb.  */
+
+#define CHUDNOVSKY_BITS_PER_TERM  47
+
+static void
+chudnovsky_term (mpz_ptr p, mpz_ptr q, mpz_ptr a, mpz_ptr b,
+		 unsigned long k, const void *data)
+{
+  mpz_set_ui (p, 6 * k - 5);
+  mpz_mul_ui (p, p, 2 * k - 1);
+  mpz_mul_ui (p, p, 6 * k - 1);
+  mpz_neg (p, p);
+
+  mpz_set_ui (q, k);
+  mpz_mul_ui (q, q, k);
+  mpz_mul_ui (q, q, k);
+  mpz_mul_ui (q, q, 26680);
+  mpz_mul_ui (q, q, 640320);
+  mpz_mul_ui (q, q, 640320);
+
+  mpz_set_ui (a, 545140134);
+  mpz_mul_ui (a, a, k);
+  mpz_add_ui (a, a, 13591409);
+}
+
+void
+mpf_const_pi (mpf_ptr r)
+{
+  struct bsplit_series  s;
+  mpf_t  t, u;
+  mp_bitcnt_t  prec;
+
+  prec = mpf_get_prec (r) + 3 * GMP_NUMB_BITS;
+  mpf_init2 (t, prec);
+  mpf_init2 (u, prec);
+
+  s.term = chudnovsky_term;
+  s.data = NULL;
+  s.qshift = 0;
+  s.flags = BSPLIT_A;
+  mpf_bsplit (t, &s, 1, prec / CHUDNOVSKY_BITS_PER_TERM + 2);
+  mpf_add_ui (t, t, 13591409);
+
+  mpf_sqrt_ui (u, 10005);
+  mpf_mul_ui (u, u, 426880);
+  mpf_div (t, u, t);
+  mpf_set (r, t);
+
+  mpf_clear (t);
+  mpf_clear (u);
+}
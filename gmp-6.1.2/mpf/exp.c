@@ -0,0 +1,228 @@
+/* mpf_exp -- exponential function.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* For 0 <= y < 1 the bits of y are split into pieces y0 + y1 + ..., with
+   y0 the first EXP_FIRST_BITS bits after the point and each following
+   piece taking as many bits again as all those before it, so yi = p/2^hi
+   with p < 2^(hi/2), and exp(y) is the product of the exp(yi).
+
+   Each exp(yi) - 1 is a series for mpf_bsplit with p(k) = p, q(k) = k and
+   2^hi as the shift.  A piece below 2^-e needs about n terms where
+   n*e + log2(n!) reaches the precision, so the product of the p(k) has
+   about the bits of the precision, whichever the piece.  Each series is
+   then O(M(n) log n) and there are O(log n) of them.  This is Brent's
+   bit-burst method.
+
+   The error in each piece is less than 2^-bits relative, the terms
+   decreasing by at least half from k=1.  The dozen or so roundings per
+   piece are well inside the two guard limbs mpf_exp allows.  */
+
+#define EXP_FIRST_BITS  8
+
+static void
+exp_term (mpz_ptr p, mpz_ptr q, mpz_ptr a, mpz_ptr b,
+	  unsigned long k, const void *data)
+{
+  mpz_set (p, (mpz_srcptr) data);
+  mpz_set_ui (q, k);
+}
+
+/* Number of terms for exp(x) - 1 with x < 2^-e.  */
+static unsigned long
+exp_terms (mp_bitcnt_t e, mp_bitcnt_t bits)
+{
+  unsigned long  n;
+  mp_bitcnt_t  acc;
+  int  lg;
+
+  n = 0;
+  acc = 0;
+  lg = 0;
+  while (acc < bits)
+    {
+      n++;
+      if ((n >> lg) > 1)
+	lg++;
+      acc += e + lg;
+    }
+  return n;
+}
+
+/* Set r to exp(y), for 0 <= y < 1, at the precision of r.  */
+static void
+exp_kernel (mpf_ptr r, mpf_srcptr y)
+{
+  struct bsplit_series  s;
+  mpz_t  Y, p;
+  mpf_t  u;
+  mp_bitcnt_t  bits, lo, hi, e;
+
+  bits = mpf_get_prec (r) + 2 * GMP_NUMB_BITS;
+
+  mpz_init (Y);
+  mpz_init (p);
+  mpf_init2 (u, bits);
+
+  mpf_mul_2exp (u, y, bits);
+  mpz_set_f (Y, u);
+
+  s.term = exp_term;
+  s.data = p;
+  s.flags = 0;
+
+  mpf_set_ui (r, 1);
+  for (lo = 0, hi = EXP_FIRST_BITS; lo < bits; lo = hi, hi *= 2)
+    {
+      hi = MIN (hi, bits);
+      mpz_tdiv_q_2exp (p, Y, bits - hi);
+      mpz_tdiv_r_2exp (p, p, hi - lo);
+      if (mpz_sgn (p) == 0)
+	continue;
+
+      e = hi - mpz_sizeinbase (p, 2);
+      s.qshift = hi;
+      mpf_bsplit (u, &s, 1, exp_terms (e, bits + 1) + 1);
+      mpf_add_ui (u, u, 1);
+      mpf_mul (r, r, u);
+    }
+
+  mpz_clear (Y);
+  mpz_clear (p);
+  mpf_clear (u);
+}
+
+/* Most of the range goes through x = n*log(2) + y with 0 <= y < log(2),
+   exp(x) being exp(y) * 2^n.  The absolute error in y is what matters, so
+   log(2) gets the bits of n beyond the working precision.  n is first
+   found from a short division, which can be out by one either way.
+
+   |x| < 1 goes straight to exp_kernel, negatives by way of 1/exp(-x).
+   That's how mpf_log calls it, and there's no need for log(2) then.
+
+   A result whose exponent in bits would not fit a long is an overflow, or
+   is underflowed to zero for x negative.  */
+
+void
+mpf_exp (mpf_ptr r, mpf_srcptr x)
+{
+  mpf_t  t, y, l;
+  mp_bitcnt_t  wbits, lbits;
+  long  n;
+
+  if (SIZ (x) == 0)
+    {
+      mpf_set_ui (r, 1);
+      return;
+    }
+
+  /* all PREC(r)+1 limbs of r, and two guard limbs */
+  wbits = mpf_get_prec (r) + 4 * GMP_NUMB_BITS;
+
+  if (EXP (x) <= 0)
+    {
+      mpf_init2 (t, wbits);
+      mpf_init2 (y, wbits);
+      mpf_abs (y, x);
+      exp_kernel (t, y);
+      if (SIZ (x) < 0)
+	mpf_ui_div (t, 1, t);
+      mpf_set (r, t);
+      mpf_clear (t);
+      mpf_clear (y);
+      return;
+    }
+
+  if (EXP (x) > 2)
+    goto out_of_range;
+
+  lbits = wbits + EXP (x) * GMP_NUMB_BITS;
+  mpf_init2 (t, (EXP (x) + 1) * GMP_NUMB_BITS);
+  mpf_init2 (y, lbits);
+  mpf_init2 (l, lbits);
+  mpf_const_log2 (l);
+
+  mpf_div (t, x, l);
+  mpf_floor (t, t);
+  if (mpf_cmp_si (t, LONG_MAX / 2) > 0 || mpf_cmp_si (t, - (LONG_MAX / 2)) < 0)
+    {
+      mpf_clear (t);
+      mpf_clear (y);
+      mpf_clear (l);
+      goto out_of_range;
+    }
+  n = mpf_get_si (t);
+
+  if (n >= 0)
+    mpf_mul_ui (y, l, n);
+  else
+    {
+      mpf_mul_ui (y, l, -n);
+      mpf_neg (y, y);
+    }
+  mpf_sub (y, x, y);
+  while (SIZ (y) < 0)
+    {
+      mpf_add (y, y, l);
+      n--;
+    }
+  while (mpf_cmp (y, l) >= 0)
+    {
+      mpf_sub (y, y, l);
+      n++;
+    }
+
+  mpf_set_prec (t, wbits);
+  exp_kernel (t, y);
+  if (n >= 0)
+    mpf_mul_2exp (t, t, n);
+  else
+    mpf_div_2exp (t, t, -n);
+  mpf_set (r, t);
+
+  mpf_clear (t);
+  mpf_clear (y);
+  mpf_clear (l);
+  return;
+
+ out_of_range:
+  if (SIZ (x) > 0)
+    {
+      fprintf (stderr, "gmp: overflow in mpf_exp\n");
+      abort ();
+    }
+  SIZ (r) = 0;
+  EXP (r) = 0;
+}
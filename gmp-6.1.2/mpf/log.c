@@ -0,0 +1,159 @@
+/* mpf_log -- natural logarithm.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* x = m * 2^e with sqrt(1/2) <= m < sqrt(2), and log(x) = log(m) + e*log(2).
+   log(m) is the root of exp(y) = m, found by the Newton iteration
+
+       y' = y + m * exp(-y) - 1
+
+   which takes an error d to about d^2/2.  Each step is done at just over
+   half the precision of the next, so the whole costs about two mpf_exp at
+   the full precision, all with |y| < 1 and so no log(2) needed in mpf_exp.
+
+   The steps start from y = m-1, within 0.09 of log(m), and the first
+   LOG_START_STEPS of them at LOG_START_BITS bring that below 2^-200.
+
+   For m close to 1 the absolute error of the iteration is relative to
+   log(m), so the bits lost there are added to the precision.  m-1 is
+   exact, m having at least the limbs of x plus one.  When e != 0 there's
+   no such loss, |log(m)| < log(2)/2 <= |e*log(2)|/2.  */
+
+#define LOG_START_BITS   (2 * GMP_NUMB_BITS)
+#define LOG_START_STEPS  7
+
+void
+mpf_log (mpf_ptr r, mpf_srcptr x)
+{
+  mpf_t  m, y, t;
+  mp_bitcnt_t  wbits, mbits, precs[BITS_PER_ULONG];
+  signed long  e, de;
+  double  d;
+  int  i, np;
+
+  if (SIZ (x) <= 0)
+    {
+      if (SIZ (x) == 0)
+	DIVIDE_BY_ZERO;
+      SQRT_OF_NEGATIVE;
+    }
+
+  /* all PREC(r)+1 limbs of r, and two guard limbs */
+  wbits = mpf_get_prec (r) + 4 * GMP_NUMB_BITS;
+
+  d = mpf_get_d_2exp (&e, x);
+  if (d < 0.7071067811865476)
+    e--;
+
+  mbits = MAX (wbits, (ABSIZ (x) + 1) * GMP_NUMB_BITS);
+  mpf_init2 (m, mbits);
+  if (e >= 0)
+    mpf_div_2exp (m, x, e);
+  else
+    mpf_mul_2exp (m, x, -e);
+
+  mpf_init2 (y, mbits);
+  mpf_sub_ui (y, m, 1);
+  if (e == 0)
+    {
+      if (SIZ (y) == 0)
+	{
+	  /* x == 1 */
+	  SIZ (r) = 0;
+	  EXP (r) = 0;
+	  mpf_clear (m);
+	  mpf_clear (y);
+	  return;
+	}
+      mpf_get_d_2exp (&de, y);
+      if (de < 0)
+	wbits -= de;
+    }
+
+  /* the step precisions, from the last down */
+  np = 0;
+  do
+    {
+      precs[np++] = wbits;
+      wbits = wbits / 2 + GMP_NUMB_BITS / 4;
+    }
+  while (wbits > LOG_START_BITS);
+
+  mpf_set_prec (y, precs[0]);
+  mpf_init2 (t, precs[0]);
+
+  mpf_set_prec_raw (y, LOG_START_BITS);
+  mpf_set_prec_raw (t, LOG_START_BITS);
+  for (i = 0; i < LOG_START_STEPS; i++)
+    {
+      mpf_neg (t, y);
+      mpf_exp (t, t);
+      mpf_mul (t, t, m);
+      mpf_sub_ui (t, t, 1);
+      mpf_add (y, y, t);
+    }
+
+  for (i = np - 1; i >= 0; i--)
+    {
+      mpf_set_prec_raw (y, precs[i]);
+      mpf_set_prec_raw (t, precs[i]);
+      mpf_neg (t, y);
+      mpf_exp (t, t);
+      mpf_mul (t, t, m);
+      mpf_sub_ui (t, t, 1);
+      mpf_add (y, y, t);
+    }
+
+  if (e == 0)
+    mpf_set (r, y);
+  else
+    {
+      mpf_set_prec_raw (t, precs[0]);
+      mpf_const_log2 (t);
+      if (e > 0)
+	mpf_mul_ui (t, t, e);
+      else
+	{
+	  mpf_mul_ui (t, t, -e);
+	  mpf_neg (t, t);
+	}
+      mpf_add (t, y, t);
+      mpf_set (r, t);
+    }
+
+  mpf_set_prec_raw (y, precs[0]);
+  mpf_set_prec_raw (t, precs[0]);
+  mpf_clear (m);
+  mpf_clear (y);
+  mpf_clear (t);
+}
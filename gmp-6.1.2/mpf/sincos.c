@@ -0,0 +1,275 @@
+/* mpf_sin, mpf_cos -- sine and cosine.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h> /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* For 0 < y < 1 the bits of y are split into pieces y0 + y1 + ... as in
+   mpf_exp, the first SINCOS_FIRST_BITS bits and then doubling, and sin and
+   cos of the pieces are combined with
+
+       sin(a+b) = sin(a) cos(b) + cos(a) sin(b)
+       cos(a+b) = cos(a) cos(b) - sin(a) sin(b)
+
+   sin(yi)/yi - 1 is a series for mpf_bsplit with p(k) = -p^2,
+   q(k) = 2k*(2k+1) and 2^(2*hi) as the shift, and cos(yi) is
+   sqrt(1 - sin(yi)^2), which loses nothing with yi < 1.  All the terms in
+   the combining are positive, bar cos(a)*cos(b) - sin(a)*sin(b) which is
+   at least cos(1), so the relative error stays small.
+
+   The fixed point form of y has the bits of the precision below its
+   leading 1 bit, so a small y keeps the relative accuracy of sin(y).  */
+
+#define SINCOS_FIRST_BITS  8
+
+static void
+sin_term (mpz_ptr p, mpz_ptr q, mpz_ptr a, mpz_ptr b,
+	  unsigned long k, const void *data)
+{
+  mpz_set (p, (mpz_srcptr) data);
+  mpz_set_ui (q, 2 * k);
+  mpz_mul_ui (q, q, 2 * k + 1);
+}
+
+/* Number of terms for sin(x)/x - 1 with x < 2^-e.  */
+static unsigned long
+sin_terms (mp_bitcnt_t e, mp_bitcnt_t bits)
+{
+  unsigned long  n;
+  mp_bitcnt_t  acc;
+  int  lg;
+
+  n = 0;
+  acc = 0;
+  lg = 0;
+  while (acc < bits)
+    {
+      n++;
+      if ((2 * n >> lg) > 1)
+	lg++;
+      acc += 2 * e + 2 * lg;
+    }
+  return n;
+}
+
+/* Set s to sin(y) and c to cos(y), for 0 < y < 1, at the precision of s.  */
+static void
+sincos_kernel (mpf_ptr s, mpf_ptr c, mpf_srcptr y)
+{
+  struct bsplit_series  ser;
+  mpz_t  Y, p, p2;
+  mpf_t  u, v, w;
+  mp_bitcnt_t  bits, fbits, lo, hi, e;
+  signed long  ey;
+  int  first;
+
+  bits = mpf_get_prec (s) + 2 * GMP_NUMB_BITS;
+  mpf_get_d_2exp (&ey, y);
+  fbits = bits - ey;
+
+  mpz_init (Y);
+  mpz_init (p);
+  mpz_init (p2);
+  mpf_init2 (u, bits);
+  mpf_init2 (v, bits);
+  mpf_init2 (w, bits);
+
+  mpf_mul_2exp (u, y, fbits);
+  mpz_set_f (Y, u);
+
+  ser.term = sin_term;
+  ser.data = p2;
+  ser.flags = 0;
+
+  first = 1;
+  for (lo = 0, hi = SINCOS_FIRST_BITS; lo < fbits; lo = hi, hi *= 2)
+    {
+      hi = MIN (hi, fbits);
+      mpz_tdiv_q_2exp (p, Y, fbits - hi);
+      mpz_tdiv_r_2exp (p, p, hi - lo);
+      if (mpz_sgn (p) == 0)
+	continue;
+
+      e = hi - mpz_sizeinbase (p, 2);
+      mpz_mul (p2, p, p);
+      mpz_neg (p2, p2);
+      ser.qshift = 2 * hi;
+      mpf_bsplit (u, &ser, 1, sin_terms (e, bits + 1) + 1);
+      mpf_add_ui (u, u, 1);
+      mpf_set_z (v, p);
+      mpf_mul (u, u, v);
+      mpf_div_2exp (u, u, hi);
+
+      /* v = cos(yi) */
+      mpf_mul (v, u, u);
+      mpf_ui_sub (v, 1, v);
+      mpf_sqrt (v, v);
+
+      if (first)
+	{
+	  mpf_swap (s, u);
+	  mpf_swap (c, v);
+	  first = 0;
+	}
+      else
+	{
+	  mpf_mul (w, s, u);
+	  mpf_mul (s, s, v);
+	  mpf_mul (u, c, u);
+	  mpf_add (s, s, u);
+	  mpf_mul (c, c, v);
+	  mpf_sub (c, c, w);
+	}
+    }
+  ASSERT (! first);
+
+  mpz_clear (Y);
+  mpz_clear (p);
+  mpz_clear (p2);
+  mpf_clear (u);
+  mpf_clear (v);
+  mpf_clear (w);
+}
+
+/* Set s to sin(x) and c to cos(x), either may be NULL.  |x| >= 1 is
+   reduced to y = x - k*pi/2 with k the nearest integer, so |y| <= pi/4.
+   pi gets the bits of k beyond the working precision, and if y comes out
+   small then its leading bits were lost to cancellation and the reduction
+   is done again with that many more.  */
+static void
+mpf_sincos_reduced (mpf_ptr sr, mpf_ptr cr, mpf_srcptr x)
+{
+  mpf_t  s, c, y, h, t;
+  mpz_t  k;
+  mp_bitcnt_t  wbits, lbits, extra;
+  signed long  ey;
+  unsigned long  quad;
+  int  neg;
+
+  if (SIZ (x) == 0)
+    {
+      if (sr != NULL)
+	mpf_set_ui (sr, 0);
+      if (cr != NULL)
+	mpf_set_ui (cr, 1);
+      return;
+    }
+
+  /* all PREC+1 limbs of the results, and two guard limbs */
+  wbits = mpf_get_prec (sr != NULL ? sr : cr) + 4 * GMP_NUMB_BITS;
+  if (sr != NULL && cr != NULL)
+    wbits = MAX (wbits, mpf_get_prec (cr) + 4 * GMP_NUMB_BITS);
+
+  mpf_init2 (y, wbits);
+  quad = 0;
+  if (EXP (x) <= 0)
+    mpf_set (y, x);
+  else
+    {
+      mpz_init (k);
+      mpf_init2 (h, wbits);
+      mpf_init2 (t, wbits);
+      extra = GMP_NUMB_BITS;
+      for (;;)
+	{
+	  lbits = wbits + EXP (x) * GMP_NUMB_BITS + extra;
+	  mpf_set_prec (h, lbits);
+	  mpf_set_prec (t, lbits);
+	  mpf_set_prec (y, lbits);
+	  mpf_const_pi (h);
+	  mpf_div_2exp (h, h, 1);
+
+	  mpf_div (t, x, h);
+	  mpf_set_d (y, 0.5);
+	  mpf_add (t, t, y);
+	  mpf_floor (t, t);
+	  mpz_set_f (k, t);
+
+	  mpf_set_z (t, k);
+	  mpf_mul (t, t, h);
+	  mpf_sub (y, x, t);
+
+	  if (SIZ (y) != 0)
+	    {
+	      mpf_get_d_2exp (&ey, y);
+	      if (ey >= 0 || (mp_bitcnt_t) -ey < extra)
+		break;
+	    }
+	  extra = 2 * extra + (SIZ (y) != 0 ? -ey : 0);
+	}
+      quad = mpz_fdiv_ui (k, 4);
+      mpz_clear (k);
+      mpf_clear (h);
+      mpf_clear (t);
+    }
+
+  neg = SIZ (y) < 0;
+  mpf_init2 (s, wbits);
+  mpf_init2 (c, wbits);
+  mpf_abs (y, y);
+  sincos_kernel (s, c, y);
+  if (neg)
+    mpf_neg (s, s);
+
+  /* sin(y + k*pi/2), cos(y + k*pi/2) */
+  if (quad & 1)
+    {
+      mpf_swap (s, c);
+      mpf_neg (c, c);
+    }
+  if (quad & 2)
+    {
+      mpf_neg (s, s);
+      mpf_neg (c, c);
+    }
+
+  if (sr != NULL)
+    mpf_set (sr, s);
+  if (cr != NULL)
+    mpf_set (cr, c);
+
+  mpf_clear (s);
+  mpf_clear (c);
+  mpf_clear (y);
+}
+
+void
+mpf_sin (mpf_ptr r, mpf_srcptr x)
+{
+  mpf_sincos_reduced (r, NULL, x);
+}
+
+void
+mpf_cos (mpf_ptr r, mpf_srcptr x)
+{
+  mpf_sincos_reduced (NULL, r, x);
+}
@@ -197,6 +197,8 @@ mpn_gcd (mp_ptr gp, mp_ptr up, mp_size_t usize, mp_ptr vp, mp_size_t n)
 	}
     }
 
+  GMP_STATS_COUNT (ABOVE_THRESHOLD (n, GCD_DC_THRESHOLD)
+		   ? GMP_STATS_GCD_DC : GMP_STATS_GCD_LEHMER, n);
   ctx.gp = gp;
 
 #if TUNE_GCD_P
@@ -121,6 +121,7 @@ mpn_div_q (mp_ptr qp,
 
   if (dn == 1)
     {
+      GMP_STATS_COUNT (GMP_STATS_DIV_Q_1, nn);
       mpn_divrem_1 (qp, 0L, np, nn, dp[dn - 1]);
       return;
     }
@@ -147,12 +148,14 @@ mpn_div_q (mp_ptr qp,
 
 	  if (dn == 2)
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_2, nn);
 	      qh = mpn_divrem_2 (qp, 0L, new_np, new_nn, new_dp);
 	    }
 	  else if (BELOW_THRESHOLD (dn, DC_DIV_Q_THRESHOLD) ||
 		   BELOW_THRESHOLD (new_nn - dn, DC_DIV_Q_THRESHOLD))
 	    {
 	      invert_pi1 (dinv, new_dp[dn - 1], new_dp[dn - 2]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_SBPI1, dn);
 	      qh = mpn_sbpi1_div_q (qp, new_np, new_nn, new_dp, dn, dinv.inv32);
 	    }
 	  else if (BELOW_THRESHOLD (dn, MUPI_DIV_Q_THRESHOLD) ||   /* fast condition */
@@ -161,12 +164,14 @@ mpn_div_q (mp_ptr qp,
 		   + (double) MUPI_DIV_Q_THRESHOLD * nn > (double) dn * nn)   /* ...condition */
 	    {
 	      invert_pi1 (dinv, new_dp[dn - 1], new_dp[dn - 2]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_DCPI1, dn);
 	      qh = mpn_dcpi1_div_q (qp, new_np, new_nn, new_dp, dn, &dinv);
 	    }
 	  else
 	    {
 	      mp_size_t itch = mpn_mu_div_q_itch (new_nn, dn, 0);
 	      mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_MU, dn);
 	      qh = mpn_mu_div_q (qp, new_np, new_nn, new_dp, dn, scratch);
 	    }
 	  if (cy == 0)
@@ -189,12 +194,14 @@ mpn_div_q (mp_ptr qp,
 
 	  if (dn == 2)
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_2, nn);
 	      qh = mpn_divrem_2 (qp, 0L, new_np, nn, dp);
 	    }
 	  else if (BELOW_THRESHOLD (dn, DC_DIV_Q_THRESHOLD) ||
 		   BELOW_THRESHOLD (nn - dn, DC_DIV_Q_THRESHOLD))
 	    {
 	      invert_pi1 (dinv, dh, dp[dn - 2]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_SBPI1, dn);
 	      qh = mpn_sbpi1_div_q (qp, new_np, nn, dp, dn, dinv.inv32);
 	    }
 	  else if (BELOW_THRESHOLD (dn, MUPI_DIV_Q_THRESHOLD) ||   /* fast condition */
@@ -203,12 +210,14 @@ mpn_div_q (mp_ptr qp,
 		   + (double) MUPI_DIV_Q_THRESHOLD * nn > (double) dn * nn)   /* ...condition */
 	    {
 	      invert_pi1 (dinv, dh, dp[dn - 2]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_DCPI1, dn);
 	      qh = mpn_dcpi1_div_q (qp, new_np, nn, dp, dn, &dinv);
 	    }
 	  else
 	    {
 	      mp_size_t itch = mpn_mu_div_q_itch (nn, dn, 0);
 	      mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_MU, dn);
 	      qh = mpn_mu_div_q (qp, np, nn, dp, dn, scratch);
 	    }
 	  qp[nn - dn] = qh;
@@ -244,22 +253,26 @@ mpn_div_q (mp_ptr qp,
 
 	  if (qn + 1 == 2)
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_2, new_nn);
 	      qh = mpn_divrem_2 (tp, 0L, new_np, new_nn, new_dp);
 	    }
 	  else if (BELOW_THRESHOLD (qn, DC_DIVAPPR_Q_THRESHOLD - 1))
 	    {
 	      invert_pi1 (dinv, new_dp[qn], new_dp[qn - 1]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_SBPI1_APPR, qn + 1);
 	      qh = mpn_sbpi1_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, dinv.inv32);
 	    }
 	  else if (BELOW_THRESHOLD (qn, MU_DIVAPPR_Q_THRESHOLD - 1))
 	    {
 	      invert_pi1 (dinv, new_dp[qn], new_dp[qn - 1]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_DCPI1_APPR, qn + 1);
 	      qh = mpn_dcpi1_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, &dinv);
 	    }
 	  else
 	    {
 	      mp_size_t itch = mpn_mu_divappr_q_itch (new_nn, qn + 1, 0);
 	      mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_MU_APPR, qn + 1);
 	      qh = mpn_mu_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, scratch);
 	    }
 	  if (cy == 0)
@@ -283,22 +296,26 @@ mpn_div_q (mp_ptr qp,
 
 	  if (qn == 2 - 1)
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_2, new_nn);
 	      qh = mpn_divrem_2 (tp, 0L, new_np, new_nn, new_dp);
 	    }
 	  else if (BELOW_THRESHOLD (qn, DC_DIVAPPR_Q_THRESHOLD - 1))
 	    {
 	      invert_pi1 (dinv, dh, new_dp[qn - 1]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_SBPI1_APPR, qn + 1);
 	      qh = mpn_sbpi1_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, dinv.inv32);
 	    }
 	  else if (BELOW_THRESHOLD (qn, MU_DIVAPPR_Q_THRESHOLD - 1))
 	    {
 	      invert_pi1 (dinv, dh, new_dp[qn - 1]);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_DCPI1_APPR, qn + 1);
 	      qh = mpn_dcpi1_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, &dinv);
 	    }
 	  else
 	    {
 	      mp_size_t itch = mpn_mu_divappr_q_itch (new_nn, qn + 1, 0);
 	      mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
+	      GMP_STATS_COUNT (GMP_STATS_DIV_Q_MU_APPR, qn + 1);
 	      qh = mpn_mu_divappr_q (tp, new_np, new_nn, new_dp, qn + 1, scratch);
 	    }
 	  tp[qn] = qh;
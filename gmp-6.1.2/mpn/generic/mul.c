@@ -134,6 +134,7 @@ mpn_mul (mp_ptr prodp,
     }
   else if (vn < MUL_TOOM22_THRESHOLD)
     { /* plain schoolbook multiplication */
+      GMP_STATS_COUNT (GMP_STATS_MUL_BASECASE, vn);
 
       /* Unless un is very large, or else if have an applicable mpn_mul_N,
 	 perform basecase multiply directly.  */
@@ -209,6 +210,8 @@ mpn_mul (mp_ptr prodp,
       mp_ptr scratch;
       TMP_SDECL; TMP_SMARK;
 
+      GMP_STATS_COUNT (GMP_STATS_MUL_TOOMX2, vn);
+
 #define ITCH_TOOMX2 (9 * vn / 2 + GMP_NUMB_BITS * 2)
       scratch = TMP_SALLOC_LIMBS (ITCH_TOOMX2);
       ASSERT (mpn_toom22_mul_itch ((5*vn-1)/4, vn) <= ITCH_TOOMX2); /* 5vn/2+ */
@@ -281,6 +284,8 @@ mpn_mul (mp_ptr prodp,
 	  mp_ptr scratch;
 	  TMP_DECL; TMP_MARK;
 
+	  GMP_STATS_COUNT (GMP_STATS_MUL_TOOMX3, vn);
+
 #define ITCH_TOOMX3 (4 * vn + GMP_NUMB_BITS)
 	  scratch = TMP_ALLOC_LIMBS (ITCH_TOOMX3);
 	  ASSERT (mpn_toom33_mul_itch ((7*vn-1)/6, vn) <= ITCH_TOOMX3); /* 7vn/2+ */
@@ -377,16 +382,19 @@ mpn_mul (mp_ptr prodp,
 
 	  if (BELOW_THRESHOLD (vn, MUL_TOOM6H_THRESHOLD))
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_MUL_TOOM44, vn);
 	      scratch = TMP_SALLOC_LIMBS (mpn_toom44_mul_itch (un, vn));
 	      mpn_toom44_mul (prodp, up, un, vp, vn, scratch);
 	    }
 	  else if (BELOW_THRESHOLD (vn, MUL_TOOM8H_THRESHOLD))
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_MUL_TOOM6H, vn);
 	      scratch = TMP_SALLOC_LIMBS (mpn_toom6h_mul_itch (un, vn));
 	      mpn_toom6h_mul (prodp, up, un, vp, vn, scratch);
 	    }
 	  else
 	    {
+	      GMP_STATS_COUNT (GMP_STATS_MUL_TOOM8H, vn);
 	      scratch = TMP_ALLOC_LIMBS (mpn_toom8h_mul_itch (un, vn));
 	      mpn_toom8h_mul (prodp, up, un, vp, vn, scratch);
 	    }
@@ -395,6 +403,7 @@ mpn_mul (mp_ptr prodp,
     }
   else
     {
+      GMP_STATS_COUNT (GMP_STATS_MUL_FFT, vn);
       if (un >= 8 * vn)
 	{
 	  mp_limb_t cy;
@@ -76,7 +76,8 @@ see https://www.gnu.org/licenses/.  */
 
 static mp_limb_t mpn_mul_fft_internal (mp_ptr, mp_size_t, int, mp_ptr *,
 				       mp_ptr *, mp_ptr, mp_ptr, mp_size_t,
-				       mp_size_t, mp_size_t, int **, mp_ptr, int);
+				       mp_size_t, mp_size_t, int **, mp_ptr, int,
+				       int);
 static void mpn_mul_fft_decompose (mp_ptr, mp_ptr *, mp_size_t, mp_size_t, mp_srcptr,
 				   mp_size_t, mp_size_t, mp_size_t, mp_ptr);
 
@@ -501,7 +502,7 @@ mpn_fft_mul_modF_K (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K)
 	    mpn_mul_fft_decompose (B, Bp, K2, nprime2, *bp, (l << k) + 1, l, Mp2, T);
 
 	  cy = mpn_mul_fft_internal (*ap, n, k, Ap, Bp, A, B, nprime2,
-				     l, Mp2, fft_l, T, sqr);
+				     l, Mp2, fft_l, T, sqr, 1);
 	  (*ap)[n] = cy;
 	}
     }
@@ -583,6 +584,198 @@ mpn_fft_fftinv (mp_ptr *Ap, mp_size_t K, mp_size_t omega, mp_size_t n, mp_ptr tp
 }
 
 
+/* Parallel variants of the transforms and the pointwise products, used by
+   mpn_mul_fft for pl >= FFT_PARALLEL_THRESHOLD when the application has
+   installed a parallel function with mp_set_parallel_function.
+
+   The top d levels of a transform are unrolled: the 2^d independent
+   sub-transforms of size K/2^d are run as separate tasks, then each of the
+   d remaining butterfly levels is split into nthreads contiguous runs of
+   butterflies.  Every butterfly does exactly what the serial code does, on
+   the same operands, so the result is bit-identical to the serial path.
+   Each task gets its own n+1 limb piece of the scratch TP.  */
+
+struct fft_par_t
+{
+  mp_ptr *Ap;
+  mp_ptr *Bp;
+  int **ll;
+  mp_ptr tp;
+  mp_size_t K;
+  mp_size_t omega;
+  mp_size_t n;
+  int level;
+  int ntasks;
+};
+
+/* Number of levels to unroll so there are at least nthreads sub-transforms,
+   keeping the sub-transforms of size >= 2.  */
+static int
+mpn_fft_par_depth (int k, int nthreads)
+{
+  int d;
+  for (d = 0; ((mp_size_t) 1 << d) < nthreads && d < k - 1; d++)
+    ;
+  return d;
+}
+
+static void
+mpn_fft_fft_sub_task (void *data, int s)
+{
+  struct fft_par_t *p = (struct fft_par_t *) data;
+  int d = p->level;
+
+  mpn_fft_fft (p->Ap + s, p->K >> d, p->ll - d, p->omega << d, p->n,
+	       (mp_size_t) 1 << d, p->tp + s * (p->n + 1));
+}
+
+/* Butterflies of level e of the forward transform, i.e. the combining loop
+   of the 2^e sub-transforms of size K/2^e with stride 2^e.  */
+static void
+mpn_fft_fft_level_task (void *data, int t)
+{
+  struct fft_par_t *p = (struct fft_par_t *) data;
+  int e = p->level;
+  mp_size_t inc = (mp_size_t) 1 << e;
+  mp_size_t K2 = (p->K >> e) >> 1;
+  mp_size_t omega = p->omega << e;
+  mp_size_t n = p->n;
+  mp_size_t b, hi;
+  mp_ptr tp = p->tp + t * (n + 1);
+  int *lk = *(p->ll - e);
+
+  b = (p->K >> 1) * t / p->ntasks;
+  hi = (p->K >> 1) * (t + 1) / p->ntasks;
+  for (; b < hi; b++)
+    {
+      mp_size_t s = b / K2, j = b % K2;
+      mp_ptr *Ap = p->Ap + s + 2 * j * inc;
+
+      mpn_fft_mul_2exp_modF (tp, Ap[inc], lk[2 * j] * omega, n);
+      mpn_fft_sub_modF (Ap[inc], Ap[0], tp, n);
+      mpn_fft_add_modF (Ap[0],   Ap[0], tp, n);
+    }
+}
+
+static void
+mpn_fft_fft_par (mp_ptr *Ap, mp_size_t K, int **ll, int k,
+		 mp_size_t omega, mp_size_t n, mp_ptr tp, int nthreads)
+{
+  struct fft_par_t p;
+  int d, e;
+
+  d = mpn_fft_par_depth (k, nthreads);
+
+  p.Ap = Ap;
+  p.ll = ll;
+  p.tp = tp;
+  p.K = K;
+  p.omega = omega;
+  p.n = n;
+  p.level = d;
+  MPN_PARALLEL_RUN (mpn_fft_fft_sub_task, &p, 1 << d);
+
+  p.ntasks = nthreads;
+  for (e = d - 1; e >= 0; e--)
+    {
+      p.level = e;
+      MPN_PARALLEL_RUN (mpn_fft_fft_level_task, &p, nthreads);
+    }
+}
+
+static void
+mpn_fft_fftinv_sub_task (void *data, int s)
+{
+  struct fft_par_t *p = (struct fft_par_t *) data;
+  int d = p->level;
+  mp_size_t Kd = p->K >> d;
+
+  mpn_fft_fftinv (p->Ap + s * Kd, Kd, p->omega << d, p->n,
+		  p->tp + s * (p->n + 1));
+}
+
+/* Butterflies of level e of the inverse transform, i.e. the combining loop
+   of the 2^e contiguous sub-transforms of size K/2^e.  */
+static void
+mpn_fft_fftinv_level_task (void *data, int t)
+{
+  struct fft_par_t *p = (struct fft_par_t *) data;
+  int e = p->level;
+  mp_size_t Ke = p->K >> e;
+  mp_size_t K2 = Ke >> 1;
+  mp_size_t omega = p->omega << e;
+  mp_size_t n = p->n;
+  mp_size_t b, hi;
+  mp_ptr tp = p->tp + t * (n + 1);
+
+  b = (p->K >> 1) * t / p->ntasks;
+  hi = (p->K >> 1) * (t + 1) / p->ntasks;
+  for (; b < hi; b++)
+    {
+      mp_size_t s = b / K2, j = b % K2;
+      mp_ptr *Ap = p->Ap + s * Ke + j;
+
+      mpn_fft_mul_2exp_modF (tp, Ap[K2], j * omega, n);
+      mpn_fft_sub_modF (Ap[K2], Ap[0], tp, n);
+      mpn_fft_add_modF (Ap[0],  Ap[0], tp, n);
+    }
+}
+
+static void
+mpn_fft_fftinv_par (mp_ptr *Ap, mp_size_t K, int k, mp_size_t omega,
+		    mp_size_t n, mp_ptr tp, int nthreads)
+{
+  struct fft_par_t p;
+  int d, e;
+
+  d = mpn_fft_par_depth (k, nthreads);
+
+  p.Ap = Ap;
+  p.tp = tp;
+  p.K = K;
+  p.omega = omega;
+  p.n = n;
+  p.level = d;
+  MPN_PARALLEL_RUN (mpn_fft_fftinv_sub_task, &p, 1 << d);
+
+  p.ntasks = nthreads;
+  for (e = d - 1; e >= 0; e--)
+    {
+      p.level = e;
+      MPN_PARALLEL_RUN (mpn_fft_fftinv_level_task, &p, nthreads);
+    }
+}
+
+static void
+mpn_fft_mul_modF_K_task (void *data, int t)
+{
+  struct fft_par_t *p = (struct fft_par_t *) data;
+  mp_size_t lo, hi;
+
+  lo = p->K * t / p->ntasks;
+  hi = p->K * (t + 1) / p->ntasks;
+  if (hi > lo)
+    mpn_fft_mul_modF_K (p->Ap + lo, p->Bp + lo, p->n, hi - lo);
+}
+
+/* a[i] <- a[i]*b[i] mod 2^(n*GMP_NUMB_BITS)+1 for 0 <= i < K, as nthreads
+   tasks each doing a contiguous run of products.  Each task allocates its
+   own temporaries in mpn_fft_mul_modF_K.  */
+static void
+mpn_fft_mul_modF_K_par (mp_ptr *ap, mp_ptr *bp, mp_size_t n, mp_size_t K,
+			int nthreads)
+{
+  struct fft_par_t p;
+
+  p.Ap = ap;
+  p.Bp = bp;
+  p.n = n;
+  p.K = K;
+  p.ntasks = nthreads;
+  MPN_PARALLEL_RUN (mpn_fft_mul_modF_K_task, &p, nthreads);
+}
+
+
 /* R <- A/2^k mod 2^(n*GMP_NUMB_BITS)+1 */
 static void
 mpn_fft_div_2exp_modF (mp_ptr r, mp_srcptr a, mp_bitcnt_t k, mp_size_t n)
@@ -719,14 +912,15 @@ mpn_mul_fft_decompose (mp_ptr A, mp_ptr *Ap, mp_size_t K, mp_size_t nprime,
 /* op <- n*m mod 2^N+1 with fft of size 2^k where N=pl*GMP_NUMB_BITS
    op is pl limbs, its high bit is returned.
    One must have pl = mpn_fft_next_size (pl, k).
-   T must have space for 2 * (nprime + 1) limbs.
+   T must have space for 2 * (nprime + 1) limbs, and when nthreads > 1 for
+   nprime + 1 limbs per task too, see mpn_mul_fft.
 */
 
 static mp_limb_t
 mpn_mul_fft_internal (mp_ptr op, mp_size_t pl, int k,
 		      mp_ptr *Ap, mp_ptr *Bp, mp_ptr A, mp_ptr B,
 		      mp_size_t nprime, mp_size_t l, mp_size_t Mp,
-		      int **fft_l, mp_ptr T, int sqr)
+		      int **fft_l, mp_ptr T, int sqr, int nthreads)
 {
   mp_size_t K, i, pla, lo, sh, j;
   mp_ptr p;
@@ -734,16 +928,29 @@ mpn_mul_fft_internal (mp_ptr op, mp_size_t pl, int k,
 
   K = (mp_size_t) 1 << k;
 
-  /* direct fft's */
-  mpn_fft_fft (Ap, K, fft_l + k, 2 * Mp, nprime, 1, T);
-  if (!sqr)
-    mpn_fft_fft (Bp, K, fft_l + k, 2 * Mp, nprime, 1, T);
+  if (nthreads > 1)
+    {
+      mpn_fft_fft_par (Ap, K, fft_l + k, k, 2 * Mp, nprime, T, nthreads);
+      if (!sqr)
+	mpn_fft_fft_par (Bp, K, fft_l + k, k, 2 * Mp, nprime, T, nthreads);
+
+      mpn_fft_mul_modF_K_par (Ap, sqr ? Ap : Bp, nprime, K, nthreads);
+
+      mpn_fft_fftinv_par (Ap, K, k, 2 * Mp, nprime, T, nthreads);
+    }
+  else
+    {
+      /* direct fft's */
+      mpn_fft_fft (Ap, K, fft_l + k, 2 * Mp, nprime, 1, T);
+      if (!sqr)
+	mpn_fft_fft (Bp, K, fft_l + k, 2 * Mp, nprime, 1, T);
 
-  /* term to term multiplications */
-  mpn_fft_mul_modF_K (Ap, sqr ? Ap : Bp, nprime, K);
+      /* term to term multiplications */
+      mpn_fft_mul_modF_K (Ap, sqr ? Ap : Bp, nprime, K);
 
-  /* inverse fft's */
-  mpn_fft_fftinv (Ap, K, 2 * Mp, nprime, T);
+      /* inverse fft's */
+      mpn_fft_fftinv (Ap, K, 2 * Mp, nprime, T);
+    }
 
   /* division of terms after inverse fft */
   Bp[0] = T + nprime + 1;
@@ -834,6 +1041,7 @@ mpn_mul_fft (mp_ptr op, mp_size_t pl,
   mp_ptr *Ap, *Bp, A, T, B;
   int **fft_l, *tmp;
   int sqr = (n == m && nl == ml);
+  int nthreads;
   mp_limb_t h;
   TMP_DECL;
 
@@ -878,7 +1086,14 @@ mpn_mul_fft (mp_ptr op, mp_size_t pl,
     }
   ASSERT_ALWAYS (nprime < pl); /* otherwise we'll loop */
 
-  T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
+  nthreads = MPN_PARALLEL_P (pl, FFT_PARALLEL_THRESHOLD)
+    ? __gmp_parallel_threads : 1;
+  if (nthreads > 1)
+    T = TMP_BALLOC_LIMBS ((nprime + 1)
+			  * MAX (MAX (nthreads, 2),
+				 1 << mpn_fft_par_depth (k, nthreads)));
+  else
+    T = TMP_BALLOC_LIMBS (2 * (nprime + 1));
   Mp = Nprime >> k;
 
   TRACE (printf ("%ldx%ld limbs -> %ld times %ldx%ld limbs (%1.2f)\n",
@@ -901,7 +1116,8 @@ mpn_mul_fft (mp_ptr op, mp_size_t pl,
       Bp = TMP_BALLOC_MP_PTRS (K);
       mpn_mul_fft_decompose (B, Bp, K, nprime, m, ml, l, Mp, T);
     }
-  h = mpn_mul_fft_internal (op, pl, k, Ap, Bp, A, B, nprime, l, Mp, fft_l, T, sqr);
+  h = mpn_mul_fft_internal (op, pl, k, Ap, Bp, A, B, nprime, l, Mp, fft_l, T, sqr,
+			    nthreads);
 
   TMP_FREE;
   return h;
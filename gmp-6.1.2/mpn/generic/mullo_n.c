@@ -39,7 +39,7 @@ see https://www.gnu.org/licenses/.  */
 #include "gmp-impl.h"
 
 
-#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY
+#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY || WANT_RUNTIME_TUNING
 #define MAYBE_range_basecase 1
 #define MAYBE_range_toom22   1
 #else
@@ -232,7 +232,9 @@ mpn_mullo_n (mp_ptr rp, mp_srcptr xp, mp_srcptr yp, mp_size_t n)
 	{
 	  /* For really large operands, use plain mpn_mul_n but throw away upper n
 	     limbs of result.  */
-#if !TUNE_PROGRAM_BUILD && (MULLO_MUL_N_THRESHOLD > MUL_FFT_THRESHOLD)
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
+	  mpn_mul_n (tp, xp, yp, n);
+#elif MULLO_MUL_N_THRESHOLD > MUL_FFT_THRESHOLD
 	  mpn_fft_mul (tp, xp, n, yp, n);
 #else
 	  mpn_mul_n (tp, xp, yp, n);
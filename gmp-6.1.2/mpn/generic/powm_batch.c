@@ -0,0 +1,396 @@
+/* mpn_powm_batch -- Compute several R[i] = U[i]^E[i] mod M with a shared M.
+
+   THE FUNCTIONS IN THIS FILE ARE INTERNAL WITH MUTABLE INTERFACES.  IT IS
+   ONLY SAFE TO REACH THEM THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS
+   ALMOST GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP
+   RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+
+/*
+  ALGORITHM
+
+  1. Compute the REDC inverse of M and B^2n mod M once.  A base is then
+     converted to REDC form by a multiply and REDC, rather than a
+     division as in mpn_powm.
+
+  2. For each group of up to POWM_BATCH_SIZE bases, convert every base to
+     REDC form and compute its table of odd powers U^1, U^3, U^5..., up to
+     the largest window value actually occurring in the group.  For a
+     sparse exponent like 65537 that's just U^1.
+
+  3. Run the left-to-right sliding window loop of mpn_powm, but in rounds,
+     where each round steps every exponentiation of the group by one
+     window, squarings for the preceding zero bits included.
+
+  Doing a window of each exponentiation in turn, rather than each
+  exponentiation to completion, keeps the code and the modulus hot in cache
+  across the group, and the only per-base setup left is the REDC
+  conversion and the table.
+*/
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+#ifndef POWM_BATCH_SIZE
+#define POWM_BATCH_SIZE 8
+#endif
+
+#undef MPN_REDC_1
+#define MPN_REDC_1(rp, up, mp, n, invm)					\
+  do {									\
+    mp_limb_t cy;							\
+    cy = mpn_redc_1 (rp, up, mp, n, invm);				\
+    if (cy != 0)							\
+      mpn_sub_n (rp, rp, mp, n);					\
+  } while (0)
+
+#undef MPN_REDC_2
+#define MPN_REDC_2(rp, up, mp, n, mip)					\
+  do {									\
+    mp_limb_t cy;							\
+    cy = mpn_redc_2 (rp, up, mp, n, mip);				\
+    if (cy != 0)							\
+      mpn_sub_n (rp, rp, mp, n);					\
+  } while (0)
+
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+#define WANT_REDC_2 1
+#endif
+
+#define getbit(p,bi) \
+  ((p[(bi - 1) / GMP_LIMB_BITS] >> (bi - 1) % GMP_LIMB_BITS) & 1)
+
+static inline mp_limb_t
+getbits (const mp_limb_t *p, mp_bitcnt_t bi, int nbits)
+{
+  int nbits_in_r;
+  mp_limb_t r;
+  mp_size_t i;
+
+  if (bi < nbits)
+    {
+      return p[0] & (((mp_limb_t) 1 << bi) - 1);
+    }
+  else
+    {
+      bi -= nbits;			/* bit index of low bit to extract */
+      i = bi / GMP_NUMB_BITS;		/* word index of low bit to extract */
+      bi %= GMP_NUMB_BITS;		/* bit index in low word */
+      r = p[i] >> bi;			/* extract (low) bits */
+      nbits_in_r = GMP_NUMB_BITS - bi;	/* number of bits now in r */
+      if (nbits_in_r < nbits)		/* did we get enough bits? */
+	r += p[i + 1] << nbits_in_r;	/* prepend bits from higher word */
+      return r & (((mp_limb_t ) 1 << nbits) - 1);
+    }
+}
+
+static inline int
+win_size (mp_bitcnt_t eb)
+{
+  int k;
+  static mp_bitcnt_t x[] = {0,7,25,81,241,673,1793,4609,11521,28161,~(mp_bitcnt_t)0};
+  for (k = 1; eb > x[k]; k++)
+    ;
+  return k;
+}
+
+/* Take the next window from the exponent at ep, with ebi bits left and the
+   top one set.  Return its value, which is odd, and leave in *ebi the bits
+   left after it and in *nsqr the number of squarings it's worth.  */
+static inline mp_limb_t
+next_window (mp_srcptr ep, mp_bitcnt_t *ebi, int windowsize, int *nsqr)
+{
+  mp_limb_t expbits;
+  int cnt;
+
+  expbits = getbits (ep, *ebi, windowsize);
+  *nsqr = windowsize;
+  if (*ebi < windowsize)
+    {
+      *nsqr -= windowsize - *ebi;
+      *ebi = 0;
+    }
+  else
+    *ebi -= windowsize;
+
+  count_trailing_zeros (cnt, expbits);
+  *nsqr -= cnt;
+  *ebi += cnt;
+  return expbits >> cnt;
+}
+
+/* {rp,n} = {tp,2n} / B^n mod M, with mip and redc from
+   mpn_powm_batch_init.  The result is < B^n but not necessarily < M.
+   Clobbers {tp,2n}.  */
+void
+mpn_powm_batch_redc (mp_ptr rp, mp_ptr tp, mp_srcptr mp, mp_size_t n,
+		     mp_srcptr mip, int redc)
+{
+  if (redc == POWM_BATCH_REDC_1)
+    MPN_REDC_1 (rp, tp, mp, n, mip[0]);
+#if WANT_REDC_2
+  else if (redc == POWM_BATCH_REDC_2)
+    MPN_REDC_2 (rp, tp, mp, n, mip);
+#endif
+  else
+    mpn_redc_n (rp, tp, mp, n, mip);
+}
+
+/* Set {mip, ...} to the REDC inverse of {mp, n}, one, two or n limbs of it
+   as mpn_powm would use, and {r2p, n} to B^2n mod {mp, n}.  Return which
+   of those it is, POWM_BATCH_REDC_1, _2 or _N.  The choice follows the
+   REDC thresholds at the time of the call, and the inverse must be used
+   with that return value even if they change later.
+   Requires that mp[n-1..0] is odd.
+   Requires mip to have room for n limbs.
+   Uses scratch space at tp of MAX(mpn_binvert_itch(n),2n+1) limbs.  */
+int
+mpn_powm_batch_init (mp_ptr mip, mp_ptr r2p, mp_srcptr mp, mp_size_t n,
+		     mp_ptr tp)
+{
+  mp_ptr qp;
+  int redc;
+  TMP_DECL;
+
+  ASSERT (n >= 1 && ((mp[0] & 1) != 0));
+
+#if WANT_REDC_2
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_2_THRESHOLD))
+    {
+      binvert_limb (mip[0], mp[0]);
+      mip[0] = -mip[0];
+      redc = POWM_BATCH_REDC_1;
+    }
+  else if (BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
+    {
+      mpn_binvert (mip, mp, 2, tp);
+      mip[0] = -mip[0]; mip[1] = ~mip[1];
+      redc = POWM_BATCH_REDC_2;
+    }
+#else
+  if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_N_THRESHOLD))
+    {
+      binvert_limb (mip[0], mp[0]);
+      mip[0] = -mip[0];
+      redc = POWM_BATCH_REDC_1;
+    }
+#endif
+  else
+    {
+      mpn_binvert (mip, mp, n, tp);
+      redc = POWM_BATCH_REDC_N;
+    }
+
+  TMP_MARK;
+  qp = TMP_ALLOC_LIMBS (n + 2);
+  MPN_ZERO (tp, 2 * n);
+  tp[2 * n] = 1;
+  mpn_tdiv_qr (qp, r2p, 0L, tp, 2 * n + 1, mp, n);
+  TMP_FREE;
+  return redc;
+}
+
+/* {rp + i*n, n} = {bp + i*n, n} ^ {epv[i], env[i]} mod {mp, n}, for
+   0 <= i < count, with mip, redc and {r2p, n} from mpn_powm_batch_init.
+   Requires that mp[n-1..0] is odd.
+   Requires that each exponent is normalized and > 0.
+   Allows rp == bp.
+   Uses scratch space at tp of 2n limbs.  */
+void
+mpn_powm_batch_pre (mp_ptr rp, mp_srcptr bp,
+		    mp_srcptr *epv, const mp_size_t *env, mp_size_t count,
+		    mp_srcptr mp, mp_size_t n, mp_srcptr mip, int redc,
+		    mp_srcptr r2p, mp_ptr tp)
+{
+  mp_bitcnt_t ebi[POWM_BATCH_SIZE], maxebi, bi;
+  mp_size_t i, g, gcount, active;
+  int windowsize, nsqr, j;
+  mp_limb_t expbits, maxodd;
+  mp_ptr pp, this_pp, r;
+  mp_srcptr ep;
+  TMP_DECL;
+
+  ASSERT (count >= 1);
+  ASSERT (n >= 1 && ((mp[0] & 1) != 0));
+  ASSERT (rp == bp || ! MPN_OVERLAP_P (rp, count * n, bp, count * n));
+
+  TMP_MARK;
+
+  maxebi = 0;
+  for (i = 0; i < count; i++)
+    {
+      ASSERT (env[i] >= 1 && epv[i][env[i] - 1] != 0);
+      MPN_SIZEINBASE_2EXP (bi, epv[i], env[i], 1);
+      maxebi = MAX (maxebi, bi);
+    }
+
+  windowsize = win_size (maxebi);
+
+  /* Tables of up to 2^(windowsize-1) odd powers for each base of a
+     group.  */
+  pp = TMP_ALLOC_LIMBS ((MIN (count, POWM_BATCH_SIZE) * n)
+		       << (windowsize - 1));
+
+  for (g = 0; g < count; g += POWM_BATCH_SIZE)
+    {
+      gcount = MIN (count - g, POWM_BATCH_SIZE);
+
+      /* A dry run over the windows, for the table size needed.  */
+      maxodd = 1;
+      for (i = 0; i < gcount; i++)
+	{
+	  ep = epv[g + i];
+	  MPN_SIZEINBASE_2EXP (bi, ep, env[g + i], 1);
+	  while (bi != 0)
+	    {
+	      if (getbit (ep, bi) == 0)
+		bi--;
+	      else
+		{
+		  expbits = next_window (ep, &bi, windowsize, &nsqr);
+		  maxodd = MAX (maxodd, expbits);
+		}
+	    }
+	}
+
+      for (i = 0; i < gcount; i++)
+	{
+	  this_pp = pp + ((i * n) << (windowsize - 1));
+	  mpn_mul_n (tp, bp + (g + i) * n, r2p, n);
+	  mpn_powm_batch_redc (this_pp, tp, mp, n, mip, redc);
+
+	  if (maxodd > 1)
+	    {
+	      /* Store b^2 at the result, not yet in use.  Since rp may equal
+		 bp, this is only safe because the base has been read.  */
+	      r = rp + (g + i) * n;
+	      mpn_sqr (tp, this_pp, n);
+	      mpn_powm_batch_redc (r, tp, mp, n, mip, redc);
+
+	      for (j = maxodd >> 1; j > 0; j--)
+		{
+		  mpn_mul_n (tp, this_pp, r, n);
+		  this_pp += n;
+		  mpn_powm_batch_redc (this_pp, tp, mp, n, mip, redc);
+		}
+	    }
+	}
+
+      /* The first window of each exponent.  */
+      active = 0;
+      for (i = 0; i < gcount; i++)
+	{
+	  ep = epv[g + i];
+	  MPN_SIZEINBASE_2EXP (ebi[i], ep, env[g + i], 1);
+	  expbits = next_window (ep, &ebi[i], windowsize, &nsqr);
+	  MPN_COPY (rp + (g + i) * n,
+		    pp + ((i * n) << (windowsize - 1)) + n * (expbits >> 1),
+		    n);
+	  active += (ebi[i] != 0);
+	}
+
+      /* Rounds of one window for each exponentiation still going.  */
+      while (active != 0)
+	{
+	  for (i = 0; i < gcount; i++)
+	    {
+	      if (ebi[i] == 0)
+		continue;
+
+	      ep = epv[g + i];
+	      r = rp + (g + i) * n;
+
+	      while (getbit (ep, ebi[i]) == 0)
+		{
+		  mpn_sqr (tp, r, n);
+		  mpn_powm_batch_redc (r, tp, mp, n, mip, redc);
+		  if (--ebi[i] == 0)
+		    break;
+		}
+	      if (ebi[i] == 0)
+		{
+		  active--;
+		  continue;
+		}
+
+	      expbits = next_window (ep, &ebi[i], windowsize, &nsqr);
+	      do
+		{
+		  mpn_sqr (tp, r, n);
+		  mpn_powm_batch_redc (r, tp, mp, n, mip, redc);
+		}
+	      while (--nsqr != 0);
+
+	      mpn_mul_n (tp, r, pp + ((i * n) << (windowsize - 1))
+			 + n * (expbits >> 1), n);
+	      mpn_powm_batch_redc (r, tp, mp, n, mip, redc);
+	      active -= (ebi[i] == 0);
+	    }
+	}
+
+      /* Convert out of REDC form.  */
+      for (i = 0; i < gcount; i++)
+	{
+	  r = rp + (g + i) * n;
+	  MPN_COPY (tp, r, n);
+	  MPN_ZERO (tp + n, n);
+	  mpn_powm_batch_redc (r, tp, mp, n, mip, redc);
+	  if (mpn_cmp (r, mp, n) >= 0)
+	    mpn_sub_n (r, r, mp, n);
+	}
+    }
+
+  TMP_FREE;
+}
+
+/* {rp + i*n, n} = {bp + i*n, n} ^ {epv[i], env[i]} mod {mp, n}, for
+   0 <= i < count.
+   Requires that mp[n-1..0] is odd.
+   Requires that each exponent is normalized and > 0.
+   Allows rp == bp.
+   Uses scratch space at tp of MAX(mpn_binvert_itch(n),2n+1) limbs.  */
+void
+mpn_powm_batch (mp_ptr rp, mp_srcptr bp,
+		mp_srcptr *epv, const mp_size_t *env, mp_size_t count,
+		mp_srcptr mp, mp_size_t n, mp_ptr tp)
+{
+  mp_ptr mip, r2p;
+  int redc;
+  TMP_DECL;
+
+  TMP_MARK;
+  mip = TMP_ALLOC_LIMBS (n);
+  r2p = TMP_ALLOC_LIMBS (n);
+  redc = mpn_powm_batch_init (mip, r2p, mp, n, tp);
+  mpn_powm_batch_pre (rp, bp, epv, env, count, mp, n, mip, redc, r2p, tp);
+  TMP_FREE;
+}
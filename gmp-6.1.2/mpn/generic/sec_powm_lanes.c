@@ -0,0 +1,58 @@
+/* mpn_sec_powm_lanes -- Compute R[i] = B[i]^E[i] mod M[i] for up to
+   SEC_POWM_LANES tuples.
+
+   THE FUNCTION IN THIS FILE IS INTERNAL WITH A MUTABLE INTERFACE.  IT IS ONLY
+   SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.  IN FACT, IT IS ALMOST
+   GUARANTEED THAT IT WILL CHANGE OR DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* The K tuples are laid out as for mpn_sec_powm_multi.  Plain code has
+   nothing to gain from doing them in lock-step, so this does them one after
+   another.  Uses scratch space at tp as defined by mpn_sec_powm_lanes_itch,
+   which is at least mpn_sec_powm_itch.  */
+void
+mpn_sec_powm_lanes (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
+		    mp_srcptr ep, mp_bitcnt_t enb,
+		    mp_srcptr mp, mp_size_t n, int k, mp_ptr tp)
+{
+  mp_size_t en;
+  int i;
+
+  ASSERT (k <= SEC_POWM_LANES);
+
+  en = BITS_TO_LIMBS (enb);
+  for (i = 0; i < k; i++)
+    mpn_sec_powm (rp + i * n, bp + i * bn, bn, ep + i * en, enb,
+		  mp + i * n, n, tp);
+}
@@ -0,0 +1,70 @@
+/* mpn_sec_powm_multi -- Compute R[i] = B[i]^E[i] mod M[i] for several
+   same-size tuples.  Secure variant, side-channel silent as mpn_sec_powm.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* The K tuples are stored one after another, so tuple i is {bp+i*bn,bn},
+   {ep+i*en,en} and {mp+i*n,n}, with en = ceil(enb/GMP_NUMB_BITS), and its
+   result goes to {rp+i*n,n}.  They're handed to mpn_sec_powm_lanes in groups
+   of SEC_POWM_LANES, which native code can do in lock-step, one tuple in
+   each lane of a vector.  The grouping depends only on K.  */
+void
+mpn_sec_powm_multi (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
+		    mp_srcptr ep, mp_bitcnt_t enb,
+		    mp_srcptr mp, mp_size_t n, int k, mp_ptr tp)
+{
+  mp_size_t en;
+  int g;
+
+  ASSERT (enb > 0);
+  ASSERT (n > 0);
+  ASSERT (bn > 0);
+  ASSERT (k >= 0);
+
+  en = BITS_TO_LIMBS (enb);
+  for ( ; k > 0; k -= g)
+    {
+      g = MIN (k, SEC_POWM_LANES);
+      mpn_sec_powm_lanes (rp, bp, bn, ep, enb, mp, n, g, tp);
+      rp += g * n;
+      bp += g * bn;
+      ep += g * en;
+      mp += g * n;
+    }
+}
+
+mp_size_t
+mpn_sec_powm_multi_itch (mp_size_t bn, mp_bitcnt_t enb, mp_size_t n)
+{
+  return mpn_sec_powm_lanes_itch (bn, enb, n);
+}
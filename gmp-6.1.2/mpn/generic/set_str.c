@@ -9,8 +9,8 @@
    FACT, IT IS ALMOST GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE
    GNU MP RELEASE.
 
-Copyright 1991-1994, 1996, 2000-2002, 2004, 2006-2008, 2012, 2013 Free
-Software Foundation, Inc.
+Copyright 1991-1994, 1996, 2000-2002, 2004, 2006-2008, 2012, 2013,
+2026 Free Software Foundation, Inc.
 
 This file is part of the GNU MP Library.
 
@@ -217,6 +217,62 @@ mpn_set_str_compute_powtab (powers_t *powtab, mp_ptr powtab_mem, mp_size_t un, i
     }
 }
 
+/* Convert STR,STR_LEN with the powers at POWTAB and below it, down to
+   big_base itself, as from an mpz_basectx_t.  There must be
+   2*POWTAB->digits_in_base >= STR_LEN.  RP needs only room for the result,
+   the conversion is made in a temporary block since it can want more.  */
+mp_size_t
+mpn_set_str_pre (mp_ptr rp, const unsigned char *str, size_t str_len,
+		 const powers_t *powtab)
+{
+  powers_t rtab[GMP_LIMB_BITS];
+  mp_ptr xp, tp;
+  mp_size_t xn, pn;
+  int i;
+  TMP_DECL;
+
+  /* mpn_dc_set_str wants the largest power first.  */
+  for (i = 0; ; i++)
+    {
+      rtab[i] = powtab[-i];
+      if (rtab[i].digits_in_base == mp_bases[powtab->base].chars_per_limb)
+	break;
+    }
+
+  TMP_MARK;
+  pn = powtab->n + powtab->shift;
+  xp = TMP_BALLOC_LIMBS (2 * pn + 2);
+  tp = TMP_BALLOC_LIMBS (2 * pn + 2 * GMP_LIMB_BITS);
+  xn = mpn_dc_set_str (xp, str, str_len, rtab, tp);
+  MPN_COPY (rp, xp, xn);
+  TMP_FREE;
+  return xn;
+}
+
+/* With a parallel function the high and low parts are converted at the same
+   time, the low one into a block of its own.  */
+
+struct set_str_par
+{
+  mp_ptr rp;
+  const unsigned char *str;
+  size_t len;
+  const powers_t *powtab;
+  mp_ptr tp;
+  mp_size_t n;
+};
+
+static void
+set_str_task (void *data, int i)
+{
+  struct set_str_par *d = (struct set_str_par *) data + i;
+
+  if (BELOW_THRESHOLD (d->len, SET_STR_DC_THRESHOLD))
+    d->n = mpn_bc_set_str (d->rp, d->str, d->len, d->powtab->base);
+  else
+    d->n = mpn_dc_set_str (d->rp, d->str, d->len, d->powtab + 1, d->tp);
+}
+
 mp_size_t
 mpn_dc_set_str (mp_ptr rp, const unsigned char *str, size_t str_len,
 		const powers_t *powtab, mp_ptr tp)
@@ -224,6 +280,7 @@ mpn_dc_set_str (mp_ptr rp, const unsigned char *str, size_t str_len,
   size_t len_lo, len_hi;
   mp_limb_t cy;
   mp_size_t ln, hn, n, sn;
+  mp_ptr lp;
 
   len_lo = powtab->digits_in_base;
 
@@ -238,13 +295,58 @@ mpn_dc_set_str (mp_ptr rp, const unsigned char *str, size_t str_len,
   len_hi = str_len - len_lo;
   ASSERT (len_lo >= len_hi);
 
+  sn = powtab->shift;
+
+  if (MPN_PARALLEL_P (str_len, SET_STR_PARALLEL_THRESHOLD))
+    {
+      struct set_str_par par[2];
+      TMP_DECL;
+
+      TMP_MARK;
+      n = powtab->n + sn;
+      lp = TMP_BALLOC_LIMBS (3 * n + 1 + GMP_LIMB_BITS);
+
+      par[0].rp = tp;
+      par[0].str = str;
+      par[0].len = len_hi;
+      par[0].powtab = powtab;
+      par[0].tp = rp;
+
+      par[1].rp = lp;
+      par[1].str = str + len_hi;
+      par[1].len = len_lo;
+      par[1].powtab = powtab;
+      par[1].tp = lp + n + 1;
+
+      MPN_PARALLEL_RUN (set_str_task, par, 2);
+      hn = par[0].n;
+      ln = par[1].n;
+
+      if (hn == 0)
+	MPN_ZERO (rp, n + 1);
+      else
+	{
+	  if (powtab->n > hn)
+	    mpn_mul (rp + sn, powtab->p, powtab->n, tp, hn);
+	  else
+	    mpn_mul (rp + sn, tp, hn, powtab->p, powtab->n);
+	  MPN_ZERO (rp, sn);
+	}
+      if (ln != 0)
+	{
+	  cy = mpn_add_n (rp, rp, lp, ln);
+	  mpn_incr_u (rp + ln, cy);
+	}
+      TMP_FREE;
+      n += hn;
+      return n - (rp[n - 1] == 0);
+    }
+
   if (BELOW_THRESHOLD (len_hi, SET_STR_DC_THRESHOLD))
     hn = mpn_bc_set_str (tp, str, len_hi, powtab->base);
   else
     hn = mpn_dc_set_str (tp, str, len_hi, powtab + 1, rp);
 
-  sn = powtab->shift;
-
   if (hn == 0)
     {
       /* Zero +1 limb here, to avoid reading an allocated but uninitialised
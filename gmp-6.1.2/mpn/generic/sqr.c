@@ -41,10 +41,12 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
 
   if (BELOW_THRESHOLD (n, SQR_BASECASE_THRESHOLD))
     { /* mul_basecase is faster than sqr_basecase on small sizes sometimes */
+      GMP_STATS_COUNT (GMP_STATS_SQR_MUL_BASECASE, n);
       mpn_mul_basecase (p, a, n, a, n);
     }
   else if (BELOW_THRESHOLD (n, SQR_TOOM2_THRESHOLD))
     {
+      GMP_STATS_COUNT (GMP_STATS_SQR_BASECASE, n);
       mpn_sqr_basecase (p, a, n);
     }
   else if (BELOW_THRESHOLD (n, SQR_TOOM3_THRESHOLD))
@@ -52,6 +54,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       /* Allocate workspace of fixed size on stack: fast! */
       mp_limb_t ws[mpn_toom2_sqr_itch (SQR_TOOM3_THRESHOLD_LIMIT-1)];
       ASSERT (SQR_TOOM3_THRESHOLD <= SQR_TOOM3_THRESHOLD_LIMIT);
+      GMP_STATS_COUNT (GMP_STATS_SQR_TOOM2, n);
       mpn_toom2_sqr (p, a, n, ws);
     }
   else if (BELOW_THRESHOLD (n, SQR_TOOM4_THRESHOLD))
@@ -60,6 +63,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom3_sqr_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_SQR_TOOM3, n);
       mpn_toom3_sqr (p, a, n, ws);
       TMP_SFREE;
     }
@@ -69,6 +73,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom4_sqr_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_SQR_TOOM4, n);
       mpn_toom4_sqr (p, a, n, ws);
       TMP_SFREE;
     }
@@ -78,6 +83,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom6_sqr_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_SQR_TOOM6, n);
       mpn_toom6_sqr (p, a, n, ws);
       TMP_SFREE;
     }
@@ -87,6 +93,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
       TMP_DECL;
       TMP_MARK;
       ws = TMP_ALLOC_LIMBS (mpn_toom8_sqr_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_SQR_TOOM8, n);
       mpn_toom8_sqr (p, a, n, ws);
       TMP_FREE;
     }
@@ -94,6 +101,7 @@ mpn_sqr (mp_ptr p, mp_srcptr a, mp_size_t n)
     {
       /* The current FFT code allocates its own space.  That should probably
 	 change.  */
+      GMP_STATS_COUNT (GMP_STATS_SQR_FFT, n);
       mpn_fft_mul (p, a, n, a, n);
     }
 }
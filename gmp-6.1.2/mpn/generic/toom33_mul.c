@@ -55,7 +55,7 @@ see https://www.gnu.org/licenses/.  */
   vinf=          a2 *         b2  # A(inf)*B(inf)
 */
 
-#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY
+#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY || WANT_RUNTIME_TUNING
 #define MAYBE_mul_basecase 1
 #define MAYBE_mul_toom33   1
 #else
@@ -56,7 +56,7 @@ see https://www.gnu.org/licenses/.  */
   vinf=               a3 *          b2      #  A(inf)*B(inf)
 */
 
-#if TUNE_PROGRAM_BUILD
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
 #define MAYBE_mul_basecase 1
 #define MAYBE_mul_toom22   1
 #define MAYBE_mul_toom44   1
@@ -53,7 +53,7 @@ see https://www.gnu.org/licenses/.  */
   vinf=               a3 ^2 #  A(inf)^2
 */
 
-#if TUNE_PROGRAM_BUILD
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
 #define MAYBE_sqr_basecase 1
 #define MAYBE_sqr_toom2   1
 #define MAYBE_sqr_toom4   1
@@ -7,8 +7,8 @@
    FACT, IT IS ALMOST GUARANTEED THAT THEY WILL CHANGE OR DISAPPEAR IN A FUTURE
    GNU MP RELEASE.
 
-Copyright 1991-1994, 1996, 2000-2002, 2004, 2006-2008, 2011, 2012 Free Software
-Foundation, Inc.
+Copyright 1991-1994, 1996, 2000-2002, 2004, 2006-2008, 2011, 2012, 2026 Free
+Software Foundation, Inc.
 
 This file is part of the GNU MP Library.
 
@@ -36,6 +36,7 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the GNU MP Library.  If not,
 see https://www.gnu.org/licenses/.  */
 
+#include <string.h>
 #include "gmp.h"
 #include "gmp-impl.h"
 #include "longlong.h"
@@ -306,7 +307,39 @@ mpn_sb_get_str (unsigned char *str, size_t len,
    the string in STR.  Generate LEN characters, possibly padding with zeros to
    the left.  If LEN is zero, generate as many characters as required.
    Return a pointer immediately after the last digit of the result string.
-   This uses divide-and-conquer and is intended for large conversions.  */
+   This uses divide-and-conquer and is intended for large conversions.
+
+   With a fixed LEN, the quotient and remainder go to known places in STR,
+   so with a parallel function they're converted at the same time, the
+   remainder with scratch space of its own.  */
+
+struct get_str_par
+{
+  unsigned char *str;
+  size_t len;
+  mp_ptr up;
+  mp_size_t un;
+  const powers_t *powtab;
+  mp_ptr tmp;
+};
+
+static unsigned char *mpn_dc_get_str (unsigned char *, size_t, mp_ptr, mp_size_t, const powers_t *, mp_ptr);
+
+static void
+get_str_task (void *data, int i)
+{
+  struct get_str_par *d = (struct get_str_par *) data + i;
+  mp_ptr tmp;
+  TMP_DECL;
+
+  TMP_MARK;
+  tmp = d->tmp;
+  if (tmp == NULL)
+    tmp = TMP_BALLOC_LIMBS (mpn_dc_get_str_itch (d->un));
+  mpn_dc_get_str (d->str, d->len, d->up, d->un, d->powtab, tmp);
+  TMP_FREE;
+}
+
 static unsigned char *
 mpn_dc_get_str (unsigned char *str, size_t len,
 		mp_ptr up, mp_size_t un,
@@ -352,6 +385,28 @@ mpn_dc_get_str (unsigned char *str, size_t len,
 	  if (len != 0)
 	    len = len - powtab->digits_in_base;
 
+	  if (len != 0 && MPN_PARALLEL_P (un, GET_STR_PARALLEL_THRESHOLD))
+	    {
+	      struct get_str_par par[2];
+
+	      par[0].str = str;
+	      par[0].len = len;
+	      par[0].up = qp;
+	      par[0].un = qn;
+	      par[0].powtab = powtab - 1;
+	      par[0].tmp = tmp + qn;
+
+	      par[1].str = str + len;
+	      par[1].len = powtab->digits_in_base;
+	      par[1].up = rp;
+	      par[1].un = pwn + sn;
+	      par[1].powtab = powtab - 1;
+	      par[1].tmp = NULL;
+
+	      MPN_PARALLEL_RUN (get_str_task, par, 2);
+	      return str + len + powtab->digits_in_base;
+	    }
+
 	  str = mpn_dc_get_str (str, len, qp, qn, powtab - 1, tmp + qn);
 	  str = mpn_dc_get_str (str, powtab->digits_in_base, rp, pwn + sn, powtab - 1, tmp);
 	}
@@ -359,7 +414,233 @@ mpn_dc_get_str (unsigned char *str, size_t len,
   return str;
 }
 
-
+
+/* Streaming counterpart of mpn_dc_get_str.  The digits are passed to FUNC
+   as each basecase conversion completes, from most to least significant,
+   so no more than a basecase's worth of them is ever held.  */
+
+struct get_str_sink
+{
+  void (*func) (void *, unsigned char *, size_t);
+  void *data;
+  size_t total;
+};
+
+static void
+sink_zeros (struct get_str_sink *sink, size_t len)
+{
+  unsigned char zeros[256];
+  size_t n;
+
+  memset (zeros, 0, MIN (len, sizeof (zeros)));
+  while (len != 0)
+    {
+      n = MIN (len, sizeof (zeros));
+      (*sink->func) (sink->data, zeros, n);
+      sink->total += n;
+      len -= n;
+    }
+}
+
+static void
+mpn_dc_out_str (struct get_str_sink *sink, size_t len,
+		mp_ptr up, mp_size_t un,
+		const powers_t *powtab, mp_ptr tmp)
+{
+  if (BELOW_THRESHOLD (un, GET_STR_DC_THRESHOLD))
+    {
+      unsigned char buf[BUF_ALLOC];
+      size_t n;
+
+      n = un == 0 ? 0 : mpn_sb_get_str (buf, 0, up, un, powtab->base) - buf;
+      if (len > n)
+	sink_zeros (sink, len - n);
+      (*sink->func) (sink->data, buf, n);
+      sink->total += n;
+    }
+  else
+    {
+      mp_ptr pwp, qp, rp;
+      mp_size_t pwn, qn;
+      mp_size_t sn;
+
+      pwp = powtab->p;
+      pwn = powtab->n;
+      sn = powtab->shift;
+
+      if (un < pwn + sn || (un == pwn + sn && mpn_cmp (up + sn, pwp, un - sn) < 0))
+	{
+	  mpn_dc_out_str (sink, len, up, un, powtab - 1, tmp);
+	}
+      else
+	{
+	  qp = tmp;
+	  rp = up;
+
+	  mpn_tdiv_qr (qp, rp + sn, 0L, up + sn, un - sn, pwp, pwn);
+	  qn = un - sn - pwn; qn += qp[qn] != 0;
+
+	  if (len != 0)
+	    len = len - powtab->digits_in_base;
+
+	  mpn_dc_out_str (sink, len, qp, qn, powtab - 1, tmp + qn);
+	  mpn_dc_out_str (sink, powtab->digits_in_base, rp, pwn + sn, powtab - 1, tmp);
+	}
+    }
+}
+
+
+/* Compute in POWTAB the powers of big_base for converting a number of UN
+   limbs, the largest >= sqrt(U), with limbs from POWTAB_MEM.  Return the
+   index of the largest.  */
+static int
+get_str_compute_powtab (powers_t *powtab, mp_ptr powtab_mem, mp_size_t un,
+			int base)
+{
+  mp_ptr powtab_mem_ptr;
+  mp_limb_t big_base;
+  size_t digits_in_base;
+  int pi;
+  mp_size_t n;
+  mp_ptr p, t;
+  mp_size_t n_pows, xn, pn, exptab[GMP_LIMB_BITS], bexp;
+  mp_limb_t cy;
+  mp_size_t shift;
+  size_t ndig;
+
+  powtab_mem_ptr = powtab_mem;
+
+  big_base = mp_bases[base].big_base;
+  digits_in_base = mp_bases[base].chars_per_limb;
+
+  DIGITS_IN_BASE_PER_LIMB (ndig, un, base);
+  xn = 1 + ndig / mp_bases[base].chars_per_limb; /* FIXME: scalar integer division */
+
+  n_pows = 0;
+  for (pn = xn; pn != 1; pn = (pn + 1) >> 1)
+    {
+      exptab[n_pows] = pn;
+      n_pows++;
+    }
+  exptab[n_pows] = 1;
+
+  /* powtab[0] points at the big_base in mp_bases, rather than a local.  */
+  powtab[0].p = (mp_ptr) &mp_bases[base].big_base;
+  powtab[0].n = 1;
+  powtab[0].digits_in_base = digits_in_base;
+  powtab[0].base = base;
+  powtab[0].shift = 0;
+
+  powtab[1].p = powtab_mem_ptr;  powtab_mem_ptr += 2;
+  powtab[1].p[0] = big_base;
+  powtab[1].n = 1;
+  powtab[1].digits_in_base = digits_in_base;
+  powtab[1].base = base;
+  powtab[1].shift = 0;
+
+  n = 1;
+  p = powtab[0].p;
+  bexp = 1;
+  shift = 0;
+  for (pi = 2; pi < n_pows; pi++)
+    {
+      t = powtab_mem_ptr;
+      powtab_mem_ptr += 2 * n + 2;
+
+      ASSERT_ALWAYS (powtab_mem_ptr < powtab_mem + mpn_dc_get_str_powtab_alloc (un));
+
+      mpn_sqr (t, p, n);
+
+      digits_in_base *= 2;
+      n *= 2;  n -= t[n - 1] == 0;
+      bexp *= 2;
+
+      if (bexp + 1 < exptab[n_pows - pi])
+	{
+	  digits_in_base += mp_bases[base].chars_per_limb;
+	  cy = mpn_mul_1 (t, t, n, big_base);
+	  t[n] = cy;
+	  n += cy != 0;
+	  bexp += 1;
+	}
+      shift *= 2;
+      /* Strip low zero limbs.  */
+      while (t[0] == 0)
+	{
+	  t++;
+	  n--;
+	  shift++;
+	}
+      p = t;
+      powtab[pi].p = p;
+      powtab[pi].n = n;
+      powtab[pi].digits_in_base = digits_in_base;
+      powtab[pi].base = base;
+      powtab[pi].shift = shift;
+    }
+
+  for (pi = 1; pi < n_pows; pi++)
+    {
+      t = powtab[pi].p;
+      n = powtab[pi].n;
+      cy = mpn_mul_1 (t, t, n, big_base);
+      t[n] = cy;
+      n += cy != 0;
+      if (t[0] == 0)
+	{
+	  powtab[pi].p = t + 1;
+	  n--;
+	  powtab[pi].shift++;
+	}
+      powtab[pi].n = n;
+      powtab[pi].digits_in_base += mp_bases[base].chars_per_limb;
+    }
+
+#if 0
+  { int i;
+    printf ("Computed table values for base=%d, un=%d, xn=%d:\n", base, un, xn);
+    for (i = 0; i < n_pows; i++)
+      printf ("%2d: %10ld %10ld %11ld %ld\n", i, exptab[n_pows-i], powtab[i].n, powtab[i].digits_in_base, powtab[i].shift);
+  }
+#endif
+
+  return n_pows - 1;
+}
+
+
+/* Convert {UP,UN}, un >= GET_STR_PRECOMPUTE_THRESHOLD, with the powers from
+   POWTAB down, where POWTAB->p^2 > U.  Returns the number of digits, there
+   are no leading zeros.  Clobbers {UP,UN}.
+
+   The parallel conversion wants a fixed length, so it's asked for the
+   length from MPN_SIZEINBASE, which can be one too many, and then any
+   leading zero is dropped.  */
+size_t
+mpn_get_str_pre (unsigned char *str, mp_ptr up, mp_size_t un,
+		 const powers_t *powtab)
+{
+  size_t len, out_len;
+  mp_ptr tmp;
+  TMP_DECL;
+
+  len = 0;
+  if (MPN_PARALLEL_P (un, GET_STR_PARALLEL_THRESHOLD))
+    MPN_SIZEINBASE (len, up, un, powtab->base);
+
+  TMP_MARK;
+  tmp = TMP_BALLOC_LIMBS (mpn_dc_get_str_itch (un));
+  out_len = mpn_dc_get_str (str, len, up, un, powtab, tmp) - str;
+  TMP_FREE;
+
+  if (len != 0 && str[0] == 0)
+    {
+      out_len--;
+      memmove (str, str + 1, out_len);
+    }
+  return out_len;
+}
+
+
 /* There are no leading zeros on the digits generated at str, but that's not
    currently a documented feature.  The current mpz_out_str and mpz_get_str
    rely on it.  */
@@ -367,15 +648,10 @@ mpn_dc_get_str (unsigned char *str, size_t len,
 size_t
 mpn_get_str (unsigned char *str, int base, mp_ptr up, mp_size_t un)
 {
-  mp_ptr powtab_mem, powtab_mem_ptr;
-  mp_limb_t big_base;
-  size_t digits_in_base;
+  mp_ptr powtab_mem;
   powers_t powtab[GMP_LIMB_BITS];
   int pi;
-  mp_size_t n;
-  mp_ptr p, t;
   size_t out_len;
-  mp_ptr tmp;
   TMP_DECL;
 
   /* Special case zero, as the code below doesn't handle it.  */
@@ -440,114 +716,87 @@ mpn_get_str (unsigned char *str, int base, mp_ptr up, mp_size_t un)
 
   /* Allocate one large block for the powers of big_base.  */
   powtab_mem = TMP_BALLOC_LIMBS (mpn_dc_get_str_powtab_alloc (un));
-  powtab_mem_ptr = powtab_mem;
 
   /* Compute a table of powers, were the largest power is >= sqrt(U).  */
+  pi = get_str_compute_powtab (powtab, powtab_mem, un, base);
 
-  big_base = mp_bases[base].big_base;
-  digits_in_base = mp_bases[base].chars_per_limb;
+  /* Using our precomputed powers, now in powtab[], convert our number.  */
+  out_len = mpn_get_str_pre (str, up, un, powtab + pi);
+  TMP_FREE;
 
-  {
-    mp_size_t n_pows, xn, pn, exptab[GMP_LIMB_BITS], bexp;
-    mp_limb_t cy;
-    mp_size_t shift;
-    size_t ndig;
-
-    DIGITS_IN_BASE_PER_LIMB (ndig, un, base);
-    xn = 1 + ndig / mp_bases[base].chars_per_limb; /* FIXME: scalar integer division */
-
-    n_pows = 0;
-    for (pn = xn; pn != 1; pn = (pn + 1) >> 1)
-      {
-	exptab[n_pows] = pn;
-	n_pows++;
-      }
-    exptab[n_pows] = 1;
-
-    powtab[0].p = &big_base;
-    powtab[0].n = 1;
-    powtab[0].digits_in_base = digits_in_base;
-    powtab[0].base = base;
-    powtab[0].shift = 0;
-
-    powtab[1].p = powtab_mem_ptr;  powtab_mem_ptr += 2;
-    powtab[1].p[0] = big_base;
-    powtab[1].n = 1;
-    powtab[1].digits_in_base = digits_in_base;
-    powtab[1].base = base;
-    powtab[1].shift = 0;
-
-    n = 1;
-    p = &big_base;
-    bexp = 1;
-    shift = 0;
-    for (pi = 2; pi < n_pows; pi++)
-      {
-	t = powtab_mem_ptr;
-	powtab_mem_ptr += 2 * n + 2;
-
-	ASSERT_ALWAYS (powtab_mem_ptr < powtab_mem + mpn_dc_get_str_powtab_alloc (un));
-
-	mpn_sqr (t, p, n);
-
-	digits_in_base *= 2;
-	n *= 2;  n -= t[n - 1] == 0;
-	bexp *= 2;
-
-	if (bexp + 1 < exptab[n_pows - pi])
-	  {
-	    digits_in_base += mp_bases[base].chars_per_limb;
-	    cy = mpn_mul_1 (t, t, n, big_base);
-	    t[n] = cy;
-	    n += cy != 0;
-	    bexp += 1;
-	  }
-	shift *= 2;
-	/* Strip low zero limbs.  */
-	while (t[0] == 0)
-	  {
-	    t++;
-	    n--;
-	    shift++;
-	  }
-	p = t;
-	powtab[pi].p = p;
-	powtab[pi].n = n;
-	powtab[pi].digits_in_base = digits_in_base;
-	powtab[pi].base = base;
-	powtab[pi].shift = shift;
-      }
-
-    for (pi = 1; pi < n_pows; pi++)
-      {
-	t = powtab[pi].p;
-	n = powtab[pi].n;
-	cy = mpn_mul_1 (t, t, n, big_base);
-	t[n] = cy;
-	n += cy != 0;
-	if (t[0] == 0)
-	  {
-	    powtab[pi].p = t + 1;
-	    n--;
-	    powtab[pi].shift++;
-	  }
-	powtab[pi].n = n;
-	powtab[pi].digits_in_base += mp_bases[base].chars_per_limb;
-      }
+  return out_len;
+}
 
-#if 0
-    { int i;
-      printf ("Computed table values for base=%d, un=%d, xn=%d:\n", base, un, xn);
-      for (i = 0; i < n_pows; i++)
-	printf ("%2d: %10ld %10ld %11ld %ld\n", i, exptab[n_pows-i], powtab[i].n, powtab[i].digits_in_base, powtab[i].shift);
+
+/* Pass the digits of {UP,UN} in base BASE to FUNC, a block at a time, and
+   return how many there were.  The blocks are in the same form as from
+   mpn_get_str, and FUNC may modify them.  Clobbers {UP,UN} for a base not a
+   power of 2.  */
+size_t
+mpn_out_str_func (void (*func) (void *, unsigned char *, size_t), void *data,
+		  int base, mp_ptr up, mp_size_t un)
+{
+  struct get_str_sink sink;
+  mp_ptr powtab_mem, tmp;
+  powers_t powtab[GMP_LIMB_BITS];
+  int pi;
+  TMP_DECL;
+
+  sink.func = func;
+  sink.data = data;
+  sink.total = 0;
+
+  if (un == 0)
+    {
+      sink_zeros (&sink, 1);
+      return 1;
     }
-#endif
-  }
 
-  /* Using our precomputed powers, now in powtab[], convert our number.  */
+  if (POW2_P (base))
+    {
+      /* Digits straight from the bits, most significant first.  */
+      unsigned char buf[256];
+      int bits_per_digit = mp_bases[base].big_base;
+      mp_bitcnt_t bits, bi;
+      mp_limb_t d;
+      size_t n;
+
+      MPN_SIZEINBASE_2EXP (bits, up, un, bits_per_digit);
+      bits *= bits_per_digit;
+      n = 0;
+      for (bi = bits; bi != 0; )
+	{
+	  bi -= bits_per_digit;
+	  d = up[bi / GMP_NUMB_BITS] >> (bi % GMP_NUMB_BITS);
+	  if (bi % GMP_NUMB_BITS + bits_per_digit > GMP_NUMB_BITS
+	      && bi / GMP_NUMB_BITS + 1 < un)
+	    d |= up[bi / GMP_NUMB_BITS + 1] << (GMP_NUMB_BITS - bi % GMP_NUMB_BITS);
+	  buf[n++] = d & ((1 << bits_per_digit) - 1);
+	  if (n == sizeof (buf))
+	    {
+	      (*func) (data, buf, n);
+	      n = 0;
+	    }
+	}
+      (*func) (data, buf, n);
+      return bits / bits_per_digit;
+    }
+
+  if (BELOW_THRESHOLD (un, GET_STR_PRECOMPUTE_THRESHOLD))
+    {
+      unsigned char buf[BUF_ALLOC];
+      size_t n;
+      n = mpn_sb_get_str (buf, (size_t) 0, up, un, base) - buf;
+      (*func) (data, buf, n);
+      return n;
+    }
+
+  TMP_MARK;
+  powtab_mem = TMP_BALLOC_LIMBS (mpn_dc_get_str_powtab_alloc (un));
+  pi = get_str_compute_powtab (powtab, powtab_mem, un, base);
   tmp = TMP_BALLOC_LIMBS (mpn_dc_get_str_itch (un));
-  out_len = mpn_dc_get_str (str, 0, up, un, powtab + (pi - 1), tmp) - str;
+  mpn_dc_out_str (&sink, 0, up, un, powtab + pi, tmp);
   TMP_FREE;
 
-  return out_len;
+  return sink.total;
 }
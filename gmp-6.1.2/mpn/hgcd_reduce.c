@@ -211,7 +211,7 @@ mpn_hgcd_reduce_itch (mp_size_t n, mp_size_t p)
     }
   else
     {
-      itch = 2*(n-p) + mpn_hgcd_itch (n-p);
+      itch = 2*(n-p) + mpn_hgcd_appr_itch (n-p);
       /* Currently, hgcd_matrix_apply allocates its own storage. */
     }
   return itch;
@@ -42,6 +42,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
 
   if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD))
     {
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_BASECASE, n);
       mpn_mul_basecase (p, a, n, b, n);
     }
   else if (BELOW_THRESHOLD (n, MUL_TOOM33_THRESHOLD))
@@ -50,6 +51,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       mp_limb_t ws[mpn_toom22_mul_itch (MUL_TOOM33_THRESHOLD_LIMIT-1,
 					MUL_TOOM33_THRESHOLD_LIMIT-1)];
       ASSERT (MUL_TOOM33_THRESHOLD <= MUL_TOOM33_THRESHOLD_LIMIT);
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_TOOM22, n);
       mpn_toom22_mul (p, a, n, b, n, ws);
     }
   else if (BELOW_THRESHOLD (n, MUL_TOOM44_THRESHOLD))
@@ -58,6 +60,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom33_mul_itch (n, n));
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_TOOM33, n);
       mpn_toom33_mul (p, a, n, b, n, ws);
       TMP_SFREE;
     }
@@ -67,6 +70,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom44_mul_itch (n, n));
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_TOOM44, n);
       mpn_toom44_mul (p, a, n, b, n, ws);
       TMP_SFREE;
     }
@@ -76,6 +80,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       TMP_SDECL;
       TMP_SMARK;
       ws = TMP_SALLOC_LIMBS (mpn_toom6_mul_n_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_TOOM6H, n);
       mpn_toom6h_mul (p, a, n, b, n, ws);
       TMP_SFREE;
     }
@@ -85,6 +90,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
       TMP_DECL;
       TMP_MARK;
       ws = TMP_ALLOC_LIMBS (mpn_toom8_mul_n_itch (n));
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_TOOM8H, n);
       mpn_toom8h_mul (p, a, n, b, n, ws);
       TMP_FREE;
     }
@@ -92,6 +98,7 @@ mpn_mul_n (mp_ptr p, mp_srcptr a, mp_srcptr b, mp_size_t n)
     {
       /* The current FFT code allocates its own space.  That should probably
 	 change.  */
+      GMP_STATS_COUNT (GMP_STATS_MUL_N_FFT, n);
       mpn_fft_mul (p, a, n, b, n);
     }
 }
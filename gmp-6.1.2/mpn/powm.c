@@ -206,12 +206,14 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 #if WANT_REDC_2
   if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_2_THRESHOLD))
     {
+      GMP_STATS_COUNT (GMP_STATS_POWM_REDC_1, n);
       mip = ip;
       binvert_limb (mip[0], mp[0]);
       mip[0] = -mip[0];
     }
   else if (BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
     {
+      GMP_STATS_COUNT (GMP_STATS_POWM_REDC_2, n);
       mip = ip;
       mpn_binvert (mip, mp, 2, tp);
       mip[0] = -mip[0]; mip[1] = ~mip[1];
@@ -219,6 +221,7 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 #else
   if (BELOW_THRESHOLD (n, REDC_1_TO_REDC_N_THRESHOLD))
     {
+      GMP_STATS_COUNT (GMP_STATS_POWM_REDC_1, n);
       mip = ip;
       binvert_limb (mip[0], mp[0]);
       mip[0] = -mip[0];
@@ -226,6 +229,7 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 #endif
   else
     {
+      GMP_STATS_COUNT (GMP_STATS_POWM_REDC_N, n);
       mip = TMP_ALLOC_LIMBS (n);
       mpn_binvert (mip, mp, n, tp);
     }
@@ -350,7 +354,10 @@ mpn_powm (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
 	      INNERLOOP;
 	    }
 	}
-      else if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD))
+      /* A fat binary can have MUL_TOOM22_THRESHOLD above
+	 REDC_2_TO_REDC_N_THRESHOLD, and mip is then for mpn_redc_n.  */
+      else if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD)
+	       && BELOW_THRESHOLD (n, REDC_2_TO_REDC_N_THRESHOLD))
 	{
 	  if (MUL_TOOM22_THRESHOLD < SQR_BASECASE_THRESHOLD
 	      || BELOW_THRESHOLD (n, SQR_BASECASE_THRESHOLD))
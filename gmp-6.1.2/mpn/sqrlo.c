@@ -38,7 +38,7 @@ see https://www.gnu.org/licenses/.  */
 #include "gmp.h"
 #include "gmp-impl.h"
 
-#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY
+#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY || WANT_RUNTIME_TUNING
 #define MAYBE_range_basecase 1
 #define MAYBE_range_toom22   1
 #else
@@ -228,7 +228,9 @@ mpn_sqrlo (mp_ptr rp, mp_srcptr xp, mp_size_t n)
 	{
 	  /* For really large operands, use plain mpn_mul_n but throw away upper n
 	     limbs of result.  */
-#if !TUNE_PROGRAM_BUILD && (SQRLO_SQR_THRESHOLD > SQR_FFT_THRESHOLD)
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
+	  mpn_sqr (tp, xp, n);
+#elif SQRLO_SQR_THRESHOLD > SQR_FFT_THRESHOLD
 	  mpn_fft_mul (tp, xp, n, xp, n);
 #else
 	  mpn_sqr (tp, xp, n);
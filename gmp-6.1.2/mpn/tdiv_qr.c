@@ -63,6 +63,7 @@ mpn_tdiv_qr (mp_ptr qp, mp_ptr rp, mp_size_t qxn,
 
     case 1:
       {
+	GMP_STATS_COUNT (GMP_STATS_TDIV_QR_1, nn);
 	rp[0] = mpn_divrem_1 (qp, (mp_size_t) 0, np, nn, dp[0]);
 	return;
       }
@@ -73,6 +74,7 @@ mpn_tdiv_qr (mp_ptr qp, mp_ptr rp, mp_size_t qxn,
 	mp_limb_t qhl, cy;
 	TMP_DECL;
 	TMP_MARK;
+	GMP_STATS_COUNT (GMP_STATS_TDIV_QR_2, nn);
 	if ((dp[1] & GMP_NUMB_HIGHBIT) == 0)
 	  {
 	    int cnt;
@@ -143,16 +145,23 @@ mpn_tdiv_qr (mp_ptr qp, mp_ptr rp, mp_size_t qxn,
 
 	    invert_pi1 (dinv, d2p[dn - 1], d2p[dn - 2]);
 	    if (BELOW_THRESHOLD (dn, DC_DIV_QR_THRESHOLD))
-	      mpn_sbpi1_div_qr (qp, n2p, nn, d2p, dn, dinv.inv32);
+	      {
+		GMP_STATS_COUNT (GMP_STATS_TDIV_QR_SBPI1, dn);
+		mpn_sbpi1_div_qr (qp, n2p, nn, d2p, dn, dinv.inv32);
+	      }
 	    else if (BELOW_THRESHOLD (dn, MUPI_DIV_QR_THRESHOLD) ||   /* fast condition */
 		     BELOW_THRESHOLD (nn, 2 * MU_DIV_QR_THRESHOLD) || /* fast condition */
 		     (double) (2 * (MU_DIV_QR_THRESHOLD - MUPI_DIV_QR_THRESHOLD)) * dn /* slow... */
 		     + (double) MUPI_DIV_QR_THRESHOLD * nn > (double) dn * nn)    /* ...condition */
-	      mpn_dcpi1_div_qr (qp, n2p, nn, d2p, dn, &dinv);
+	      {
+		GMP_STATS_COUNT (GMP_STATS_TDIV_QR_DCPI1, dn);
+		mpn_dcpi1_div_qr (qp, n2p, nn, d2p, dn, &dinv);
+	      }
 	    else
 	      {
 		mp_size_t itch = mpn_mu_div_qr_itch (nn, dn, 0);
 		mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
+		GMP_STATS_COUNT (GMP_STATS_TDIV_QR_MU, dn);
 		mpn_mu_div_qr (qp, rp, n2p, nn, d2p, dn, scratch);
 		n2p = rp;
 	      }
@@ -263,24 +272,35 @@ mpn_tdiv_qr (mp_ptr qp, mp_ptr rp, mp_size_t qxn,
 	    if (qn == 1)
 	      {
 		mp_limb_t q0, r0;
+		GMP_STATS_COUNT (GMP_STATS_TDIV_QR_1, qn);
 		udiv_qrnnd (q0, r0, n2p[1], n2p[0] << GMP_NAIL_BITS, d2p[0] << GMP_NAIL_BITS);
 		n2p[0] = r0 >> GMP_NAIL_BITS;
 		qp[0] = q0;
 	      }
 	    else if (qn == 2)
-	      mpn_divrem_2 (qp, 0L, n2p, 4L, d2p); /* FIXME: obsolete function */
+	      {
+		GMP_STATS_COUNT (GMP_STATS_TDIV_QR_2, qn);
+		mpn_divrem_2 (qp, 0L, n2p, 4L, d2p); /* FIXME: obsolete function */
+	      }
 	    else
 	      {
 		invert_pi1 (dinv, d2p[qn - 1], d2p[qn - 2]);
 		if (BELOW_THRESHOLD (qn, DC_DIV_QR_THRESHOLD))
-		  mpn_sbpi1_div_qr (qp, n2p, 2 * qn, d2p, qn, dinv.inv32);
+		  {
+		    GMP_STATS_COUNT (GMP_STATS_TDIV_QR_SBPI1, qn);
+		    mpn_sbpi1_div_qr (qp, n2p, 2 * qn, d2p, qn, dinv.inv32);
+		  }
 		else if (BELOW_THRESHOLD (qn, MU_DIV_QR_THRESHOLD))
-		  mpn_dcpi1_div_qr (qp, n2p, 2 * qn, d2p, qn, &dinv);
+		  {
+		    GMP_STATS_COUNT (GMP_STATS_TDIV_QR_DCPI1, qn);
+		    mpn_dcpi1_div_qr (qp, n2p, 2 * qn, d2p, qn, &dinv);
+		  }
 		else
 		  {
 		    mp_size_t itch = mpn_mu_div_qr_itch (2 * qn, qn, 0);
 		    mp_ptr scratch = TMP_ALLOC_LIMBS (itch);
 		    mp_ptr r2p = rp;
+		    GMP_STATS_COUNT (GMP_STATS_TDIV_QR_MU, qn);
 		    if (np == r2p)	/* If N and R share space, put ... */
 		      r2p += nn - qn;	/* intermediate remainder at N's upper end. */
 		    mpn_mu_div_qr (qp, r2p, n2p, 2 * qn, d2p, qn, scratch);
@@ -52,7 +52,7 @@ see https://www.gnu.org/licenses/.  */
   vinf=      a1 *     b1   # A(inf)*B(inf)
 */
 
-#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY
+#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY || WANT_RUNTIME_TUNING
 #define MAYBE_mul_toom22   1
 #else
 #define MAYBE_mul_toom22						\
@@ -49,17 +49,22 @@ see https://www.gnu.org/licenses/.  */
   vinf=      a1 ^2  # A(inf)^2
 */
 
-#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY
+#if TUNE_PROGRAM_BUILD || WANT_FAT_BINARY || WANT_RUNTIME_TUNING
 #define MAYBE_sqr_toom2   1
 #else
 #define MAYBE_sqr_toom2							\
   (SQR_TOOM3_THRESHOLD >= 2 * SQR_TOOM2_THRESHOLD)
 #endif
 
+/* As in mpn_sqr, SQR_TOOM2_THRESHOLD 0 means squares below
+   SQR_BASECASE_THRESHOLD are done by mpn_mul_basecase and bigger ones by
+   toom2, so the recursion must stop there too.  */
 #define TOOM2_SQR_REC(p, a, n, ws)					\
   do {									\
-    if (! MAYBE_sqr_toom2						\
-	|| BELOW_THRESHOLD (n, SQR_TOOM2_THRESHOLD))			\
+    if (BELOW_THRESHOLD (n, SQR_BASECASE_THRESHOLD))			\
+      mpn_mul_basecase (p, a, n, a, n);					\
+    else if (! MAYBE_sqr_toom2						\
+	     || BELOW_THRESHOLD (n, SQR_TOOM2_THRESHOLD))		\
       mpn_sqr_basecase (p, a, n);					\
     else								\
       mpn_toom2_sqr (p, a, n, ws);					\
@@ -44,7 +44,7 @@ see https://www.gnu.org/licenses/.  */
 #endif
 
 
-#if TUNE_PROGRAM_BUILD
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
 #define MAYBE_sqr_basecase 1
 #define MAYBE_sqr_above_basecase   1
 #define MAYBE_sqr_toom2   1
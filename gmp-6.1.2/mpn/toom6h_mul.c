@@ -43,7 +43,7 @@ see https://www.gnu.org/licenses/.  */
 #error Not implemented.
 #endif
 
-#if TUNE_PROGRAM_BUILD
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
 #define MAYBE_mul_basecase 1
 #define MAYBE_mul_toom22   1
 #define MAYBE_mul_toom33   1
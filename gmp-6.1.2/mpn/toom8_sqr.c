@@ -58,7 +58,7 @@ see https://www.gnu.org/licenses/.  */
 #define SQR_TOOM6_THRESHOLD MUL_TOOM6H_THRESHOLD
 #endif
 
-#if TUNE_PROGRAM_BUILD
+#if TUNE_PROGRAM_BUILD || WANT_RUNTIME_TUNING
 #define MAYBE_sqr_basecase 1
 #define MAYBE_sqr_above_basecase   1
 #define MAYBE_sqr_toom2   1
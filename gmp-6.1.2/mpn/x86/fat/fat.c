@@ -194,6 +194,7 @@ struct cpuvec_t __gmpn_cpuvec = {
   __MPN(redc_1_init),
   __MPN(redc_2_init),
   __MPN(rshift_init),
+  __MPN(sec_powm_lanes_init),
   __MPN(sqr_basecase_init),
   __MPN(sub_n_init),
   0,
@@ -98,6 +98,7 @@ define(CPUVEC_FUNCS_LIST,
 `redc_1',
 `redc_2',
 `rshift',
+`sec_powm_lanes',
 `sqr_basecase',
 `sub_n',
 `sublsh1_n',
@@ -48,6 +48,7 @@ see https://www.gnu.org/licenses/.  */
 
 /* fat_entry.asm */
 long __gmpn_cpuid (char [12], int);
+long __gmpn_xgetbv (int);
 
 
 #if WANT_FAKE_CPUID
@@ -180,6 +181,7 @@ struct cpuvec_t __gmpn_cpuvec = {
   __MPN(redc_1_init),
   __MPN(redc_2_init),
   __MPN(rshift_init),
+  __MPN(sec_powm_lanes_init),
   __MPN(sqr_basecase_init),
   __MPN(sub_n_init),
   __MPN(sublsh1_n_init),
@@ -189,6 +191,8 @@ struct cpuvec_t __gmpn_cpuvec = {
 
 int __gmpn_cpuvec_initialized = 0;
 
+struct cpuvec_ifma_t __gmpn_cpuvec_ifma;
+
 /* The following setups start with generic x86, then overwrite with
    specifics for a chip, and higher versions of that chip.
 
@@ -206,6 +210,8 @@ int __gmpn_cpuvec_initialized = 0;
    asm routines only operate correctly up to their own defined threshold,
    not an arbitrary value.  */
 
+enum {BMI2_BIT = 8, AVX512F_BIT = 16, AVX512IFMA_BIT = 21, OSXSAVE_BIT = 27};
+
 static int
 gmp_workaround_skylake_cpuid_bug ()
 {
@@ -247,7 +253,19 @@ gmp_workaround_skylake_cpuid_bug ()
   return 0;
 }
 
-enum {BMI2_BIT = 8};
+/* Whether the operating system saves the AVX-512 state, the zmm and
+   opmask registers as well as xmm and ymm, in XCR0 bits 1, 2 and 5 to 7.  */
+static int
+gmp_avx512_os_p (void)
+{
+  char dummy_string[12];
+
+  __gmpn_cpuid (dummy_string, 1);
+  if ((dummy_string[8 + OSXSAVE_BIT / 8] & (1 << (OSXSAVE_BIT % 8))) == 0)
+    return 0;
+  return (__gmpn_xgetbv (0) & 0xe6) == 0xe6;
+}
+
 
 void
 __gmpn_cpuvec_init (void)
@@ -435,6 +453,23 @@ __gmpn_cpuvec_init (void)
 	}
     }
 
+#ifdef CPUVEC_SETUP_ifma
+  /* AVX-512 IFMA goes on top of whatever cpu was found, keeping the
+     functions decided so far for the sizes it doesn't take.  */
+  __gmpn_cpuid (dummy_string, 7);
+  if ((dummy_string[AVX512F_BIT / 8] & (1 << (AVX512F_BIT % 8))) != 0
+      && (dummy_string[AVX512IFMA_BIT / 8] & (1 << (AVX512IFMA_BIT % 8))) != 0
+      && gmp_avx512_os_p ())
+    {
+      __gmpn_cpuvec_ifma.mul_basecase = decided_cpuvec.mul_basecase;
+      __gmpn_cpuvec_ifma.redc_1 = decided_cpuvec.redc_1;
+      __gmpn_cpuvec_ifma.redc_2 = decided_cpuvec.redc_2;
+      __gmpn_cpuvec_ifma.sec_powm_lanes = decided_cpuvec.sec_powm_lanes;
+      __gmpn_cpuvec_ifma.sqr_basecase = decided_cpuvec.sqr_basecase;
+      CPUVEC_SETUP_ifma;
+    }
+#endif
+
   /* There's no x86 generic mpn_preinv_divrem_1 or mpn_preinv_mod_1.
      Instead default to the plain versions from whichever CPU we detected.
      The function arguments are compatible, no need for any glue code.  */
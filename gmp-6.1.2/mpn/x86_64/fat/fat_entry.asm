@@ -205,3 +205,19 @@ PROLOGUE(__gmpn_cpuid)
 	FUNC_EXIT()
 	ret
 EPILOGUE()
+
+
+C long __gmpn_xgetbv (int id);
+C
+C Used only after cpuid has shown OSXSAVE.  The instruction is given as
+C bytes for the benefit of old assemblers.
+
+PROLOGUE(__gmpn_xgetbv)
+	FUNC_ENTRY(1)
+	mov	R32(%rdi), R32(%rcx)
+	.byte	0x0f, 0x01, 0xd0	C xgetbv
+	shl	$32, %rdx
+	or	%rdx, %rax
+	FUNC_EXIT()
+	ret
+EPILOGUE()
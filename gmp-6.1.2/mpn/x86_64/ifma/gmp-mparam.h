@@ -0,0 +1,44 @@
+/* AVX-512 IFMA gmp-mparam.h -- Compiler/machine parameter header file.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#define GMP_LIMB_BITS 64
+#define GMP_LIMB_BYTES 8
+
+/* Only the fat binary thresholds are here, read by configure for the
+   CPUVEC_SETUP_ifma applied on top of the cpu's own.  The IFMA basecase
+   functions stay ahead of Toom up to quite large sizes.  */
+
+/* 2100 MHz Xeon Emerald Rapids */
+
+#define MUL_TOOM22_THRESHOLD               200
+#define MUL_TOOM33_THRESHOLD               220
+
+#define SQR_TOOM2_THRESHOLD                360
+#define SQR_TOOM3_THRESHOLD                400
@@ -0,0 +1,387 @@
+/* Radix 2^52 helpers for the AVX-512 IFMA mpn functions.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+/* The vpmadd52luq and vpmadd52huq instructions multiply eight pairs of 52-bit
+   lanes and add the low or high 52 bits of each product to a 64-bit lane.
+   So operands are converted to 52-bit digits, and products accumulated
+   without carrying, each 64-bit lane having room for 2^11 or so products,
+   then carries are propagated once while converting back to limbs.  The
+   conversions are O(n), so these functions only pay from some moderate size,
+   and below that go to the plain functions the cpu would otherwise have,
+   from __gmpn_cpuvec_ifma.
+
+   The functions are compiled with a target attribute, not with -mavx512f
+   and friends, since in a fat binary only these must use AVX-512.
+
+   There's no IFMA mpn_addmul_1.  Its single limb operand gives O(n) work,
+   the same as converting {up,n} to digits and the result back, so it could
+   not beat the mulx or mul loops.  The functions here are those doing
+   O(n^2) work on the converted operands.
+
+   Nothing here branches on the data or uses it for addresses, only sizes,
+   so the mpn_sec functions can use this code as they do the plain code.  */
+
+#include <immintrin.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+#define IFMA_FUNCTION  __attribute__ ((__target__ ("avx512f,avx512ifma")))
+
+#define D52_BITS  52
+#define D52_MASK  ((CNST_LIMB(1) << D52_BITS) - 1)
+
+/* Digits in N limbs.  */
+#define D52_DIGITS(n)  (((n) * GMP_LIMB_BITS + D52_BITS - 1) / D52_BITS)
+
+/* Lanes accumulate up to two products below 2^52 for each digit of an
+   operand, so operands must be below 2^11 digits.  */
+#define D52_MAX_LIMBS  1663
+
+/* Zeroed digits either side of an operand in d52_mul and d52_sqr.  */
+#define D52_PAD  16
+
+/* Return a pointer to an array of N digits, aligned for vector access.  */
+#define D52_ALLOC(n) \
+  ((mp_ptr) (((size_t) TMP_ALLOC_LIMBS ((n) + 8) + 63) & ~ (size_t) 63))
+
+/* Mask for the lanes below LIMIT of a vector of 8 starting at lane 0.  */
+static inline __mmask8
+d52_lanes (mp_size_t limit)
+{
+  return limit <= 0 ? 0 : limit >= 8 ? 0xff : (1 << limit) - 1;
+}
+
+/* 13 limbs are 16 digits.  Digit t of such a group is limb q = 52t/64
+   shifted right by r = 52t%64, or-ed with limb q+1 shifted left by 64-r.
+   Limb j is digit a = 64j/52 shifted right by r = 64j%52, or-ed with digit
+   a+1 shifted left by 52-r and digit a+2 shifted left by 104-r.  Shifts of
+   64 or more give 0 in vpsrlvq and vpsllvq, so the terms not wanted need no
+   special case.  */
+static const mp_limb_t d52_from_tab[2][3][8] = {
+  { { 0, 0, 1, 2, 3, 4, 4, 5 },
+    { 0, 52, 40, 28, 16, 4, 56, 44 },
+    { 64, 12, 24, 36, 48, 60, 8, 20 } },
+  { { 6, 7, 8, 8, 9, 10, 11, 12 },
+    { 32, 20, 8, 60, 48, 36, 24, 12 },
+    { 32, 44, 56, 4, 16, 28, 40, 52 } }
+};
+static const mp_limb_t d52_to_tab[2][4][8] = {
+  { { 0, 1, 2, 3, 4, 6, 7, 8 },
+    { 0, 12, 24, 36, 48, 8, 20, 32 },
+    { 52, 40, 28, 16, 4, 44, 32, 20 },
+    { 104, 92, 80, 68, 56, 96, 84, 72 } },
+  { { 9, 11, 12, 13, 14, 0, 0, 0 },
+    { 44, 4, 16, 28, 40, 0, 0, 0 },
+    { 8, 48, 36, 24, 12, 64, 64, 64 },
+    { 60, 100, 88, 76, 64, 64, 64, 64 } }
+};
+
+/* Set {dp,dn} to the digits of {up,un}, zero above it.  */
+IFMA_FUNCTION static inline void
+d52_from_limbs (mp_ptr dp, mp_size_t dn, mp_srcptr up, mp_size_t un)
+{
+  __m512i l, h, one, v;
+  mp_size_t i, k;
+  int t;
+
+  one = _mm512_set1_epi64 (1);
+  for (i = 0, k = 0; k < dn; i += 13, k += 16)
+    {
+      l = _mm512_maskz_loadu_epi64 (d52_lanes (un - i), up + i);
+      h = _mm512_maskz_loadu_epi64 (d52_lanes (un - i - 8), up + i + 8);
+      for (t = 0; t < 2; t++)
+	{
+	  __m512i a = _mm512_loadu_si512 (d52_from_tab[t][0]);
+	  v = _mm512_or_si512
+	    (_mm512_srlv_epi64 (_mm512_permutex2var_epi64 (l, a, h),
+				_mm512_loadu_si512 (d52_from_tab[t][1])),
+	     _mm512_sllv_epi64 (_mm512_permutex2var_epi64
+				(l, _mm512_add_epi64 (a, one), h),
+				_mm512_loadu_si512 (d52_from_tab[t][2])));
+	  _mm512_mask_storeu_epi64 (dp + k + 8 * t, d52_lanes (dn - k - 8 * t),
+				    _mm512_and_si512 (v, _mm512_set1_epi64
+						      (D52_MASK)));
+	}
+    }
+}
+
+/* Set {rp,rn} to the value of the unnormalized digits {dp,dn}, plus CY in
+   the lowest.  The value must fit.  {dp,dn} is clobbered.
+
+   Carries are propagated a vector at a time.  Adding the part of each lane
+   above 52 bits to the next leaves each lane below 2^52+2^12, and then the
+   only carries are single bits.  A lane generates one if it's 2^52 or more,
+   or passes one on if it's exactly 2^52-1, and which lanes receive one
+   follows from an addition of those as bit masks.  */
+IFMA_FUNCTION static inline void
+d52_to_limbs (mp_ptr rp, mp_size_t rn, mp_ptr dp, mp_size_t dn, mp_limb_t cy)
+{
+  __m512i mask, one, x, y, v, d0, d1, a;
+  __mmask8 lanes;
+  mp_size_t i, k;
+  unsigned g, p, c;
+  int t;
+
+  mask = _mm512_set1_epi64 (D52_MASK);
+  one = _mm512_set1_epi64 (1);
+  for (k = 0; k < dn; k += 8)
+    {
+      lanes = d52_lanes (dn - k);
+      x = _mm512_maskz_loadu_epi64 (lanes, dp + k);
+      y = _mm512_add_epi64 (_mm512_and_si512 (x, mask),
+			    _mm512_alignr_epi64 (_mm512_srli_epi64 (x, D52_BITS),
+						 _mm512_set1_epi64 (cy), 7));
+      cy = dn - k >= 8 ? dp[k + 7] >> D52_BITS : 0;
+      g = _mm512_cmpgt_epu64_mask (y, mask);
+      p = _mm512_cmpeq_epu64_mask (y, mask);
+      c = (g << 1) + p;
+      y = _mm512_mask_add_epi64 (y, (__mmask8) (c ^ p), y, one);
+      _mm512_mask_storeu_epi64 (dp + k, lanes, _mm512_and_si512 (y, mask));
+      cy += c >> 8;
+    }
+  ASSERT (cy == 0);
+
+  for (i = 0, k = 0; i < rn; i += 13, k += 16)
+    {
+      d0 = _mm512_maskz_loadu_epi64 (d52_lanes (dn - k), dp + k);
+      d1 = _mm512_maskz_loadu_epi64 (d52_lanes (dn - k - 8), dp + k + 8);
+      for (t = 0; t < 2; t++)
+	{
+	  a = _mm512_loadu_si512 (d52_to_tab[t][0]);
+	  v = _mm512_srlv_epi64 (_mm512_permutex2var_epi64 (d0, a, d1),
+				 _mm512_loadu_si512 (d52_to_tab[t][1]));
+	  a = _mm512_add_epi64 (a, one);
+	  v = _mm512_or_si512
+	    (v, _mm512_sllv_epi64 (_mm512_permutex2var_epi64 (d0, a, d1),
+				   _mm512_loadu_si512 (d52_to_tab[t][2])));
+	  a = _mm512_add_epi64 (a, one);
+	  v = _mm512_or_si512
+	    (v, _mm512_sllv_epi64 (_mm512_permutex2var_epi64 (d0, a, d1),
+				   _mm512_loadu_si512 (d52_to_tab[t][3])));
+	  _mm512_mask_storeu_epi64 (rp + i + 8 * t,
+				    d52_lanes (MIN (rn - i, 13) - 8 * t), v);
+	}
+    }
+}
+
+/* Set {pp,an+bn} to the unnormalized digits of {ap,an} times {bp,bn},
+   with D52_PAD zero digits below and above {ap,an}.  pp must have room for
+   an+bn rounded up to a multiple of 16.
+
+   Each pass forms 16 output digits, as two vectors for the low halves and
+   two for the high halves of the products.  Output digit d gets the low half
+   of a[d-j]*b[j] and the high half of a[d-1-j]*b[j], so the vector of a
+   used for the high halves at j is the one for the low halves at j+1.  */
+IFMA_FUNCTION static inline void
+d52_mul (mp_ptr pp, mp_srcptr ap, mp_size_t an, mp_srcptr bp, mp_size_t bn)
+{
+  __m512i l0, l1, h0, h1, x0, x1, y0, y1, b;
+  mp_size_t d, j, jlo, jhi;
+
+  for (d = 0; d < an + bn; d += 16)
+    {
+      jlo = MAX (0, d - an);
+      jhi = MIN (bn - 1, d + 15);
+
+      l0 = l1 = h0 = h1 = _mm512_setzero_si512 ();
+      x0 = _mm512_loadu_si512 (ap + d - jlo);
+      x1 = _mm512_loadu_si512 (ap + d + 8 - jlo);
+      for (j = jlo; j <= jhi; j++)
+	{
+	  b = _mm512_set1_epi64 (bp[j]);
+	  y0 = _mm512_loadu_si512 (ap + d - 1 - j);
+	  y1 = _mm512_loadu_si512 (ap + d + 7 - j);
+	  l0 = _mm512_madd52lo_epu64 (l0, x0, b);
+	  l1 = _mm512_madd52lo_epu64 (l1, x1, b);
+	  h0 = _mm512_madd52hi_epu64 (h0, y0, b);
+	  h1 = _mm512_madd52hi_epu64 (h1, y1, b);
+	  x0 = y0;
+	  x1 = y1;
+	}
+      _mm512_storeu_si512 (pp + d, _mm512_add_epi64 (l0, h0));
+      _mm512_storeu_si512 (pp + d + 8, _mm512_add_epi64 (l1, h1));
+    }
+}
+
+/* Set {pp,2an} to the unnormalized digits of {ap,an} squared, with
+   D52_PAD zero digits below and above {ap,an}.  pp must have room for 2an
+   rounded up to a multiple of 16.
+
+   As d52_mul, but only the products a[i]*a[j] with i > j are formed, by
+   masking off the lanes with i <= j, then doubled, and the squares a[j]^2
+   added at the end.  */
+IFMA_FUNCTION static inline void
+d52_sqr (mp_ptr pp, mp_srcptr ap, mp_size_t an)
+{
+  __m512i l0, l1, h0, h1, x0, x1, y0, y1, b;
+  mp_limb_t hi, lo;
+  mp_size_t d, j, jlo, jhi;
+  unsigned ml, mh;
+  int k;
+
+  for (d = 0; d < 2 * an; d += 16)
+    {
+      jlo = MAX (0, d - an);
+      jhi = MIN (an - 1, (d + 14) / 2);
+
+      l0 = l1 = h0 = h1 = _mm512_setzero_si512 ();
+      x0 = _mm512_loadu_si512 (ap + d - jlo);
+      x1 = _mm512_loadu_si512 (ap + d + 8 - jlo);
+      /* Lane t has i = d+t-j for the low halves, d+t-1-j for the high
+	 halves, so wants t > 2j-d or t > 2j-d+1, which is all lanes up to
+	 j = (d-2)/2.  */
+      for (j = jlo; j <= MIN (jhi, (d - 2) / 2); j++)
+	{
+	  b = _mm512_set1_epi64 (ap[j]);
+	  y0 = _mm512_loadu_si512 (ap + d - 1 - j);
+	  y1 = _mm512_loadu_si512 (ap + d + 7 - j);
+	  l0 = _mm512_madd52lo_epu64 (l0, x0, b);
+	  l1 = _mm512_madd52lo_epu64 (l1, x1, b);
+	  h0 = _mm512_madd52hi_epu64 (h0, y0, b);
+	  h1 = _mm512_madd52hi_epu64 (h1, y1, b);
+	  x0 = y0;
+	  x1 = y1;
+	}
+      for ( ; j <= jhi; j++)
+	{
+	  k = 2 * j - d + 1;
+	  ml = 0xffff << MAX (k, 0);
+	  mh = 0xffff << MAX (k + 1, 0);
+
+	  b = _mm512_set1_epi64 (ap[j]);
+	  y0 = _mm512_loadu_si512 (ap + d - 1 - j);
+	  y1 = _mm512_loadu_si512 (ap + d + 7 - j);
+	  l0 = _mm512_mask_madd52lo_epu64 (l0, (__mmask8) ml, x0, b);
+	  l1 = _mm512_mask_madd52lo_epu64 (l1, (__mmask8) (ml >> 8), x1, b);
+	  h0 = _mm512_mask_madd52hi_epu64 (h0, (__mmask8) mh, y0, b);
+	  h1 = _mm512_mask_madd52hi_epu64 (h1, (__mmask8) (mh >> 8), y1, b);
+	  x0 = y0;
+	  x1 = y1;
+	}
+      _mm512_storeu_si512 (pp + d,
+			   _mm512_slli_epi64 (_mm512_add_epi64 (l0, h0), 1));
+      _mm512_storeu_si512 (pp + d + 8,
+			   _mm512_slli_epi64 (_mm512_add_epi64 (l1, h1), 1));
+    }
+
+  for (j = 0; j < an; j++)
+    {
+      umul_ppmm (hi, lo, ap[j], ap[j]);
+      pp[2 * j] += lo & D52_MASK;
+      pp[2 * j + 1] += hi << (GMP_LIMB_BITS - D52_BITS) | lo >> D52_BITS;
+    }
+}
+
+/* Set {rp,n} to {up,2n} / B^n mod {mp,n}, less than 2*M, as mpn_redc_1
+   with the given INVM, returning the carry.
+
+   With U = Ulo + Uhi*B^n, the result is Uhi + (Ulo + Q*M)/B^n, Q being
+   determined by Ulo alone.  Ulo is reduced in a window of digits, each step
+   adding q*M to clear the low digit, then moving the window down a digit,
+   the high halves of q*M going in after the move.  The carry out of the low
+   digit is held in a limb, rather than the window.
+
+   B^n is not a power of 2^52, so the last step clears only the bits left
+   below B^n, and the result is the window shifted right past them.  */
+
+IFMA_FUNCTION static inline mp_limb_t
+d52_redc (mp_ptr rp, mp_srcptr up, mp_srcptr mp, mp_size_t n, mp_limb_t invm)
+{
+  __m512i zero, q, r0, r1, m, h, hp;
+  mp_ptr md, wp, xp;
+  mp_limb_t minv, t, c, qd, cy;
+  mp_size_t s, nb, i, b;
+  int w;
+  TMP_DECL;
+
+  TMP_MARK;
+  s = D52_DIGITS (n);
+  w = n * GMP_LIMB_BITS - (s - 1) * D52_BITS;
+  nb = s / 8 + 1;		/* a zero digit above M, for the high halves */
+
+  md = D52_ALLOC (8 * nb);
+  wp = D52_ALLOC (8 * nb);
+  xp = TMP_ALLOC_LIMBS (n + 1);
+  d52_from_limbs (md, 8 * nb, mp, n);
+  d52_from_limbs (wp, 8 * nb, up, n);
+
+  zero = _mm512_setzero_si512 ();
+  minv = invm & D52_MASK;
+  c = 0;
+  for (i = 0; i < s - 1; i++)
+    {
+      t = wp[0] + c;
+      qd = (t * minv) & D52_MASK;
+      c = (t + (qd * md[0] & D52_MASK)) >> D52_BITS;
+      q = _mm512_set1_epi64 (qd);
+
+      r0 = _mm512_madd52lo_epu64 (_mm512_load_si512 (wp),
+				  _mm512_load_si512 (md), q);
+      for (b = 0; b < nb; b++)
+	{
+	  m = _mm512_load_si512 (md + 8 * b);
+	  r1 = b + 1 < nb
+	    ? _mm512_madd52lo_epu64 (_mm512_load_si512 (wp + 8 * b + 8),
+				     _mm512_load_si512 (md + 8 * b + 8), q)
+	    : zero;
+	  h = _mm512_madd52hi_epu64 (zero, m, q);
+	  _mm512_store_si512 (wp + 8 * b,
+			      _mm512_add_epi64 (_mm512_alignr_epi64 (r1, r0, 1),
+						h));
+	  r0 = r1;
+	}
+    }
+
+  t = wp[0] + c;
+  qd = (t * minv) & (D52_MASK >> (D52_BITS - w));
+  q = _mm512_set1_epi64 (qd);
+  hp = zero;
+  for (b = 0; b < nb; b++)
+    {
+      m = _mm512_load_si512 (md + 8 * b);
+      r0 = _mm512_madd52lo_epu64 (_mm512_load_si512 (wp + 8 * b), m, q);
+      h = _mm512_madd52hi_epu64 (zero, m, q);
+      _mm512_store_si512 (wp + 8 * b,
+			  _mm512_add_epi64 (r0, _mm512_alignr_epi64 (h, hp, 7)));
+      hp = h;
+    }
+
+  d52_to_limbs (xp, n + 1, wp, 8 * nb, c);
+  mpn_rshift (xp, xp, n + 1, w);
+  cy = mpn_add_n (rp, xp, up + n, n);
+  TMP_FREE;
+  return cy;
+}
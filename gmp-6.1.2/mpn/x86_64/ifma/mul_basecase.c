@@ -0,0 +1,73 @@
+/* mpn_mul_basecase for AVX-512 IFMA.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "ifma.h"
+
+#ifndef MUL_BASECASE_IFMA_THRESHOLD
+#define MUL_BASECASE_IFMA_THRESHOLD  16
+#endif
+
+IFMA_FUNCTION void
+mpn_mul_basecase (mp_ptr rp, mp_srcptr up, mp_size_t un,
+		  mp_srcptr vp, mp_size_t vn)
+{
+  mp_ptr ap, bp, pp;
+  mp_size_t an, bn;
+  TMP_DECL;
+
+  ASSERT (un >= vn);
+  ASSERT (vn >= 1);
+  ASSERT (! MPN_OVERLAP_P (rp, un+vn, up, un));
+  ASSERT (! MPN_OVERLAP_P (rp, un+vn, vp, vn));
+
+  if (BELOW_THRESHOLD (vn, MUL_BASECASE_IFMA_THRESHOLD) || vn > D52_MAX_LIMBS)
+    {
+      (*__gmpn_cpuvec_ifma.mul_basecase) (rp, up, un, vp, vn);
+      return;
+    }
+
+  TMP_MARK;
+  an = D52_DIGITS (un);
+  bn = D52_DIGITS (vn);
+  ap = D52_ALLOC (an + 2 * D52_PAD) + D52_PAD;
+  bp = D52_ALLOC (bn);
+  pp = D52_ALLOC (an + bn + 15);
+
+  MPN_ZERO (ap - D52_PAD, D52_PAD);
+  d52_from_limbs (ap, an + D52_PAD, up, un);
+  d52_from_limbs (bp, bn, vp, vn);
+  d52_mul (pp, ap, an, bp, bn);
+  d52_to_limbs (rp, un + vn, pp, an + bn, 0);
+  TMP_FREE;
+}
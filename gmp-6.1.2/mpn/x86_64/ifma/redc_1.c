@@ -0,0 +1,51 @@
+/* mpn_redc_1 for AVX-512 IFMA.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "ifma.h"
+
+#ifndef REDC_1_IFMA_THRESHOLD
+#define REDC_1_IFMA_THRESHOLD  24
+#endif
+
+IFMA_FUNCTION mp_limb_t
+mpn_redc_1 (mp_ptr rp, mp_ptr up, mp_srcptr mp, mp_size_t n, mp_limb_t invm)
+{
+  ASSERT (n > 0);
+  ASSERT_MPN (up, 2*n);
+
+  if (BELOW_THRESHOLD (n, REDC_1_IFMA_THRESHOLD) || n > D52_MAX_LIMBS)
+    return (*__gmpn_cpuvec_ifma.redc_1) (rp, up, mp, n, invm);
+
+  return d52_redc (rp, up, mp, n, invm);
+}
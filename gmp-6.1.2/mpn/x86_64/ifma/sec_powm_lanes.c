@@ -0,0 +1,385 @@
+/* mpn_sec_powm_lanes for AVX-512 IFMA.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+/* The tuples go in the eight 64-bit lanes of a vector, so a number of s
+   digits is s vectors, digit j of tuple l being lane l of vector j, and
+   each vpmadd52 does the same step of eight separate Montgomery
+   multiplications.  Tuples missing from a partial group are filled in with
+   the first, and their results dropped.
+
+   R is 2^(52s) with s chosen so 4M < R.  Then with Montgomery
+   multiplication of operands below 2M the result is below 2M again, so no
+   subtraction is needed until the end, when the result is converted back
+   to limbs.  Table entries are selected in each lane separately with
+   masked moves over the whole table.  */
+
+#include "ifma.h"
+
+/* Fewer tuples than this do better one at a time, the lanes costing the
+   same however many are used.  */
+#ifndef SEC_POWM_LANES_IFMA_MIN_TUPLES
+#define SEC_POWM_LANES_IFMA_MIN_TUPLES  4
+#endif
+
+/* Digits of a modulus of N limbs, with 4M < R.  */
+#define LANES_DIGITS(n)  (((n) * GMP_LIMB_BITS + 2 + D52_BITS - 1) / D52_BITS)
+
+/* A lane accumulates four products below 2^52 for each digit of the
+   modulus, so it must be below 2^10 digits.  */
+#define LANES_MAX_LIMBS  800
+
+static inline mp_limb_t
+getbits (const mp_limb_t *p, mp_bitcnt_t bi, int nbits)
+{
+  int nbits_in_r;
+  mp_limb_t r;
+  mp_size_t i;
+
+  if (bi < nbits)
+    {
+      return p[0] & (((mp_limb_t) 1 << bi) - 1);
+    }
+  else
+    {
+      bi -= nbits;			/* bit index of low bit to extract */
+      i = bi / GMP_NUMB_BITS;		/* word index of low bit to extract */
+      bi %= GMP_NUMB_BITS;		/* bit index in low word */
+      r = p[i] >> bi;			/* extract (low) bits */
+      nbits_in_r = GMP_NUMB_BITS - bi;	/* number of bits now in r */
+      if (nbits_in_r < nbits)		/* did we get enough bits? */
+	r += p[i + 1] << nbits_in_r;	/* prepend bits from higher word */
+      return r & (((mp_limb_t ) 1 << nbits) - 1);
+    }
+}
+
+/* Set the S digit vectors at rp to A*B/R mod M in each lane, below 2M given
+   A and B below 2M.  The digits of A, B and the result are below 2^52.  rp
+   can be ap or bp.  wp is 2S vectors of scratch.
+
+   Each row adds a digit of B times A, and q times M to clear the low digit
+   of the window, the carry out of it going to the next, as in d52_redc.
+   The rest is normalized only at the end.  Rows go in pairs, so each load
+   and store of the window serves eight vpmadd52 rather than four.  */
+IFMA_FUNCTION static void
+lanes_mulredc (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_srcptr mp,
+	       __m512i minv, mp_size_t s, mp_ptr wp)
+{
+  __m512i zero, mask, a0, a1, a2, m0, m1, m2, b0, b1, q0, q1, t, c, x, y;
+  mp_ptr w;
+  mp_size_t i, j;
+
+  zero = _mm512_setzero_si512 ();
+  mask = _mm512_set1_epi64 (D52_MASK);
+  for (j = 0; j < 2 * s; j++)
+    _mm512_store_si512 (wp + 8 * j, zero);
+
+  for (i = 0; i + 1 < s; i += 2)
+    {
+      w = wp + 8 * i;
+      b0 = _mm512_load_si512 (bp + 8 * i);
+      b1 = _mm512_load_si512 (bp + 8 * i + 8);
+      a0 = _mm512_load_si512 (ap);
+      m0 = _mm512_load_si512 (mp);
+      a1 = _mm512_load_si512 (ap + 8);
+      m1 = _mm512_load_si512 (mp + 8);
+      t = _mm512_madd52lo_epu64 (_mm512_load_si512 (w), a0, b0);
+      q0 = _mm512_madd52lo_epu64 (zero, t, minv);
+      t = _mm512_madd52lo_epu64 (t, m0, q0);
+      c = _mm512_srli_epi64 (t, D52_BITS);
+      x = _mm512_madd52lo_epu64 (_mm512_load_si512 (w + 8), a1, b0);
+      x = _mm512_madd52lo_epu64 (x, m1, q0);
+      y = _mm512_madd52hi_epu64 (c, a0, b0);
+      y = _mm512_madd52hi_epu64 (y, m0, q0);
+      /* The second row's low digit, once the first has gone in.  */
+      t = _mm512_madd52lo_epu64 (_mm512_add_epi64 (x, y), a0, b1);
+      q1 = _mm512_madd52lo_epu64 (zero, t, minv);
+      t = _mm512_madd52lo_epu64 (t, m0, q1);
+      c = _mm512_srli_epi64 (t, D52_BITS);
+      for (j = 2; j < s; j++)
+	{
+	  a2 = _mm512_load_si512 (ap + 8 * j);
+	  m2 = _mm512_load_si512 (mp + 8 * j);
+	  x = _mm512_madd52lo_epu64 (_mm512_load_si512 (w + 8 * j), a2, b0);
+	  x = _mm512_madd52lo_epu64 (x, m2, q0);
+	  x = _mm512_madd52lo_epu64 (x, a1, b1);
+	  x = _mm512_madd52lo_epu64 (x, m1, q1);
+	  y = _mm512_madd52hi_epu64 (c, a1, b0);
+	  y = _mm512_madd52hi_epu64 (y, m1, q0);
+	  y = _mm512_madd52hi_epu64 (y, a0, b1);
+	  y = _mm512_madd52hi_epu64 (y, m0, q1);
+	  _mm512_store_si512 (w + 8 * j, _mm512_add_epi64 (x, y));
+	  a0 = a1;
+	  a1 = a2;
+	  m0 = m1;
+	  m1 = m2;
+	  c = zero;
+	}
+      x = _mm512_madd52lo_epu64 (_mm512_load_si512 (w + 8 * s), a1, b1);
+      x = _mm512_madd52lo_epu64 (x, m1, q1);
+      y = _mm512_madd52hi_epu64 (c, a1, b0);
+      y = _mm512_madd52hi_epu64 (y, m1, q0);
+      y = _mm512_madd52hi_epu64 (y, a0, b1);
+      y = _mm512_madd52hi_epu64 (y, m0, q1);
+      _mm512_store_si512 (w + 8 * s, _mm512_add_epi64 (x, y));
+      y = _mm512_madd52hi_epu64 (_mm512_load_si512 (w + 8 * s + 8), a1, b1);
+      y = _mm512_madd52hi_epu64 (y, m1, q1);
+      _mm512_store_si512 (w + 8 * s + 8, y);
+    }
+  /* With s odd, a last row on its own.  */
+  for ( ; i < s; i++)
+    {
+      w = wp + 8 * i;
+      b0 = _mm512_load_si512 (bp + 8 * i);
+      a0 = _mm512_load_si512 (ap);
+      m0 = _mm512_load_si512 (mp);
+      t = _mm512_madd52lo_epu64 (_mm512_load_si512 (w), a0, b0);
+      q0 = _mm512_madd52lo_epu64 (zero, t, minv);
+      t = _mm512_madd52lo_epu64 (t, m0, q0);
+      c = _mm512_srli_epi64 (t, D52_BITS);
+      for (j = 1; j < s; j++)
+	{
+	  a1 = _mm512_load_si512 (ap + 8 * j);
+	  m1 = _mm512_load_si512 (mp + 8 * j);
+	  x = _mm512_madd52lo_epu64 (_mm512_load_si512 (w + 8 * j), a1, b0);
+	  x = _mm512_madd52lo_epu64 (x, m1, q0);
+	  y = _mm512_madd52hi_epu64 (c, a0, b0);
+	  y = _mm512_madd52hi_epu64 (y, m0, q0);
+	  _mm512_store_si512 (w + 8 * j, _mm512_add_epi64 (x, y));
+	  a0 = a1;
+	  m0 = m1;
+	  c = zero;
+	}
+      y = _mm512_madd52hi_epu64 (c, a0, b0);
+      y = _mm512_madd52hi_epu64 (y, m0, q0);
+      _mm512_store_si512 (w + 8 * s,
+			  _mm512_add_epi64 (_mm512_load_si512 (w + 8 * s), y));
+    }
+
+  c = zero;
+  for (j = 0; j < s; j++)
+    {
+      x = _mm512_add_epi64 (_mm512_load_si512 (wp + 8 * (s + j)), c);
+      _mm512_store_si512 (rp + 8 * j, _mm512_and_si512 (x, mask));
+      c = _mm512_srli_epi64 (x, D52_BITS);
+    }
+}
+
+/* Set the S digit vectors at rp to entry WHICH of the NENTS in the table at
+   tab, WHICH being per lane.  The whole table is read, and the entries
+   wanted picked up with masked moves.  */
+IFMA_FUNCTION static void
+lanes_tabselect (mp_ptr rp, mp_srcptr tab, mp_size_t s, int nents,
+		 __m512i which)
+{
+  __mmask8 m[1 << 6];
+  __m512i r;
+  mp_size_t j;
+  int e;
+
+  ASSERT (nents <= 1 << 6);
+
+  for (e = 0; e < nents; e++)
+    m[e] = _mm512_cmpeq_epi64_mask (which, _mm512_set1_epi64 (e));
+
+  for (j = 0; j < s; j++)
+    {
+      r = _mm512_setzero_si512 ();
+      for (e = 0; e < nents; e++)
+	r = _mm512_mask_mov_epi64 (r, m[e],
+				   _mm512_load_si512 (tab + 8 * (e * s + j)));
+      _mm512_store_si512 (rp + 8 * j, r);
+    }
+}
+
+/* Set lane L of the S digit vectors at dp to the digits of {up,un}.  tp
+   needs S limbs.  */
+IFMA_FUNCTION static void
+lanes_put (mp_ptr dp, int l, mp_srcptr up, mp_size_t un, mp_size_t s,
+	   mp_ptr tp)
+{
+  mp_size_t j;
+
+  d52_from_limbs (tp, s, up, un);
+  for (j = 0; j < s; j++)
+    dp[8 * j + l] = tp[j];
+}
+
+/* Set lane L of the S digit vectors at dp to {up,un} * R mod {mp,n}, with
+   mpn_sec_div_r as redcify in sec_powm.c does.  */
+IFMA_FUNCTION static void
+lanes_redcify (mp_ptr dp, int l, mp_srcptr up, mp_size_t un,
+	       mp_srcptr mp, mp_size_t n, mp_size_t s, mp_ptr tp)
+{
+  mp_size_t q, tn;
+  int r;
+
+  q = s * D52_BITS / GMP_NUMB_BITS;
+  r = s * D52_BITS % GMP_NUMB_BITS;
+  tn = q + un + 1;
+
+  MPN_ZERO (tp, q);
+  if (r != 0)
+    tp[q + un] = mpn_lshift (tp + q, up, un, r);
+  else
+    {
+      MPN_COPY (tp + q, up, un);
+      tp[q + un] = 0;
+    }
+  mpn_sec_div_r (tp, tn, mp, n, tp + tn);
+  lanes_put (dp, l, tp, n, s, tp + n);
+}
+
+/* Set {rp,n} to lane L of the S digit vectors at dp, which is at most
+   {mp,n}, reduced mod {mp,n}.  tp needs MAX(S,n) limbs.  */
+IFMA_FUNCTION static void
+lanes_get (mp_ptr rp, mp_srcptr dp, int l, mp_srcptr mp, mp_size_t n,
+	   mp_size_t s, mp_ptr tp)
+{
+  mp_size_t j;
+  int cnd;
+
+  for (j = 0; j < s; j++)
+    tp[j] = dp[8 * j + l];
+  d52_to_limbs (rp, n, tp, s, 0);
+
+  cnd = mpn_sub_n (tp, rp, mp, n);	/* we need just retval */
+  mpn_cnd_sub_n (!cnd, rp, rp, mp, n);
+}
+
+/* Gather the next window of the exponents, at bit BI, into a vector.  */
+IFMA_FUNCTION static inline __m512i
+lanes_getbits (mp_srcptr ep, mp_size_t en, int k, mp_bitcnt_t bi, int nbits)
+{
+  mp_limb_t e[SEC_POWM_LANES];
+  int l;
+
+  for (l = 0; l < SEC_POWM_LANES; l++)
+    e[l] = getbits (ep + (l < k ? l : 0) * en, bi, nbits);
+  return _mm512_loadu_si512 (e);
+}
+
+IFMA_FUNCTION void
+mpn_sec_powm_lanes (mp_ptr rp, mp_srcptr bp, mp_size_t bn,
+		    mp_srcptr ep, mp_bitcnt_t enb,
+		    mp_srcptr mp, mp_size_t n, int k, mp_ptr tp)
+{
+  static const mp_limb_t one = 1;
+  mp_limb_t inv[SEC_POWM_LANES];
+  mp_ptr md, pp, xp, yp, wp, sp;
+  mp_srcptr mlp;
+  mp_size_t en, s;
+  __m512i minv, expbits;
+  int windowsize, this_windowsize, l, t;
+  long i;
+
+  ASSERT (enb > 0);
+  ASSERT (n > 0);
+  ASSERT (bn > 0);
+  ASSERT (k <= SEC_POWM_LANES);
+
+  if (k < SEC_POWM_LANES_IFMA_MIN_TUPLES || n > LANES_MAX_LIMBS)
+    {
+      (*__gmpn_cpuvec_ifma.sec_powm_lanes) (rp, bp, bn, ep, enb, mp, n, k, tp);
+      return;
+    }
+
+  en = BITS_TO_LIMBS (enb);
+  s = LANES_DIGITS (n);
+  ASSERT (s <= SEC_POWM_LANES_LIMBS (n));
+  windowsize = sec_powm_lanes_win (enb);
+
+  /* scratch: |  s   | s*2^windowsize | s | s |  2s  |  limbs  |  */
+  /*          |  M   |  power table   | x | y | prod | per lane | */
+  md = (mp_ptr) (((size_t) tp + 63) & ~(size_t) 63);
+  pp = md + 8 * s;
+  xp = pp + (8 * s << windowsize);
+  yp = xp + 8 * s;
+  wp = yp + 8 * s;
+  sp = wp + 16 * s;
+
+  /* Table entries 0 and 1 are R and B*R mod M, each lane with its own M.  */
+  for (l = 0; l < SEC_POWM_LANES; l++)
+    {
+      t = l < k ? l : 0;
+      mlp = mp + t * n;
+      binvert_limb (inv[l], mlp[0]);
+      inv[l] = -inv[l] & D52_MASK;
+      lanes_put (md, l, mlp, n, s, sp);
+      lanes_redcify (pp, l, &one, 1, mlp, n, s, sp);
+      lanes_redcify (pp + 8 * s, l, bp + t * bn, bn, mlp, n, s, sp);
+    }
+  minv = _mm512_loadu_si512 (inv);
+
+  for (i = 2; i < 1 << windowsize; i++)
+    lanes_mulredc (pp + 8 * s * i, pp + 8 * s * (i - 1), pp + 8 * s,
+		   md, minv, s, wp);
+
+  expbits = lanes_getbits (ep, en, k, enb, windowsize);
+  ASSERT_ALWAYS (enb >= windowsize);
+  enb -= windowsize;
+
+  lanes_tabselect (xp, pp, s, 1 << windowsize, expbits);
+
+  while (enb != 0)
+    {
+      expbits = lanes_getbits (ep, en, k, enb, windowsize);
+      this_windowsize = windowsize;
+      if (enb < windowsize)
+	{
+	  this_windowsize -= windowsize - enb;
+	  enb = 0;
+	}
+      else
+	enb -= windowsize;
+
+      do
+	{
+	  lanes_mulredc (xp, xp, xp, md, minv, s, wp);
+	  this_windowsize--;
+	}
+      while (this_windowsize != 0);
+
+      lanes_tabselect (yp, pp, s, 1 << windowsize, expbits);
+      lanes_mulredc (xp, xp, yp, md, minv, s, wp);
+    }
+
+  /* Multiply by 1 to leave REDC form, giving at most M.  */
+  MPN_ZERO (yp, 8 * s);
+  for (l = 0; l < SEC_POWM_LANES; l++)
+    yp[l] = 1;
+  lanes_mulredc (xp, xp, yp, md, minv, s, wp);
+
+  for (l = 0; l < k; l++)
+    lanes_get (rp + l * n, xp, l, mp + l * n, n, s, sp);
+}
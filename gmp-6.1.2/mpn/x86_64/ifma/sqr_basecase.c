@@ -0,0 +1,67 @@
+/* mpn_sqr_basecase for AVX-512 IFMA.
+
+   THE FUNCTIONS IN THIS FILE ARE FOR INTERNAL USE ONLY.  THEY'RE ALMOST
+   CERTAIN TO BE SUBJECT TO INCOMPATIBLE CHANGES OR DISAPPEAR COMPLETELY IN
+   FUTURE GNU MP RELEASES.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "ifma.h"
+
+#ifndef SQR_BASECASE_IFMA_THRESHOLD
+#define SQR_BASECASE_IFMA_THRESHOLD  24
+#endif
+
+IFMA_FUNCTION void
+mpn_sqr_basecase (mp_ptr rp, mp_srcptr up, mp_size_t un)
+{
+  mp_ptr ap, pp;
+  mp_size_t an;
+  TMP_DECL;
+
+  ASSERT (un >= 1);
+  ASSERT (! MPN_OVERLAP_P (rp, 2*un, up, un));
+
+  if (BELOW_THRESHOLD (un, SQR_BASECASE_IFMA_THRESHOLD) || un > D52_MAX_LIMBS)
+    {
+      (*__gmpn_cpuvec_ifma.sqr_basecase) (rp, up, un);
+      return;
+    }
+
+  TMP_MARK;
+  an = D52_DIGITS (un);
+  ap = D52_ALLOC (an + 2 * D52_PAD) + D52_PAD;
+  pp = D52_ALLOC (2 * an + 15);
+
+  MPN_ZERO (ap - D52_PAD, D52_PAD);
+  d52_from_limbs (ap, an + D52_PAD, up, un);
+  d52_sqr (pp, ap, an);
+  d52_to_limbs (rp, 2 * un, pp, 2 * an, 0);
+  TMP_FREE;
+}
@@ -44,7 +44,7 @@ mpq_inp_str (mpq_ptr q, FILE *fp, int base)
     fp = stdin;
 
   SIZ(DEN(q)) = 1;
-  PTR(DEN(q))[0] = 1;
+  MPZ_NEWALLOC (DEN(q), 1)[0] = 1;
 
   nread = mpz_inp_str (mpq_numref(q), fp, base);
   if (nread == 0)
@@ -63,7 +63,7 @@ mpq_inp_str (mpq_ptr q, FILE *fp, int base)
 	{
 	  SIZ(NUM(q)) = 0;
 	  SIZ(DEN(q)) = 1;
-	  PTR(DEN(q))[0] = 1;
+	  MPZ_NEWALLOC (DEN(q), 1)[0] = 1;
 	}
     }
   else
@@ -52,10 +52,10 @@ mpq_set_ui (mpq_t dest, unsigned long int num, unsigned long int den)
     }
   else
     {
-      PTR(NUM(dest))[0] = num;
+      MPZ_NEWALLOC (NUM(dest), 1)[0] = num;
       SIZ(NUM(dest)) = 1;
     }
 
-  PTR(DEN(dest))[0] = den;
+  MPZ_NEWALLOC (DEN(dest), 1)[0] = den;
   SIZ(DEN(dest)) = (den != 0);
 }
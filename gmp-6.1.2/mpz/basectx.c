@@ -0,0 +1,136 @@
+/* mpz_basectx_init, mpz_basectx_clear -- cached powers of a radix for
+   string conversions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The powers are computed as mpz_get_str_ctx or mpz_set_str_ctx first want
+   them, then kept for later conversions, of that size or smaller.  They
+   are pure squares, big_base^(2^i), so that a bigger conversion only adds
+   powers and never changes those already made.  mpn_get_str and
+   mpn_set_str instead fit each power to the one size being converted.
+
+   Each power is a block of its own, of exactly its size, with low zero
+   limbs stripped into the shift field.
+
+   mpz_basectx_init2 makes the powers up front.  MPN_SIZEINBASE can give
+   one digit more than a number has, hence the digits+1 there, and with
+   that a conversion of up to DIGITS digits finds every power it needs and
+   only reads the context.  */
+
+void
+mpz_basectx_init (mpz_basectx_ptr c, int base)
+{
+  c->_mp_base = base;
+  c->_mp_levels = 0;
+  c->_mp_tab = NULL;
+}
+
+void
+mpz_basectx_init2 (mpz_basectx_ptr c, int base, size_t digits)
+{
+  int b;
+
+  mpz_basectx_init (c, base);
+  b = ABS (base);
+  if (b >= 3 && b <= 62 && ! POW2_P (b))
+    mpz_basectx_powtab (c, digits + 1);
+}
+
+void
+mpz_basectx_clear (mpz_basectx_ptr c)
+{
+  powers_t *tab;
+  int i;
+
+  tab = BASECTX_POWTAB (c);
+  if (tab == NULL)
+    return;
+  for (i = 0; i < c->_mp_levels; i++)
+    __GMP_FREE_FUNC_LIMBS (tab[i].p, tab[i].n);
+  __GMP_FREE_FUNC_TYPE (tab, GMP_LIMB_BITS, powers_t);
+}
+
+int
+mpz_basectx_powtab (mpz_basectx_ptr c, size_t digits)
+{
+  powers_t *tab;
+  mp_ptr tp;
+  mp_size_t n, zn;
+  int base, i;
+
+  base = ABS (c->_mp_base);
+  ASSERT (base >= 3 && ! POW2_P (base));
+
+  tab = BASECTX_POWTAB (c);
+  if (tab == NULL)
+    {
+      tab = __GMP_ALLOCATE_FUNC_TYPE (GMP_LIMB_BITS, powers_t);
+      c->_mp_tab = tab;
+
+      tab[0].p = __GMP_ALLOCATE_FUNC_LIMBS (1);
+      tab[0].p[0] = mp_bases[base].big_base;
+      tab[0].n = 1;
+      tab[0].shift = 0;
+      tab[0].digits_in_base = mp_bases[base].chars_per_limb;
+      tab[0].base = base;
+      c->_mp_levels = 1;
+    }
+
+  for (i = 0; 2 * tab[i].digits_in_base < digits; i++)
+    {
+      if (i + 1 < c->_mp_levels)
+	continue;
+      ASSERT_ALWAYS (i + 1 < GMP_LIMB_BITS);
+
+      n = 2 * tab[i].n;
+      tp = __GMP_ALLOCATE_FUNC_LIMBS (n);
+      mpn_sqr (tp, tab[i].p, tab[i].n);
+      n -= tp[n - 1] == 0;
+
+      for (zn = 0; tp[zn] == 0; zn++)
+	;
+      if (zn != 0)
+	MPN_COPY_INCR (tp, tp + zn, n - zn);
+      tp = __GMP_REALLOCATE_FUNC_LIMBS (tp, 2 * tab[i].n, n - zn);
+
+      tab[i + 1].p = tp;
+      tab[i + 1].n = n - zn;
+      tab[i + 1].shift = 2 * tab[i].shift + zn;
+      tab[i + 1].digits_in_base = 2 * tab[i].digits_in_base;
+      tab[i + 1].base = base;
+      c->_mp_levels = i + 2;
+    }
+  return i;
+}
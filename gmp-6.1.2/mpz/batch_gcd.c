@@ -0,0 +1,86 @@
+/* mpz_batch_gcd (G, N, COUNT) -- Set G[i] to the gcd of N[i] and the product
+   of the other N[j].
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* Bernstein's batch gcd.  A product tree P over the n[i] is formed, then a
+   remainder tree takes P mod v^2 down to each node v, and at a leaf
+   (P mod n^2) / n = (P / n) mod n, whose gcd with n is the gcd of n with
+   the product of the others.  The trees are mpz_prodtree and mpz_remtree,
+   freeing each product once used.  */
+
+/* FIXME: should be tuned */
+#ifndef BATCH_GCD_PARALLEL_THRESHOLD
+#define BATCH_GCD_PARALLEL_THRESHOLD (MUL_TOOM33_THRESHOLD * 16)
+#endif
+
+static int
+batch_gcd_leaf (const struct prodtree *p, size_t i, mpz_ptr r)
+{
+  mpz_gcd (((mpz_ptr *) p->data)[i], r, p->v[i]);
+  return 1;
+}
+
+void
+mpz_batch_gcd (mpz_ptr *g, mpz_srcptr *n, size_t count)
+{
+  struct prodtree p;
+  mpz_t r;
+  size_t i;
+  TMP_DECL;
+
+  for (i = 0; i < count; i++)
+    if (UNLIKELY (SIZ (n[i]) == 0))
+      DIVIDE_BY_ZERO;
+
+  if (count <= 1)
+    {
+      if (count == 1)
+	mpz_set_ui (g[0], 1);
+      return;
+    }
+
+  TMP_MARK;
+  p.v = n;
+  p.t = TMP_ALLOC_TYPE (count - 1, __mpz_struct);
+  p.leaf = batch_gcd_leaf;
+  p.data = g;
+  p.thresh = BATCH_GCD_PARALLEL_THRESHOLD;
+  p.keep = 0;
+
+  mpz_prodtree (&p, 0, count);
+
+  /* P mod P^2 is P.  */
+  *r = p.t[count / 2 - 1];
+  mpz_remtree (&p, 0, count, r);
+  TMP_FREE;
+}
@@ -0,0 +1,286 @@
+/* mpz_bpsw_p(n) -- Baillie-PSW probable prime test.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+/* A strong probable prime test to base 2, then a strong Lucas probable prime
+   test with Selfridge's parameters.  No composite passing both is known, and
+   there is none below 2^64.
+
+   Both tests work on residues in REDC form, x*B^n mod M, with the REDC
+   inverse and B^2n mod M from a single mpz_modctx_t.  Residues are kept
+   fully reduced, so they can be compared with 0, 1 and -1.  Sums and the
+   multiplications by the small Lucas parameters don't need a REDC, since
+   REDC form is linear.
+
+   The base 2 test costs about one modular exponentiation, since stepping
+   the exponent by a one bit is only a doubling, and the Lucas test about
+   three, a U, V and Q^k product for each bit.  */
+
+struct bpsw_ctx {
+  mpz_modctx_srcptr c;
+  mp_srcptr mp;
+  mp_srcptr mip;
+  int redc;
+  mp_size_t n;
+  mp_ptr tp;			/* 2n+1 limbs scratch */
+};
+
+/* {rp,n} = {ap,n} * {bp,n} / B^n mod M */
+static void
+mulredc (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, const struct bpsw_ctx *x)
+{
+  if (ap == bp)
+    mpn_sqr (x->tp, ap, x->n);
+  else
+    mpn_mul_n (x->tp, ap, bp, x->n);
+  mpn_powm_batch_redc (rp, x->tp, x->mp, x->n, x->mip, x->redc);
+  if (mpn_cmp (rp, x->mp, x->n) >= 0)
+    mpn_sub_n (rp, rp, x->mp, x->n);
+}
+
+/* {rp,n} = {ap,n} + {bp,n} mod M */
+static void
+addmod (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, const struct bpsw_ctx *x)
+{
+  mp_limb_t cy;
+  cy = mpn_add_n (rp, ap, bp, x->n);
+  if (cy != 0 || mpn_cmp (rp, x->mp, x->n) >= 0)
+    mpn_sub_n (rp, rp, x->mp, x->n);
+}
+
+/* {rp,n} = {ap,n} - {bp,n} mod M */
+static void
+submod (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, const struct bpsw_ctx *x)
+{
+  if (mpn_sub_n (rp, ap, bp, x->n) != 0)
+    mpn_add_n (rp, rp, x->mp, x->n);
+}
+
+/* {rp,n} = {ap,n} / 2 mod M */
+static void
+halfmod (mp_ptr rp, mp_srcptr ap, const struct bpsw_ctx *x)
+{
+  mp_limb_t cy;
+  if ((ap[0] & 1) != 0)
+    {
+      cy = mpn_add_n (rp, ap, x->mp, x->n);
+      mpn_rshift (rp, rp, x->n, 1);
+      rp[x->n - 1] |= cy << (GMP_NUMB_BITS - 1);
+    }
+  else
+    mpn_rshift (rp, ap, x->n, 1);
+}
+
+/* {rp,n} = {ap,n} * s mod M */
+static void
+mulmod_si (mp_ptr rp, mp_srcptr ap, long s, const struct bpsw_ctx *x)
+{
+  mp_size_t n = x->n;
+  x->tp[n] = mpn_mul_1 (x->tp, ap, n, (mp_limb_t) ABS_CAST (unsigned long, s));
+  mpz_modctx_reduce (rp, x->tp, n + 1, x->c);
+  if (s < 0 && ! mpn_zero_p (rp, n))
+    mpn_sub_n (rp, x->mp, rp, n);
+}
+
+/* Strong test to base 2, with {one,n} = B^n mod M.  */
+static int
+spsp2 (const struct bpsw_ctx *x, mp_srcptr one, mp_ptr yp, mp_ptr mone)
+{
+  mp_size_t n = x->n;
+  mp_ptr ep;
+  mp_bitcnt_t k, i;
+  TMP_DECL;
+
+  /* n-1 = q*2^k, and -1 in REDC form.  */
+  TMP_MARK;
+  ep = TMP_ALLOC_LIMBS (n);
+  mpn_sub_1 (ep, x->mp, n, CNST_LIMB(1));
+  k = mpn_scan1 (ep, 0);
+  mpn_sub_n (mone, x->mp, one, n);
+
+  /* 2^q, left to right.  */
+  addmod (yp, one, one, x);
+  MPN_SIZEINBASE_2EXP (i, ep, n, 1);
+  for (i--; i-- > k; )
+    {
+      mulredc (yp, yp, yp, x);
+      if ((ep[i / GMP_NUMB_BITS] >> (i % GMP_NUMB_BITS) & 1) != 0)
+	addmod (yp, yp, yp, x);
+    }
+  TMP_FREE;
+
+  if (mpn_cmp (yp, one, n) == 0 || mpn_cmp (yp, mone, n) == 0)
+    return 1;
+
+  while (--k != 0)
+    {
+      mulredc (yp, yp, yp, x);
+      if (mpn_cmp (yp, mone, n) == 0)
+	return 1;
+      if (mpn_cmp (yp, one, n) == 0)
+	return 0;
+    }
+  return 0;
+}
+
+/* Strong Lucas test for the odd n > 2, with {one,n} = B^n mod M.
+
+   D is the first of 5, -7, 9, -11, ... with Jacobi symbol (D/n) = -1, and
+   P = 1, Q = (1-D)/4.  With n+1 = d*2^s, d odd, n passes when U(d) = 0 or
+   V(d*2^r) = 0 (mod n) for some 0 <= r < s.  Perfect squares have no such D,
+   so they're tested for once a few D's have failed.
+
+   The sequences are formed with the doubling formulas
+     U(2k) = U(k)V(k),  V(2k) = V(k)^2 - 2Q^k,
+   and, to step from k to k+1,
+     U(k+1) = (P U(k) + V(k))/2,  V(k+1) = (D U(k) + P V(k))/2.  */
+static int
+stronglucas (mpz_srcptr n, const struct bpsw_ctx *x, mp_srcptr one,
+	     mp_ptr up, mp_ptr vp, mp_ptr qkp, mp_ptr wp)
+{
+  mp_size_t nn = x->n;
+  mp_ptr dp;
+  mp_bitcnt_t s, i;
+  long D, Q;
+  int j, res;
+  TMP_DECL;
+
+  for (D = 5; ; D = D > 0 ? -D - 2 : -D + 2)
+    {
+      j = mpz_si_kronecker (D, n);
+      if (j == -1)
+	break;
+      if (j == 0 && mpz_cmpabs_ui (n, ABS (D)) != 0)
+	return 0;
+      if (D == 17 && mpz_perfect_square_p (n))
+	return 0;
+    }
+  Q = (1 - D) / 4;
+
+  TMP_MARK;
+  dp = TMP_ALLOC_LIMBS (nn + 1);
+  dp[nn] = mpn_add_1 (dp, x->mp, nn, CNST_LIMB(1));
+  s = mpn_scan1 (dp, 0);
+
+  /* k = 1, the top bit of d.  */
+  MPN_COPY (up, one, nn);
+  MPN_COPY (vp, one, nn);
+  mulmod_si (qkp, one, Q, x);
+
+  MPN_SIZEINBASE_2EXP (i, dp, nn + (dp[nn] != 0), 1);
+  for (i--; i-- > s; )
+    {
+      mulredc (up, up, vp, x);
+      mulredc (vp, vp, vp, x);
+      submod (vp, vp, qkp, x);
+      submod (vp, vp, qkp, x);
+      mulredc (qkp, qkp, qkp, x);
+
+      if ((dp[i / GMP_NUMB_BITS] >> (i % GMP_NUMB_BITS) & 1) != 0)
+	{
+	  mulmod_si (wp, up, D, x);
+	  addmod (up, up, vp, x);
+	  halfmod (up, up, x);
+	  addmod (vp, wp, vp, x);
+	  halfmod (vp, vp, x);
+	  mulmod_si (qkp, qkp, Q, x);
+	}
+    }
+  TMP_FREE;
+
+  res = mpn_zero_p (up, nn);
+  for (i = 0; i < s && ! res; i++)
+    {
+      if (mpn_zero_p (vp, nn))
+	res = 1;
+      else if (i + 1 < s)
+	{
+	  mulredc (vp, vp, vp, x);
+	  submod (vp, vp, qkp, x);
+	  submod (vp, vp, qkp, x);
+	  mulredc (qkp, qkp, qkp, x);
+	}
+    }
+  return res;
+}
+
+int
+mpz_bpsw_p (mpz_srcptr n)
+{
+  mpz_modctx_t c;
+  struct bpsw_ctx x;
+  mp_size_t nn;
+  mp_ptr one, yp, mone, up, vp;
+  int res;
+  TMP_DECL;
+
+  nn = ABSIZ (n);
+  if (nn == 0)
+    return 0;
+  if (nn == 1 && PTR (n)[0] <= 3)
+    return PTR (n)[0] >= 2 ? 2 : 0;
+  if ((PTR (n)[0] & 1) == 0)
+    return 0;
+
+  mpz_modctx_init (c, n);
+
+  TMP_MARK;
+  x.c = c;
+  x.mp = PTR (&c->_mp_mod);
+  x.mip = MODCTX_MIP (c);
+  x.redc = c->_mp_redc;
+  x.n = nn;
+  x.tp = TMP_ALLOC_LIMBS (2 * nn + 1);
+  one = TMP_ALLOC_LIMBS (5 * nn);
+  yp = one + nn;
+  mone = yp + nn;
+  up = mone + nn;
+  vp = up + nn;
+
+  /* B^n mod M, as REDC of B^2n mod M.  */
+  MPN_COPY (x.tp, MODCTX_R2P (c), nn);
+  MPN_ZERO (x.tp + nn, nn);
+  mpn_powm_batch_redc (one, x.tp, x.mp, nn, x.mip, x.redc);
+  if (mpn_cmp (one, x.mp, nn) >= 0)
+    mpn_sub_n (one, one, x.mp, nn);
+
+  res = spsp2 (&x, one, yp, mone)
+    && stronglucas (&c->_mp_mod, &x, one, up, vp, yp, mone);
+
+  TMP_FREE;
+  mpz_modctx_clear (c);
+
+  if (res && mpz_sizeinbase (n, 2) <= 64)
+    res = 2;
+  return res;
+}
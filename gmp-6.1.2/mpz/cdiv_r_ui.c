@@ -101,7 +101,7 @@ mpz_cdiv_r_ui (mpz_ptr rem, mpz_srcptr dividend, unsigned long int divisor)
 	  if (ns >= 0)
 	    rl = divisor - rl;
 
-	  PTR(rem)[0] = rl;
+	  MPZ_NEWALLOC (rem, 1)[0] = rl;
 	  SIZ(rem) = -1;
 	}
     }
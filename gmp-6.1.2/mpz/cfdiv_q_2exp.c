@@ -53,7 +53,7 @@ cfdiv_q_2exp (mpz_ptr w, mpz_srcptr u, mp_bitcnt_t cnt, int dir)
   if (wsize <= 0)
     {
       /* u < 2**cnt, so result 1, 0 or -1 according to rounding */
-      PTR(w)[0] = 1;
+      MPZ_NEWALLOC (w, 1)[0] = 1;
       SIZ(w) = (usize == 0 || (usize ^ dir) < 0 ? 0 : dir);
       return;
     }
@@ -0,0 +1,113 @@
+/* mpz_crt (X, R, C) -- Set X to the value congruent to each R[i] modulo the
+   moduli of C.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* With M the product of all the moduli and c[i] = (M/m[i])^-1 mod m[i],
+   X = sum (R[i] c[i] mod m[i]) * M/m[i] mod M.  The sum is formed up the
+   product tree, a node v with halves v1, v2 getting s = s1 v2 + s2 v1,
+   which is the sum over its range of (R[i] c[i] mod m[i]) * v/m[i].  So
+   each level costs about a product of the whole set, and the final s is
+   under count*M, needing just one reduction.  */
+
+struct crt_par
+{
+  mpz_ptr s;
+  mpz_srcptr *r;
+  mpz_crtctx_srcptr c;
+  size_t lo, hi;
+};
+
+static void crt_tree (mpz_ptr, mpz_srcptr *, mpz_crtctx_srcptr, size_t,
+		      size_t);
+
+static void
+crt_task (void *data, int i)
+{
+  struct crt_par *p = (struct crt_par *) data + i;
+  crt_tree (p->s, p->r, p->c, p->lo, p->hi);
+}
+
+/* Set S to the sum for [lo,hi).  */
+static void
+crt_tree (mpz_ptr s, mpz_srcptr *r, mpz_crtctx_srcptr c, size_t lo,
+	  size_t hi)
+{
+  struct crt_par par[2];
+  mpz_srcptr m;
+  mpz_t s2;
+  size_t mid;
+
+  if (hi - lo == 1)
+    {
+      m = c->_mp_tree + lo;
+      mpz_fdiv_r (s, r[lo], m);
+      mpz_mul (s, s, c->_mp_coef + lo);
+      mpz_fdiv_r (s, s, m);
+      return;
+    }
+  mid = (lo + hi) / 2;
+
+  mpz_init (s2);
+  if (hi - lo >= 4
+      && MPN_PARALLEL_P (mpz_size (CRTCTX_NODE (c, lo, hi)),
+			 CRT_PARALLEL_THRESHOLD))
+    {
+      par[0].s = s;  par[0].r = r; par[0].c = c; par[0].lo = lo;
+      par[0].hi = mid;
+      par[1].s = s2; par[1].r = r; par[1].c = c; par[1].lo = mid;
+      par[1].hi = hi;
+      MPN_PARALLEL_RUN (crt_task, par, 2);
+    }
+  else
+    {
+      crt_tree (s, r, c, lo, mid);
+      crt_tree (s2, r, c, mid, hi);
+    }
+
+  mpz_mul (s, s, CRTCTX_NODE (c, mid, hi));
+  mpz_addmul (s, s2, CRTCTX_NODE (c, lo, mid));
+  mpz_clear (s2);
+}
+
+void
+mpz_crt (mpz_ptr x, mpz_srcptr *r, mpz_crtctx_srcptr c)
+{
+  mpz_t s;
+
+  ASSERT_ALWAYS (c->_mp_coef != NULL);
+
+  mpz_init (s);
+  crt_tree (s, r, c, 0, c->_mp_count);
+  mpz_tdiv_r (x, s, CRTCTX_NODE (c, 0, c->_mp_count));
+  mpz_clear (s);
+}
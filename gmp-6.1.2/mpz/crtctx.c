@@ -0,0 +1,125 @@
+/* mpz_crtctx_init, mpz_crtctx_clear -- product tree over a set of moduli,
+   for mpz_multi_mod and mpz_crt.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* The tree is an mpz_prodtree over the moduli, kept in the context for
+   mpz_crt and mpz_multi_mod, see CRTCTX_NODE.
+
+   The CRT coefficients are c[i] = (M/m[i])^-1 mod m[i], M the product of
+   all the moduli.  M/m[i] mod m[i] comes from mpz_remtree, as in
+   mpz_batch_gcd.  */
+
+/* Set the coefficient of modulus i from r = (M/m[i]) mod m[i].  Return 0
+   if there's none, for m[i] not being coprime to the others.  */
+static int
+crtctx_leaf (const struct prodtree *p, size_t i, mpz_ptr r)
+{
+  mpz_crtctx_ptr c = (mpz_crtctx_ptr) p->data;
+
+  if (mpz_cmp_ui (p->v[i], 1) == 0)
+    return 1;			/* anything is a coefficient mod 1 */
+  return mpz_invert (c->_mp_coef + i, r, p->v[i]);
+}
+
+int
+mpz_crtctx_init (mpz_crtctx_ptr c, mpz_srcptr *m, size_t count)
+{
+  struct prodtree p;
+  mpz_t r;
+  size_t i;
+  int ok;
+  TMP_DECL;
+
+  ASSERT_ALWAYS (count != 0);
+  for (i = 0; i < count; i++)
+    if (UNLIKELY (SIZ (m[i]) == 0))
+      DIVIDE_BY_ZERO;
+
+  TMP_MARK;
+  c->_mp_count = count;
+  c->_mp_tree = __GMP_ALLOCATE_FUNC_TYPE (2 * count - 1, __mpz_struct);
+  p.v = TMP_ALLOC_TYPE (count, mpz_srcptr);
+  for (i = 0; i < count; i++)
+    {
+      mpz_init (c->_mp_tree + i);
+      mpz_abs (c->_mp_tree + i, m[i]);
+      p.v[i] = c->_mp_tree + i;
+    }
+  p.t = c->_mp_tree + count;
+  p.leaf = crtctx_leaf;
+  p.data = c;
+  p.thresh = CRT_PARALLEL_THRESHOLD;
+  p.keep = 1;
+  mpz_prodtree (&p, 0, count);
+
+  c->_mp_coef = __GMP_ALLOCATE_FUNC_TYPE (count, __mpz_struct);
+  for (i = 0; i < count; i++)
+    mpz_init (c->_mp_coef + i);
+
+  /* M mod M^2 is M.  */
+  mpz_init_set (r, CRTCTX_NODE (c, 0, count));
+  ok = mpz_remtree (&p, 0, count, r);
+  TMP_FREE;
+  if (ok)
+    return 1;
+
+  for (i = 0; i < count; i++)
+    mpz_clear (c->_mp_coef + i);
+  __GMP_FREE_FUNC_TYPE (c->_mp_coef, count, __mpz_struct);
+  c->_mp_coef = NULL;
+  return 0;
+}
+
+void
+mpz_crtctx_clear (mpz_crtctx_ptr c)
+{
+  size_t i, count;
+
+  count = c->_mp_count;
+  for (i = 0; i < 2 * count - 1; i++)
+    mpz_clear (c->_mp_tree + i);
+  __GMP_FREE_FUNC_TYPE (c->_mp_tree, 2 * count - 1, __mpz_struct);
+
+  if (c->_mp_coef != NULL)
+    {
+      for (i = 0; i < count; i++)
+	mpz_clear (c->_mp_coef + i);
+      __GMP_FREE_FUNC_TYPE (c->_mp_coef, count, __mpz_struct);
+    }
+}
+
+mpz_srcptr
+mpz_crtctx_product (mpz_crtctx_srcptr c) __GMP_NOTHROW
+{
+  return CRTCTX_NODE (c, 0, c->_mp_count);
+}
@@ -0,0 +1,291 @@
+/* mpz_fixedbase_init, mpz_fixedbase_clear, mpz_powm_fixed_base -- fixed-base
+   exponentiation with a precomputed comb table.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* This is the Lim-Lee comb.  An exponent of up to teeth*spacing bits is
+   seen as a matrix with a row of spacing bits for each tooth, and column k
+   takes one bit from each row, bits k, spacing+k, 2*spacing+k, etc, giving
+   a teeth bit value j_k.  With T[j] the product of g^(2^(i*spacing)) over
+   the bits i set in j,
+
+       g^e = prod_k T[j_k]^(2^k).
+
+   The columns are split into blocks of width columns, and each block s has
+   its own table, T[j]^(2^(s*width)), so the remaining 2^k is the offset
+   within the block and is done by width-1 squarings of the accumulated
+   product, one round over the blocks per column offset.
+
+   So an exponentiation is about spacing = bits/teeth multiplications and
+   width-1 squarings, from a table of blocks*(2^teeth-1) entries.  With a
+   block per column, width is 1 and there are no squarings at all.
+
+   For an odd modulus the table is in REDC form, as in mpn_powm, otherwise
+   products are reduced by the division in the modulus context.  */
+
+/* {rp,n} = {tp,2n} / B^n mod M, with the inverse from the context.  */
+static void
+fixedbase_redc (mp_ptr rp, mp_ptr tp, mpz_modctx_srcptr c)
+{
+  mpn_powm_batch_redc (rp, tp, PTR(&c->_mp_mod), MODCTX_SIZE (c),
+		       MODCTX_MIP (c), c->_mp_redc);
+}
+
+/* {rp,n} = {ap,n} * {bp,n} in the representation of the table.
+   Uses scratch space at tp of 2n limbs.  */
+static void
+fixedbase_mul (mp_ptr rp, mp_srcptr ap, mp_srcptr bp, mp_ptr tp,
+	       mpz_modctx_srcptr c)
+{
+  mp_size_t n = MODCTX_SIZE (c);
+
+  if (ap == bp)
+    mpn_sqr (tp, ap, n);
+  else
+    mpn_mul_n (tp, ap, bp, n);
+
+  if (MODCTX_ODD_P (c))
+    fixedbase_redc (rp, tp, c);
+  else
+    mpz_modctx_reduce (rp, tp, 2 * n, c);
+}
+
+/* Set up fb for base g and modulus m, with the given comb shape, leaving
+   the table contents undefined.  */
+void
+mpz_fixedbase_alloc (mpz_fixedbase_ptr fb, mpz_srcptr g, mpz_srcptr m,
+		     mp_bitcnt_t spacing, int teeth, mp_bitcnt_t width)
+{
+  gmp_intptr_t d;
+
+  ASSERT (teeth >= 1 && teeth <= 16);
+  ASSERT (width >= 1 && width <= spacing);
+
+  mpz_modctx_init (&fb->_mp_ctx, m);
+  mpz_init (&fb->_mp_base);
+  mpz_mod_ctx (&fb->_mp_base, g, &fb->_mp_ctx);
+
+  fb->_mp_teeth = teeth;
+  fb->_mp_spacing = spacing;
+  fb->_mp_width = width;
+  fb->_mp_blocks = (spacing + width - 1) / width;
+  fb->_mp_stride
+    = ROUND_UP_MULTIPLE ((unsigned long) MODCTX_SIZE (&fb->_mp_ctx),
+			 FIXEDBASE_ALIGN / GMP_LIMB_BYTES);
+
+  fb->_mp_alloc = (*__gmp_allocate_func)
+    (FIXEDBASE_ENTRIES (fb) * fb->_mp_stride * GMP_LIMB_BYTES
+     + FIXEDBASE_ALIGN - 1);
+  d = ((gmp_intptr_t) fb->_mp_alloc) & (FIXEDBASE_ALIGN - 1);
+  d = (d != 0 ? FIXEDBASE_ALIGN - d : 0);
+  fb->_mp_d = (mp_ptr) ((char *) fb->_mp_alloc + d);
+}
+
+void
+mpz_fixedbase_init (mpz_fixedbase_ptr fb, mpz_srcptr g, mpz_srcptr m,
+		    mp_bitcnt_t ebits, int teeth, unsigned long blocks)
+{
+  mp_size_t n;
+  mp_bitcnt_t spacing, width, p, k;
+  mp_ptr cur, tp;
+  mpz_modctx_srcptr c;
+  int i, s;
+  mp_size_t j, low;
+  TMP_DECL;
+
+  teeth = MAX (teeth, 1);
+  teeth = MIN (teeth, 16);
+  ebits = MAX (ebits, 1);
+  spacing = (ebits + teeth - 1) / teeth;
+  if (blocks == 0 || blocks > spacing)
+    blocks = spacing;
+  width = (spacing + blocks - 1) / blocks;
+
+  mpz_fixedbase_alloc (fb, g, m, spacing, teeth, width);
+
+  c = &fb->_mp_ctx;
+  n = MODCTX_SIZE (c);
+
+  TMP_MARK;
+  cur = TMP_ALLOC_LIMBS (n);
+  tp = TMP_ALLOC_LIMBS (2 * n);
+
+  MPN_COPY (cur, PTR(&fb->_mp_base), SIZ(&fb->_mp_base));
+  MPN_ZERO (cur + SIZ(&fb->_mp_base), n - SIZ(&fb->_mp_base));
+  if (MODCTX_ODD_P (c))
+    {
+      mpn_mul_n (tp, cur, MODCTX_R2P (c), n);
+      fixedbase_redc (cur, tp, c);
+    }
+
+  /* The single tooth entries, g^(2^(i*spacing + s*width)), from
+     successive squarings.  */
+  for (p = 0;; p++)
+    {
+      i = p / spacing;
+      k = p % spacing;
+      if (k % width == 0)
+	{
+	  s = k / width;
+	  MPN_COPY (FIXEDBASE_ENTRY (fb, s, (mp_size_t) 1 << i), cur, n);
+	  if (i == teeth - 1 && s == fb->_mp_blocks - 1)
+	    break;
+	}
+      fixedbase_mul (cur, cur, cur, tp, c);
+    }
+
+  /* The others, each from two with fewer bits.  */
+  for (s = 0; s < fb->_mp_blocks; s++)
+    for (j = 3; j < ((mp_size_t) 1 << teeth); j++)
+      {
+	low = j & -j;
+	if (low == j)
+	  continue;
+	fixedbase_mul (FIXEDBASE_ENTRY (fb, s, j),
+		       FIXEDBASE_ENTRY (fb, s, j - low),
+		       FIXEDBASE_ENTRY (fb, s, low), tp, c);
+      }
+
+  TMP_FREE;
+}
+
+void
+mpz_fixedbase_clear (mpz_fixedbase_ptr fb)
+{
+  (*__gmp_free_func) (fb->_mp_alloc,
+		      FIXEDBASE_ENTRIES (fb) * fb->_mp_stride * GMP_LIMB_BYTES
+		      + FIXEDBASE_ALIGN - 1);
+  mpz_clear (&fb->_mp_base);
+  mpz_modctx_clear (&fb->_mp_ctx);
+}
+
+void
+mpz_powm_fixed_base (mpz_ptr r, mpz_srcptr e, mpz_fixedbase_srcptr fb)
+{
+  mpz_modctx_srcptr c;
+  mp_size_t n, en, rn;
+  mp_srcptr ep, mp;
+  mp_ptr rp, tp, xp;
+  mp_bitcnt_t ebits, spacing, width, t, k, bi;
+  mp_limb_t j;
+  int i, s, started;
+  TMP_DECL;
+
+  c = &fb->_mp_ctx;
+  n = MODCTX_SIZE (c);
+  mp = PTR(&c->_mp_mod);
+  en = SIZ(e);
+  spacing = fb->_mp_spacing;
+  width = fb->_mp_width;
+
+  if (en == 0)
+    {
+      /* b^0 mod m,  b is anything and m is non-zero.
+	 Result is 1 mod m, i.e., 1 or 0 depending on if m = 1.  */
+      SIZ(r) = n != 1 || mp[0] != 1;
+      MPZ_NEWALLOC (r, 1)[0] = 1;
+      return;
+    }
+
+  ep = PTR(e);
+  ebits = 0;
+  if (en > 0)
+    MPN_SIZEINBASE_2EXP (ebits, ep, en, 1);
+
+  /* Exponents the table doesn't cover.  */
+  if (en < 0 || ebits > fb->_mp_teeth * spacing)
+    {
+      mpz_powm_ctx (r, &fb->_mp_base, e, c);
+      return;
+    }
+
+  TMP_MARK;
+  rp = TMP_ALLOC_LIMBS (n);
+  tp = TMP_ALLOC_LIMBS (2 * n);
+
+  started = 0;
+  t = width;
+  do
+    {
+      t--;
+      if (started)
+	fixedbase_mul (rp, rp, rp, tp, c);
+
+      for (s = 0; s < fb->_mp_blocks; s++)
+	{
+	  k = s * width + t;
+	  if (k >= spacing)
+	    break;
+
+	  j = 0;
+	  for (i = fb->_mp_teeth - 1; i >= 0; i--)
+	    {
+	      bi = i * spacing + k;
+	      j <<= 1;
+	      if (bi < ebits)
+		j |= (ep[bi / GMP_NUMB_BITS] >> (bi % GMP_NUMB_BITS)) & 1;
+	    }
+	  if (j == 0)
+	    continue;
+
+	  if (started)
+	    fixedbase_mul (rp, rp, FIXEDBASE_ENTRY (fb, s, j), tp, c);
+	  else
+	    {
+	      MPN_COPY (rp, FIXEDBASE_ENTRY (fb, s, j), n);
+	      started = 1;
+	    }
+	}
+    }
+  while (t != 0);
+
+  ASSERT (started);
+
+  if (MODCTX_ODD_P (c))
+    {
+      /* Convert out of REDC form.  */
+      MPN_COPY (tp, rp, n);
+      MPN_ZERO (tp + n, n);
+      fixedbase_redc (rp, tp, c);
+      if (mpn_cmp (rp, mp, n) >= 0)
+	mpn_sub_n (rp, rp, mp, n);
+    }
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  xp = MPZ_NEWALLOC (r, rn);
+  MPN_COPY (xp, rp, rn);
+  SIZ(r) = rn;
+  TMP_FREE;
+}
@@ -0,0 +1,199 @@
+/* mpz_fixedbase_out_raw, mpz_fixedbase_inp_raw -- write and read an
+   mpz_fixedbase_t table.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The format is four 4-byte big endian words, GMP_NUMB_BITS, the number of
+   teeth, the spacing and the block width, then in mpz_out_raw format the
+   modulus, the base, and each table entry in turn.
+
+   For an odd modulus the entries are in REDC form, which depends on the
+   limb size, so a table can only be read back by a build with the same
+   GMP_NUMB_BITS.  Byte order doesn't matter.
+
+   The header alone could ask for a table of any size, so on reading the
+   entries are first collected in a buffer that grows as they actually
+   arrive, and the table is only allocated once they're all there.  */
+
+#define FIXEDBASE_HEADER_WORDS  4
+
+size_t
+mpz_fixedbase_out_raw (FILE *fp, mpz_fixedbase_srcptr fb)
+{
+  unsigned char header[4 * FIXEDBASE_HEADER_WORDS];
+  unsigned long w[FIXEDBASE_HEADER_WORDS];
+  mp_size_t n, xn, i, entries;
+  mpz_t x;
+  size_t total, size;
+  mp_ptr xp;
+  int k, b;
+
+  if (fp == 0)
+    fp = stdout;
+
+  w[0] = GMP_NUMB_BITS;
+  w[1] = fb->_mp_teeth;
+  w[2] = fb->_mp_spacing;
+  w[3] = fb->_mp_width;
+  for (k = 0; k < FIXEDBASE_HEADER_WORDS; k++)
+    for (b = 0; b < 4; b++)
+      header[4 * k + b] = (w[k] >> (8 * (3 - b))) & 0xff;
+
+  if (fwrite (header, sizeof (header), 1, fp) != 1)
+    return 0;
+  total = sizeof (header);
+
+  size = mpz_out_raw (fp, &fb->_mp_ctx._mp_mod);
+  if (size == 0)
+    return 0;
+  total += size;
+
+  size = mpz_out_raw (fp, &fb->_mp_base);
+  if (size == 0)
+    return 0;
+  total += size;
+
+  n = MODCTX_SIZE (&fb->_mp_ctx);
+  entries = FIXEDBASE_ENTRIES (fb);
+  for (i = 0; i < entries; i++)
+    {
+      xp = fb->_mp_d + i * fb->_mp_stride;
+      xn = n;
+      MPN_NORMALIZE (xp, xn);
+      size = mpz_out_raw (fp, mpz_roinit_n (x, xp, xn));
+      if (size == 0)
+	return 0;
+      total += size;
+    }
+
+  return total;
+}
+
+size_t
+mpz_fixedbase_inp_raw (mpz_fixedbase_ptr fb, FILE *fp)
+{
+  unsigned char header[4 * FIXEDBASE_HEADER_WORDS];
+  unsigned long w[FIXEDBASE_HEADER_WORDS];
+  unsigned long blocks;
+  mp_size_t n, xn, i, entries, stride, alloc;
+  mpz_t m, g, x;
+  size_t total, size;
+  mp_ptr xp, bp;
+  int k, b;
+
+  if (fp == 0)
+    fp = stdin;
+
+  if (fread (header, sizeof (header), 1, fp) != 1)
+    return 0;
+  total = sizeof (header);
+
+  for (k = 0; k < FIXEDBASE_HEADER_WORDS; k++)
+    {
+      w[k] = 0;
+      for (b = 0; b < 4; b++)
+	w[k] = (w[k] << 8) | header[4 * k + b];
+    }
+  if (w[0] != GMP_NUMB_BITS || w[1] < 1 || w[1] > 16
+      || w[3] < 1 || w[3] > w[2])
+    return 0;
+
+  mpz_init (m);
+  mpz_init (g);
+  mpz_init (x);
+  bp = NULL;
+  alloc = 0;
+
+  size = mpz_inp_raw (m, fp);
+  if (size == 0 || SIZ(m) <= 0)
+    goto fail;
+  total += size;
+
+  size = mpz_inp_raw (g, fp);
+  if (size == 0 || SIZ(g) < 0 || mpz_cmp (g, m) >= 0)
+    goto fail;
+  total += size;
+
+  /* The table mpz_fixedbase_alloc would make, which must be addressable.  */
+  n = SIZ(m);
+  stride = ROUND_UP_MULTIPLE ((unsigned long) n,
+			      FIXEDBASE_ALIGN / GMP_LIMB_BYTES);
+  blocks = (w[2] + w[3] - 1) / w[3];
+  if (blocks > (unsigned long) (MP_SIZE_T_MAX >> w[1]))
+    goto fail;
+  entries = ((mp_size_t) blocks << w[1]) - blocks;
+  if ((size_t) entries
+      > ((~ (size_t) 0) - FIXEDBASE_ALIGN) / GMP_LIMB_BYTES / stride)
+    goto fail;
+
+  for (i = 0; i < entries; i++)
+    {
+      size = mpz_inp_raw (x, fp);
+      xn = SIZ(x);
+      if (size == 0 || xn < 0 || xn > n)
+	goto fail;
+      total += size;
+
+      if (i == alloc)
+	{
+	  alloc = MIN (entries, 2 * alloc + 16);
+	  if (i == 0)
+	    bp = __GMP_ALLOCATE_FUNC_LIMBS (alloc * n);
+	  else
+	    bp = __GMP_REALLOCATE_FUNC_LIMBS (bp, i * n, alloc * n);
+	}
+      xp = bp + i * n;
+      MPN_COPY (xp, PTR(x), xn);
+      MPN_ZERO (xp + xn, n - xn);
+    }
+
+  mpz_fixedbase_alloc (fb, g, m, w[2], w[1], w[3]);
+  ASSERT (FIXEDBASE_ENTRIES (fb) == entries);
+  for (i = 0; i < entries; i++)
+    MPN_COPY (fb->_mp_d + i * fb->_mp_stride, bp + i * n, n);
+
+  __GMP_FREE_FUNC_LIMBS (bp, alloc * n);
+  mpz_clear (m);
+  mpz_clear (g);
+  mpz_clear (x);
+  return total;
+
+ fail:
+  if (alloc != 0)
+    __GMP_FREE_FUNC_LIMBS (bp, alloc * n);
+  mpz_clear (m);
+  mpz_clear (g);
+  mpz_clear (x);
+  return 0;
+}
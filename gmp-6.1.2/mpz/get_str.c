@@ -2,9 +2,10 @@
    number MP_SRC to a string STRING of base BASE.  If STRING is NULL
    allocate space for the result.  In any case, return a pointer to the
    result.  If STRING is not NULL, the caller must ensure enough space is
-   available to store the result.
+   available to store the result.  mpz_get_str_ctx does the same with the
+   base and powers from a context.
 
-Copyright 1991, 1993, 1994, 1996, 2000-2002, 2005, 2012 Free Software
+Copyright 1991, 1993, 1994, 1996, 2000-2002, 2005, 2012, 2026 Free Software
 Foundation, Inc.
 
 This file is part of the GNU MP Library.
@@ -38,8 +39,8 @@ see https://www.gnu.org/licenses/.  */
 #include "gmp-impl.h"
 #include "longlong.h"
 
-char *
-mpz_get_str (char *res_str, int base, mpz_srcptr x)
+static char *
+get_str (char *res_str, int base, mpz_srcptr x, mpz_basectx_ptr ctx)
 {
   mp_ptr xp;
   mp_size_t x_size = SIZ (x);
@@ -97,7 +98,17 @@ mpz_get_str (char *res_str, int base, mpz_srcptr x)
       MPN_COPY (xp, PTR (x), x_size);
     }
 
-  str_size = mpn_get_str ((unsigned char *) res_str, base, xp, x_size);
+  if (ctx != NULL && ! POW2_P (base)
+      && ! BELOW_THRESHOLD (x_size, GET_STR_PRECOMPUTE_THRESHOLD))
+    {
+      int pi;
+      MPN_SIZEINBASE (str_size, xp, x_size, base);
+      pi = mpz_basectx_powtab (ctx, str_size);
+      str_size = mpn_get_str_pre ((unsigned char *) res_str, xp, x_size,
+				  BASECTX_POWTAB (ctx) + pi);
+    }
+  else
+    str_size = mpn_get_str ((unsigned char *) res_str, base, xp, x_size);
   ASSERT (alloc_size == 0 || str_size <= alloc_size - (SIZ(x) < 0));
 
   /* Convert result to printable chars.  */
@@ -117,3 +128,15 @@ mpz_get_str (char *res_str, int base, mpz_srcptr x)
     }
   return return_str;
 }
+
+char *
+mpz_get_str (char *res_str, int base, mpz_srcptr x)
+{
+  return get_str (res_str, base, x, NULL);
+}
+
+char *
+mpz_get_str_ctx (char *res_str, mpz_srcptr x, mpz_basectx_ptr ctx)
+{
+  return get_str (res_str, ctx->_mp_base, x, ctx);
+}
@@ -31,15 +31,15 @@ see https://www.gnu.org/licenses/.  */
 #include "gmp.h"
 #include "gmp-impl.h"
 
+/* Nothing is allocated until a value is stored.  Until then ALLOC is 0 and
+   PTR points to a dummy limb, so that reading the low limb of a zero, as
+   mpz_get_ui does, is still valid.  */
+static const mp_limb_t dummy_limb = 0xc1a0;
+
 void
 mpz_init (mpz_ptr x)
 {
-  ALLOC (x) = 1;
-  PTR (x) = __GMP_ALLOCATE_FUNC_LIMBS (1);
+  ALLOC (x) = 0;
+  PTR (x) = (mp_ptr) &dummy_limb;
   SIZ (x) = 0;
-
-#ifdef __CHECKER__
-  /* let the low limb look initialized, for the benefit of mpz_get_ui etc */
-  PTR (x)[0] = 0;
-#endif
 }
@@ -32,6 +32,9 @@ see https://www.gnu.org/licenses/.  */
 #include "gmp.h"
 #include "gmp-impl.h"
 
+/* As in mpz_init, nothing is allocated.  */
+static const mp_limb_t dummy_limb = 0xc1a0;
+
 void
 mpz_inits (mpz_ptr x, ...)
 {
@@ -41,15 +44,10 @@ mpz_inits (mpz_ptr x, ...)
 
   while (x != NULL)
     {
-      ALLOC (x) = 1;
-      PTR (x) = __GMP_ALLOCATE_FUNC_LIMBS (1);
+      ALLOC (x) = 0;
+      PTR (x) = (mp_ptr) &dummy_limb;
       SIZ (x) = 0;
 
-#ifdef __CHECKER__
-      /* let the low limb look initialized, for the benefit of mpz_get_ui etc */
-      PTR (x)[0] = 0;
-#endif
-
       x = va_arg (ap, mpz_ptr);
     }
 
@@ -0,0 +1,51 @@
+/* mpz_invert_ctx(r,a,ctx) -- Set r to the inverse of a mod the modulus of
+   ctx, if it exists.  Return non-zero if it does.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* The inversion itself is mpz_invert's, but the operand reduction it would
+   do with a plain division comes from the context.  */
+
+int
+mpz_invert_ctx (mpz_ptr r, mpz_srcptr a, mpz_modctx_srcptr c)
+{
+  mpz_t t;
+  int res;
+  TMP_DECL;
+
+  TMP_MARK;
+  MPZ_TMP_INIT (t, MODCTX_SIZE (c));
+  mpz_mod_ctx (t, a, c);
+  res = mpz_invert (r, t, &c->_mp_mod);
+  TMP_FREE;
+  return res;
+}
@@ -139,7 +139,7 @@ mpz_ior (mpz_ptr res, mpz_srcptr op1, mpz_srcptr op2)
 	    }
 	  else
 	    {
-	      res_ptr[0] = 1;
+	      MPZ_NEWALLOC (res, 1)[0] = 1;
 	      res_size = 1;
 	    }
 
@@ -0,0 +1,62 @@
+/* mpz_mod_ctx(r,a,ctx) -- Set r to a mod the modulus of ctx.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+void
+mpz_mod_ctx (mpz_ptr r, mpz_srcptr a, mpz_modctx_srcptr c)
+{
+  mp_size_t n, rn;
+  mp_ptr rp, xp;
+  mp_srcptr mp;
+  TMP_DECL;
+
+  n = MODCTX_SIZE (c);
+  mp = PTR(&c->_mp_mod);
+
+  TMP_MARK;
+  rp = TMP_ALLOC_LIMBS (n);
+  mpz_modctx_reduce (rp, PTR(a), ABSIZ(a), c);
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  if (SIZ(a) < 0 && rn != 0)
+    {
+      mpn_sub (rp, mp, n, rp, rn);
+      rn = n;
+      MPN_NORMALIZE (rp, rn);
+    }
+
+  xp = MPZ_NEWALLOC (r, rn);
+  MPN_COPY (xp, rp, rn);
+  SIZ(r) = rn;
+  TMP_FREE;
+}
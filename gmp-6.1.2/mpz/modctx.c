@@ -0,0 +1,214 @@
+/* mpz_modctx_init, mpz_modctx_clear -- precomputed modulus contexts.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+
+/* Everything mpz_tdiv_qr and mpz_powm work out from the divisor on each
+   call is done here once: the normalizing shift and the divisor shifted by
+   it, the 3/2 inverse for the schoolbook and divide-and-conquer divisions,
+   the approximate inverse for mpn_preinv_mu_div_qr when the modulus is big
+   enough that products of residues would go to the mu division, and for an
+   odd modulus the REDC inverse and B^2n mod M used by mpz_powm_ctx.
+
+   The mu inverse is sized for a 2n limb dividend, the product of two
+   residues.  */
+
+void
+mpz_modctx_init (mpz_modctx_ptr c, mpz_srcptr m)
+{
+  mp_size_t n, in;
+  mp_ptr dp, ip, tp;
+  mp_limb_t cy;
+  int cnt;
+  TMP_DECL;
+
+  n = ABSIZ(m);
+  if (UNLIKELY (n == 0))
+    DIVIDE_BY_ZERO;
+
+  mpz_init (&c->_mp_mod);
+  mpz_abs (&c->_mp_mod, m);
+
+  in = 0;
+  if (n > 2
+      && ! BELOW_THRESHOLD (n, MUPI_DIV_QR_THRESHOLD)
+      && ! BELOW_THRESHOLD (n, MU_DIV_QR_THRESHOLD))
+    in = mpn_mu_div_qr_choose_in (n, n, 0);
+  c->_mp_in = in;
+
+  c->_mp_d = __GMP_ALLOCATE_FUNC_LIMBS (MODCTX_ALLOC (c));
+
+  dp = MODCTX_DP (c);
+  count_leading_zeros (cnt, PTR(m)[n - 1]);
+  cnt -= GMP_NAIL_BITS;
+  c->_mp_shift = cnt;
+  if (cnt != 0)
+    mpn_lshift (dp, PTR(m), n, cnt);
+  else
+    MPN_COPY (dp, PTR(m), n);
+
+  if (n >= 2)
+    {
+      gmp_pi1_t dinv;
+      invert_pi1 (dinv, dp[n - 1], dp[n - 2]);
+      c->_mp_dinv = dinv.inv32;
+    }
+  else
+    invert_limb (c->_mp_dinv, dp[0]);
+
+  TMP_MARK;
+  tp = TMP_ALLOC_LIMBS (MAX (2 * in + 2 + mpn_invertappr_itch (in + 1),
+			     MAX (mpn_binvert_itch (n), 2 * n + 1)));
+
+  if (in != 0)
+    {
+      /* As in mpn_mu_div_qr.  */
+      ip = MODCTX_IP (c);
+      if (n == in)
+	{
+	  MPN_COPY (tp + 1, dp, in);
+	  tp[0] = 1;
+	  mpn_invertappr (tp + in + 1, tp, in + 1, tp + 2 * in + 2);
+	  MPN_COPY (ip, tp + in + 2, in);
+	}
+      else
+	{
+	  cy = mpn_add_1 (tp, dp + n - (in + 1), in + 1, 1);
+	  if (UNLIKELY (cy != 0))
+	    MPN_ZERO (ip, in);
+	  else
+	    {
+	      mpn_invertappr (tp + in + 1, tp, in + 1, tp + 2 * in + 2);
+	      MPN_COPY (ip, tp + in + 2, in);
+	    }
+	}
+    }
+
+  if (MODCTX_ODD_P (c))
+    c->_mp_redc = mpn_powm_batch_init (MODCTX_MIP (c), MODCTX_R2P (c),
+				       PTR(m), n, tp);
+
+  TMP_FREE;
+}
+
+void
+mpz_modctx_clear (mpz_modctx_ptr c)
+{
+  __GMP_FREE_FUNC_LIMBS (c->_mp_d, MODCTX_ALLOC (c));
+  mpz_clear (&c->_mp_mod);
+}
+
+/* Set {rp,n} to {np,nn} mod M, not normalized, where n is the size of M.
+   Allows rp == np.  */
+void
+mpz_modctx_reduce (mp_ptr rp, mp_srcptr np, mp_size_t nn,
+		   mpz_modctx_srcptr c)
+{
+  mp_size_t n, in;
+  mp_srcptr dp;
+  mp_ptr tp, qp;
+  int cnt;
+  TMP_DECL;
+
+  n = MODCTX_SIZE (c);
+
+  if (nn < n)
+    {
+      MPN_COPY (rp, np, nn);
+      MPN_ZERO (rp + nn, n - nn);
+      return;
+    }
+
+  if (n == 1)
+    {
+      rp[0] = mpn_mod_1 (np, nn, PTR(&c->_mp_mod)[0]);
+      return;
+    }
+
+  TMP_MARK;
+
+  dp = MODCTX_DP (c);
+  cnt = c->_mp_shift;
+
+  if (n == 2)
+    {
+      qp = TMP_ALLOC_LIMBS (nn - 2);
+      if (cnt != 0)
+	mpn_div_qr_2u_pi1 (qp, rp, np, nn, dp[1], dp[0], cnt, c->_mp_dinv);
+      else
+	mpn_div_qr_2n_pi1 (qp, rp, np, nn, dp[1], dp[0], c->_mp_dinv);
+      TMP_FREE;
+      return;
+    }
+
+  /* Shift the dividend as the divisor, always with an extra high limb, so
+     the high n limbs are below the divisor and there's no quotient high
+     limb to deal with.  */
+  tp = TMP_ALLOC_LIMBS (nn + 1);
+  qp = TMP_ALLOC_LIMBS (nn + 1 - n);
+  if (cnt != 0)
+    tp[nn] = mpn_lshift (tp, np, nn, cnt);
+  else
+    {
+      MPN_COPY (tp, np, nn);
+      tp[nn] = 0;
+    }
+  nn++;
+
+  in = c->_mp_in;
+  if (BELOW_THRESHOLD (n, DC_DIV_QR_THRESHOLD)
+	   || BELOW_THRESHOLD (nn - n, DC_DIV_QR_THRESHOLD))
+    mpn_sbpi1_div_qr (qp, tp, nn, dp, n, c->_mp_dinv);
+  else if (in == 0 || nn < 2 * n)
+    {
+      gmp_pi1_t dinv;
+      dinv.inv32 = c->_mp_dinv;
+      mpn_dcpi1_div_qr (qp, tp, nn, dp, n, &dinv);
+    }
+  else
+    {
+      mp_ptr scratch, r2p;
+      scratch = TMP_ALLOC_LIMBS (mpn_preinv_mu_div_qr_itch (nn, n, in));
+      r2p = TMP_ALLOC_LIMBS (n);
+      mpn_preinv_mu_div_qr (qp, r2p, tp, nn, dp, n, MODCTX_IP (c), in,
+			    scratch);
+      MPN_COPY (tp, r2p, n);
+    }
+
+  if (cnt != 0)
+    mpn_rshift (rp, tp, n, cnt);
+  else
+    MPN_COPY (rp, tp, n);
+
+  TMP_FREE;
+}
@@ -0,0 +1,101 @@
+/* mpz_mulmod_ctx(r,a,b,ctx) -- Set r to a*b mod the modulus of ctx.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* Operands bigger than the modulus are reduced first, so the product is
+   at most 2n limbs, the size the mu inverse in the context is made for.  */
+
+void
+mpz_mulmod_ctx (mpz_ptr r, mpz_srcptr a, mpz_srcptr b, mpz_modctx_srcptr c)
+{
+  mp_size_t n, an, bn, rn;
+  mp_srcptr ap, bp, mp;
+  mp_ptr tp, rp, xp;
+  TMP_DECL;
+
+  n = MODCTX_SIZE (c);
+  mp = PTR(&c->_mp_mod);
+  an = ABSIZ(a);
+  bn = ABSIZ(b);
+
+  if (an == 0 || bn == 0)
+    {
+      SIZ(r) = 0;
+      return;
+    }
+
+  TMP_MARK;
+  ap = PTR(a);
+  if (an > n)
+    {
+      tp = TMP_ALLOC_LIMBS (n);
+      mpz_modctx_reduce (tp, ap, an, c);
+      ap = tp;
+      an = n;
+      MPN_NORMALIZE (tp, an);
+    }
+  bp = PTR(b);
+  if (bn > n)
+    {
+      tp = TMP_ALLOC_LIMBS (n);
+      mpz_modctx_reduce (tp, bp, bn, c);
+      bp = tp;
+      bn = n;
+      MPN_NORMALIZE (tp, bn);
+    }
+
+  rp = TMP_ALLOC_LIMBS (n);
+  rn = 0;
+  if (an != 0 && bn != 0)
+    {
+      tp = TMP_ALLOC_LIMBS (an + bn);
+      if (an >= bn)
+	mpn_mul (tp, ap, an, bp, bn);
+      else
+	mpn_mul (tp, bp, bn, ap, an);
+      mpz_modctx_reduce (rp, tp, an + bn, c);
+      rn = n;
+      MPN_NORMALIZE (rp, rn);
+    }
+
+  if ((SIZ(a) ^ SIZ(b)) < 0 && rn != 0)
+    {
+      mpn_sub (rp, mp, n, rp, rn);
+      rn = n;
+      MPN_NORMALIZE (rp, rn);
+    }
+
+  xp = MPZ_NEWALLOC (r, rn);
+  MPN_COPY (xp, rp, rn);
+  SIZ(r) = rn;
+  TMP_FREE;
+}
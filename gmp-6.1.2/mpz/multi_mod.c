@@ -0,0 +1,107 @@
+/* mpz_multi_mod (R, A, C) -- Set each R[i] to A mod the moduli of C.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* A remainder tree: A mod the root product, then each node's remainder
+   reduced mod its two children's products, down to the moduli.  Only the
+   remainders on the path being worked are held, each freed once both its
+   children are reduced.  */
+
+struct multi_mod_par
+{
+  mpz_ptr *r;
+  mpz_crtctx_srcptr c;
+  size_t lo, hi;
+  mpz_ptr a;
+};
+
+static void multi_mod_tree (mpz_ptr *, mpz_crtctx_srcptr, size_t, size_t,
+			    mpz_ptr);
+
+static void
+multi_mod_task (void *data, int i)
+{
+  struct multi_mod_par *p = (struct multi_mod_par *) data + i;
+  multi_mod_tree (p->r, p->c, p->lo, p->hi, p->a);
+}
+
+/* With A reduced mod the product of [lo,hi), set the remainders of that
+   range, and clear A.  */
+static void
+multi_mod_tree (mpz_ptr *r, mpz_crtctx_srcptr c, size_t lo, size_t hi,
+		mpz_ptr a)
+{
+  struct multi_mod_par par[2];
+  mpz_t a1, a2;
+  size_t mid;
+
+  if (hi - lo == 1)
+    {
+      mpz_swap (r[lo], a);
+      mpz_clear (a);
+      return;
+    }
+  mid = (lo + hi) / 2;
+
+  mpz_init (a1);
+  mpz_init (a2);
+  mpz_tdiv_r (a1, a, CRTCTX_NODE (c, lo, mid));
+  mpz_tdiv_r (a2, a, CRTCTX_NODE (c, mid, hi));
+  mpz_clear (a);
+
+  if (hi - lo >= 4
+      && MPN_PARALLEL_P (mpz_size (CRTCTX_NODE (c, lo, hi)),
+			 CRT_PARALLEL_THRESHOLD))
+    {
+      par[0].r = r; par[0].c = c; par[0].lo = lo;  par[0].hi = mid;
+      par[0].a = a1;
+      par[1].r = r; par[1].c = c; par[1].lo = mid; par[1].hi = hi;
+      par[1].a = a2;
+      MPN_PARALLEL_RUN (multi_mod_task, par, 2);
+    }
+  else
+    {
+      multi_mod_tree (r, c, lo, mid, a1);
+      multi_mod_tree (r, c, mid, hi, a2);
+    }
+}
+
+void
+mpz_multi_mod (mpz_ptr *r, mpz_srcptr a, mpz_crtctx_srcptr c)
+{
+  mpz_t t;
+
+  /* The remainders stay non-negative on the way down.  */
+  mpz_init (t);
+  mpz_fdiv_r (t, a, CRTCTX_NODE (c, 0, c->_mp_count));
+  multi_mod_tree (r, c, 0, c->_mp_count, t);
+}
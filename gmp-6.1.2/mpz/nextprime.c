@@ -1,6 +1,8 @@
 /* mpz_nextprime(p,t) - compute the next prime > t and store that in p.
 
-Copyright 1999-2001, 2008, 2009, 2012 Free Software Foundation, Inc.
+   mpz_nextprime_range(rp,count,a,b) - store the primes a <= p < b in rp[].
+
+Copyright 1999-2001, 2008, 2009, 2012, 2026 Free Software Foundation, Inc.
 
 Contributed to the GNU project by Niels Möller and Torbjorn Granlund.
 
@@ -32,33 +34,134 @@ see https://www.gnu.org/licenses/.  */
 
 #include "gmp.h"
 #include "gmp-impl.h"
-#include "longlong.h"
 
-static const unsigned char primegap[] =
+/* The candidates are sieved a window at a time, against all the odd primes
+   below a limit growing with the size of the numbers.  A remainder of the
+   window start is kept for each sieving prime, and stepped along with the
+   window, so the big number is divided only once, and then by products of
+   as many primes as fit a limb.  The few survivors go to mpz_bpsw_p.  */
+
+#define SIEVE_LIMIT_MAX  0x40000	/* about 23000 odd primes */
+#define WINDOW_MAX       0x10000	/* odd candidates per window */
+
+/* id_to_n (x) = bit_to_n (x-1) = (id*3+1)|1*/
+static mp_limb_t
+id_to_n  (mp_limb_t id)  { return id*3+1+(id&1); }
+
+/* n_to_bit (n) = ((n-5)|1)/3U */
+static mp_limb_t
+n_to_bit (mp_limb_t n) { return ((n-5)|1)/3U; }
+
+/* Store the probable primes p with a <= p < b, or with no upper limit if b
+   is NULL, in rp[0], rp[1], ..., stopping after count of them, and return
+   the number stored.  a must be odd and >= 3.  The rp[] can be the same
+   variable as a, but not as b.  */
+static size_t
+sieve_range (mpz_ptr *rp, size_t count, mpz_srcptr a, mpz_srcptr b)
 {
-  2,2,4,2,4,2,4,6,2,6,4,2,4,6,6,2,6,4,2,6,4,6,8,4,2,4,2,4,14,4,6,
-  2,10,2,6,6,4,6,6,2,10,2,4,2,12,12,4,2,4,6,2,10,6,6,6,2,6,4,2,10,14,4,2,
-  4,14,6,10,2,4,6,8,6,6,4,6,8,4,8,10,2,10,2,6,4,6,8,4,2,4,12,8,4,8,4,6,
-  12,2,18,6,10,6,6,2,6,10,6,6,2,6,6,4,2,12,10,2,4,6,6,2,12,4,6,8,10,8,10,8,
-  6,6,4,8,6,4,8,4,14,10,12,2,10,2,4,2,10,14,4,2,4,14,4,2,4,20,4,8,10,8,4,6,
-  6,14,4,6,6,8,6,12
-};
+  unsigned *primes, *residues;
+  mp_ptr sieve, sp;
+  mp_limb_t limit, prod, r;
+  unsigned long np, w, ww, i, k, j, q, s0;
+  mp_bitcnt_t nbits;
+  mpz_t c, t;
+  size_t found;
+  TMP_DECL;
+
+  nbits = mpz_sizeinbase (b != NULL ? b : a, 2);
+  limit = MIN ((mp_limb_t) nbits * 32, SIEVE_LIMIT_MAX);
+  w = MIN (MAX (2 * nbits, 256), WINDOW_MAX);
+  w = ROUND_UP_MULTIPLE (w, (unsigned long) GMP_LIMB_BITS);
+
+  TMP_MARK;
+
+  sp = TMP_ALLOC_LIMBS (n_to_bit (limit) / GMP_LIMB_BITS + 1);
+  np = gmp_primesieve (sp, limit) + 1;
+  primes = TMP_ALLOC_TYPE (np, unsigned);
+  residues = TMP_ALLOC_TYPE (np, unsigned);
+  primes[0] = 3;
+  for (i = 0, k = 1; k < np; i++)
+    if ((sp[i / GMP_LIMB_BITS] & (CNST_LIMB(1) << (i % GMP_LIMB_BITS))) == 0)
+      primes[k++] = id_to_n (i + 1);
+
+  for (i = 0; i < np; )
+    {
+      prod = primes[i];
+      for (k = i + 1; k < np && prod <= GMP_NUMB_MAX / primes[k]; k++)
+	prod *= primes[k];
+      r = mpn_mod_1 (PTR (a), SIZ (a), prod);
+      for ( ; i < k; i++)
+	residues[i] = r % primes[i];
+    }
+
+  sieve = TMP_ALLOC_LIMBS (w / GMP_LIMB_BITS);
+
+  mpz_init_set (c, a);
+  mpz_init (t);
+  found = 0;
+
+  for (;;)
+    {
+      /* The window is the odd c + 2j, 0 <= j < ww.  */
+      ww = w;
+      if (b != NULL)
+	{
+	  mpz_sub (t, b, c);
+	  if (mpz_sgn (t) <= 0)
+	    break;
+	  if (mpz_cmp_ui (t, 2 * w) < 0)
+	    ww = (mpz_get_ui (t) + 1) / 2;
+	}
+
+      /* While c is below the limit, the sieving primes are candidates too,
+	 and mustn't be struck out.  */
+      s0 = mpz_cmp_ui (c, limit) <= 0 ? mpz_get_ui (c) : 0;
+
+      MPN_ZERO (sieve, w / GMP_LIMB_BITS);
+      for (i = 0; i < np; i++)
+	{
+	  q = primes[i];
+	  r = residues[i];
 
-#define NUMBER_OF_PRIMES 167
+	  /* First j with c + 2j = 0 mod q.  */
+	  j = r == 0 ? 0 : q - r;
+	  if (j & 1)
+	    j += q;
+	  j /= 2;
+	  if (s0 != 0 && q >= s0 && j == (q - s0) / 2)
+	    j += q;
+
+	  for ( ; j < ww; j += q)
+	    sieve[j / GMP_LIMB_BITS] |= CNST_LIMB(1) << (j % GMP_LIMB_BITS);
+
+	  residues[i] = (r + 2 * w) % q;
+	}
+
+      for (j = 0; j < ww; j++)
+	if ((sieve[j / GMP_LIMB_BITS] & (CNST_LIMB(1) << (j % GMP_LIMB_BITS))) == 0)
+	  {
+	    mpz_add_ui (t, c, 2 * j);
+	    if (mpz_bpsw_p (t))
+	      {
+		mpz_set (rp[found], t);
+		if (++found == count)
+		  goto done;
+	      }
+	  }
+
+      mpz_add_ui (c, c, 2 * w);
+    }
+
+ done:
+  mpz_clear (c);
+  mpz_clear (t);
+  TMP_FREE;
+  return found;
+}
 
 void
 mpz_nextprime (mpz_ptr p, mpz_srcptr n)
 {
-  unsigned short *moduli;
-  unsigned long difference;
-  int i;
-  unsigned prime_limit;
-  unsigned long prime;
-  mp_size_t pn;
-  mp_bitcnt_t nbits;
-  unsigned incr;
-  TMP_SDECL;
-
   /* First handle tiny numbers */
   if (mpz_cmp_ui (n, 2) < 0)
     {
@@ -71,59 +174,34 @@ mpz_nextprime (mpz_ptr p, mpz_srcptr n)
   if (mpz_cmp_ui (p, 7) <= 0)
     return;
 
-  pn = SIZ(p);
-  MPN_SIZEINBASE_2EXP(nbits, PTR(p), pn, 1);
-  if (nbits / 2 >= NUMBER_OF_PRIMES)
-    prime_limit = NUMBER_OF_PRIMES - 1;
-  else
-    prime_limit = nbits / 2;
+  sieve_range (&p, 1, p, NULL);
+}
 
-  TMP_SMARK;
+size_t
+mpz_nextprime_range (mpz_ptr *rp, size_t count, mpz_srcptr a, mpz_srcptr b)
+{
+  mpz_t s, e;
+  size_t found;
 
-  /* Compute residues modulo small odd primes */
-  moduli = TMP_SALLOC_TYPE (prime_limit * sizeof moduli[0], unsigned short);
+  if (count == 0 || mpz_cmp (a, b) >= 0 || mpz_cmp_ui (b, 2) <= 0)
+    return 0;
 
-  for (;;)
+  /* Copy the ends, so the rp[] can be any variables.  */
+  mpz_init_set (e, b);
+  mpz_init_set (s, a);
+
+  found = 0;
+  if (mpz_cmp_ui (s, 2) <= 0)
     {
-      /* FIXME: Compute lazily? */
-      prime = 3;
-      for (i = 0; i < prime_limit; i++)
-	{
-	  moduli[i] = mpz_fdiv_ui (p, prime);
-	  prime += primegap[i];
-	}
+      mpz_set_ui (rp[found++], 2);
+      mpz_set_ui (s, 3);
+    }
+  mpz_setbit (s, 0);
 
-#define INCR_LIMIT 0x10000	/* deep science */
+  if (found < count)
+    found += sieve_range (rp + found, count - found, s, e);
 
-      for (difference = incr = 0; incr < INCR_LIMIT; difference += 2)
-	{
-	  /* First check residues */
-	  prime = 3;
-	  for (i = 0; i < prime_limit; i++)
-	    {
-	      unsigned r;
-	      /* FIXME: Reduce moduli + incr and store back, to allow for
-		 division-free reductions.  Alternatively, table primes[]'s
-		 inverses (mod 2^16).  */
-	      r = (moduli[i] + incr) % prime;
-	      prime += primegap[i];
-
-	      if (r == 0)
-		goto next;
-	    }
-
-	  mpz_add_ui (p, p, difference);
-	  difference = 0;
-
-	  /* Miller-Rabin test */
-	  if (mpz_millerrabin (p, 25))
-	    goto done;
-	next:;
-	  incr += 2;
-	}
-      mpz_add_ui (p, p, difference);
-      difference = 0;
-    }
- done:
-  TMP_SFREE;
+  mpz_clear (s);
+  mpz_clear (e);
+  return found;
 }
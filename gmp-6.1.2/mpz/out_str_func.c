@@ -0,0 +1,122 @@
+/* mpz_out_str_func(func, data, base, integer) -- Pass the digits of INTEGER
+   in base BASE to FUNC, a block at a time.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The digits come from mpn_out_str_func as each basecase conversion is
+   done, and go out straight away, so only the divide-and-conquer remainders
+   are held, not the whole string.  */
+
+struct out_str_func_data
+{
+  void (*func) (void *, const char *, size_t);
+  void *data;
+  const char *num_to_text;
+};
+
+static void
+out_digits (void *data, unsigned char *str, size_t len)
+{
+  struct out_str_func_data *d = (struct out_str_func_data *) data;
+  size_t i;
+
+  if (len == 0)
+    return;
+
+  /* Convert to printable chars.  */
+  for (i = 0; i < len; i++)
+    str[i] = d->num_to_text[str[i]];
+
+  (*d->func) (d->data, (const char *) str, len);
+}
+
+size_t
+mpz_out_str_func (void (*func) (void *, const char *, size_t), void *data,
+		  int base, mpz_srcptr x)
+{
+  struct out_str_func_data d;
+  mp_ptr xp;
+  mp_size_t x_size = SIZ (x);
+  size_t written;
+  TMP_DECL;
+
+  if (base >= 0)
+    {
+      d.num_to_text = "0123456789abcdefghijklmnopqrstuvwxyz";
+      if (base <= 1)
+	base = 10;
+      else if (base > 36)
+	{
+	  d.num_to_text = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+	  if (base > 62)
+	    return 0;
+	}
+    }
+  else
+    {
+      base = -base;
+      if (base <= 1)
+	base = 10;
+      else if (base > 36)
+	return 0;
+      d.num_to_text = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    }
+
+  d.func = func;
+  d.data = data;
+
+  written = 0;
+
+  if (x_size < 0)
+    {
+      (*func) (data, "-", 1);
+      x_size = -x_size;
+      written = 1;
+    }
+
+  /* mpn_out_str_func clobbers its input on non power-of-2 bases */
+  TMP_MARK;
+  xp = PTR (x);
+  if (! POW2_P (base))
+    {
+      xp = TMP_ALLOC_LIMBS (x_size | 1);  /* |1 in case x_size==0 */
+      MPN_COPY (xp, PTR (x), x_size);
+    }
+
+  written += mpn_out_str_func (out_digits, &d, base, xp, x_size);
+
+  TMP_FREE;
+  return written;
+}
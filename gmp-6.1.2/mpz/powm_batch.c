@@ -0,0 +1,148 @@
+/* mpz_powm_batch(res,base,exp,count,mod) -- Set res[i] to base[i]^exp[i]
+   mod mod, for 0 <= i < count.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The results are formed in temporary space and only stored at the end, so
+   any res[i] can be the same variable as any of the inputs.
+
+   Bases are reduced mod m up front, so a negative base just becomes its
+   positive residue.  Even moduli, zero and negative exponents and zero
+   bases are uncommon and left to mpz_powm, one by one.  */
+
+void
+mpz_powm_batch (mpz_ptr *r, mpz_srcptr *b, mpz_srcptr *e, size_t count,
+		mpz_srcptr m)
+{
+  mp_size_t n, bn, rn, maxbn;
+  size_t i, k;
+  mp_srcptr mp;
+  mp_ptr rp, bp, tp, qp;
+  mp_srcptr *epv;
+  mp_size_t *env, *rnv;
+  size_t *job;
+  mpz_t t;
+  int odd;
+  TMP_DECL;
+
+  n = ABSIZ(m);
+  if (UNLIKELY (n == 0))
+    DIVIDE_BY_ZERO;
+
+  if (count == 0)
+    return;
+
+  mp = PTR(m);
+  odd = (mp[0] & 1) != 0;
+
+  TMP_MARK;
+
+  maxbn = 0;
+  for (i = 0; i < count; i++)
+    maxbn = MAX (maxbn, ABSIZ(b[i]));
+
+  rp = TMP_ALLOC_LIMBS (count * n);
+  bp = TMP_ALLOC_LIMBS (count * n);
+  tp = TMP_ALLOC_LIMBS (MAX (mpn_binvert_itch (n), 2 * n + 1));
+  qp = TMP_ALLOC_LIMBS (MAX (maxbn - n + 1, 1));
+  rnv = TMP_ALLOC_TYPE (count, mp_size_t);
+  epv = TMP_ALLOC_TYPE (count, mp_srcptr);
+  env = TMP_ALLOC_TYPE (count, mp_size_t);
+  job = TMP_ALLOC_TYPE (count, size_t);
+  MPZ_TMP_INIT (t, n + 1);
+
+  /* Gather the reduced bases for mpn_powm_batch at the front of bp, in the
+     order they come, and do the others right away.  */
+  k = 0;
+  for (i = 0; i < count; i++)
+    {
+      mp_ptr up;
+
+      bn = ABSIZ(b[i]);
+      if (! odd || SIZ(e[i]) <= 0 || bn == 0)
+	{
+	  mpz_powm (t, b[i], e[i], m);
+	  rnv[i] = SIZ(t);
+	  MPN_COPY (rp + i * n, PTR(t), SIZ(t));
+	  continue;
+	}
+
+      up = bp + k * n;
+      if (bn >= n)
+	mpn_tdiv_qr (qp, up, 0L, PTR(b[i]), bn, mp, n);
+      else
+	{
+	  MPN_COPY (up, PTR(b[i]), bn);
+	  MPN_ZERO (up + bn, n - bn);
+	}
+
+      if (SIZ(b[i]) < 0)
+	{
+	  /* b mod m = m - (|b| mod m), unless that's zero.  */
+	  rn = n;
+	  MPN_NORMALIZE (up, rn);
+	  if (rn != 0)
+	    mpn_sub (up, mp, n, up, rn);
+	}
+
+      epv[k] = PTR(e[i]);
+      env[k] = SIZ(e[i]);
+      job[k] = i;
+      k++;
+    }
+
+  if (k != 0)
+    {
+      mpn_powm_batch (bp, bp, epv, env, k, mp, n, tp);
+
+      for (i = 0; i < k; i++)
+	{
+	  rn = n;
+	  MPN_NORMALIZE (bp + i * n, rn);
+	  rnv[job[i]] = rn;
+	  MPN_COPY (rp + job[i] * n, bp + i * n, rn);
+	}
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      mp_ptr xp;
+      rn = rnv[i];
+      xp = MPZ_NEWALLOC (r[i], rn);
+      MPN_COPY (xp, rp + i * n, rn);
+      SIZ(r[i]) = rn;
+    }
+
+  TMP_FREE;
+}
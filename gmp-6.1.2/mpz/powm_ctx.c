@@ -0,0 +1,103 @@
+/* mpz_powm_ctx(r,b,e,ctx) -- Set r to b^e mod the modulus of ctx.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* For an odd modulus the REDC inverse and B^2n mod M come from the context
+   and the exponentiation is mpn_powm_batch_pre's, for a batch of one.  An
+   even modulus isn't worth a special case, it goes to mpz_powm.  */
+
+void
+mpz_powm_ctx (mpz_ptr r, mpz_srcptr b, mpz_srcptr e, mpz_modctx_srcptr c)
+{
+  mp_size_t n, en, rn;
+  mp_srcptr mp, ep;
+  mp_ptr rp, bp, tp, xp;
+  mpz_t t;
+  TMP_DECL;
+
+  if (! MODCTX_ODD_P (c))
+    {
+      mpz_powm (r, b, e, &c->_mp_mod);
+      return;
+    }
+
+  n = MODCTX_SIZE (c);
+  mp = PTR(&c->_mp_mod);
+  en = SIZ(e);
+
+  TMP_MARK;
+
+  if (en < 0)
+    {
+      MPZ_TMP_INIT (t, n + 1);
+      if (! mpz_invert_ctx (t, b, c))
+	DIVIDE_BY_ZERO;
+      b = t;
+      en = -en;
+    }
+
+  if (en == 0)
+    {
+      /* b^0 mod m,  b is anything and m is non-zero.
+	 Result is 1 mod m, i.e., 1 or 0 depending on if m = 1.  */
+      SIZ(r) = n != 1 || mp[0] != 1;
+      MPZ_NEWALLOC (r, 1)[0] = 1;
+      TMP_FREE;
+      return;
+    }
+
+  bp = TMP_ALLOC_LIMBS (n);
+  mpz_modctx_reduce (bp, PTR(b), ABSIZ(b), c);
+  rn = n;
+  MPN_NORMALIZE (bp, rn);
+  if (rn == 0)
+    {
+      SIZ(r) = 0;
+      TMP_FREE;
+      return;
+    }
+  if (SIZ(b) < 0)
+    mpn_sub (bp, mp, n, bp, rn);
+
+  ep = PTR(e);
+  rp = TMP_ALLOC_LIMBS (n);
+  tp = TMP_ALLOC_LIMBS (2 * n);
+  mpn_powm_batch_pre (rp, bp, &ep, &en, 1, mp, n,
+		      MODCTX_MIP (c), c->_mp_redc, MODCTX_R2P (c), tp);
+
+  rn = n;
+  MPN_NORMALIZE (rp, rn);
+  xp = MPZ_NEWALLOC (r, rn);
+  MPN_COPY (xp, rp, rn);
+  SIZ(r) = rn;
+  TMP_FREE;
+}
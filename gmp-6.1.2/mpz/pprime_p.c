@@ -40,6 +40,8 @@ see https://www.gnu.org/licenses/.  */
 
 static int isprime (unsigned long int);
 
+#define BPSW_REPS  24
+
 
 /* MPN_MOD_OR_MODEXACT_1_ODD can be used instead of mpn_mod_1 for the trial
    division.  It gives a result which is not the actual remainder r but a
@@ -141,6 +143,17 @@ mpz_probab_prime_p (mpz_srcptr n, int reps)
       }
   }
 
+  /* From BPSW_REPS reps up, a Baillie-PSW test stands in for that many
+     Miller-Rabin rounds, at the cost of about four of them.  Any reps beyond
+     are done as Miller-Rabin rounds on top.  */
+  if (reps >= BPSW_REPS)
+    {
+      int is_prime = mpz_bpsw_p (n);
+      if (is_prime != 1 || reps == BPSW_REPS)
+	return is_prime;
+      reps -= BPSW_REPS;
+    }
+
   /* Perform a number of Miller-Rabin tests.  */
   return mpz_millerrabin (n, reps);
 }
@@ -0,0 +1,88 @@
+/* mpz_prod_ui_array(RESULT, V, N) -- Set RESULT to V[0]*V[1]*...*V[N-1].
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "longlong.h"
+
+/* The values are packed into limbs, each the product of as many of them as
+   fit, as the factorial code does with FACTOR_LIST_STORE, and the limbs
+   are then multiplied with mpz_prodlimbs, a balanced product tree.  */
+
+void
+mpz_prod_ui_array (mpz_ptr r, const unsigned long *v, size_t n)
+{
+  mp_ptr factors;
+  mp_limb_t prod, hi, lo;
+  mp_size_t j;
+  size_t i;
+  TMP_DECL;
+
+  for (i = 0; i < n; i++)
+    if (v[i] == 0)
+      {
+	SIZ (r) = 0;
+	return;
+      }
+
+#if BITS_PER_ULONG > GMP_NUMB_BITS
+  /* A value may need more than one limb, just multiply one by one.  */
+  mpz_set_ui (r, 1);
+  for (i = 0; i < n; i++)
+    mpz_mul_ui (r, r, v[i]);
+#else
+  TMP_MARK;
+  factors = TMP_ALLOC_LIMBS (n + 1);
+
+  j = 0;
+  prod = 1;
+  for (i = 0; i < n; i++)
+    {
+      umul_ppmm (hi, lo, prod, (mp_limb_t) v[i]);
+      if (hi != 0 || lo > GMP_NUMB_MAX)
+	{
+	  factors[j++] = prod;
+	  prod = v[i];
+	}
+      else
+	prod = lo;
+    }
+  factors[j++] = prod;
+
+  if (j == 1)
+    {
+      MPZ_NEWALLOC (r, 1)[0] = prod;
+      SIZ (r) = 1;
+    }
+  else
+    mpz_prodlimbs (r, factors, j);
+  TMP_FREE;
+#endif
+}
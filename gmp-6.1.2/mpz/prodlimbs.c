@@ -7,7 +7,7 @@ IT IS ONLY SAFE TO REACH IT THROUGH DOCUMENTED INTERFACES.
 IN FACT, IT IS ALMOST GUARANTEED THAT IT WILL CHANGE OR
 DISAPPEAR IN A FUTURE GNU MP RELEASE.
 
-Copyright 2010-2012 Free Software Foundation, Inc.
+Copyright 2010-2012, 2026 Free Software Foundation, Inc.
 
 This file is part of the GNU MP Library.
 
@@ -47,6 +47,25 @@ see https://www.gnu.org/licenses/.  */
 #define RECURSIVE_PROD_THRESHOLD (MUL_TOOM22_THRESHOLD)
 #endif
 
+/* FIXME: should be tuned */
+#ifndef PRODLIMBS_PARALLEL_THRESHOLD
+#define PRODLIMBS_PARALLEL_THRESHOLD (MUL_TOOM33_THRESHOLD * 16)
+#endif
+
+struct prodlimbs_par
+{
+  mpz_ptr x;
+  mp_ptr factors;
+  mp_size_t j;
+};
+
+static void
+prodlimbs_task (void *data, int i)
+{
+  struct prodlimbs_par *d = (struct prodlimbs_par *) data + i;
+  d->j = mpz_prodlimbs (d->x, d->factors, d->j);
+}
+
 /* Computes the product of the j>1 limbs pointed by factors, puts the
  * result in x. It assumes that all limbs are non-zero. Above
  * Karatsuba's threshold it uses a binary splitting strategy, to gain
@@ -54,6 +73,12 @@ see https://www.gnu.org/licenses/.  */
  *
  * The list in  {factors, j} is overwritten.
  * Returns the size of the result
+ *
+ * The two halves of a long list are independent, and with a parallel
+ * function they are multiplied at the same time, the low half then
+ * going to a block of its own rather than to the high half's list.
+ * Halving the list keeps the two products of about equal size, so the
+ * biggest multiplications are balanced and reach the FFT range.
  */
 
 mp_size_t
@@ -92,10 +117,28 @@ mpz_prodlimbs (mpz_ptr x, mp_ptr factors, mp_size_t j)
 
     MPZ_TMP_INIT (x2, j);
 
-    PTR (x1) = factors + i;
-    ALLOC (x1) = j;
-    j = mpz_prodlimbs (x2, factors + i, j);
-    i = mpz_prodlimbs (x1, factors, i);
+    if (MPN_PARALLEL_P (i + j, PRODLIMBS_PARALLEL_THRESHOLD))
+      {
+	struct prodlimbs_par par[2];
+
+	MPZ_TMP_INIT (x1, i);
+	par[0].x = x1;
+	par[0].factors = factors;
+	par[0].j = i;
+	par[1].x = x2;
+	par[1].factors = factors + i;
+	par[1].j = j;
+	MPN_PARALLEL_RUN (prodlimbs_task, par, 2);
+	i = par[0].j;
+	j = par[1].j;
+      }
+    else
+      {
+	PTR (x1) = factors + i;
+	ALLOC (x1) = j;
+	j = mpz_prodlimbs (x2, factors + i, j);
+	i = mpz_prodlimbs (x1, factors, i);
+      }
     size = i + j;
     prod = MPZ_NEWALLOC (x, size);
     if (i >= j)
@@ -0,0 +1,170 @@
+/* mpz_prodtree, mpz_remtree -- product and remainder trees.
+
+THE FUNCTIONS IN THIS FILE ARE INTERNAL WITH MUTABLE INTERFACES.
+IT IS ONLY SAFE TO REACH THEM THROUGH DOCUMENTED INTERFACES.
+IN FACT, IT IS ALMOST GUARANTEED THAT THEY WILL CHANGE OR
+DISAPPEAR IN A FUTURE GNU MP RELEASE.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+/* The tree is over the index range [0,count), halved at each level, so
+   products at the same level are of similar size when the values are.  An
+   internal node is identified by the index MID where its range splits,
+   each such index from 1 to count-1 splitting exactly one range, so its
+   product goes in t[MID-1].
+
+   The remainder tree takes P mod v^2 down to each node v, P the product
+   of everything, and at a leaf (P mod v^2) / v = (P / v) mod v.  It goes
+   depth first, so without the keep flag each product can be freed once
+   used and the memory held shrinks as results come out.
+
+   Above the threshold the two halves of a range are given to the parallel
+   function, both when forming the products and when descending.  */
+
+struct prodtree_par
+{
+  const struct prodtree *p;
+  size_t lo, hi;
+  mpz_ptr r;
+  int ok;
+};
+
+static void
+prodtree_task (void *data, int i)
+{
+  struct prodtree_par *d = (struct prodtree_par *) data + i;
+  mpz_prodtree (d->p, d->lo, d->hi);
+}
+
+static void
+remtree_task (void *data, int i)
+{
+  struct prodtree_par *d = (struct prodtree_par *) data + i;
+  d->ok = mpz_remtree (d->p, d->lo, d->hi, d->r);
+}
+
+/* Form the products of the internal nodes under [lo,hi).  */
+void
+mpz_prodtree (const struct prodtree *p, size_t lo, size_t hi)
+{
+  struct prodtree_par par[2];
+  size_t mid;
+  mpz_ptr t;
+
+  if (hi - lo == 1)
+    return;
+  mid = (lo + hi) / 2;
+
+  if (hi - lo >= 4
+      && MPN_PARALLEL_P (mpz_size (p->v[lo]) * (hi - lo), p->thresh))
+    {
+      par[0].p = p; par[0].lo = lo;  par[0].hi = mid;
+      par[1].p = p; par[1].lo = mid; par[1].hi = hi;
+      MPN_PARALLEL_RUN (prodtree_task, par, 2);
+    }
+  else
+    {
+      mpz_prodtree (p, lo, mid);
+      mpz_prodtree (p, mid, hi);
+    }
+
+  t = p->t + mid - 1;
+  mpz_init (t);
+  mpz_mul (t, PRODTREE_NODE (p, lo, mid), PRODTREE_NODE (p, mid, hi));
+}
+
+/* Set r to parent modulo the square of the product of [lo,hi), and unless
+   keeping the products free that product if it's a node of the tree.  */
+static void
+reduce (const struct prodtree *p, size_t lo, size_t hi,
+	mpz_ptr r, mpz_srcptr parent)
+{
+  mpz_ptr v;
+  mpz_t sq;
+
+  if (hi - lo == 1 || p->keep)
+    {
+      mpz_init (sq);
+      mpz_mul (sq, PRODTREE_NODE (p, lo, hi), PRODTREE_NODE (p, lo, hi));
+      mpz_tdiv_r (r, parent, sq);
+      mpz_clear (sq);
+    }
+  else
+    {
+      v = p->t + (lo + hi) / 2 - 1;
+      mpz_mul (v, v, v);
+      mpz_tdiv_r (r, parent, v);
+      mpz_clear (v);
+    }
+}
+
+/* With r = P mod v^2, v the product of [lo,hi), call the leaf function
+   for each value of that range, and clear r.  Return 0 if any call
+   returned 0, otherwise 1.  */
+int
+mpz_remtree (const struct prodtree *p, size_t lo, size_t hi, mpz_ptr r)
+{
+  struct prodtree_par par[2];
+  mpz_t r1, r2;
+  size_t mid;
+  int ok;
+
+  if (hi - lo == 1)
+    {
+      mpz_divexact (r, r, p->v[lo]);
+      ok = (*p->leaf) (p, lo, r);
+      mpz_clear (r);
+      return ok;
+    }
+  mid = (lo + hi) / 2;
+
+  mpz_init (r1);
+  mpz_init (r2);
+  reduce (p, lo, mid, r1, r);
+  reduce (p, mid, hi, r2, r);
+  mpz_clear (r);
+
+  if (hi - lo >= 4
+      && MPN_PARALLEL_P (mpz_size (r1) + mpz_size (r2), p->thresh))
+    {
+      par[0].p = p; par[0].lo = lo;  par[0].hi = mid; par[0].r = r1;
+      par[1].p = p; par[1].lo = mid; par[1].hi = hi;  par[1].r = r2;
+      MPN_PARALLEL_RUN (remtree_task, par, 2);
+      ok = par[0].ok & par[1].ok;
+    }
+  else
+    {
+      ok = mpz_remtree (p, lo, mid, r1);
+      ok &= mpz_remtree (p, mid, hi, r2);
+    }
+  return ok;
+}
@@ -58,7 +58,11 @@ _mpz_realloc (mpz_ptr m, mp_size_t new_alloc)
 	}
     }
 
-  mp = __GMP_REALLOCATE_FUNC_LIMBS (PTR(m), ALLOC(m), new_alloc);
+  /* ALLOC 0 is an mpz_init with nothing allocated yet, see init.c.  */
+  if (ALLOC (m) == 0)
+    mp = __GMP_ALLOCATE_FUNC_LIMBS (new_alloc);
+  else
+    mp = __GMP_REALLOCATE_FUNC_LIMBS (PTR(m), ALLOC(m), new_alloc);
   PTR(m) = mp;
   ALLOC(m) = new_alloc;
 
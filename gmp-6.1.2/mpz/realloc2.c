@@ -50,7 +50,10 @@ mpz_realloc2 (mpz_ptr m, mp_bitcnt_t bits)
 	}
     }
 
-  PTR(m) = __GMP_REALLOCATE_FUNC_LIMBS (PTR(m), ALLOC(m), new_alloc);
+  if (ALLOC (m) == 0)
+    PTR(m) = __GMP_ALLOCATE_FUNC_LIMBS (new_alloc);
+  else
+    PTR(m) = __GMP_REALLOCATE_FUNC_LIMBS (PTR(m), ALLOC(m), new_alloc);
   ALLOC(m) = new_alloc;
 
   /* Don't create an invalid number; if the current value doesn't fit after
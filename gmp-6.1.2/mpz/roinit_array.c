@@ -0,0 +1,47 @@
+/* mpz_roinit_array -- Initialize mpz as a view of a value in an array file.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include "gmp.h"
+#include "gmp-impl.h"
+
+mpz_srcptr
+mpz_roinit_array (mpz_ptr x, gmp_array_srcptr a, size_t i)
+{
+  mp_size_t  size, prec;
+  mp_exp_t   exp;
+
+  if (a->_mp_kind != GMP_ARRAY_MPZ || i >= a->_mp_count)
+    return NULL;
+
+  PTR (x) = __gmp_array_entry (a, i, &size, &exp, &prec);
+  ALLOC (x) = 0;
+  SIZ (x) = size;
+  return x;
+}
@@ -2,10 +2,11 @@
    string STRING in base BASE to multiple precision integer in
    MP_DEST.  Allow white space in the string.  If BASE == 0 determine
    the base in the C standard way, i.e.  0xhh...h means base 16,
-   0oo...o means base 8, otherwise assume base 10.
+   0oo...o means base 8, otherwise assume base 10.  mpz_set_str_ctx does the
+   same with the base and powers from a context.
 
-Copyright 1991, 1993, 1994, 1996-1998, 2000-2003, 2005, 2011-2013 Free Software
-Foundation, Inc.
+Copyright 1991, 1993, 1994, 1996-1998, 2000-2003, 2005, 2011-2013, 2026 Free
+Software Foundation, Inc.
 
 This file is part of the GNU MP Library.
 
@@ -41,8 +42,8 @@ see https://www.gnu.org/licenses/.  */
 
 #define digit_value_tab __gmp_digit_value_tab
 
-int
-mpz_set_str (mpz_ptr x, const char *str, int base)
+static int
+set_str (mpz_ptr x, const char *str, int base, mpz_basectx_ptr ctx)
 {
   size_t str_size;
   char *s, *begs;
@@ -137,9 +138,30 @@ mpz_set_str (mpz_ptr x, const char *str, int base)
   MPZ_REALLOC (x, xsize);
 
   /* Convert the byte array in base BASE to our bignum format.  */
-  xsize = mpn_set_str (PTR (x), (unsigned char *) begs, str_size, base);
+  if (ctx != NULL && ! POW2_P (base)
+      && ! BELOW_THRESHOLD (str_size, SET_STR_PRECOMPUTE_THRESHOLD))
+    {
+      int pi;
+      pi = mpz_basectx_powtab (ctx, str_size);
+      xsize = mpn_set_str_pre (PTR (x), (unsigned char *) begs, str_size,
+			       BASECTX_POWTAB (ctx) + pi);
+    }
+  else
+    xsize = mpn_set_str (PTR (x), (unsigned char *) begs, str_size, base);
   SIZ (x) = negative ? -xsize : xsize;
 
   TMP_FREE;
   return 0;
 }
+
+int
+mpz_set_str (mpz_ptr x, const char *str, int base)
+{
+  return set_str (x, str, base, NULL);
+}
+
+int
+mpz_set_str_ctx (mpz_ptr x, const char *str, mpz_basectx_ptr ctx)
+{
+  return set_str (x, str, ABS (ctx->_mp_base), ctx);
+}
@@ -55,8 +55,6 @@ mpz_ui_sub (mpz_ptr w, unsigned long int uval, mpz_srcptr v)
   vp = PTR(v);
   vn = SIZ(v);
 
-  wp = PTR(w);
-
   if (vn > 1)
     {
       wp = MPZ_REALLOC (w, vn);
@@ -66,6 +64,7 @@ mpz_ui_sub (mpz_ptr w, unsigned long int uval, mpz_srcptr v)
     }
   else if (vn == 1)
     {
+      wp = MPZ_NEWALLOC (w, 1);
       if (uval >= vp[0])
 	{
 	  wp[0] = uval - vp[0];
@@ -79,7 +78,7 @@ mpz_ui_sub (mpz_ptr w, unsigned long int uval, mpz_srcptr v)
     }
   else if (vn == 0)
     {
-      wp[0] = uval;
+      MPZ_NEWALLOC (w, 1)[0] = uval;
       wn = uval != 0;
     }
   else /* (vn < 0) */
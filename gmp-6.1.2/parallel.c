@@ -0,0 +1,77 @@
+/* Parallel task hook used by the large-operand mpn routines.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>  /* for NULL */
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* GMP never creates threads itself.  An application wanting the FFT and
+   other big-operand code to use several cores installs a function which runs
+   TASK (DATA, i) for 0 <= i < N, possibly concurrently, and returns once all
+   N calls have completed.  Until then __gmp_parallel_threads is 1 and every
+   caller takes its ordinary serial path.  */
+
+void (*__gmp_parallel_func) (void (*) (void *, int), void *, int)
+  = __gmp_default_parallel;
+int __gmp_parallel_threads = 1;
+
+
+void
+__gmp_default_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = 0; i < n; i++)
+    (*task) (data, i);
+}
+
+void
+mp_set_parallel_function (void (*run_func) (void (*) (void *, int), void *, int),
+			  int nthreads) __GMP_NOTHROW
+{
+  if (run_func == NULL || nthreads < 2)
+    {
+      run_func = __gmp_default_parallel;
+      nthreads = 1;
+    }
+
+  __gmp_parallel_func = run_func;
+  __gmp_parallel_threads = nthreads;
+}
+
+void
+mp_get_parallel_function (void (**run_func) (void (*) (void *, int), void *, int),
+			  int *nthreads) __GMP_NOTHROW
+{
+  if (run_func != NULL)
+    *run_func = __gmp_parallel_func;
+  if (nthreads != NULL)
+    *nthreads = __gmp_parallel_threads;
+}
@@ -37,6 +37,7 @@ see https://www.gnu.org/licenses/.  */
 
 #include "gmp.h"
 #include "gmp-impl.h"
+#include "longlong.h"
 
 /**************************************************************/
 /* Section macros: common macros, for mswing/fac/bin (&sieve) */
@@ -286,6 +287,164 @@ gmp_primesieve (mp_ptr bit_array, mp_limb_t n)
   return size * GMP_LIMB_BITS - mpn_popcount (bit_array, size);
 }
 
+/*******************************************************/
+/* Section iterator: primes of a range, block by block */
+/*******************************************************/
+
+/* The range is sieved a segment of BLOCK_SIZE limbs at a time, against a
+   sieve of the primes up to sqrt(end), so memory is bounded by the
+   segments whatever the range.  With a parallel function installed, there
+   is a segment per thread, and each refill sieves them all at once.  */
+
+struct primeiter_par_t
+{
+  mp_ptr block;
+  mp_limb_t off;
+  mp_srcptr seed;
+  mp_limb_t seed_bits;
+};
+
+static void
+primeiter_block_task (void *data, int t)
+{
+  struct primeiter_par_t *p = (struct primeiter_par_t *) data;
+
+  block_resieve (p->block + (mp_size_t) t * BLOCK_SIZE, BLOCK_SIZE,
+		 p->off + (mp_limb_t) t * BLOCK_SIZE * GMP_LIMB_BITS,
+		 p->seed, p->seed_bits);
+}
+
+/* Sieve the segments from bit number it->_mp_off on, as many as there's
+   room for and the range needs.  */
+static void
+primeiter_fill (gmp_primeiter_t it)
+{
+  struct primeiter_par_t p;
+  mp_limb_t last;
+  mp_size_t nblocks;
+  int t;
+
+  last = n_to_bit (it->_mp_end - 1);
+  nblocks = (last - it->_mp_off) / (BLOCK_SIZE * GMP_LIMB_BITS) + 1;
+  nblocks = MIN (nblocks, it->_mp_alloc / BLOCK_SIZE);
+
+  p.block = it->_mp_d;
+  p.off = it->_mp_off;
+  p.seed = it->_mp_seed;
+  p.seed_bits = it->_mp_seed_bits;
+
+  if (MPN_PARALLEL_P (nblocks, 2))
+    MPN_PARALLEL_RUN (primeiter_block_task, &p, nblocks);
+  else
+    for (t = 0; t < nblocks; t++)
+      primeiter_block_task (&p, t);
+
+  it->_mp_size = nblocks * BLOCK_SIZE;
+}
+
+void
+gmp_primeiter_init (gmp_primeiter_t it, mp_limb_t a, mp_limb_t b)
+{
+  mp_limb_t root, first, last;
+  mp_size_t nblocks, size;
+
+  ASSERT (b <= GMP_NUMB_MAX / 3);
+
+  it->_mp_end = b;
+  it->_mp_small = a <= 2 ? 2 : a == 3 ? 3 : 5;
+  it->_mp_d = NULL;
+  it->_mp_seed = NULL;
+  it->_mp_alloc = 0;
+  it->_mp_size = 0;
+  it->_mp_pos = 0;
+  it->_mp_off = 0;
+
+  if (b <= 5 || a >= b)
+    return;
+
+  /* Bit number of the first candidate >= a.  */
+  first = a <= 5 ? 0 : n_to_bit (a - 1) + 1;
+  last = n_to_bit (b - 1);
+  if (first > last)
+    return;
+
+  it->_mp_off = first - first % GMP_LIMB_BITS;
+  it->_mp_pos = first % GMP_LIMB_BITS;
+
+  mpn_sqrtrem (&root, NULL, &b, 1);
+  root = MAX (root, 5);
+  size = n_to_bit (root) / GMP_LIMB_BITS + 1;
+  it->_mp_seed = __GMP_ALLOCATE_FUNC_LIMBS (size);
+  it->_mp_seed_bits = n_to_bit (root);
+  gmp_primesieve (it->_mp_seed, root);
+
+  nblocks = (last - it->_mp_off) / (BLOCK_SIZE * GMP_LIMB_BITS) + 1;
+  nblocks = MIN (nblocks, MAX (__gmp_parallel_threads, 1));
+  it->_mp_alloc = nblocks * BLOCK_SIZE;
+  it->_mp_d = __GMP_ALLOCATE_FUNC_LIMBS (it->_mp_alloc);
+
+  primeiter_fill (it);
+}
+
+/* Return the next prime of the range, or 0 when there are no more.  */
+mp_limb_t
+gmp_primeiter_next (gmp_primeiter_t it)
+{
+  mp_limb_t w, n, bit;
+  mp_size_t i;
+  int cnt;
+
+  if (it->_mp_small < 5)
+    {
+      n = it->_mp_small;
+      it->_mp_small = n == 2 ? 3 : 5;
+      if (n < it->_mp_end)
+	return n;
+      it->_mp_small = 5;
+    }
+
+  while (it->_mp_size != 0)
+    {
+      for (i = it->_mp_pos / GMP_LIMB_BITS; i < it->_mp_size; i++)
+	{
+	  w = ~it->_mp_d[i];
+	  if (i == it->_mp_pos / GMP_LIMB_BITS)
+	    w &= MP_LIMB_T_MAX << (it->_mp_pos % GMP_LIMB_BITS);
+	  if (w != 0)
+	    {
+	      count_trailing_zeros (cnt, w);
+	      bit = i * GMP_LIMB_BITS + cnt;
+	      n = id_to_n (it->_mp_off + bit + 1);
+	      if (n >= it->_mp_end)
+		break;
+	      it->_mp_pos = bit + 1;
+	      return n;
+	    }
+	}
+      if (i < it->_mp_size)
+	break;
+
+      it->_mp_off += it->_mp_size * GMP_LIMB_BITS;
+      it->_mp_pos = 0;
+      if (it->_mp_off > n_to_bit (it->_mp_end - 1))
+	break;
+      primeiter_fill (it);
+    }
+
+  it->_mp_size = 0;
+  return 0;
+}
+
+void
+gmp_primeiter_clear (gmp_primeiter_t it)
+{
+  if (it->_mp_d != NULL)
+    __GMP_FREE_FUNC_LIMBS (it->_mp_d, it->_mp_alloc);
+  if (it->_mp_seed != NULL)
+    __GMP_FREE_FUNC_LIMBS (it->_mp_seed,
+			   it->_mp_seed_bits / GMP_LIMB_BITS + 1);
+}
+
 #undef BLOCK_SIZE
 #undef SEED_LIMIT
 #undef SIEVE_SEED
@@ -0,0 +1,173 @@
+/* gmp_stats_enable, gmp_stats_reset, gmp_stats_dump -- mpn dispatch
+   statistics.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <string.h>
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+/* The counts are plain increments, not atomic, so when several threads
+   call GMP at once a few may be lost.  That's fine for a profile, and keeps
+   the counting cheap.  */
+
+#if WANT_STATS
+
+int __gmp_stats_enabled = 0;
+
+unsigned long __gmp_stats_table[GMP_STATS_N][GMP_STATS_BUCKETS];
+
+/* Function and branch names, in the order of the GMP_STATS_ enum.  */
+static const char *const stats_name[][2] = {
+  { "mpn_mul",     "basecase"     },
+  { "mpn_mul",     "toomX2"       },
+  { "mpn_mul",     "toomX3"       },
+  { "mpn_mul",     "toom44"       },
+  { "mpn_mul",     "toom6h"       },
+  { "mpn_mul",     "toom8h"       },
+  { "mpn_mul",     "fft"          },
+  { "mpn_mul_n",   "basecase"     },
+  { "mpn_mul_n",   "toom22"       },
+  { "mpn_mul_n",   "toom33"       },
+  { "mpn_mul_n",   "toom44"       },
+  { "mpn_mul_n",   "toom6h"       },
+  { "mpn_mul_n",   "toom8h"       },
+  { "mpn_mul_n",   "fft"          },
+  { "mpn_sqr",     "mul_basecase" },
+  { "mpn_sqr",     "basecase"     },
+  { "mpn_sqr",     "toom2"        },
+  { "mpn_sqr",     "toom3"        },
+  { "mpn_sqr",     "toom4"        },
+  { "mpn_sqr",     "toom6"        },
+  { "mpn_sqr",     "toom8"        },
+  { "mpn_sqr",     "fft"          },
+  { "mpn_tdiv_qr", "divrem_1"     },
+  { "mpn_tdiv_qr", "divrem_2"     },
+  { "mpn_tdiv_qr", "sbpi1"        },
+  { "mpn_tdiv_qr", "dcpi1"        },
+  { "mpn_tdiv_qr", "mu"           },
+  { "mpn_div_q",   "divrem_1"     },
+  { "mpn_div_q",   "divrem_2"     },
+  { "mpn_div_q",   "sbpi1"        },
+  { "mpn_div_q",   "dcpi1"        },
+  { "mpn_div_q",   "mu"           },
+  { "mpn_div_q",   "sbpi1_appr"   },
+  { "mpn_div_q",   "dcpi1_appr"   },
+  { "mpn_div_q",   "mu_appr"      },
+  { "mpn_gcd",     "lehmer"       },
+  { "mpn_gcd",     "hgcd"         },
+  { "mpn_powm",    "redc_1"       },
+  { "mpn_powm",    "redc_2"       },
+  { "mpn_powm",    "redc_n"       },
+};
+
+typedef char stats_name_check[numberof (stats_name) == GMP_STATS_N ? 1 : -1];
+
+void
+__gmp_stats_count (int what, mp_size_t n)
+{
+  int  b;
+
+  ASSERT (what >= 0 && what < GMP_STATS_N);
+  ASSERT (n >= 1);
+
+  b = 0;
+  do
+    b++;
+  while ((n >>= 1) != 0 && b < GMP_STATS_BUCKETS - 1);
+
+  __gmp_stats_table[what][b]++;
+}
+
+#endif /* WANT_STATS */
+
+
+int
+gmp_stats_enable (int enable)
+{
+#if WANT_STATS
+  __gmp_stats_enabled = (enable != 0);
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+void
+gmp_stats_reset (void)
+{
+#if WANT_STATS
+  memset (__gmp_stats_table, 0, sizeof (__gmp_stats_table));
+#endif
+}
+
+void
+gmp_stats_dump (FILE *fp)
+{
+#if WANT_STATS
+  unsigned long  total, lo;
+  int            i, b;
+
+  if (fp == NULL)
+    fp = stdout;
+
+  fprintf (fp, "%-12s %-12s %12s  sizes in limbs: calls\n",
+	   "function", "branch", "calls");
+  for (i = 0; i < GMP_STATS_N; i++)
+    {
+      total = 0;
+      for (b = 0; b < GMP_STATS_BUCKETS; b++)
+	total += __gmp_stats_table[i][b];
+      if (total == 0)
+	continue;
+
+      fprintf (fp, "%-12s %-12s %12lu ",
+	       stats_name[i][0], stats_name[i][1], total);
+      for (b = 1; b < GMP_STATS_BUCKETS; b++)
+	{
+	  if (__gmp_stats_table[i][b] == 0)
+	    continue;
+	  lo = 1UL << (b - 1);
+	  if (b == 1)
+	    fprintf (fp, " 1:%lu", __gmp_stats_table[i][b]);
+	  else
+	    fprintf (fp, " %lu-%lu:%lu", lo, 2 * lo - 1,
+		     __gmp_stats_table[i][b]);
+	}
+      fprintf (fp, "\n");
+    }
+#else
+  if (fp == NULL)
+    fp = stdout;
+  fprintf (fp, "GMP dispatch statistics not available, "
+	   "configure with --enable-stats\n");
+#endif
+}
@@ -26,8 +26,10 @@ the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
 
 #if __GMPXX_USE_CXX11
 
+#include <algorithm>
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 void check_noexcept ()
 {
@@ -38,6 +40,7 @@ void check_noexcept ()
   static_assert(noexcept(q1 = std::move(q2)), "sorry");
   static_assert(noexcept(f1 = std::move(f2)), "sorry");
   static_assert(noexcept(q1 = std::move(z1)), "sorry");
+  static_assert(std::is_nothrow_move_constructible<mpz_class>::value, "sorry");
 }
 
 void check_common_type ()
@@ -161,6 +164,51 @@ void check_move_assign ()
   }
 }
 
+static size_t alloc_count;
+static void *(*old_alloc) (size_t);
+static void *(*old_realloc) (void *, size_t, size_t);
+
+static void *
+count_alloc (size_t n)
+{
+  alloc_count++;
+  return (*old_alloc) (n);
+}
+
+static void *
+count_realloc (void *p, size_t old_size, size_t new_size)
+{
+  alloc_count++;
+  return (*old_realloc) (p, old_size, new_size);
+}
+
+// Growing a vector of mpz_class and sorting it only move values around, so
+// must not allocate any limbs.
+void check_move_no_alloc ()
+{
+  gmp_randstate_ptr rands = RANDS;
+  std::vector<mpz_class> src (500), v;
+  void (*old_free) (void *, size_t);
+
+  for (size_t i = 0; i < src.size(); i++)
+    mpz_rrandomb (src[i].get_mpz_t(), rands, 1 + i % 200);
+
+  mp_get_memory_functions (&old_alloc, &old_realloc, &old_free);
+  mp_set_memory_functions (count_alloc, count_realloc, old_free);
+  alloc_count = 0;
+
+  for (size_t i = 0; i < src.size(); i++)
+    v.push_back (std::move (src[i]));
+  std::sort (v.begin(), v.end());
+  src.clear();
+  mpz_class z;
+
+  mp_set_memory_functions (old_alloc, old_realloc, old_free);
+  ASSERT_ALWAYS (alloc_count == 0);
+  for (size_t i = 1; i < v.size(); i++)
+    ASSERT_ALWAYS (v[i - 1] <= v[i]);
+}
+
 void check_user_defined_literal ()
 {
   ASSERT_ALWAYS (123_mpz % 5 == 3);
@@ -213,6 +261,7 @@ main (void)
   check_move_assign<mpf_class>();
   check_move_init<mpz_class,mpq_class>();
   check_move_assign<mpz_class,mpq_class>();
+  check_move_no_alloc();
   check_user_defined_literal();
   check_bool_conversion();
 
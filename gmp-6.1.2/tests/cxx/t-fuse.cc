@@ -0,0 +1,161 @@
+/* Test the fused multiply-accumulate forms of mpz_class expressions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <iostream>
+
+#include "gmp.h"
+#include "gmpxx.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+using namespace std;
+
+
+/* Each form is evaluated with the destination a fresh variable and then
+   each of the operands in turn, and compared against the same sum done with
+   an explicit product.  */
+
+#define CHECK(form, ref)						\
+  do {									\
+    for (int dst = 0; dst <= 5; dst++)					\
+      {									\
+	mpz_class w[6] = { v[0], v[1], v[2], v[3], v[4], 0 };		\
+	mpz_class &A = w[0], &B = w[1], &C = w[2], &D = w[3], &X = w[4]; \
+	mpz_class &R = w[dst];						\
+	mpz_class want, t1, t2;						\
+	ref;								\
+	R = form;							\
+	if (R != want)							\
+	  {								\
+	    cout << "wrong result for " #form ", destination " << dst	\
+		 << endl;						\
+	    cout << "  a = " << v[0] << "\n  b = " << v[1]		\
+		 << "\n  c = " << v[2] << "\n  d = " << v[3]		\
+		 << "\n  x = " << v[4] << endl;				\
+	    cout << "  got  " << R << "\n  want " << want << endl;	\
+	    abort ();							\
+	  }								\
+      }									\
+  } while (0)
+
+static void
+check_forms (gmp_randstate_ptr rands)
+{
+  mpz_class v[5];
+
+  for (int rep = 0; rep < 100; rep++)
+    {
+      for (int i = 0; i < 5; i++)
+	{
+	  mpz_rrandomb (v[i].get_mpz_t (), rands, urandom () % 300);
+	  if (urandom () % 2)
+	    v[i] = -v[i];
+	}
+      if (v[4] == 0)
+	v[4] = 1;
+
+      CHECK (X + B*C, t1 = B*C; want = v[4] + t1);
+      CHECK (X - B*C, t1 = B*C; want = v[4] - t1);
+      CHECK (B*C + X, t1 = B*C; want = t1 + v[4]);
+      CHECK (B*C - X, t1 = B*C; want = t1 - v[4]);
+      CHECK ((X + A) + B*C, t1 = B*C; t2 = X + A; want = t2 + t1);
+      CHECK ((X + A) - B*C, t1 = B*C; t2 = X + A; want = t2 - t1);
+      CHECK (B*C + (X - A), t1 = B*C; t2 = X - A; want = t1 + t2);
+      CHECK (B*C - (X - A), t1 = B*C; t2 = X - A; want = t1 - t2);
+      CHECK (A*B + C*D, t1 = A*B; t2 = C*D; want = t1 + t2);
+      CHECK (A*B - C*D, t1 = A*B; t2 = C*D; want = t1 - t2);
+      CHECK (A*B + C*D + X*A,
+	     t1 = A*B; t2 = C*D; want = t1 + t2; t1 = X*A; want += t1);
+      CHECK (A*B - C*D - X*B,
+	     t1 = A*B; t2 = C*D; want = t1 - t2; t1 = X*B; want -= t1);
+      CHECK ((A*B + C*D) % X,
+	     t1 = A*B; t2 = C*D; want = t1 + t2; want %= X);
+      CHECK ((A*B) % X + C*D,
+	     t1 = A*B; t1 %= X; t2 = C*D; want = t1 + t2);
+    }
+}
+
+static size_t  alloc_count;
+static void *(*old_alloc) (size_t);
+static void *(*old_realloc) (void *, size_t, size_t);
+
+static void *
+count_alloc (size_t n)
+{
+  alloc_count++;
+  return (*old_alloc) (n);
+}
+
+static void *
+count_realloc (void *p, size_t old_size, size_t new_size)
+{
+  alloc_count++;
+  return (*old_realloc) (p, old_size, new_size);
+}
+
+/* The fused forms evaluate straight into a destination with enough space,
+   without creating any temporary variable.  TMP_ALLOC blocks are on the
+   stack when alloca is used.  */
+static void
+check_no_temps (void)
+{
+#if WANT_TMP_ALLOCA
+  mpz_class a, b, c, d, x, r;
+  void (*old_free) (void *, size_t);
+
+  mpz_set_str (a.get_mpz_t (), "123456789012345678901234567890", 10);
+  b = a + 1;
+  c = b * 3;
+  d = c - 7;
+  x = d * d;
+  mpz_realloc2 (r.get_mpz_t (), 1000);
+
+  mp_get_memory_functions (&old_alloc, &old_realloc, &old_free);
+  mp_set_memory_functions (count_alloc, count_realloc, old_free);
+  alloc_count = 0;
+
+  r = x + a*b;
+  r = r + a*b;
+  r = r - c*d;
+  r = a*b + c*d;
+  r = a*b - c*d + x*a;
+  r = (a*b + c*d) % x;
+
+  mp_set_memory_functions (old_alloc, old_realloc, old_free);
+  if (alloc_count != 0)
+    {
+      cout << "fused forms made " << alloc_count << " allocations" << endl;
+      abort ();
+    }
+#endif
+}
+
+int
+main (void)
+{
+  tests_start ();
+
+  check_forms (RANDS);
+  check_no_temps ();
+
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,218 @@
+/* Test mp_set_arena.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if HAVE_PTHREAD_KEY_CREATE
+#include <pthread.h>
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+/* Some arithmetic, with TMP blocks big enough to go to the heap and mpz
+   reallocations across size classes, leaving the result in r.  */
+static void
+work (mpz_ptr r, gmp_randstate_ptr rands)
+{
+  mpz_t a, b, m;
+  int i;
+
+  mpz_inits (a, b, m, NULL);
+  mpz_set_ui (r, 1);
+  for (i = 0; i < 40; i++)
+    {
+      mpz_urandomb (a, rands, 1000 * (i % 7 + 1));
+      mpz_urandomb (b, rands, 30000 * (i % 5 + 1));
+      mpz_mul (m, a, b);
+      mpz_mul_2exp (r, r, 1 + i % 64);
+      mpz_add (r, r, m);
+      mpz_tdiv_r (r, r, b);
+      mpz_mul (r, r, r);
+    }
+  mpz_realloc2 (r, 10);
+  mpz_set_ui (a, 12345);
+  mpz_realloc2 (a, 200000);
+  mpz_add (r, r, a);
+  mpz_clears (a, b, m, NULL);
+}
+
+#if HAVE_PTHREAD_KEY_CREATE
+/* Leave blocks in this thread's cache.  The key destructor must give them
+   back, or tests_end finds them not freed.  */
+static void *
+thread_work (void *arg)
+{
+  gmp_randstate_t rs;
+  size_t cached;
+
+  gmp_randinit_default (rs);
+  work ((mpz_ptr) arg, rs);
+  gmp_randclear (rs);
+  mp_get_arena_stats (NULL, NULL, &cached);
+  if (cached == 0)
+    {
+      printf ("mp_set_arena: nothing cached in a thread\n");
+      abort ();
+    }
+  return NULL;
+}
+#endif
+
+static void
+check_thread (mpz_srcptr want)
+{
+#if HAVE_PTHREAD_KEY_CREATE
+  pthread_t t;
+  mpz_t got;
+
+  mpz_init (got);
+  /* Some systems have pthread_key_create, but pthread_create only in a
+     library not linked here, failing.  */
+  if (pthread_create (&t, NULL, thread_work, got) != 0)
+    {
+      mpz_clear (got);
+      return;
+    }
+  pthread_join (t, NULL);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("mp_set_arena: wrong result in a thread\n");
+      abort ();
+    }
+  mpz_clear (got);
+#endif
+}
+
+int
+main (int argc, char *argv[])
+{
+  gmp_randstate_t rs;
+  mpz_t want, got;
+  size_t allocated, reused, cached, allocated2, reused2;
+  void * (*allocate_func) (size_t);
+
+  tests_start ();
+
+  mpz_init (want);
+  gmp_randinit_default (rs);
+  work (want, rs);
+  gmp_randclear (rs);
+
+  mp_set_arena (1 << 24);
+
+  /* Without thread local storage the arena isn't installed, and everything
+     should go on as before.  */
+  mp_get_memory_functions (&allocate_func, NULL, NULL);
+  if (allocate_func != __gmp_arena_allocate)
+    {
+      mpz_init (got);
+      gmp_randinit_default (rs);
+      work (got, rs);
+      gmp_randclear (rs);
+      if (mpz_cmp (got, want) != 0)
+	{
+	  printf ("mp_set_arena: wrong result, not installed\n");
+	  abort ();
+	}
+      mpz_clears (got, want, NULL);
+      tests_end ();
+      exit (0);
+    }
+
+  /* The first round primes the cache, the second should be served from it
+     entirely.  */
+  mpz_init (got);
+  gmp_randinit_default (rs);
+  work (got, rs);
+  gmp_randclear (rs);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("mp_set_arena: wrong result\n");
+      abort ();
+    }
+  mpz_clear (got);
+
+  mp_get_arena_stats (&allocated, &reused, &cached);
+  if (allocated == 0 || cached == 0)
+    {
+      printf ("mp_set_arena: nothing allocated or cached, %lu %lu\n",
+	      (unsigned long) allocated, (unsigned long) cached);
+      abort ();
+    }
+
+  mpz_init (got);
+  gmp_randinit_default (rs);
+  work (got, rs);
+  gmp_randclear (rs);
+  if (mpz_cmp (got, want) != 0)
+    {
+      printf ("mp_set_arena: wrong result, second time\n");
+      abort ();
+    }
+  mpz_clear (got);
+
+  mp_get_arena_stats (&allocated2, &reused2, NULL);
+  if (allocated2 != allocated || reused2 <= reused)
+    {
+      printf ("mp_set_arena: second round not from the cache\n");
+      printf ("  allocated %lu then %lu, reused %lu then %lu\n",
+	      (unsigned long) allocated, (unsigned long) allocated2,
+	      (unsigned long) reused, (unsigned long) reused2);
+      abort ();
+    }
+
+  check_thread (want);
+
+  /* Lowering the limit frees what's cached above it at once, and with a
+     tiny limit everything goes back to the underlying allocator.  */
+  mp_set_arena (1 << 16);
+  mp_get_arena_stats (NULL, NULL, &cached);
+  if (cached > 1 << 16)
+    {
+      printf ("mp_set_arena: %lu bytes cached after lowering the limit\n",
+	      (unsigned long) cached);
+      abort ();
+    }
+  mp_set_arena (1);
+  mpz_init (got);
+  gmp_randinit_default (rs);
+  work (got, rs);
+  gmp_randclear (rs);
+  mpz_clear (got);
+  mp_get_arena_stats (NULL, NULL, &cached);
+  if (cached != 0)
+    {
+      printf ("mp_set_arena: %lu bytes cached over the limit\n",
+	      (unsigned long) cached);
+      abort ();
+    }
+
+  /* Back to the test suite's functions, which then check nothing leaked
+     and that all sizes passed to them matched.  */
+  mp_set_arena (0);
+
+  mpz_clear (want);
+  tests_end ();
+  exit (0);
+}
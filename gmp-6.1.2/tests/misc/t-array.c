@@ -0,0 +1,353 @@
+/* Test mpz_out_array, mpq_out_array, mpf_out_array and gmp_array_map.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define FILENAME  "t-array.tmp"
+
+#define MAX_COUNT  50
+
+
+static FILE *
+fopen_or_die (const char *filename, const char *mode)
+{
+  FILE  *fp;
+  fp = fopen (filename, mode);
+  if (fp == NULL)
+    {
+      printf ("Cannot open file %s\n", filename);
+      abort ();
+    }
+  return fp;
+}
+
+/* Write with FUNC, check the returned size is the file size.  */
+#define WRITE_ARRAY(func, x, count)					\
+  do {									\
+    FILE    *__fp;							\
+    size_t  __ret;							\
+    long    __pos;							\
+    __fp = fopen_or_die (FILENAME, "wb");				\
+    __ret = func (__fp, x, count);					\
+    __pos = ftell (__fp);						\
+    fclose (__fp);							\
+    if (__ret == 0 || __ret != (size_t) __pos)					\
+      {									\
+	printf ("%s returned %lu, file size %ld\n", #func,		\
+		(unsigned long) __ret, __pos);				\
+	abort ();							\
+      }									\
+  } while (0)
+
+static void
+map_or_die (gmp_array_ptr a, int kind, size_t count)
+{
+  if (gmp_array_map (a, FILENAME) != 0)
+    {
+      printf ("gmp_array_map failed\n");
+      abort ();
+    }
+  if (gmp_array_kind (a) != kind || gmp_array_count (a) != count)
+    {
+      printf ("gmp_array_map wrong kind %d or count %lu\n",
+	      gmp_array_kind (a), (unsigned long) gmp_array_count (a));
+      abort ();
+    }
+}
+
+/* Turn the file into one written with the other limb byte order.  */
+static void
+swap_file (void)
+{
+  unsigned char  *buf, t;
+  long           bytes, i, j, data;
+  FILE           *fp;
+
+  fp = fopen_or_die (FILENAME, "rb");
+  fseek (fp, 0L, SEEK_END);
+  bytes = ftell (fp);
+  rewind (fp);
+  buf = (unsigned char *) malloc (bytes);
+  if (fread (buf, bytes, 1, fp) != 1)
+    abort ();
+  fclose (fp);
+
+  buf[55] ^= 1;
+  data = 0;
+  for (i = 56; i < 64; i++)
+    data = (data << 8) | buf[i];
+  for (i = data; i < bytes; i += GMP_LIMB_BYTES)
+    for (j = 0; j < GMP_LIMB_BYTES / 2; j++)
+      {
+	t = buf[i + j];
+	buf[i + j] = buf[i + GMP_LIMB_BYTES - 1 - j];
+	buf[i + GMP_LIMB_BYTES - 1 - j] = t;
+      }
+
+  fp = fopen_or_die (FILENAME, "wb");
+  fwrite (buf, bytes, 1, fp);
+  fclose (fp);
+  free (buf);
+}
+
+static void
+check_mpz (gmp_randstate_ptr rands, int swap)
+{
+  mpz_t          x[MAX_COUNT], v;
+  mpq_t          q;
+  mpf_t          f;
+  gmp_array_t    a;
+  size_t         count, i;
+
+  count = gmp_urandomm_ui (rands, MAX_COUNT + 1);
+  for (i = 0; i < count; i++)
+    {
+      mpz_init (x[i]);
+      if (gmp_urandomm_ui (rands, 8) != 0)
+	mpz_rrandomb (x[i], rands, gmp_urandomm_ui (rands, 1000));
+      if (gmp_urandomb_ui (rands, 1))
+	mpz_neg (x[i], x[i]);
+    }
+
+  WRITE_ARRAY (mpz_out_array, x[0], count);
+  if (swap)
+    swap_file ();
+  map_or_die (a, GMP_ARRAY_MPZ, count);
+
+  for (i = 0; i < count; i++)
+    {
+      if (mpz_roinit_array (v, a, i) != v || mpz_cmp (v, x[i]) != 0)
+	{
+	  printf ("mpz_roinit_array wrong, swap %d, entry %lu of %lu\n",
+		  swap, (unsigned long) i, (unsigned long) count);
+	  mpz_trace ("want", x[i]);
+	  mpz_trace ("got ", v);
+	  abort ();
+	}
+    }
+  if (mpz_roinit_array (v, a, count) != NULL
+      || mpq_roinit_array (q, a, 0) != NULL
+      || mpf_roinit_array (f, a, 0) != NULL)
+    {
+      printf ("roinit_array didn't reject a bad entry\n");
+      abort ();
+    }
+
+  gmp_array_unmap (a);
+  for (i = 0; i < count; i++)
+    mpz_clear (x[i]);
+}
+
+static void
+check_mpq (gmp_randstate_ptr rands, int swap)
+{
+  mpq_t          x[MAX_COUNT], v;
+  gmp_array_t    a;
+  size_t         count, i;
+
+  count = gmp_urandomm_ui (rands, MAX_COUNT + 1);
+  for (i = 0; i < count; i++)
+    {
+      mpq_init (x[i]);
+      mpz_rrandomb (mpq_numref (x[i]), rands, gmp_urandomm_ui (rands, 500));
+      mpz_rrandomb (mpq_denref (x[i]), rands, gmp_urandomm_ui (rands, 500));
+      mpz_add_ui (mpq_denref (x[i]), mpq_denref (x[i]), 1);
+      if (gmp_urandomb_ui (rands, 1))
+	mpq_neg (x[i], x[i]);
+      mpq_canonicalize (x[i]);
+    }
+
+  WRITE_ARRAY (mpq_out_array, x[0], count);
+  if (swap)
+    swap_file ();
+  map_or_die (a, GMP_ARRAY_MPQ, count);
+
+  for (i = 0; i < count; i++)
+    {
+      if (mpq_roinit_array (v, a, i) != v || ! mpq_equal (v, x[i]))
+	{
+	  printf ("mpq_roinit_array wrong, swap %d, entry %lu of %lu\n",
+		  swap, (unsigned long) i, (unsigned long) count);
+	  mpq_trace ("want", x[i]);
+	  mpq_trace ("got ", v);
+	  abort ();
+	}
+    }
+
+  gmp_array_unmap (a);
+  for (i = 0; i < count; i++)
+    mpq_clear (x[i]);
+}
+
+static void
+check_mpf (gmp_randstate_ptr rands, int swap)
+{
+  mpf_t          x[MAX_COUNT], v;
+  gmp_array_t    a;
+  size_t         count, i;
+
+  count = gmp_urandomm_ui (rands, MAX_COUNT + 1);
+  for (i = 0; i < count; i++)
+    {
+      mpf_init2 (x[i], 1 + gmp_urandomm_ui (rands, 1000));
+      if (gmp_urandomm_ui (rands, 8) != 0)
+	mpf_random2 (x[i], PREC (x[i]) + 1, 100);
+      if (gmp_urandomb_ui (rands, 1))
+	mpf_neg (x[i], x[i]);
+    }
+
+  WRITE_ARRAY (mpf_out_array, x[0], count);
+  if (swap)
+    swap_file ();
+  map_or_die (a, GMP_ARRAY_MPF, count);
+
+  for (i = 0; i < count; i++)
+    {
+      if (mpf_roinit_array (v, a, i) != v || mpf_cmp (v, x[i]) != 0
+	  || mpf_get_prec (v) != mpf_get_prec (x[i]))
+	{
+	  printf ("mpf_roinit_array wrong, swap %d, entry %lu of %lu\n",
+		  swap, (unsigned long) i, (unsigned long) count);
+	  mpf_trace ("want", x[i]);
+	  mpf_trace ("got ", v);
+	  abort ();
+	}
+    }
+
+  gmp_array_unmap (a);
+  for (i = 0; i < count; i++)
+    mpf_clear (x[i]);
+}
+
+/* Damaged files must be rejected.  */
+static void
+check_bad (void)
+{
+  static const struct {
+    long  pos;		/* byte to change, negative from the end */
+    int   xor;
+    long  truncate;	/* bytes to drop from the end */
+  } data[] = {
+    {  0, 1, 0 },	/* magic */
+    { 15, 2, 0 },	/* version */
+    { 23, 7, 0 },	/* kind */
+    { 31, 8, 0 },	/* count */
+    { 24, 1, 0 },	/* count, way too big */
+    { 39, 64, 0 },	/* limb bits */
+    { 47, 1, 0 },	/* nail bits */
+    { 55, 2, 0 },	/* byte order */
+    { 63, 8, 0 },	/* limb data offset */
+    { 64, 0x80, 0 },	/* size of the first value */
+    { 64 + 24 + 32 + 7, 1, 0 },	/* offset of the second value */
+    { -1, 0xff, 0 },	/* high limb of the last value zero */
+    { 0, 0, 1 },	/* truncated limbs */
+    { 0, 0, 1000000 },	/* truncated to nothing */
+  };
+  mpz_t          x[2];
+  gmp_array_t    a;
+  unsigned char  *buf;
+  long           bytes, pos;
+  FILE           *fp;
+  int            i;
+
+  mpz_init_set_ui (x[0], 123);
+  mpz_init_set_ui (x[1], 255);
+  mpz_mul_2exp (x[1], x[1], 2 * GMP_NUMB_BITS - 8);
+
+  for (i = 0; i < numberof (data); i++)
+    {
+      WRITE_ARRAY (mpz_out_array, x[0], 2);
+
+      fp = fopen_or_die (FILENAME, "rb");
+      fseek (fp, 0L, SEEK_END);
+      bytes = ftell (fp);
+      rewind (fp);
+      buf = (unsigned char *) malloc (bytes);
+      if (fread (buf, bytes, 1, fp) != 1)
+	abort ();
+      fclose (fp);
+
+      pos = data[i].pos;
+      if (pos < 0)
+	{
+	  /* the high byte of the high limb of x[1] */
+	  pos = bytes - GMP_LIMB_BYTES;
+	  if (buf[pos] == 0)
+	    pos += GMP_LIMB_BYTES - 1;
+	}
+      buf[pos] ^= data[i].xor;
+      bytes -= MIN (bytes, data[i].truncate);
+
+      fp = fopen_or_die (FILENAME, "wb");
+      if (bytes != 0)
+	fwrite (buf, bytes, 1, fp);
+      fclose (fp);
+      free (buf);
+
+      if (gmp_array_map (a, FILENAME) == 0)
+	{
+	  printf ("gmp_array_map accepted bad file %d\n", i);
+	  abort ();
+	}
+    }
+
+  if (gmp_array_map (a, "t-array-does-not-exist.tmp") == 0)
+    {
+      printf ("gmp_array_map accepted a missing file\n");
+      abort ();
+    }
+
+  mpz_clear (x[0]);
+  mpz_clear (x[1]);
+}
+
+int
+main (int argc, char **argv)
+{
+  gmp_randstate_ptr  rands;
+  int                reps = 20;
+  int                i;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+  rands = RANDS;
+
+  for (i = 0; i < reps; i++)
+    {
+      check_mpz (rands, i & 1);
+      check_mpq (rands, i & 1);
+      check_mpf (rands, i & 1);
+    }
+  check_bad ();
+
+  unlink (FILENAME);
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,189 @@
+/* Test the factoring engine of demos/factorize, in demos/libfactor.a.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+#include "demos/factor.h"
+
+#define FILENAME  "t-factor.tmp"
+
+/* Each number is followed by its prime factors, each as "p^e", ascending.
+   They're chosen to go through each method: trial division, rho, p-1
+   (the 28 digit factor is 3 times the product of the primes to 71, plus 1),
+   a perfect power, and ECM for 2^128+1 and the two 15 digit primes.  */
+static const struct {
+  const char *n;
+  const char *f[6];
+} data[] = {
+  { "1", { NULL } },
+  { "2", { "2^1" } },
+  { "-720", { "2^4", "3^2", "5^1" } },
+  { "18446744073709551617",	/* 2^64+1 */
+    { "274177^1", "67280421310721^1" } },
+  { "147573952589676412927",	/* 2^67-1 */
+    { "193707721^1", "761838257287^1" } },
+  { "340282366920938463463374607431768211457",	/* 2^128+1 */
+    { "59649589127497217^1", "5704689200685129054721^1" } },
+  { "1000012000054000108000081",	/* 1000003^4 */
+    { "1000003^4" } },
+  /* 2^3 * 1000003^3 * 999999000001 */
+  { "8000064000152000072000000000216",
+    { "2^3", "1000003^3", "999999000001^1" } },
+  /* 1673822490380096882902246171 * (10^29+319) */
+  { "167382249038009688290224617633949374431250905645816528549",
+    { "1673822490380096882902246171^1", "100000000000000000000000000319^1" } },
+  { "30000000003804400000010574641",
+    { "100000000012397^1", "300000000000853^1" } },
+};
+
+static void
+check_data (void)
+{
+  struct factor_params params;
+  struct factors factors;
+  mpz_t n, p, prod;
+  char buf[100];
+  int i, j, complete;
+
+  factor_params_init (&params);
+  mpz_init (n);
+  mpz_init (p);
+  mpz_init (prod);
+
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpz_set_str_or_abort (n, data[i].n, 10);
+      factor_init (&factors);
+      complete = factor (&factors, n, &params);
+
+      for (j = 0; j < numberof (data[i].f) && data[i].f[j] != NULL; j++)
+	;
+      if (! complete || factors.nfactors != j)
+	{
+	  printf ("factor %s: complete %d, %ld factors, want %d\n",
+		  data[i].n, complete, factors.nfactors, j);
+	  abort ();
+	}
+
+      mpz_set_ui (prod, 1);
+      for (j = 0; j < factors.nfactors; j++)
+	{
+	  gmp_snprintf (buf, sizeof (buf), "%Zd^%lu",
+			factors.p[j], factors.e[j]);
+	  if (strcmp (buf, data[i].f[j]) != 0)
+	    {
+	      printf ("factor %s: factor %d is %s, want %s\n",
+		      data[i].n, j, buf, data[i].f[j]);
+	      abort ();
+	    }
+	  mpz_pow_ui (p, factors.p[j], factors.e[j]);
+	  mpz_mul (prod, prod, p);
+	}
+      mpz_abs (n, n);
+      if (mpz_cmp (prod, n) != 0)
+	{
+	  printf ("factor %s: product of factors differs\n", data[i].n);
+	  abort ();
+	}
+      factor_clear (&factors);
+    }
+
+  mpz_clear (n);
+  mpz_clear (p);
+  mpz_clear (prod);
+}
+
+/* factor_report's JSON, read back from a file.  */
+static void
+check_report (void)
+{
+  static const struct {
+    const char *n;
+    const char *want;
+  } report[] = {
+    { "1",
+      "{\"n\":\"1\",\"factors\":[],\"complete\":true,\"curves\":0}\n" },
+    { "147573952589676412927",
+      "{\"n\":\"147573952589676412927\",\"factors\":["
+      "{\"p\":\"193707721\",\"e\":1,\"method\":\"rho\"},"
+      "{\"p\":\"761838257287\",\"e\":1,\"method\":\"rho\"}],"
+      "\"complete\":true,\"curves\":0}\n" },
+    { "999999000001",
+      "{\"n\":\"999999000001\",\"factors\":["
+      "{\"p\":\"999999000001\",\"e\":1,\"method\":\"prime\"}],"
+      "\"complete\":true,\"curves\":0}\n" },
+    { "1500",
+      "{\"n\":\"1500\",\"factors\":["
+      "{\"p\":\"2\",\"e\":2,\"method\":\"division\"},"
+      "{\"p\":\"3\",\"e\":1,\"method\":\"division\"},"
+      "{\"p\":\"5\",\"e\":3,\"method\":\"division\"}],"
+      "\"complete\":true,\"curves\":0,\"seconds\":1.500}\n" },
+  };
+  struct factor_params params;
+  struct factors factors;
+  char buf[500];
+  FILE *fp;
+  mpz_t n;
+  int i, complete;
+
+  factor_params_init (&params);
+  mpz_init (n);
+
+  for (i = 0; i < numberof (report); i++)
+    {
+      mpz_set_str_or_abort (n, report[i].n, 10);
+      factor_init (&factors);
+      complete = factor (&factors, n, &params);
+
+      fp = fopen (FILENAME, "w+");
+      ASSERT_ALWAYS (fp != NULL);
+      factor_report (fp, n, &factors, complete, i == 3 ? 1.5 : -1.0);
+      rewind (fp);
+      if (fgets (buf, sizeof (buf), fp) == NULL
+	  || strcmp (buf, report[i].want) != 0)
+	{
+	  printf ("factor_report %s:\n", report[i].n);
+	  printf ("  got  %s", buf);
+	  printf ("  want %s", report[i].want);
+	  abort ();
+	}
+      fclose (fp);
+      factor_clear (&factors);
+    }
+
+  remove (FILENAME);
+  mpz_clear (n);
+}
+
+int
+main (void)
+{
+  tests_start ();
+
+  check_data ();
+  check_report ();
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,156 @@
+/* Test gmp_primeiter_init, gmp_primeiter_next and gmp_primeiter_clear.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one segment on another
+   shows up.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+/* Check the primes in [a,b) against mpz_probab_prime_p.  */
+static void
+check_range (mp_limb_t a, mp_limb_t b)
+{
+  gmp_primeiter_t it;
+  mp_limb_t n, p;
+  mpz_t z;
+
+  mpz_init (z);
+  gmp_primeiter_init (it, a, b);
+  p = gmp_primeiter_next (it);
+  for (n = a; n < b; n++)
+    {
+      /* n may not fit an unsigned long.  */
+      mpz_set_ui (z, (unsigned long) (n >> 31 >> 1));
+      mpz_mul_2exp (z, z, 32);
+      mpz_add_ui (z, z, (unsigned long) (n & 0xffffffff));
+      if ((mpz_probab_prime_p (z, 25) != 0) != (p != 0 && p == n))
+	{
+	  printf ("ERROR in range [%#lx,%#lx), at %#lx: iterator gave %#lx\n",
+		  (unsigned long) a, (unsigned long) b,
+		  (unsigned long) n, (unsigned long) p);
+	  abort ();
+	}
+      if (p != 0 && p == n)
+	p = gmp_primeiter_next (it);
+    }
+  if (p != 0 || gmp_primeiter_next (it) != 0)
+    {
+      printf ("ERROR in range [%#lx,%#lx), %#lx after the end\n",
+	      (unsigned long) a, (unsigned long) b, (unsigned long) p);
+      abort ();
+    }
+  gmp_primeiter_clear (it);
+  mpz_clear (z);
+}
+
+/* Count the primes in [a,b), and sum them mod 2^GMP_LIMB_BITS.  */
+static mp_limb_t
+count_range (mp_limb_t a, mp_limb_t b, mp_limb_t *sum)
+{
+  gmp_primeiter_t it;
+  mp_limb_t p, count;
+
+  count = 0;
+  *sum = 0;
+  gmp_primeiter_init (it, a, b);
+  while ((p = gmp_primeiter_next (it)) != 0)
+    {
+      count++;
+      *sum += p;
+    }
+  gmp_primeiter_clear (it);
+  return count;
+}
+
+int
+main (int argc, char **argv)
+{
+  mp_limb_t a, b, count, sum, pcount, psum;
+  int reps = 100;
+  int i, nthreads;
+  gmp_randstate_ptr rands;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+  rands = RANDS;
+
+  for (a = 0; a < 40; a++)
+    for (b = a; b < 60; b++)
+      check_range (a, b);
+
+  count = count_range (0, 1000000, &sum);
+  if (count != 78498)
+    {
+      printf ("ERROR, %lu primes below 10^6, expected 78498\n",
+	      (unsigned long) count);
+      abort ();
+    }
+
+  for (i = 0; i < reps; i++)
+    {
+      a = gmp_urandomb_ui (rands, 20);
+      if (GMP_NUMB_BITS >= 64 && (i & 1) != 0)
+	a = (a << 20) + gmp_urandomb_ui (rands, 20);
+      b = a + gmp_urandomb_ui (rands, 13);
+      check_range (a, b);
+    }
+
+  /* Several segments, serially and in parallel.  */
+  for (i = 0; i < 4; i++)
+    {
+      a = gmp_urandomb_ui (rands, 24);
+      b = a + 3000000 + gmp_urandomb_ui (rands, 20);
+      count = count_range (a, b, &sum);
+
+      nthreads = 2 + gmp_urandomm_ui (rands, 7);
+      task_calls = 0;
+      mp_set_parallel_function (reverse_parallel, nthreads);
+      pcount = count_range (a, b, &psum);
+      mp_set_parallel_function (NULL, 0);
+
+      if (task_calls == 0 || pcount != count || psum != sum)
+	{
+	  printf ("ERROR in parallel, range [%#lx,%#lx), %d threads\n",
+		  (unsigned long) a, (unsigned long) b, nthreads);
+	  printf ("  %lu tasks, count %lu vs %lu\n", (unsigned long) task_calls,
+		  (unsigned long) pcount, (unsigned long) count);
+	  abort ();
+	}
+    }
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,144 @@
+/* Test gmp_stats_enable, gmp_stats_reset and gmp_stats_dump.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define FILENAME  "t-stats.tmp"
+
+
+/* The dump must produce something, whether or not counting is compiled
+   in.  */
+static void
+check_dump (void)
+{
+  FILE  *fp;
+  long  pos;
+
+  fp = fopen (FILENAME, "w+");
+  if (fp == NULL)
+    {
+      printf ("Cannot create file %s\n", FILENAME);
+      abort ();
+    }
+  gmp_stats_dump (fp);
+  pos = ftell (fp);
+  fclose (fp);
+  unlink (FILENAME);
+  if (pos <= 0)
+    {
+      printf ("gmp_stats_dump wrote nothing\n");
+      abort ();
+    }
+}
+
+#if WANT_STATS
+static unsigned long
+total (int what)
+{
+  unsigned long  t;
+  int            b;
+
+  t = 0;
+  for (b = 0; b < GMP_STATS_BUCKETS; b++)
+    t += __gmp_stats_table[what][b];
+  return t;
+}
+
+static void
+check_count (gmp_randstate_ptr rands)
+{
+  mp_limb_t  a[8], b[8], r[16];
+  mp_size_t  n;
+  int        bucket;
+
+  /* Sizes 4 to 7 go in bucket 3.  */
+  n = 4 + gmp_urandomm_ui (rands, 4);
+  bucket = 3;
+  mpn_random (a, n);
+  mpn_random (b, n);
+
+  gmp_stats_reset ();
+  gmp_stats_enable (0);
+  mpn_mul_n (r, a, b, n);
+  if (total (GMP_STATS_MUL_N_BASECASE) != 0)
+    {
+      printf ("mpn_mul_n counted while disabled\n");
+      abort ();
+    }
+
+  gmp_stats_enable (1);
+  mpn_mul_n (r, a, b, n);
+  mpn_mul_n (r, a, b, n);
+  gmp_stats_enable (0);
+  if (BELOW_THRESHOLD (n, MUL_TOOM22_THRESHOLD)
+      && (__gmp_stats_table[GMP_STATS_MUL_N_BASECASE][bucket] != 2
+	  || total (GMP_STATS_MUL_N_BASECASE) != 2))
+    {
+      printf ("mpn_mul_n basecase count wrong, n=%ld\n", (long) n);
+      gmp_stats_dump (stdout);
+      abort ();
+    }
+
+  gmp_stats_reset ();
+  if (total (GMP_STATS_MUL_N_BASECASE) != 0)
+    {
+      printf ("gmp_stats_reset didn't clear\n");
+      abort ();
+    }
+}
+#endif
+
+int
+main (int argc, char **argv)
+{
+  tests_start ();
+
+  check_dump ();
+  if (gmp_stats_enable (1))
+    {
+#if WANT_STATS
+      check_count (RANDS);
+#else
+      printf ("gmp_stats_enable says enabled, but WANT_STATS not set\n");
+      abort ();
+#endif
+    }
+#if WANT_STATS
+  else
+    {
+      printf ("gmp_stats_enable says disabled, but WANT_STATS is set\n");
+      abort ();
+    }
+#endif
+  gmp_stats_enable (0);
+
+  tests_end ();
+  exit (0);
+}
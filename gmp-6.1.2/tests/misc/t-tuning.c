@@ -0,0 +1,452 @@
+/* Test gmp_set_tuning, gmp_get_tuning and gmp_read_tuning.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define FILENAME  "t-tuning.tmp"
+
+/* Names which may be tunable.  Only one of the REDC sets exists in a given
+   build, gmp_get_tuning gives -1 for the other.  */
+static const char *const names[] = {
+  "MUL_TOOM22_THRESHOLD",
+  "MUL_TOOM33_THRESHOLD",
+  "MUL_TOOM44_THRESHOLD",
+  "MUL_TOOM6H_THRESHOLD",
+  "MUL_TOOM8H_THRESHOLD",
+  "MUL_TOOM32_TO_TOOM43_THRESHOLD",
+  "MUL_TOOM32_TO_TOOM53_THRESHOLD",
+  "MUL_TOOM42_TO_TOOM53_THRESHOLD",
+  "MUL_TOOM42_TO_TOOM63_THRESHOLD",
+  "MUL_TOOM43_TO_TOOM54_THRESHOLD",
+  "MUL_FFT_THRESHOLD",
+  "SQR_TOOM3_THRESHOLD",
+  "SQR_TOOM4_THRESHOLD",
+  "SQR_TOOM6_THRESHOLD",
+  "SQR_TOOM8_THRESHOLD",
+  "SQR_FFT_THRESHOLD",
+  "DC_DIV_QR_THRESHOLD",
+  "DC_DIVAPPR_Q_THRESHOLD",
+  "MU_DIV_QR_THRESHOLD",
+  "MU_DIVAPPR_Q_THRESHOLD",
+  "MUPI_DIV_QR_THRESHOLD",
+  "HGCD_THRESHOLD",
+  "GCD_DC_THRESHOLD",
+  "GCDEXT_DC_THRESHOLD",
+  "REDC_1_TO_REDC_2_THRESHOLD",
+  "REDC_2_TO_REDC_N_THRESHOLD",
+  "REDC_1_TO_REDC_N_THRESHOLD",
+  "GET_STR_DC_THRESHOLD",
+  "SET_STR_DC_THRESHOLD",
+  "SET_STR_PRECOMPUTE_THRESHOLD",
+};
+
+#define NUM_NAMES  numberof (names)
+
+#if WANT_RUNTIME_TUNING
+
+static long  dflt[NUM_NAMES];
+static long  lo[NUM_NAMES];
+
+static void
+set_or_die (const char *name, long value)
+{
+  if (gmp_set_tuning (name, value) != 0 || gmp_get_tuning (name) != value)
+    {
+      printf ("gmp_set_tuning %s %ld failed\n", name, value);
+      abort ();
+    }
+}
+
+/* Set each of the count thresholds in n[] to v[] (skipping -1s).  The
+   order rule may reject a value until its neighbours have moved, so go
+   round until everything is set.  */
+static void
+set_all_or_die (const char *const *n, const long *v, int count)
+{
+  int  i, pass, left;
+
+  for (pass = 0; pass <= count; pass++)
+    {
+      left = 0;
+      for (i = 0; i < count; i++)
+	if (v[i] != -1 && gmp_get_tuning (n[i]) != v[i]
+	    && gmp_set_tuning (n[i], v[i]) != 0)
+	  left++;
+      if (left == 0)
+	return;
+    }
+  for (i = 0; i < count; i++)
+    if (v[i] != -1)
+      set_or_die (n[i], v[i]);
+}
+
+/* Find the defaults, and the smallest value each threshold accepts.  */
+static void
+check_limits (void)
+{
+  int   i;
+  long  v;
+
+  for (i = 0; i < NUM_NAMES; i++)
+    {
+      dflt[i] = gmp_get_tuning (names[i]);
+      if (dflt[i] == -1)
+	continue;
+      if (dflt[i] < 1)
+	{
+	  printf ("%s default %ld\n", names[i], dflt[i]);
+	  abort ();
+	}
+
+      for (v = 1; gmp_set_tuning (names[i], v) != 0; v++)
+	{
+	  if (gmp_get_tuning (names[i]) != dflt[i])
+	    {
+	      printf ("%s changed by a rejected value %ld\n", names[i], v);
+	      abort ();
+	    }
+	  if (v > 100000)
+	    {
+	      printf ("%s accepts no small value\n", names[i]);
+	      abort ();
+	    }
+	}
+      lo[i] = v;
+      if (lo[i] > dflt[i])
+	{
+	  printf ("%s default %ld below its minimum %ld\n",
+		  names[i], dflt[i], lo[i]);
+	  abort ();
+	}
+      set_or_die (names[i], dflt[i]);
+    }
+
+  if (gmp_set_tuning ("NO_SUCH_THRESHOLD", 100) != -1
+      || gmp_get_tuning ("NO_SUCH_THRESHOLD") != -1)
+    {
+      printf ("unknown threshold name accepted\n");
+      abort ();
+    }
+
+  /* Successive toom thresholds must stay in order.  */
+  {
+    long  t22 = gmp_get_tuning ("MUL_TOOM22_THRESHOLD");
+    long  t33 = gmp_get_tuning ("MUL_TOOM33_THRESHOLD");
+    if (gmp_set_tuning ("MUL_TOOM22_THRESHOLD", t33 + 1) != -1
+	|| gmp_set_tuning ("MUL_TOOM33_THRESHOLD", t22 - 1) != -1
+	|| gmp_get_tuning ("MUL_TOOM22_THRESHOLD") != t22
+	|| gmp_get_tuning ("MUL_TOOM33_THRESHOLD") != t33)
+      {
+	printf ("toom thresholds accepted out of order\n");
+	abort ();
+      }
+  }
+
+  /* These size stack arrays, so they have an upper limit.  */
+  if (gmp_set_tuning ("MUL_TOOM22_THRESHOLD", 100000) != -1
+      || gmp_set_tuning ("SQR_TOOM3_THRESHOLD", 100000) != -1
+      || gmp_set_tuning ("GET_STR_DC_THRESHOLD", 100000) != -1)
+    {
+      printf ("threshold above its limit accepted\n");
+      abort ();
+    }
+}
+
+static void
+check_read (void)
+{
+  FILE  *fp;
+  int   ret;
+  long  want, t22, t33, dc, mu;
+
+  /* Between its lowest value, which is at least MUL_TOOM33_THRESHOLD, and
+     its default, so the order rule allows it.  */
+  want = (lo[2] + gmp_get_tuning ("MUL_TOOM44_THRESHOLD") + 1) / 2;
+
+  fp = fopen (FILENAME, "w+");
+  if (fp == NULL)
+    {
+      printf ("Cannot create file %s\n", FILENAME);
+      abort ();
+    }
+  fprintf (fp, "/* Generated by tuneup.c */\n");
+  fprintf (fp, "#define GMP_MPARAM_H_SUGGEST \"./mpn/generic/gmp-mparam.h\"\n");
+  fprintf (fp, "#define MUL_TOOM44_THRESHOLD               %ld\n", want);
+  fprintf (fp, "#define SQR_BASECASE_THRESHOLD                0\n");
+  fprintf (fp, "#define MUL_FFT_TABLE3 \\\n  { {    100, 5}, {    200, 6} }\n");
+  rewind (fp);
+  ret = gmp_read_tuning (fp);
+  if (ret != 1 || gmp_get_tuning ("MUL_TOOM44_THRESHOLD") != want)
+    {
+      printf ("gmp_read_tuning returned %d, MUL_TOOM44_THRESHOLD %ld\n",
+	      ret, gmp_get_tuning ("MUL_TOOM44_THRESHOLD"));
+      abort ();
+    }
+  fclose (fp);
+
+  fp = fopen (FILENAME, "w+");
+  fprintf (fp, "#define MUL_TOOM44_THRESHOLD  1\n");
+  rewind (fp);
+  ret = gmp_read_tuning (fp);
+  fclose (fp);
+  if (ret != -1 || gmp_get_tuning ("MUL_TOOM44_THRESHOLD") != want)
+    {
+      printf ("gmp_read_tuning accepted a bad value\n");
+      abort ();
+    }
+
+  /* MU below DC is out of order, and then nothing is set, not even the
+     good MUL_TOOM44 line.  */
+  dc = gmp_get_tuning ("DC_DIV_QR_THRESHOLD");
+  mu = gmp_get_tuning ("MU_DIV_QR_THRESHOLD");
+  fp = fopen (FILENAME, "w+");
+  fprintf (fp, "#define MUL_TOOM44_THRESHOLD  %ld\n", dflt[2]);
+  fprintf (fp, "#define MU_DIV_QR_THRESHOLD  %ld\n", MAX (dc - 1, 6));
+  rewind (fp);
+  ret = gmp_read_tuning (fp);
+  fclose (fp);
+  if (ret != -1 || gmp_get_tuning ("MU_DIV_QR_THRESHOLD") != mu
+      || gmp_get_tuning ("MUL_TOOM44_THRESHOLD") != want)
+    {
+      printf ("gmp_read_tuning accepted thresholds out of order\n");
+      abort ();
+    }
+
+  /* Both moved down together, MUL_TOOM33 first, possibly below the old
+     MUL_TOOM22, where one at a time gmp_set_tuning would need MUL_TOOM22
+     moved first.  */
+  t22 = MAX (lo[0], 4);
+  t33 = MAX (t22, MPN_TOOM33_MUL_MINSIZE);
+  fp = fopen (FILENAME, "w+");
+  fprintf (fp, "#define MUL_TOOM33_THRESHOLD  %ld\n", t33);
+  fprintf (fp, "#define MUL_TOOM22_THRESHOLD  %ld\n", t22);
+  rewind (fp);
+  ret = gmp_read_tuning (fp);
+  fclose (fp);
+  if (ret != 2 || gmp_get_tuning ("MUL_TOOM22_THRESHOLD") != t22
+      || gmp_get_tuning ("MUL_TOOM33_THRESHOLD") != t33)
+    {
+      printf ("gmp_read_tuning returned %d for ordered thresholds\n", ret);
+      abort ();
+    }
+
+  unlink (FILENAME);
+  set_all_or_die (names, dflt, NUM_NAMES);
+}
+
+#define NUM_OPS  10
+
+static void
+do_ops (mpz_t *r, mpz_srcptr a, mpz_srcptr b, mpz_srcptr m)
+{
+  char  *s;
+
+  mpz_mul (r[0], a, b);
+  mpz_mul (r[1], a, a);
+  mpz_tdiv_qr (r[2], r[3], r[0], a);
+  mpz_tdiv_qr (r[4], r[5], a, b);
+  mpz_gcdext (r[6], r[7], NULL, a, b);
+  mpz_powm_ui (r[8], a, 65537, m);
+  s = mpz_get_str (NULL, 10, r[1]);
+  mpz_set_str (r[9], s, 10);
+  (*__gmp_free_func) (s, strlen (s) + 1);
+}
+
+/* Operations under random thresholds must give the same results as under
+   the defaults.  */
+static void
+check_ops (gmp_randstate_ptr rands, int reps)
+{
+  mpz_t  a, b, m, want[NUM_OPS], got[NUM_OPS];
+  long   maxlo, v;
+  int    i, j, rep;
+
+  maxlo = 0;
+  for (i = 0; i < NUM_NAMES; i++)
+    if (dflt[i] != -1)
+      maxlo = MAX (maxlo, lo[i]);
+
+  mpz_init (a);
+  mpz_init (b);
+  mpz_init (m);
+  for (j = 0; j < NUM_OPS; j++)
+    {
+      mpz_init (want[j]);
+      mpz_init (got[j]);
+    }
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      mpz_rrandomb (a, rands,
+		    (1 + gmp_urandomm_ui (rands, 3 * maxlo)) * GMP_NUMB_BITS);
+      mpz_rrandomb (b, rands,
+		    (1 + gmp_urandomm_ui (rands, 3 * maxlo)) * GMP_NUMB_BITS);
+      mpz_urandomb (m, rands,
+		    (1 + gmp_urandomm_ui (rands, 60)) * GMP_NUMB_BITS);
+      mpz_setbit (m, 0);
+
+      set_all_or_die (names, dflt, NUM_NAMES);
+      do_ops (want, a, b, m);
+
+      /* Mostly small values, so the big algorithms get used at sizes
+	 tested here.  A value out of order with its neighbours is
+	 rejected, and the threshold left as it was.  */
+      for (i = 0; i < NUM_NAMES; i++)
+	{
+	  if (dflt[i] == -1)
+	    continue;
+	  v = lo[i] + gmp_urandomm_ui (rands, 2 * lo[i]);
+	  gmp_set_tuning (names[i], v);
+	}
+      do_ops (got, a, b, m);
+
+      for (j = 0; j < NUM_OPS; j++)
+	if (mpz_cmp (want[j], got[j]) != 0)
+	  {
+	    printf ("result %d differs under changed thresholds\n", j);
+	    for (i = 0; i < NUM_NAMES; i++)
+	      if (dflt[i] != -1)
+		printf ("  %s %ld\n", names[i], gmp_get_tuning (names[i]));
+	    mpz_trace ("a   ", a);
+	    mpz_trace ("b   ", b);
+	    mpz_trace ("want", want[j]);
+	    mpz_trace ("got ", got[j]);
+	    abort ();
+	  }
+    }
+
+  set_all_or_die (names, dflt, NUM_NAMES);
+
+  mpz_clear (a);
+  mpz_clear (b);
+  mpz_clear (m);
+  for (j = 0; j < NUM_OPS; j++)
+    {
+      mpz_clear (want[j]);
+      mpz_clear (got[j]);
+    }
+}
+
+/* A modulus context, and the fixed-base table holding one, keep the REDC
+   form they were made with when the REDC thresholds change.  */
+static void
+check_contexts (gmp_randstate_ptr rands, int reps)
+{
+  static const char *const redc[] = {
+    "REDC_1_TO_REDC_2_THRESHOLD",
+    "REDC_2_TO_REDC_N_THRESHOLD",
+    "REDC_1_TO_REDC_N_THRESHOLD",
+  };
+  mpz_modctx_t     c;
+  mpz_fixedbase_t  fb;
+  mpz_t  g, e, m, want, got;
+  long   save[numberof (redc)], v;
+  int    i, rep;
+
+  mpz_init (g);
+  mpz_init (e);
+  mpz_init (m);
+  mpz_init (want);
+  mpz_init (got);
+  for (i = 0; i < numberof (redc); i++)
+    save[i] = gmp_get_tuning (redc[i]);
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      mpz_urandomb (m, rands,
+		    (1 + gmp_urandomm_ui (rands, 40)) * GMP_NUMB_BITS);
+      mpz_setbit (m, 0);
+      mpz_urandomb (g, rands, mpz_sizeinbase (m, 2));
+      mpz_urandomb (e, rands, 1 + gmp_urandomm_ui (rands, 300));
+
+      mpz_modctx_init (c, m);
+      mpz_fixedbase_init (fb, g, m, 300, 4, 0);
+
+      for (i = 0; i < numberof (redc); i++)
+	if (save[i] != -1)
+	  {
+	    v = 1 + gmp_urandomm_ui (rands, 50);
+	    if (gmp_set_tuning (redc[i], v) != 0)
+	      gmp_set_tuning (redc[i], save[i]);
+	  }
+
+      mpz_powm (want, g, e, m);
+      mpz_powm_ctx (got, g, e, c);
+      if (mpz_cmp (want, got) != 0)
+	{
+	  printf ("mpz_powm_ctx wrong after REDC thresholds changed\n");
+	  abort ();
+	}
+      mpz_powm_fixed_base (got, e, fb);
+      if (mpz_cmp (want, got) != 0)
+	{
+	  printf ("mpz_powm_fixed_base wrong after REDC thresholds changed\n");
+	  abort ();
+	}
+
+      mpz_modctx_clear (c);
+      mpz_fixedbase_clear (fb);
+      set_all_or_die (redc, save, numberof (redc));
+    }
+
+  mpz_clear (g);
+  mpz_clear (e);
+  mpz_clear (m);
+  mpz_clear (want);
+  mpz_clear (got);
+}
+#endif /* WANT_RUNTIME_TUNING */
+
+int
+main (int argc, char **argv)
+{
+  int  reps = 20;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+#if WANT_RUNTIME_TUNING
+  check_limits ();
+  check_read ();
+  check_ops (RANDS, reps);
+  check_contexts (RANDS, reps);
+#else
+  if (gmp_get_tuning ("MUL_TOOM22_THRESHOLD") != -1
+      || gmp_set_tuning ("MUL_TOOM22_THRESHOLD", 20) != -1
+      || gmp_read_tuning (stdin) != -1)
+    {
+      printf ("runtime tuning functions work, but WANT_RUNTIME_TUNING not set\n");
+      abort ();
+    }
+#endif
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,350 @@
+/* Test mpf_exp, mpf_log, mpf_sin, mpf_cos and mpf_atan.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+struct func_t {
+  const char  *name;
+  void        (*f) (mpf_ptr, mpf_srcptr);
+};
+
+static const struct func_t  funcs[] = {
+  { "mpf_exp",  mpf_exp  },
+  { "mpf_log",  mpf_log  },
+  { "mpf_sin",  mpf_sin  },
+  { "mpf_cos",  mpf_cos  },
+  { "mpf_atan", mpf_atan },
+};
+
+#define FUNC_EXP   0
+#define FUNC_LOG   1
+#define FUNC_SIN   2
+#define FUNC_COS   3
+#define FUNC_ATAN  4
+
+/* Fail unless got is want to within 2^-bits relative.  */
+static void
+check_close (const char *name, mpf_srcptr x, mpf_srcptr got, mpf_srcptr want,
+	     mp_bitcnt_t bits)
+{
+  mpf_t  d, lim;
+
+  mpf_init2 (d, 64);
+  mpf_init2 (lim, 64);
+  mpf_set_ui (lim, 1);
+  mpf_div_2exp (lim, lim, bits);
+
+  if (mpf_sgn (want) == 0)
+    mpf_abs (d, got);
+  else
+    mpf_reldiff (d, want, got);
+  mpf_abs (d, d);
+  if (mpf_cmp (d, lim) > 0)
+    {
+      printf ("%s wrong, %lu bits\n", name, (unsigned long) bits);
+      mpf_trace ("  x   ", x);
+      mpf_trace ("  want", want);
+      mpf_trace ("  got ", got);
+      mpf_trace ("  diff", d);
+      abort ();
+    }
+
+  mpf_clear (d);
+  mpf_clear (lim);
+}
+
+#define PI_STR \
+  "3.14159265358979323846264338327950288419716939937510582097494459230781640629"
+
+static const struct {
+  int         func;
+  const char  *x;
+  const char  *want;
+} data[] = {
+  { FUNC_EXP,  "1",
+    "2.71828182845904523536028747135266249775724709369995957496696762772407663035" },
+  { FUNC_EXP,  "0.5",
+    "1.64872127070012814684865078781416357165377610071014801157507931164066102119" },
+  { FUNC_EXP,  "-3.25",
+    "0.0387742078317220098868998352675961432601440619360201457006958609930934431984" },
+  { FUNC_EXP,  "10",
+    "22026.4657948067165169579006452842443663535126185567810742354263552252028185" },
+  { FUNC_EXP,  "100",
+    "26881171418161354484126255515800135873611118.7737419224151916086152802870349" },
+
+  { FUNC_LOG,  "2",
+    "0.693147180559945309417232121458176568075500134360255254120680009493393621969" },
+  { FUNC_LOG,  "0.5",
+    "-0.693147180559945309417232121458176568075500134360255254120680009493393621969" },
+  { FUNC_LOG,  "10",
+    "2.30258509299404568401799145468436420760110148862877297603332790096757260967" },
+  { FUNC_LOG,  "1.0001",
+    "0.0000999950003333083353331666809511310634820644010710755126612943216449160740" },
+  { FUNC_LOG,  "1e30",
+    "69.0775527898213705205397436405309262280330446588631892809998370290271782903" },
+  { FUNC_LOG,  "1",  "0" },
+
+  { FUNC_SIN,  "1",
+    "0.841470984807896506652502321630298999622563060798371065672751709991910404391" },
+  { FUNC_SIN,  "-0.5",
+    "-0.479425538604203000273287935215571388081803367940600675188616613125535000287" },
+  { FUNC_SIN,  "3",
+    "0.141120008059867222100744802808110279846933264252265584151882641232422009967" },
+  { FUNC_SIN,  "100",
+    "-0.506365641109758793656557610459785432065032721290657323443392473594357913419" },
+  { FUNC_SIN,  "1e-20",
+    "9.99999999999999999999999999999999999999983333333333333333333333333333333333e-21" },
+  { FUNC_SIN,  "0",  "0" },
+
+  { FUNC_COS,  "1",
+    "0.540302305868139717400936607442976603732310420617922227670097255381100394774" },
+  { FUNC_COS,  "-0.5",
+    "0.877582561890372716116281582603829651991645197109744052997610868315950763274" },
+  { FUNC_COS,  "3",
+    "-0.989992496600445457271572794731261302393679096615588328814085932928329197513" },
+  { FUNC_COS,  "100",
+    "0.862318872287683934101938513950842535510084008535510829280162112692721088050" },
+  { FUNC_COS,  "1e-20",
+    "0.999999999999999999999999999999999999999950000000000000000000000000000000000" },
+  { FUNC_COS,  "0",  "1" },
+
+  { FUNC_ATAN, "1",
+    "0.785398163397448309615660845819875721049292349843776455243736148076954101571" },
+  { FUNC_ATAN, "0.5",
+    "0.463647609000806116214256231461214402028537054286120263810933088720197864165" },
+  { FUNC_ATAN, "-3",
+    "-1.24904577239825442582991707728109012307782940412989671905466923679715196573" },
+  { FUNC_ATAN, "100",
+    "1.56079666010823138102498157543047189353721534714317627085953287795745164993" },
+  { FUNC_ATAN, "1e-20",
+    "9.99999999999999999999999999999999999999966666666666666666666666666666666666e-21" },
+  { FUNC_ATAN, "0",  "0" },
+};
+
+/* The strings have about 245 bits.  */
+static void
+check_data (void)
+{
+  mpf_t  x, got, want;
+  int    i;
+
+  mpf_init2 (x, 256);
+  mpf_init2 (got, 224);
+  mpf_init2 (want, 256);
+
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpf_set_str (x, data[i].x, 10);
+      mpf_set_str (want, data[i].want, 10);
+      (*funcs[data[i].func].f) (got, x);
+      check_close (funcs[data[i].func].name, x, got, want, 224);
+    }
+
+  /* 4*atan(1) is pi */
+  mpf_set_ui (x, 1);
+  mpf_atan (got, x);
+  mpf_mul_2exp (got, got, 2);
+  mpf_set_str (want, PI_STR, 10);
+  check_close ("mpf_atan", x, got, want, 224);
+
+  mpf_clear (x);
+  mpf_clear (got);
+  mpf_clear (want);
+}
+
+/* An argument for FUNC, of a size it should handle.  */
+static void
+random_arg (mpf_ptr x, int func, gmp_randstate_ptr rands)
+{
+  mp_size_t  n;
+  int  c;
+
+  n = 1 + gmp_urandomm_ui (rands, PREC (x));
+  c = gmp_urandomm_ui (rands, 4);
+  if (c >= 2 && func != FUNC_EXP)
+    mpf_random2 (x, n, 2);
+  else
+    {
+      mpf_random2 (x, n, 0);
+      if (c == 0)
+	{
+	  /* just above 1 for log, about 113*pi for sin and cos */
+	  mpf_div_2exp (x, x, 20);
+	  if (func == FUNC_LOG)
+	    mpf_add_ui (x, x, 1);
+	  else if (func == FUNC_SIN || func == FUNC_COS)
+	    mpf_add_ui (x, x, 355);
+	}
+      else
+	mpf_mul_ui (x, x, 1 + gmp_urandomm_ui (rands, 1000));
+    }
+  if (func != FUNC_LOG && gmp_urandomb_ui (rands, 1))
+    mpf_neg (x, x);
+  if (mpf_sgn (x) == 0)
+    mpf_set_ui (x, 3);
+}
+
+/* Each result must agree with one at a higher precision.  Also in-place
+   operation.  */
+static void
+check_random (gmp_randstate_ptr rands, int reps)
+{
+  mpf_t  x, got, want, t;
+  mp_bitcnt_t  prec;
+  int    rep, i;
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      prec = 1 + gmp_urandomm_ui (rands, rep < reps / 10 ? 2000 : 300);
+      mpf_init2 (x, prec + gmp_urandomm_ui (rands, 200));
+      mpf_init2 (got, prec);
+      mpf_init2 (t, prec);
+      mpf_init2 (want, prec + 3 * GMP_NUMB_BITS);
+
+      for (i = 0; i < numberof (funcs); i++)
+	{
+	  random_arg (x, i, rands);
+	  (*funcs[i].f) (got, x);
+	  (*funcs[i].f) (want, x);
+	  check_close (funcs[i].name, x, got, want, mpf_get_prec (got));
+
+	  mpf_set (t, x);
+	  (*funcs[i].f) (want, t);
+	  (*funcs[i].f) (t, t);
+	  check_close (funcs[i].name, x, t, want, mpf_get_prec (t));
+	}
+
+      mpf_clear (x);
+      mpf_clear (got);
+      mpf_clear (t);
+      mpf_clear (want);
+    }
+}
+
+/* sin^2 + cos^2 = 1, and log(exp(x)) = x.  */
+static void
+check_identities (gmp_randstate_ptr rands, int reps)
+{
+  mpf_t  x, s, c, one;
+  mp_bitcnt_t  prec;
+  int    rep;
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      prec = 1 + gmp_urandomm_ui (rands, 500);
+      mpf_init2 (x, prec);
+      mpf_init2 (s, prec);
+      mpf_init2 (c, prec);
+      mpf_init2 (one, prec);
+      mpf_set_ui (one, 1);
+
+      mpf_random2 (x, PREC (x), 3);
+      mpf_sin (s, x);
+      mpf_cos (c, x);
+      mpf_mul (s, s, s);
+      mpf_mul (c, c, c);
+      mpf_add (s, s, c);
+      check_close ("sin^2+cos^2", x, s, one, mpf_get_prec (s) - 4);
+
+      mpf_random2 (x, PREC (x), 0);
+      mpf_mul_ui (x, x, 10);
+      mpf_add_ui (x, x, 1);
+      if (gmp_urandomb_ui (rands, 1))
+	mpf_neg (x, x);
+      mpf_exp (s, x);
+      mpf_log (s, s);
+      check_close ("log(exp(x))", x, s, x, mpf_get_prec (s) - 8);
+
+      mpf_clear (x);
+      mpf_clear (s);
+      mpf_clear (c);
+      mpf_clear (one);
+    }
+}
+
+static int  task_calls;
+
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+/* Enough terms for the series to go to the parallel function.  */
+static void
+check_parallel (void)
+{
+  mpf_t  x, r1, r2;
+  int    i;
+
+  mpf_init2 (x, 64);
+  mpf_init2 (r1, 80000);
+  mpf_init2 (r2, 80000);
+  mpf_set_d (x, 0.75);
+
+  for (i = 0; i < numberof (funcs); i++)
+    {
+      (*funcs[i].f) (r1, x);
+      mp_set_parallel_function (reverse_parallel, 4);
+      task_calls = 0;
+      (*funcs[i].f) (r2, x);
+      mp_set_parallel_function (NULL, 1);
+      if (mpf_cmp (r1, r2) != 0)
+	{
+	  printf ("%s wrong in parallel\n", funcs[i].name);
+	  abort ();
+	}
+      if (task_calls == 0)
+	{
+	  printf ("%s didn't use the parallel function\n", funcs[i].name);
+	  abort ();
+	}
+    }
+
+  mpf_clear (x);
+  mpf_clear (r1);
+  mpf_clear (r2);
+}
+
+int
+main (int argc, char **argv)
+{
+  int  reps = 100;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_data ();
+  check_random (RANDS, reps);
+  check_identities (RANDS, reps);
+  check_parallel ();
+
+  tests_end ();
+  exit (0);
+}
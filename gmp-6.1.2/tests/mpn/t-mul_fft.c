@@ -0,0 +1,127 @@
+/* Test mpn_mul_fft with a parallel function installed.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef COUNT
+#define COUNT 12
+#endif
+
+/* Don't go wild when the threshold is large.  */
+#define MAX_PL  (1L << 17)
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one task on another
+   having already run shows up as a wrong product.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr ap, bp, rp, refp;
+  mp_size_t pl, min_pl;
+  mp_limb_t h, refh;
+  int count = COUNT;
+  int test, k, sqr, nthreads;
+  gmp_randstate_ptr rands;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  min_pl = FFT_PARALLEL_THRESHOLD;
+  if (min_pl > MAX_PL / 2)
+    {
+      printf ("FFT_PARALLEL_THRESHOLD too big, skipping\n");
+      tests_end ();
+      exit (0);
+    }
+
+  TMP_MARK;
+  ap = TMP_ALLOC_LIMBS (MAX_PL + 1);
+  bp = TMP_ALLOC_LIMBS (MAX_PL + 1);
+  rp = TMP_ALLOC_LIMBS (MAX_PL + 1);
+  refp = TMP_ALLOC_LIMBS (MAX_PL + 1);
+
+  for (test = 0; test < count; test++)
+    {
+      sqr = test & 1;
+      nthreads = 2 + gmp_urandomm_ui (rands, 7);
+
+      pl = min_pl + gmp_urandomm_ui (rands, min_pl);
+      /* Mostly the k mpn_mul_fft would choose, sometimes a small one to
+	 exercise the depth capping.  */
+      if (test % 4 == 3)
+	k = 4 + gmp_urandomm_ui (rands, 2);
+      else
+	k = mpn_fft_best_k (pl, sqr);
+      pl = mpn_fft_next_size (pl, k);
+      ASSERT_ALWAYS (pl <= MAX_PL);
+
+      mpn_random2 (ap, pl);
+      if (sqr)
+	bp = ap;
+      else
+	mpn_random2 (bp, pl);
+
+      mp_set_parallel_function (NULL, 0);
+      refh = mpn_mul_fft (refp, pl, ap, pl, bp, pl, k);
+
+      task_calls = 0;
+      mp_set_parallel_function (reverse_parallel, nthreads);
+      h = mpn_mul_fft (rp, pl, ap, pl, bp, pl, k);
+      mp_set_parallel_function (NULL, 0);
+
+      if (task_calls == 0)
+	{
+	  printf ("parallel function not used, pl=%ld k=%d\n", (long) pl, k);
+	  abort ();
+	}
+      if (h != refh || mpn_cmp (rp, refp, pl) != 0)
+	{
+	  printf ("ERROR in test %d, pl=%ld k=%d sqr=%d nthreads=%d\n",
+		  test, (long) pl, k, sqr, nthreads);
+	  abort ();
+	}
+
+      if (sqr)
+	bp = TMP_ALLOC_LIMBS (MAX_PL + 1);
+    }
+
+  TMP_FREE;
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,179 @@
+/* Test mpn_powm at each size across the thresholds choosing its REDC form
+   and its multiplication functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+/* Sizes tested go this far past the biggest of the thresholds, but not
+   beyond MAX_N.  An IFMA cpu in a fat binary has MUL_TOOM22_THRESHOLD 200,
+   so MAX_N covers that.  */
+#define MARGIN  20
+#define MAX_N   300
+
+#ifndef COUNT
+#define COUNT 2
+#endif
+
+/* Exponent limbs.  */
+#define EN  2
+
+/* As in mpn/generic/powm.c.  */
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+#define WANT_REDC_2 1
+#endif
+
+/* rp = b^e mod m by left to right binary powering.  */
+static void
+ref_powm (mpz_t r, const mpz_t b, const mpz_t e, const mpz_t m)
+{
+  mp_bitcnt_t i;
+
+  mpz_set_ui (r, 1);
+  for (i = mpz_sizeinbase (e, 2); i-- > 0; )
+    {
+      mpz_mul (r, r, r);
+      if (mpz_tstbit (e, i))
+	mpz_mul (r, r, b);
+      mpz_mod (r, r, m);
+    }
+}
+
+static void
+check_sizes (gmp_randstate_ptr rands, int count, const char *what)
+{
+  mpz_t b, e, m, r;
+  mp_ptr rp, tp;
+  mp_size_t n, max_n, bn, rn, itch;
+  int i;
+
+  mpz_init (b);
+  mpz_init (e);
+  mpz_init (m);
+  mpz_init (r);
+
+  max_n = MUL_TOOM22_THRESHOLD;
+#if WANT_REDC_2
+  max_n = MAX (max_n, REDC_2_TO_REDC_N_THRESHOLD);
+#else
+  max_n = MAX (max_n, REDC_1_TO_REDC_N_THRESHOLD);
+#endif
+  max_n = MIN (max_n + MARGIN, MAX_N);
+
+  rp = refmpn_malloc_limbs (max_n);
+  tp = refmpn_malloc_limbs (MAX (mpn_binvert_itch (max_n), 2 * max_n) + 1);
+
+  for (n = 1; n <= max_n; n++)
+    for (i = 0; i < count; i++)
+      {
+	mpz_rrandomb (m, rands, n * GMP_NUMB_BITS);
+	mpz_setbit (m, 0);
+	mpz_urandomb (b, rands, n * GMP_NUMB_BITS);
+	if (mpz_sgn (b) == 0)
+	  mpz_set_ui (b, 1);
+	do
+	  mpz_rrandomb (e, rands, EN * GMP_NUMB_BITS);
+	while (mpz_cmp_ui (e, 1) <= 0);
+
+	bn = mpz_size (b);
+	itch = MAX (mpn_binvert_itch (n), 2 * n);
+	tp[itch] = 0x5a5a5a5a;
+
+	mpn_powm (rp, mpz_limbs_read (b), bn, mpz_limbs_read (e),
+		  mpz_size (e), mpz_limbs_read (m), n, tp);
+	ref_powm (r, b, e, m);
+
+	rn = mpz_size (r);
+	if (rn > n
+	    || mpn_cmp (rp, mpz_limbs_read (r), rn) != 0
+	    || (rn < n && ! mpn_zero_p (rp + rn, n - rn))
+	    || tp[itch] != 0x5a5a5a5a)
+	  {
+	    printf ("mpn_powm failed, %s, n=%ld\n", what, (long) n);
+	    gmp_printf ("b   = %Zx\n", b);
+	    gmp_printf ("e   = %Zx\n", e);
+	    gmp_printf ("m   = %Zx\n", m);
+	    gmp_printf ("want %Zx\n", r);
+	    gmp_printf ("got  %Nx\n", rp, n);
+	    if (tp[itch] != 0x5a5a5a5a)
+	      printf ("scratch overrun\n");
+	    abort ();
+	  }
+      }
+
+  free (rp);
+  free (tp);
+  mpz_clear (b);
+  mpz_clear (e);
+  mpz_clear (m);
+  mpz_clear (r);
+}
+
+/* With runtime tuning, also put REDC_2_TO_REDC_N_THRESHOLD below
+   MUL_TOOM22_THRESHOLD, as the IFMA setup of a fat binary does, so the
+   sizes between the two, where mpn_powm must not use its basecase loop
+   with REDC_2, are tested on any cpu.  */
+static void
+check_redc_n_below_toom22 (gmp_randstate_ptr rands, int count)
+{
+#if WANT_RUNTIME_TUNING && WANT_REDC_2
+  long  r12, r2n, v;
+
+  r12 = gmp_get_tuning ("REDC_1_TO_REDC_2_THRESHOLD");
+  r2n = gmp_get_tuning ("REDC_2_TO_REDC_N_THRESHOLD");
+
+  for (v = 1; v < MUL_TOOM22_THRESHOLD - 2; v++)
+    if (gmp_set_tuning ("REDC_1_TO_REDC_2_THRESHOLD", v) == 0)
+      break;
+  for (v++; v < MUL_TOOM22_THRESHOLD - 1; v++)
+    if (gmp_set_tuning ("REDC_2_TO_REDC_N_THRESHOLD", v) == 0)
+      break;
+
+  if (REDC_2_TO_REDC_N_THRESHOLD < MUL_TOOM22_THRESHOLD)
+    check_sizes (rands, count, "REDC_2_TO_REDC_N below MUL_TOOM22");
+
+  if (gmp_set_tuning ("REDC_2_TO_REDC_N_THRESHOLD", r2n) != 0
+      || gmp_set_tuning ("REDC_1_TO_REDC_2_THRESHOLD", r12) != 0)
+    {
+      printf ("cannot restore REDC thresholds\n");
+      abort ();
+    }
+#endif
+}
+
+int
+main (int argc, char **argv)
+{
+  gmp_randstate_ptr rands;
+  int count = COUNT;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  check_sizes (rands, count, "default thresholds");
+  check_redc_n_below_toom22 (rands, count);
+
+  tests_end ();
+  return 0;
+}
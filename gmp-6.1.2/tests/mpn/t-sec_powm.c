@@ -0,0 +1,322 @@
+/* Test mpn_sec_powm, both its results and that the sequence of operations it
+   performs, with their operand addresses and sizes, does not depend on the
+   operand values.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef MAX_N
+#define MAX_N 20
+#endif
+
+#ifndef COUNT
+#define COUNT 100
+#endif
+
+/* Operand sets compared against the first one of each test.  */
+#define VARIANTS 4
+
+#define MAX_TRACE 50000
+
+/* Each traced call is recorded as its function and up to five arguments.
+   Pointers are recorded as an operand number and a limb offset into it,
+   secret values such as a condition or a table index are not recorded.  */
+struct trace_entry
+{
+  mp_size_t fn;
+  mp_size_t arg[5];
+};
+
+static struct trace_entry *trace;
+static int trace_len;
+
+#define N_REGIONS 5
+static const mp_limb_t *region_ptr[N_REGIONS];
+static mp_size_t region_size[N_REGIONS];
+
+static mp_size_t
+addr (const volatile mp_limb_t *p)
+{
+  int i;
+  for (i = 0; i < N_REGIONS; i++)
+    if (p >= region_ptr[i] && p < region_ptr[i] + region_size[i])
+      return ((mp_size_t) (i + 1) << 24) + (p - region_ptr[i]);
+  return -1;			/* such as mip, which lives on the stack */
+}
+
+static void
+record (int fn, mp_size_t a0, mp_size_t a1, mp_size_t a2, mp_size_t a3,
+	mp_size_t a4)
+{
+  if (trace_len == MAX_TRACE)
+    {
+      printf ("trace overflow\n");
+      abort ();
+    }
+  trace[trace_len].fn = fn;
+  trace[trace_len].arg[0] = a0;
+  trace[trace_len].arg[1] = a1;
+  trace[trace_len].arg[2] = a2;
+  trace[trace_len].arg[3] = a3;
+  trace[trace_len].arg[4] = a4;
+  trace_len++;
+}
+
+static void
+trace_mul_basecase (mp_ptr rp, mp_srcptr up, mp_size_t un,
+		    mp_srcptr vp, mp_size_t vn)
+{
+  record (1, addr (rp), addr (up), un, addr (vp), vn);
+  __MPN(mul_basecase) (rp, up, un, vp, vn);
+}
+
+static void
+trace_sqr_basecase (mp_ptr rp, mp_srcptr up, mp_size_t n)
+{
+  record (2, addr (rp), addr (up), n, 0, 0);
+  __MPN(sqr_basecase) (rp, up, n);
+}
+
+static mp_limb_t
+trace_redc_1 (mp_ptr rp, mp_ptr up, mp_srcptr mp, mp_size_t n, mp_limb_t invm)
+{
+  record (3, addr (rp), addr (up), addr (mp), n, 0);
+  return __MPN(redc_1) (rp, up, mp, n, invm);
+}
+
+static mp_limb_t
+trace_redc_2 (mp_ptr rp, mp_ptr up, mp_srcptr mp, mp_size_t n, mp_srcptr mip)
+{
+  record (4, addr (rp), addr (up), addr (mp), n, addr (mip));
+  return __MPN(redc_2) (rp, up, mp, n, mip);
+}
+
+static mp_limb_t
+trace_cnd_sub_n (mp_limb_t cnd, mp_ptr rp, mp_srcptr up, mp_srcptr vp,
+		 mp_size_t n)
+{
+  record (5, addr (rp), addr (up), addr (vp), n, 0);
+  return __MPN(cnd_sub_n) (cnd, rp, up, vp, n);
+}
+
+static mp_limb_t
+trace_sub_n (mp_ptr rp, mp_srcptr up, mp_srcptr vp, mp_size_t n)
+{
+  record (6, addr (rp), addr (up), addr (vp), n, 0);
+  return __MPN(sub_n) (rp, up, vp, n);
+}
+
+static void
+trace_sec_div_r (mp_ptr np, mp_size_t nn, mp_srcptr dp, mp_size_t dn,
+		 mp_ptr tp)
+{
+  record (7, addr (np), nn, addr (dp), dn, addr (tp));
+  __MPN(sec_div_r) (np, nn, dp, dn, tp);
+}
+
+static void
+trace_binvert (mp_ptr rp, mp_srcptr up, mp_size_t n, mp_ptr scratch)
+{
+  record (8, addr (rp), addr (up), n, addr (scratch), 0);
+  __MPN(binvert) (rp, up, n, scratch);
+}
+
+static void
+trace_sec_tabselect (volatile mp_limb_t *rp, volatile const mp_limb_t *tab,
+		     mp_size_t n, mp_size_t nents, mp_size_t which)
+{
+  record (9, addr (rp), addr (tab), n, nents, 0);
+  __MPN(sec_tabselect) (rp, tab, n, nents, which);
+}
+
+/* Compile our own copy of mpn_sec_powm, calling the functions above.  */
+#undef mpn_sec_powm
+#undef mpn_sec_powm_itch
+#undef mpn_mul_basecase
+#undef mpn_sqr_basecase
+#undef mpn_redc_1
+#undef mpn_redc_2
+#undef mpn_cnd_sub_n
+#undef mpn_sub_n
+#undef mpn_sec_div_r
+#undef mpn_binvert
+#define mpn_sec_powm		traced_sec_powm
+#define mpn_sec_powm_itch	traced_sec_powm_itch
+#define mpn_mul_basecase	trace_mul_basecase
+#define mpn_sqr_basecase	trace_sqr_basecase
+#define mpn_redc_1		trace_redc_1
+#define mpn_redc_2		trace_redc_2
+#define mpn_cnd_sub_n		trace_cnd_sub_n
+#define mpn_sub_n		trace_sub_n
+#define mpn_sec_div_r		trace_sec_div_r
+#define mpn_binvert		trace_binvert
+#undef mpn_sec_tabselect
+#define mpn_sec_tabselect	trace_sec_tabselect
+
+#include "mpn/generic/sec_powm.c"
+
+static void
+set_operands (mp_ptr bp, mp_size_t bn, mp_ptr ep, mp_bitcnt_t enb,
+	      mp_ptr mp, mp_size_t n, int variant, gmp_randstate_ptr rands)
+{
+  mp_size_t en = BITS_TO_LIMBS (enb);
+
+  switch (variant)
+    {
+    case 1:
+      /* All ones for the greatest intermediate values.  */
+      MPN_FILL (bp, bn, GMP_NUMB_MAX);
+      MPN_FILL (ep, en, GMP_NUMB_MAX);
+      MPN_FILL (mp, n, GMP_NUMB_MAX);
+      break;
+    case 2:
+      /* A zero base and exponent.  */
+      MPN_ZERO (bp, bn);
+      MPN_ZERO (ep, en);
+      mpn_random2 (mp, n);
+      break;
+    default:
+      mpn_random2 (bp, bn);
+      mpn_random2 (ep, en);
+      mpn_random2 (mp, n);
+      if (gmp_urandomb_ui (rands, 1))
+	{
+	  /* Single bit exponent, the same table entry most of the time.  */
+	  MPN_ZERO (ep, en);
+	  ep[0] = 1;
+	}
+    }
+  if (enb % GMP_NUMB_BITS != 0)
+    ep[en - 1] &= (CNST_LIMB(1) << enb % GMP_NUMB_BITS) - 1;
+  mp[0] |= 1;
+  if (mp[n - 1] == 0)
+    mp[n - 1] = 1;
+}
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr bp, ep, mp, rp, tp;
+  mp_size_t n, bn, en, itch;
+  mp_bitcnt_t enb;
+  mp_limb_t t_before, t_after;
+  mpz_t b, e, m, r, ref;
+  struct trace_entry *trace0;
+  int trace0_len = 0;
+  int count = COUNT;
+  int test, variant;
+  gmp_randstate_ptr rands;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  trace0 = (struct trace_entry *) malloc (MAX_TRACE * sizeof (*trace));
+  trace = (struct trace_entry *) malloc (MAX_TRACE * sizeof (*trace));
+  mpz_init (ref);
+
+  for (test = 0; test < count; test++)
+    {
+      TMP_MARK;
+
+      n = 1 + gmp_urandomm_ui (rands, MAX_N);
+      bn = 1 + gmp_urandomm_ui (rands, 2 * n);
+      enb = 1 + gmp_urandomm_ui (rands, n * GMP_NUMB_BITS + 100);
+      en = BITS_TO_LIMBS (enb);
+
+      bp = TMP_ALLOC_LIMBS (bn);
+      ep = TMP_ALLOC_LIMBS (en);
+      mp = TMP_ALLOC_LIMBS (n);
+      rp = TMP_ALLOC_LIMBS (n);
+      itch = traced_sec_powm_itch (bn, enb, n);
+      if (itch != __MPN(sec_powm_itch) (bn, enb, n))
+	{
+	  printf ("ERROR in test %d, itch mismatch\n", test);
+	  abort ();
+	}
+      tp = 1 + TMP_ALLOC_LIMBS (itch + 2);
+
+      region_ptr[0] = rp; region_size[0] = n;
+      region_ptr[1] = bp; region_size[1] = bn;
+      region_ptr[2] = ep; region_size[2] = en;
+      region_ptr[3] = mp; region_size[3] = n;
+      region_ptr[4] = tp; region_size[4] = itch;
+
+      for (variant = 0; variant <= VARIANTS; variant++)
+	{
+	  set_operands (bp, bn, ep, enb, mp, n, variant, rands);
+
+	  mpn_random (tp - 1, itch + 2);
+	  t_before = tp[-1];
+	  t_after = tp[itch];
+
+	  trace_len = 0;
+	  traced_sec_powm (rp, bp, bn, ep, enb, mp, n, tp);
+
+	  if (tp[-1] != t_before || tp[itch] != t_after)
+	    {
+	      printf ("ERROR in test %d, scratch overwritten\n", test);
+	      abort ();
+	    }
+
+	  mpz_roinit_n (b, bp, bn);
+	  mpz_roinit_n (e, ep, en);
+	  mpz_roinit_n (m, mp, n);
+	  mpz_roinit_n (r, rp, n);
+	  mpz_powm (ref, b, e, m);
+	  if (mpz_cmp (r, ref) != 0)
+	    {
+	      printf ("ERROR in test %d, n = %d, bn = %d, enb = %lu\n",
+		      test, (int) n, (int) bn, (unsigned long) enb);
+	      gmp_printf ("b   = %Zx\ne   = %Zx\nm   = %Zx\n", b, e, m);
+	      gmp_printf ("r   = %Zx\nref = %Zx\n", r, ref);
+	      abort ();
+	    }
+
+	  if (variant == 0)
+	    {
+	      memcpy (trace0, trace, trace_len * sizeof (*trace));
+	      trace0_len = trace_len;
+	    }
+	  else if (trace_len != trace0_len
+		   || memcmp (trace0, trace, trace_len * sizeof (*trace)) != 0)
+	    {
+	      printf ("ERROR in test %d, n = %d, bn = %d, enb = %lu\n",
+		      test, (int) n, (int) bn, (unsigned long) enb);
+	      printf ("operation sequence depends on operand values\n");
+	      abort ();
+	    }
+	}
+      TMP_FREE;
+    }
+
+  free (trace0);
+  free (trace);
+  mpz_clear (ref);
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* Test mpn_sec_powm_multi.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#ifndef MAX_N
+#define MAX_N 40
+#endif
+
+/* Enough for three full groups and a partial one.  */
+#define MAX_K (3 * SEC_POWM_LANES + 3)
+
+#ifndef COUNT
+#define COUNT 200
+#endif
+
+int
+main (int argc, char **argv)
+{
+  mp_ptr bp, ep, mp, rp, tp;
+  mp_size_t n, bn, en, itch, i;
+  mp_bitcnt_t enb;
+  mp_limb_t t_before, t_after;
+  mpz_t b, e, m, r, ref;
+  int count = COUNT;
+  int test, k, j;
+  gmp_randstate_ptr rands;
+  TMP_DECL;
+
+  tests_start ();
+  TESTS_REPS (count, argv, argc);
+  rands = RANDS;
+
+  mpz_init (ref);
+
+  for (test = 0; test < count; test++)
+    {
+      TMP_MARK;
+
+      n = 1 + gmp_urandomm_ui (rands, MAX_N);
+      bn = 1 + gmp_urandomm_ui (rands, 2 * n);
+      enb = 1 + gmp_urandomm_ui (rands, n * GMP_NUMB_BITS + 100);
+      en = BITS_TO_LIMBS (enb);
+      k = gmp_urandomm_ui (rands, MAX_K + 1);
+
+      bp = TMP_ALLOC_LIMBS (MAX_K * bn);
+      ep = TMP_ALLOC_LIMBS (MAX_K * en);
+      mp = TMP_ALLOC_LIMBS (MAX_K * n);
+      rp = TMP_ALLOC_LIMBS (MAX_K * n);
+      itch = mpn_sec_powm_multi_itch (bn, enb, n);
+      tp = 1 + TMP_ALLOC_LIMBS (itch + 2);
+
+      for (j = 0; j < k; j++)
+	{
+	  if ((test & 15) == 1)
+	    {
+	      /* All ones for the greatest intermediate values.  */
+	      MPN_FILL (bp + j * bn, bn, GMP_NUMB_MAX);
+	      MPN_FILL (mp + j * n, n, GMP_NUMB_MAX);
+	      MPN_FILL (ep + j * en, en, GMP_NUMB_MAX);
+	    }
+	  else
+	    {
+	      mpn_random2 (bp + j * bn, bn);
+	      mpn_random2 (mp + j * n, n);
+	      mpn_random2 (ep + j * en, en);
+	    }
+	  if (enb % GMP_NUMB_BITS != 0)
+	    ep[j * en + en - 1] &= (CNST_LIMB(1) << enb % GMP_NUMB_BITS) - 1;
+	  mp[j * n] |= 1;
+	  if (mp[j * n + n - 1] == 0)
+	    mp[j * n + n - 1] = 1;
+	  if ((test & 15) == 2 && bn >= n)
+	    {
+	      /* A base that's a multiple of the modulus.  */
+	      MPN_ZERO (bp + j * bn, bn);
+	      MPN_COPY (bp + j * bn, mp + j * n, n);
+	    }
+	}
+
+      mpn_random (tp - 1, itch + 2);
+      t_before = tp[-1];
+      t_after = tp[itch];
+
+      mpn_sec_powm_multi (rp, bp, bn, ep, enb, mp, n, k, tp);
+
+      if (tp[-1] != t_before || tp[itch] != t_after)
+	{
+	  printf ("ERROR in test %d, scratch overwritten\n", test);
+	  abort ();
+	}
+
+      for (j = 0; j < k; j++)
+	{
+	  mpz_roinit_n (b, bp + j * bn, bn);
+	  mpz_roinit_n (e, ep + j * en, en);
+	  mpz_roinit_n (m, mp + j * n, n);
+	  mpz_roinit_n (r, rp + j * n, n);
+	  mpz_powm (ref, b, e, m);
+	  if (mpz_cmp (r, ref) != 0)
+	    {
+	      printf ("ERROR in test %d, tuple %d of %d, n = %d, bn = %d, enb = %lu\n",
+		      test, j, k, (int) n, (int) bn, (unsigned long) enb);
+	      gmp_printf ("b   = %Zx\ne   = %Zx\nm   = %Zx\n", b, e, m);
+	      gmp_printf ("r   = %Zx\nref = %Zx\n", r, ref);
+	      abort ();
+	    }
+	}
+      TMP_FREE;
+    }
+
+  mpz_clear (ref);
+  tests_end ();
+  return 0;
+}
@@ -0,0 +1,255 @@
+/* Test mpz_get_str_ctx, mpz_set_str_ctx and mpz_out_str_func.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one on another shows
+   up.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+/* Collect mpz_out_str_func output.  */
+struct collect
+{
+  char *str;
+  size_t len;
+  size_t alloc;
+  size_t calls;
+};
+
+static void
+collect_func (void *data, const char *str, size_t len)
+{
+  struct collect *c = (struct collect *) data;
+  if (c->len + len + 1 > c->alloc)
+    {
+      size_t alloc = 2 * (c->len + len + 1);
+      c->str = (char *) (*__gmp_reallocate_func) (c->str, c->alloc, alloc);
+      c->alloc = alloc;
+    }
+  memcpy (c->str + c->len, str, len);
+  c->len += len;
+  c->str[c->len] = 0;
+  c->calls++;
+}
+
+static void
+check_one (mpz_srcptr x, mpz_basectx_ptr ctx, int base)
+{
+  struct collect c;
+  char *ref, *str;
+  size_t ret;
+  mpz_t y;
+
+  ref = mpz_get_str (NULL, base, x);
+
+  str = mpz_get_str_ctx (NULL, x, ctx);
+  if (strcmp (str, ref) != 0)
+    {
+      printf ("mpz_get_str_ctx wrong, base %d\n", base);
+      mpz_trace ("x", x);
+      printf ("  got  %s\n  want %s\n", str, ref);
+      abort ();
+    }
+  (*__gmp_free_func) (str, strlen (str) + 1);
+
+  mpz_init (y);
+  if (mpz_set_str_ctx (y, ref, ctx) != 0 || mpz_cmp (y, x) != 0)
+    {
+      printf ("mpz_set_str_ctx wrong, base %d\n", base);
+      mpz_trace ("x", x);
+      mpz_trace ("y", y);
+      abort ();
+    }
+  mpz_clear (y);
+
+  c.alloc = 1;
+  c.str = (char *) (*__gmp_allocate_func) (c.alloc);
+  c.str[0] = 0;
+  c.len = 0;
+  c.calls = 0;
+  ret = mpz_out_str_func (collect_func, &c, base, x);
+  if (ret != c.len || strcmp (c.str, ref) != 0)
+    {
+      printf ("mpz_out_str_func wrong, base %d\n", base);
+      mpz_trace ("x", x);
+      printf ("  got  %s (return %lu)\n  want %s\n",
+	      c.str, (unsigned long) ret, ref);
+      abort ();
+    }
+  (*__gmp_free_func) (c.str, c.alloc);
+  (*__gmp_free_func) (ref, strlen (ref) + 1);
+}
+
+static const int bases[] = { 10, 3, 7, 16, -36, 62, 100 };
+
+/* Random sizes, in random order, so each context's table is reused both
+   for sizes it already covers and for bigger ones.  */
+static void
+check_random (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_basectx_t ctx[numberof (bases) - 1];
+  mpz_t x, bs;
+  int i, j;
+
+  mpz_init (x);
+  mpz_init (bs);
+  for (j = 0; j < numberof (ctx); j++)
+    mpz_basectx_init (ctx[j], bases[j]);
+
+  /* An invalid base in the last entry, for mpz_out_str_func.  */
+  mpz_set_ui (x, 123);
+  if (mpz_out_str_func (collect_func, NULL, bases[numberof (bases) - 1], x) != 0)
+    {
+      printf ("mpz_out_str_func accepted base %d\n", bases[numberof (bases) - 1]);
+      abort ();
+    }
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      mpz_urandomb (bs, rands, mpz_get_ui (bs) % 14 + 1);	/* 0..16383 bits */
+      mpz_rrandomb (x, rands, mpz_get_ui (bs));
+      if ((i & 1) != 0)
+	mpz_neg (x, x);
+
+      j = i % numberof (ctx);
+      check_one (x, ctx[j], bases[j]);
+    }
+
+  for (j = 0; j < numberof (ctx); j++)
+    mpz_basectx_clear (ctx[j]);
+  mpz_clear (bs);
+  mpz_clear (x);
+}
+
+/* Numbers big enough for the parallel get_str and set_str, converted with
+   the tasks run in reverse.  */
+static void
+check_parallel (void)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_basectx_t ctx;
+  mpz_t x;
+  int i;
+
+  mpz_init (x);
+  mpz_basectx_init (ctx, 10);
+  mp_set_parallel_function (reverse_parallel, 4);
+
+  for (i = 0; i < 3; i++)
+    {
+      mpz_urandomb (x, rands, (mp_bitcnt_t) (5000 + 1000 * i) * GMP_NUMB_BITS);
+      if (i == 1)
+	mpz_setbit (x, (mp_bitcnt_t) (7000 + 100) * GMP_NUMB_BITS);
+      task_calls = 0;
+      check_one (x, ctx, 10);
+      if (task_calls == 0)
+	{
+	  printf ("parallel function not used\n");
+	  abort ();
+	}
+    }
+
+  mp_set_parallel_function (NULL, 0);
+  mpz_basectx_clear (ctx);
+  mpz_clear (x);
+}
+
+/* A context from mpz_basectx_init2 must come through conversions of
+   numbers up to its size unchanged.  */
+static void
+check_init2 (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_basectx_t ctx;
+  mpz_t x, bs;
+  void *tab;
+  size_t digits;
+  int levels, i, j;
+
+  mpz_init (x);
+  mpz_init (bs);
+
+  for (j = 0; j < numberof (bases) - 1; j++)
+    {
+      mpz_set_ui (x, 1);
+      mpz_mul_2exp (x, x, 16384);
+      digits = mpz_sizeinbase (x, ABS (bases[j]));
+      mpz_basectx_init2 (ctx, bases[j], digits);
+      tab = ctx->_mp_tab;
+      levels = ctx->_mp_levels;
+
+      for (i = 0; i < reps / 4; i++)
+	{
+	  mpz_urandomb (bs, rands, 32);
+	  mpz_urandomb (bs, rands, mpz_get_ui (bs) % 14 + 1);	/* 0..16383 bits */
+	  mpz_rrandomb (x, rands, mpz_get_ui (bs));
+	  check_one (x, ctx, bases[j]);
+	}
+      /* the biggest number of that many digits */
+      mpz_ui_pow_ui (x, ABS (bases[j]), digits);
+      mpz_sub_ui (x, x, 1);
+      check_one (x, ctx, bases[j]);
+
+      if (ctx->_mp_tab != tab || ctx->_mp_levels != levels)
+	{
+	  printf ("mpz_basectx_init2 context changed, base %d\n", bases[j]);
+	  printf ("  levels %d, now %d\n", levels, ctx->_mp_levels);
+	  abort ();
+	}
+      mpz_basectx_clear (ctx);
+    }
+
+  mpz_clear (bs);
+  mpz_clear (x);
+}
+
+int
+main (int argc, char **argv)
+{
+  int reps = 200;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_random (reps);
+  check_init2 (reps);
+  check_parallel ();
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,189 @@
+/* Test mpz_batch_gcd.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one on another shows
+   up.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+#define MAXN  100
+
+/* Check mpz_batch_gcd on {n,count}, against a gcd with the product of the
+   others formed directly.  With IN_PLACE the results overwrite N.  */
+static void
+check_one (mpz_t *n, size_t count, int in_place)
+{
+  mpz_ptr gp[MAXN];
+  mpz_srcptr np[MAXN];
+  mpz_t g[MAXN], want, p;
+  size_t i, j;
+
+  mpz_init (want);
+  mpz_init (p);
+  for (i = 0; i < count; i++)
+    {
+      mpz_init (g[i]);
+      mpz_set (g[i], n[i]);
+      gp[i] = g[i];
+      np[i] = in_place ? g[i] : n[i];
+    }
+
+  mpz_batch_gcd (gp, np, count);
+
+  for (i = 0; i < count; i++)
+    {
+      mpz_set_ui (p, 1);
+      for (j = 0; j < count; j++)
+	if (j != i)
+	  mpz_mul (p, p, n[j]);
+      mpz_gcd (want, n[i], p);
+
+      MPZ_CHECK_FORMAT (g[i]);
+      if (mpz_cmp (g[i], want) != 0)
+	{
+	  printf ("mpz_batch_gcd wrong, count = %lu, i = %lu%s\n",
+		  (unsigned long) count, (unsigned long) i,
+		  in_place ? ", in place" : "");
+	  for (j = 0; j < count; j++)
+	    {
+	      printf ("  n[%lu] = ", (unsigned long) j);
+	      mpz_out_str (stdout, 16, n[j]);
+	      printf ("\n");
+	    }
+	  mpz_trace ("got ", g[i]);
+	  mpz_trace ("want", want);
+	  abort ();
+	}
+    }
+
+  for (i = 0; i < count; i++)
+    mpz_clear (g[i]);
+  mpz_clear (want);
+  mpz_clear (p);
+}
+
+/* Products of pairs from a pool of random factors, like moduli with some
+   primes shared, and sometimes a negative or repeated value.  */
+static void
+random_list (mpz_t *n, size_t count, size_t pool, mp_bitcnt_t bits,
+	     gmp_randstate_ptr rands)
+{
+  mpz_t f[2 * MAXN];
+  size_t i;
+
+  for (i = 0; i < pool; i++)
+    {
+      mpz_init (f[i]);
+      mpz_rrandomb (f[i], rands, bits);
+      mpz_setbit (f[i], 0);
+    }
+  for (i = 0; i < count; i++)
+    {
+      mpz_mul (n[i], f[gmp_urandomm_ui (rands, pool)],
+	       f[gmp_urandomm_ui (rands, pool)]);
+      if (gmp_urandomb_ui (rands, 4) == 0)
+	mpz_neg (n[i], n[i]);
+      if (i > 0 && gmp_urandomb_ui (rands, 5) == 0)
+	mpz_set (n[i], n[i - 1]);
+    }
+  for (i = 0; i < pool; i++)
+    mpz_clear (f[i]);
+}
+
+static void
+check_random (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t n[MAXN];
+  size_t count, i;
+  int rep;
+
+  for (i = 0; i < MAXN; i++)
+    mpz_init (n[i]);
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      count = gmp_urandomm_ui (rands, 40);
+      random_list (n, count, 2 * count + 1,
+		   gmp_urandomm_ui (rands, 300) + 2, rands);
+      check_one (n, count, rep & 1);
+    }
+
+  for (i = 0; i < MAXN; i++)
+    mpz_clear (n[i]);
+}
+
+/* Enough limbs for the parallel product and remainder trees, run with the
+   tasks in reverse.  */
+static void
+check_parallel (void)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t n[MAXN];
+  size_t i;
+
+  for (i = 0; i < MAXN; i++)
+    mpz_init (n[i]);
+
+  mp_set_parallel_function (reverse_parallel, 4);
+  task_calls = 0;
+  random_list (n, MAXN, 150, 2000, rands);
+  check_one (n, MAXN, 0);
+  if (task_calls == 0)
+    {
+      printf ("parallel function not used\n");
+      abort ();
+    }
+  mp_set_parallel_function (NULL, 0);
+
+  for (i = 0; i < MAXN; i++)
+    mpz_clear (n[i]);
+}
+
+int
+main (int argc, char **argv)
+{
+  int reps = 100;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_random (reps);
+  check_parallel ();
+
+  tests_end ();
+  exit (0);
+}
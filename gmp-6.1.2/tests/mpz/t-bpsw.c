@@ -0,0 +1,202 @@
+/* Test mpz_bpsw_p.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int
+isprime (unsigned long int t)
+{
+  unsigned long int q, r, d;
+
+  if (t < 3 || (t & 1) == 0)
+    return t == 2;
+
+  for (d = 3, r = 1; r != 0; d += 2)
+    {
+      q = t / d;
+      r = t - q * d;
+      if (q < d)
+	return 1;
+    }
+  return 0;
+}
+
+static void
+check_one (mpz_srcptr n, int want)
+{
+  int got;
+
+  got = mpz_bpsw_p (n);
+  if (got != want)
+    {
+      gmp_printf ("mpz_bpsw_p wrong on %Zd\n", n);
+      printf ("  got  %d\n", got);
+      printf ("  want %d\n", want);
+      abort ();
+    }
+
+  /* Same for -n.  */
+  mpz_neg ((mpz_ptr) n, n);
+  got = mpz_bpsw_p (n);
+  mpz_neg ((mpz_ptr) n, n);
+  if (got != want)
+    {
+      gmp_printf ("mpz_bpsw_p wrong on -%Zd\n", n);
+      printf ("  got  %d\n", got);
+      printf ("  want %d\n", want);
+      abort ();
+    }
+}
+
+/* All numbers up to a limit, against trial division.  */
+void
+check_small (void)
+{
+  mpz_t n;
+  unsigned long i;
+
+  mpz_init (n);
+  for (i = 0; i < 30000; i++)
+    {
+      mpz_set_ui (n, i);
+      check_one (n, isprime (i) ? 2 : 0);
+    }
+  mpz_clear (n);
+}
+
+/* Composites which pass one of the two halves of the test.  */
+void
+check_pseudoprimes (void)
+{
+  static const char * const data[] = {
+    /* strong pseudoprimes to base 2 */
+    "2047", "3277", "4033", "4681", "8321", "15841", "29341", "42799",
+    "3215031751", "1194649",
+    /* strong Lucas pseudoprimes */
+    "5459", "5777", "10877", "16109", "18971", "22499", "24569", "25199",
+    "40309", "58519", "75077", "97439",
+    /* Carmichael numbers */
+    "561", "1105", "1729", "2465", "2821", "6601", "8911",
+    /* squares of primes */
+    "25", "49", "1018081", "18446744030759878681",
+    "340282366920938463463374607431768211457",	/* 2^128+1 */
+  };
+  mpz_t n;
+  int i;
+
+  mpz_init (n);
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpz_set_str_or_abort (n, data[i], 0);
+      check_one (n, 0);
+    }
+  mpz_clear (n);
+}
+
+void
+check_primes (void)
+{
+  static const struct {
+    const char *n;
+    int want;
+  } data[] = {
+    { "4294967291", 2 },
+    { "18446744073709551557", 2 },	/* 2^64-59 */
+    { "18446744073709551629", 1 },	/* 2^64+13 */
+    { "170141183460469231731687303715884105727", 1 },	/* 2^127-1 */
+    { "2305843009213693951", 2 },	/* 2^61-1 */
+  };
+  mpz_t n;
+  int i;
+
+  mpz_init (n);
+  for (i = 0; i < numberof (data); i++)
+    {
+      mpz_set_str_or_abort (n, data[i].n, 0);
+      check_one (n, data[i].want);
+    }
+  mpz_clear (n);
+}
+
+/* Random numbers, against Miller-Rabin, and products of two primes.  */
+void
+check_rand (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t bs, n, p, q;
+  unsigned long size_range;
+  int i, want;
+
+  mpz_init (bs);
+  mpz_init (n);
+  mpz_init (p);
+  mpz_init (q);
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      size_range = mpz_get_ui (bs) % 9 + 2;	/* 0..1024 bit operands */
+
+      mpz_urandomb (bs, rands, size_range);
+      mpz_rrandomb (n, rands, mpz_get_ui (bs) + 1);
+      mpz_setbit (n, 0);
+
+      want = mpz_probab_prime_p (n, 20);
+      if (want != 0)
+	want = mpz_sizeinbase (n, 2) <= 64 ? 2 : 1;
+      check_one (n, want);
+
+      /* The next prime, and its product with another.  */
+      mpz_nextprime (p, n);
+      check_one (p, mpz_sizeinbase (p, 2) <= 64 ? 2 : 1);
+
+      mpz_urandomb (bs, rands, size_range);
+      mpz_urandomb (q, rands, mpz_get_ui (bs) + 2);
+      mpz_nextprime (q, q);
+      mpz_mul (n, p, q);
+      check_one (n, 0);
+    }
+
+  mpz_clear (bs);
+  mpz_clear (n);
+  mpz_clear (p);
+  mpz_clear (q);
+}
+
+int
+main (int argc, char **argv)
+{
+  int reps = 100;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_small ();
+  check_pseudoprimes ();
+  check_primes ();
+  check_rand (reps);
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,296 @@
+/* Test mpz_crtctx_init, mpz_multi_mod and mpz_crt.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one on another shows
+   up.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+#define MAXN  300
+
+static void
+dump_moduli (mpz_t *m, size_t count)
+{
+  size_t i;
+  for (i = 0; i < count; i++)
+    {
+      printf ("  m[%lu] = ", (unsigned long) i);
+      mpz_out_str (stdout, 16, m[i]);
+      printf ("\n");
+    }
+}
+
+/* Check the context for {m,count}, which is coprime or not as COPRIME
+   says, with A to reduce and {r,count} residues to combine.  */
+static void
+check_one (mpz_t *m, size_t count, int coprime, mpz_srcptr a, mpz_t *r)
+{
+  mpz_crtctx_t c;
+  mpz_srcptr mp[MAXN], rp[MAXN];
+  mpz_ptr gp[MAXN];
+  mpz_t g[MAXN], want, x, prod;
+  size_t i;
+  int got;
+
+  for (i = 0; i < count; i++)
+    {
+      mp[i] = m[i];
+      rp[i] = r[i];
+      mpz_init (g[i]);
+      gp[i] = g[i];
+    }
+  mpz_init (want);
+  mpz_init (x);
+  mpz_init_set_ui (prod, 1);
+  for (i = 0; i < count; i++)
+    mpz_mul (prod, prod, m[i]);
+  mpz_abs (prod, prod);
+
+  got = mpz_crtctx_init (c, mp, count);
+  if (got != coprime)
+    {
+      printf ("mpz_crtctx_init returned %d, want %d\n", got, coprime);
+      dump_moduli (m, count);
+      abort ();
+    }
+  if (mpz_cmp (mpz_crtctx_product (c), prod) != 0)
+    {
+      printf ("mpz_crtctx_product wrong\n");
+      dump_moduli (m, count);
+      abort ();
+    }
+
+  mpz_multi_mod (gp, a, c);
+  for (i = 0; i < count; i++)
+    {
+      mpz_mod (want, a, m[i]);
+      MPZ_CHECK_FORMAT (g[i]);
+      if (mpz_cmp (g[i], want) != 0)
+	{
+	  printf ("mpz_multi_mod wrong, count = %lu, i = %lu\n",
+		  (unsigned long) count, (unsigned long) i);
+	  dump_moduli (m, count);
+	  mpz_trace ("a   ", a);
+	  mpz_trace ("got ", g[i]);
+	  mpz_trace ("want", want);
+	  abort ();
+	}
+    }
+
+  if (coprime)
+    {
+      /* Back to A mod M.  */
+      mpz_crt (x, (mpz_srcptr *) gp, c);
+      mpz_fdiv_r (want, a, prod);
+      MPZ_CHECK_FORMAT (x);
+      if (mpz_cmp (x, want) != 0)
+	{
+	  printf ("mpz_crt of mpz_multi_mod wrong, count = %lu\n",
+		  (unsigned long) count);
+	  dump_moduli (m, count);
+	  mpz_trace ("a   ", a);
+	  mpz_trace ("got ", x);
+	  mpz_trace ("want", want);
+	  abort ();
+	}
+
+      /* Unreduced residues, with the result in place of one of them.  */
+      mpz_set (g[0], r[0]);
+      rp[0] = g[0];
+      mpz_crt (g[0], rp, c);
+      for (i = 0; i < count; i++)
+	if (mpz_sgn (g[0]) < 0 || mpz_cmp (g[0], prod) >= 0
+	    || ! mpz_congruent_p (g[0], r[i], m[i]))
+	  {
+	    printf ("mpz_crt wrong, count = %lu, i = %lu\n",
+		    (unsigned long) count, (unsigned long) i);
+	    dump_moduli (m, count);
+	    mpz_trace ("r[i]", r[i]);
+	    mpz_trace ("got ", g[0]);
+	    abort ();
+	  }
+    }
+
+  /* The input in place of one of the outputs.  */
+  mpz_set (g[count - 1], a);
+  mpz_multi_mod (gp, g[count - 1], c);
+  mpz_mod (want, a, m[count - 1]);
+  if (mpz_cmp (g[count - 1], want) != 0)
+    {
+      printf ("mpz_multi_mod in place wrong, count = %lu\n",
+	      (unsigned long) count);
+      abort ();
+    }
+
+  mpz_crtctx_clear (c);
+  for (i = 0; i < count; i++)
+    mpz_clear (g[i]);
+  mpz_clear (want);
+  mpz_clear (x);
+  mpz_clear (prod);
+}
+
+/* COUNT moduli of up to BITS bits, pairwise coprime if COPRIME, as
+   distinct primes or 1, else with some factor shared.  */
+static void
+random_moduli (mpz_t *m, size_t count, mp_bitcnt_t bits, int coprime,
+	       gmp_randstate_ptr rands)
+{
+  size_t i, j;
+
+  for (i = 0; i < count; i++)
+    {
+      mpz_rrandomb (m[i], rands, bits);
+      if (gmp_urandomb_ui (rands, 5) == 0)
+	mpz_set_ui (m[i], 1);
+      else
+	do
+	  {
+	    mpz_nextprime (m[i], m[i]);
+	    for (j = 0; j < i; j++)
+	      if (mpz_cmpabs (m[i], m[j]) == 0)
+		break;
+	  }
+	while (j < i);
+      if (gmp_urandomb_ui (rands, 3) == 0)
+	mpz_neg (m[i], m[i]);
+    }
+  if (! coprime)
+    {
+      i = gmp_urandomm_ui (rands, count);
+      j = (i + 1 + gmp_urandomm_ui (rands, count - 1)) % count;
+      mpz_set_ui (m[i], 3);
+      mpz_set_ui (m[j], 6);
+    }
+}
+
+static void
+check_random (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t m[MAXN], r[MAXN], a;
+  size_t count, i;
+  mp_bitcnt_t bits;
+  int rep, coprime;
+
+  for (i = 0; i < MAXN; i++)
+    {
+      mpz_init (m[i]);
+      mpz_init (r[i]);
+    }
+  mpz_init (a);
+
+  for (rep = 0; rep < reps; rep++)
+    {
+      count = gmp_urandomm_ui (rands, 30) + 1;
+      bits = gmp_urandomm_ui (rands, 200) + 2;
+      coprime = count == 1 || rep % 4 != 0;
+      random_moduli (m, count, bits, coprime, rands);
+      for (i = 0; i < count; i++)
+	mpz_rrandomb (r[i], rands, bits + 10);
+      mpz_rrandomb (a, rands, count * bits + gmp_urandomm_ui (rands, 500));
+      if (rep & 1)
+	mpz_neg (a, a);
+      check_one (m, count, coprime, a, r);
+    }
+
+  for (i = 0; i < MAXN; i++)
+    {
+      mpz_clear (m[i]);
+      mpz_clear (r[i]);
+    }
+  mpz_clear (a);
+}
+
+/* Enough moduli for the parallel trees, run with the tasks in reverse.  */
+static void
+check_parallel (void)
+{
+  gmp_randstate_ptr rands = RANDS;
+  mpz_t m[MAXN], r[MAXN], a;
+  size_t i;
+
+  for (i = 0; i < MAXN; i++)
+    {
+      mpz_init (m[i]);
+      mpz_init (r[i]);
+    }
+  mpz_init (a);
+
+  /* 2^k-1 for distinct primes k, which are pairwise coprime since
+     gcd(2^j-1,2^k-1) = 2^gcd(j,k)-1, and much quicker than big primes.  */
+  mpz_set_ui (a, 300);
+  for (i = 0; i < MAXN; i++)
+    {
+      mpz_nextprime (a, a);
+      mpz_setbit (m[i], mpz_get_ui (a));
+      mpz_sub_ui (m[i], m[i], 1);
+      mpz_urandomb (r[i], rands, mpz_get_ui (a) + 10);
+    }
+  mpz_urandomb (a, rands, 800000);
+
+  mp_set_parallel_function (reverse_parallel, 4);
+  task_calls = 0;
+  check_one (m, MAXN, 1, a, r);
+  if (task_calls == 0)
+    {
+      printf ("parallel function not used\n");
+      abort ();
+    }
+  mp_set_parallel_function (NULL, 0);
+
+  for (i = 0; i < MAXN; i++)
+    {
+      mpz_clear (m[i]);
+      mpz_clear (r[i]);
+    }
+  mpz_clear (a);
+}
+
+int
+main (int argc, char **argv)
+{
+  int reps = 100;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_random (reps);
+  check_parallel ();
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,212 @@
+/* Test mpz_powm_fixed_base and the mpz_fixedbase_t functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#if HAVE_UNISTD_H
+#include <unistd.h>		/* for unlink */
+#endif
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define SIZEM 10
+#define FILENAME  "t-fixedbase.tmp"
+
+static void
+check_one (int i, mpz_srcptr want, mpz_srcptr got, mpz_srcptr base,
+	   mpz_srcptr exp, mpz_srcptr mod, int teeth, unsigned long blocks)
+{
+  MPZ_CHECK_FORMAT (got);
+  if (mpz_cmp (want, got) != 0)
+    {
+      fprintf (stderr, "ERROR in test %d, teeth %d, blocks %lu\n",
+	       i, teeth, blocks);
+      gmp_fprintf (stderr, "base = %Zx\n", base);
+      gmp_fprintf (stderr, "exp  = %Zx\n", exp);
+      gmp_fprintf (stderr, "mod  = %Zx\n", mod);
+      gmp_fprintf (stderr, "want = %Zx\n", want);
+      gmp_fprintf (stderr, "got  = %Zx\n", got);
+      abort ();
+    }
+}
+
+/* Headers asking for a huge table, followed by a modulus, a base and just
+   one entry, must be rejected without allocating that table.  */
+static void
+check_bad_header (void)
+{
+  static const unsigned long shapes[][3] = {
+    /* teeth, spacing, width */
+    { 16, 0xFFFFFFFFUL, 1 },
+    { 16, 0xFFFFFFFFUL, 0xFFFFFFFFUL },
+    { 1, 0x80000000UL, 3 },
+  };
+  unsigned char header[16];
+  unsigned long w[4];
+  mpz_fixedbase_t fb;
+  mpz_t m, g;
+  FILE *fp;
+  int i, k, b;
+
+  mpz_init_set_ui (m, 1000003);
+  mpz_init_set_ui (g, 2);
+
+  for (i = 0; i < numberof (shapes); i++)
+    {
+      w[0] = GMP_NUMB_BITS;
+      w[1] = shapes[i][0];
+      w[2] = shapes[i][1];
+      w[3] = shapes[i][2];
+      for (k = 0; k < 4; k++)
+	for (b = 0; b < 4; b++)
+	  header[4 * k + b] = (w[k] >> (8 * (3 - b))) & 0xff;
+
+      fp = fopen (FILENAME, "w+");
+      if (fp == NULL)
+	{
+	  perror ("fopen " FILENAME);
+	  abort ();
+	}
+      fwrite (header, sizeof (header), 1, fp);
+      mpz_out_raw (fp, m);
+      mpz_out_raw (fp, g);
+      mpz_out_raw (fp, g);
+      rewind (fp);
+      if (mpz_fixedbase_inp_raw (fb, fp) != 0)
+	{
+	  fprintf (stderr, "ERROR, accepted teeth %lu spacing %lu width %lu\n",
+		   w[1], w[2], w[3]);
+	  abort ();
+	}
+      fclose (fp);
+      unlink (FILENAME);
+    }
+
+  mpz_clear (m);
+  mpz_clear (g);
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_t mod, base, exp, r, ref, bs;
+  mpz_fixedbase_t fb, fb2;
+  unsigned long size_range, ebits, blocks;
+  size_t wsize, rsize;
+  int i, j, teeth;
+  int reps = 200;
+  FILE *fp;
+  gmp_randstate_ptr rands;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  rands = RANDS;
+
+  mpz_inits (mod, base, exp, r, ref, bs, NULL);
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      size_range = mpz_get_ui (bs) % SIZEM + 2;
+
+      do
+	{
+	  mpz_urandomb (bs, rands, size_range);
+	  mpz_rrandomb (mod, rands, mpz_get_ui (bs) + 1);
+	}
+      while (mpz_sgn (mod) == 0);
+      if ((i & 3) != 0)
+	mpz_setbit (mod, 0);
+
+      mpz_urandomb (bs, rands, size_range);
+      mpz_rrandomb (base, rands, mpz_get_ui (bs) + 1);
+      if ((i & 8) != 0)
+	mpz_neg (base, base);
+
+      ebits = gmp_urandomm_ui (rands, 1000) + 1;
+      teeth = gmp_urandomm_ui (rands, 8) + 1;
+      blocks = gmp_urandomm_ui (rands, 20);
+
+      mpz_fixedbase_init (fb, base, mod, ebits, teeth, blocks);
+
+      for (j = 0; j < 10; j++)
+	{
+	  mpz_rrandomb (exp, rands, gmp_urandomm_ui (rands, ebits) + 1);
+	  if (j == 0)
+	    mpz_set_ui (exp, 0);
+	  else if (j == 1)
+	    mpz_set_ui (exp, 1);
+	  else if (j == 2)
+	    {
+	      /* Exactly the bits covered, or more.  */
+	      mpz_rrandomb (exp, rands, ebits);
+	      mpz_setbit (exp, ebits - 1);
+	      if ((i & 1) != 0)
+		mpz_mul_2exp (exp, exp, 100);
+	    }
+	  else if (j == 3 && mpz_invert (ref, base, mod))
+	    mpz_neg (exp, exp);
+
+	  mpz_powm (ref, base, exp, mod);
+	  mpz_powm_fixed_base (r, exp, fb);
+	  check_one (i, ref, r, base, exp, mod, teeth, blocks);
+	}
+
+      /* Write it out and read it back.  */
+      if ((i & 15) == 0)
+	{
+	  fp = fopen (FILENAME, "w+");
+	  if (fp == NULL)
+	    {
+	      perror ("fopen " FILENAME);
+	      abort ();
+	    }
+	  wsize = mpz_fixedbase_out_raw (fp, fb);
+	  rewind (fp);
+	  rsize = mpz_fixedbase_inp_raw (fb2, fp);
+	  fclose (fp);
+	  unlink (FILENAME);
+	  if (wsize == 0 || rsize != wsize)
+	    {
+	      fprintf (stderr, "ERROR in test %d, wrote %lu bytes, read %lu\n",
+		       i, (unsigned long) wsize, (unsigned long) rsize);
+	      abort ();
+	    }
+	  mpz_rrandomb (exp, rands, gmp_urandomm_ui (rands, ebits) + 1);
+	  mpz_powm (ref, base, exp, mod);
+	  mpz_powm_fixed_base (r, exp, fb2);
+	  check_one (i, ref, r, base, exp, mod, teeth, blocks);
+	  mpz_fixedbase_clear (fb2);
+	}
+
+      mpz_fixedbase_clear (fb);
+    }
+
+  mpz_clears (mod, base, exp, r, ref, bs, NULL);
+
+  check_bad_header ();
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,165 @@
+/* Test mpz_modctx_t and the _ctx functions.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define SIZEM 11
+
+static void
+check_one (const char *name, int i, mpz_srcptr want, mpz_srcptr got,
+	   mpz_srcptr a, mpz_srcptr b, mpz_srcptr mod)
+{
+  MPZ_CHECK_FORMAT (got);
+  if (mpz_cmp (want, got) != 0)
+    {
+      fprintf (stderr, "ERROR in %s, test %d\n", name, i);
+      gmp_fprintf (stderr, "a    = %Zx\n", a);
+      gmp_fprintf (stderr, "b    = %Zx\n", b);
+      gmp_fprintf (stderr, "mod  = %Zx\n", mod);
+      gmp_fprintf (stderr, "want = %Zx\n", want);
+      gmp_fprintf (stderr, "got  = %Zx\n", got);
+      abort ();
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+  mpz_t mod, a, b, e, r, ref, bs;
+  mpz_modctx_t ctx;
+  unsigned long size_range;
+  int i, j, inv, inv_ref;
+  int reps = 100;
+  gmp_randstate_ptr rands;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  rands = RANDS;
+
+  mpz_inits (mod, a, b, e, r, ref, bs, NULL);
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      size_range = mpz_get_ui (bs) % SIZEM + 2;
+
+      do
+	{
+	  mpz_urandomb (bs, rands, size_range);
+	  mpz_rrandomb (mod, rands, mpz_get_ui (bs) + 1);
+	}
+      while (mpz_sgn (mod) == 0);
+
+      /* Now and then a modulus big enough for the mu division.  */
+      if ((i & 31) == 7)
+	mpz_rrandomb (mod, rands, (MU_DIV_QR_THRESHOLD + 50) * GMP_NUMB_BITS);
+
+      if ((i & 3) != 0)
+	mpz_setbit (mod, 0);
+      if ((i & 4) != 0)
+	mpz_neg (mod, mod);
+
+      mpz_modctx_init (ctx, mod);
+
+      for (j = 0; j < 4; j++)
+	{
+	  mpz_urandomb (bs, rands, size_range + 2);
+	  mpz_rrandomb (a, rands, mpz_get_ui (bs) + 1);
+	  mpz_urandomb (bs, rands, size_range + 2);
+	  mpz_rrandomb (b, rands, mpz_get_ui (bs) + 1);
+	  mpz_urandomb (bs, rands, 4);
+	  if ((mpz_get_ui (bs) & 1) != 0)
+	    mpz_neg (a, a);
+	  if ((mpz_get_ui (bs) & 2) != 0)
+	    mpz_neg (b, b);
+	  if (mpz_get_ui (bs) == 12)
+	    mpz_set_ui (a, 0);
+	  if (mpz_get_ui (bs) == 13)
+	    mpz_set (a, mod);
+	  /* Operands about the size of the modulus, or of a product.  */
+	  if (mpz_get_ui (bs) == 14 || mpz_get_ui (bs) == 15)
+	    {
+	      mpz_rrandomb (a, rands, mpz_sizeinbase (mod, 2));
+	      mpz_rrandomb (b, rands, 2 * mpz_sizeinbase (mod, 2));
+	    }
+
+	  mpz_mod (ref, a, mod);
+	  mpz_mod_ctx (r, a, ctx);
+	  check_one ("mpz_mod_ctx", i, ref, r, a, a, mod);
+
+	  mpz_mul (ref, a, b);
+	  mpz_mod (ref, ref, mod);
+	  mpz_mulmod_ctx (r, a, b, ctx);
+	  check_one ("mpz_mulmod_ctx", i, ref, r, a, b, mod);
+
+	  mpz_mul (ref, a, a);
+	  mpz_mod (ref, ref, mod);
+	  mpz_sqrmod_ctx (r, a, ctx);
+	  check_one ("mpz_sqrmod_ctx", i, ref, r, a, a, mod);
+
+	  /* In place.  */
+	  mpz_set (r, a);
+	  mpz_mulmod_ctx (r, r, r, ctx);
+	  check_one ("mpz_mulmod_ctx in place", i, ref, r, a, a, mod);
+
+	  inv_ref = mpz_invert (ref, a, mod);
+	  inv = mpz_invert_ctx (r, a, ctx);
+	  if ((inv != 0) != (inv_ref != 0))
+	    {
+	      fprintf (stderr, "ERROR in mpz_invert_ctx, test %d\n", i);
+	      fprintf (stderr, "returned %d, mpz_invert %d\n", inv, inv_ref);
+	      gmp_fprintf (stderr, "a    = %Zx\n", a);
+	      gmp_fprintf (stderr, "mod  = %Zx\n", mod);
+	      abort ();
+	    }
+	  if (inv)
+	    check_one ("mpz_invert_ctx", i, ref, r, a, a, mod);
+
+	  if ((i & 31) == 7)
+	    mpz_set_ui (e, 65537);
+	  else
+	    {
+	      mpz_urandomb (bs, rands, size_range);
+	      mpz_rrandomb (e, rands, mpz_get_ui (bs) + 1);
+	      if (j == 3)
+		mpz_set_ui (e, 0);
+	    }
+	  /* A negative exponent, when the base is invertible.  */
+	  if (inv && j == 2)
+	    mpz_neg (e, e);
+
+	  mpz_powm (ref, a, e, mod);
+	  mpz_powm_ctx (r, a, e, ctx);
+	  check_one ("mpz_powm_ctx", i, ref, r, a, e, mod);
+	}
+
+      mpz_modctx_clear (ctx);
+    }
+
+  mpz_clears (mod, a, b, e, r, ref, bs, NULL);
+
+  tests_end ();
+  exit (0);
+}
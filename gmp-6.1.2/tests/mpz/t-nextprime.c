@@ -67,6 +67,71 @@ run (const char *start, int reps, const char *end, short diffs[])
   mpz_clear (x);
 }
 
+#define MAXCOUNT 16
+
+/* Walk [a,b) with mpz_nextprime_range, count primes at a time, checking
+   each against refmpz_nextprime.  Return the number of primes found.  */
+unsigned long
+check_range (mpz_srcptr a, mpz_srcptr b, int count)
+{
+  mpz_t prev, ref, x, r[MAXCOUNT];
+  mpz_ptr rp[MAXCOUNT];
+  unsigned long total;
+  size_t n, k;
+
+  mpz_init (prev);
+  mpz_init (ref);
+  mpz_init (x);
+  for (k = 0; k < MAXCOUNT; k++)
+    {
+      mpz_init (r[k]);
+      rp[k] = r[k];
+    }
+
+  mpz_set (x, a);
+  mpz_sub_ui (prev, a, 1);
+  if (mpz_cmp_ui (prev, 1) < 0)
+    mpz_set_ui (prev, 1);
+
+  total = 0;
+  for (;;)
+    {
+      n = mpz_nextprime_range (rp, count, x, b);
+      for (k = 0; k < n; k++)
+	{
+	  MPZ_CHECK_FORMAT (rp[k]);
+	  refmpz_nextprime (ref, prev);
+	  if (mpz_cmp (rp[k], ref) != 0 || mpz_cmp (ref, b) >= 0)
+	    {
+	      gmp_printf ("mpz_nextprime_range [%Zd,%Zd), item %d\n",
+			  a, b, (int) k);
+	      gmp_printf ("got  %Zd\n", rp[k]);
+	      gmp_printf ("want %Zd\n", ref);
+	      abort ();
+	    }
+	  mpz_set (prev, ref);
+	}
+      total += n;
+      if (n < count)
+	break;
+      mpz_add_ui (x, prev, 1);
+    }
+
+  refmpz_nextprime (ref, prev);
+  if (mpz_cmp (ref, b) < 0 && mpz_cmp (ref, a) >= 0)
+    {
+      gmp_printf ("mpz_nextprime_range [%Zd,%Zd) missed %Zd\n", a, b, ref);
+      abort ();
+    }
+
+  mpz_clear (prev);
+  mpz_clear (ref);
+  mpz_clear (x);
+  for (k = 0; k < MAXCOUNT; k++)
+    mpz_clear (r[k]);
+  return total;
+}
+
 extern short diff1[];
 extern short diff3[];
 extern short diff4[];
@@ -121,6 +186,32 @@ main (int argc, char **argv)
 	abort ();
     }
 
+  /* pi(10^5) = 9592 */
+  mpz_set_si (x, -10);
+  mpz_set_ui (nxtp, 100000);
+  if (check_range (x, nxtp, MAXCOUNT) != 9592)
+    {
+      printf ("mpz_nextprime_range miscounted primes below 10^5\n");
+      abort ();
+    }
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      size_range = mpz_get_ui (bs) % 8 + 2;
+
+      mpz_urandomb (bs, rands, size_range);
+      mpz_rrandomb (x, rands, mpz_get_ui (bs));
+      if (i & 1)
+	mpz_neg (x, x);
+
+      mpz_urandomb (bs, rands, 11);
+      mpz_add (nxtp, x, bs);
+
+      mpz_urandomb (bs, rands, 32);
+      check_range (x, nxtp, mpz_get_ui (bs) % MAXCOUNT + 1);
+    }
+
   mpz_clear (bs);
   mpz_clear (x);
   mpz_clear (nxtp);
@@ -0,0 +1,143 @@
+/* Test mpz_powm_batch.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+#define SIZEM 10
+#define MAXCOUNT 20
+
+int
+main (int argc, char **argv)
+{
+  mpz_t mod, bs;
+  mpz_t base[MAXCOUNT], exp[MAXCOUNT], res[MAXCOUNT], ref[MAXCOUNT];
+  mpz_ptr rv[MAXCOUNT];
+  mpz_srcptr bv[MAXCOUNT], ev[MAXCOUNT];
+  unsigned long size_range;
+  int count, i, j;
+  int reps = 200;
+  gmp_randstate_ptr rands;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  rands = RANDS;
+
+  mpz_init (bs);
+  mpz_init (mod);
+  for (j = 0; j < MAXCOUNT; j++)
+    {
+      mpz_init (base[j]);
+      mpz_init (exp[j]);
+      mpz_init (res[j]);
+      mpz_init (ref[j]);
+    }
+
+  for (i = 0; i < reps; i++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      size_range = mpz_get_ui (bs) % SIZEM + 2;
+
+      do
+	{
+	  mpz_urandomb (bs, rands, size_range);
+	  mpz_rrandomb (mod, rands, mpz_get_ui (bs) + 1);
+	}
+      while (mpz_sgn (mod) == 0);
+
+      /* Mostly odd moduli, the case mpn_powm_batch handles.  */
+      if ((i & 7) != 0)
+	mpz_setbit (mod, 0);
+
+      count = gmp_urandomm_ui (rands, MAXCOUNT + 1);
+
+      /* A shared sparse exponent, like for signature verification, or
+	 random ones.  */
+      if ((i & 3) == 0)
+	for (j = 0; j < count; j++)
+	  mpz_set_ui (exp[j], 65537);
+      else
+	for (j = 0; j < count; j++)
+	  {
+	    mpz_urandomb (bs, rands, size_range);
+	    mpz_rrandomb (exp[j], rands, mpz_get_ui (bs) + 1);
+	    if ((i & 15) == 5 && j == 0)
+	      mpz_set_ui (exp[j], 1);
+	  }
+
+      for (j = 0; j < count; j++)
+	{
+	  mpz_urandomb (bs, rands, size_range);
+	  mpz_rrandomb (base[j], rands, mpz_get_ui (bs) + 2);
+	  mpz_urandomb (bs, rands, 3);
+	  if (mpz_get_ui (bs) & 1)
+	    mpz_neg (base[j], base[j]);
+	  if (mpz_get_ui (bs) == 6)
+	    mpz_set_ui (base[j], 0);
+	  if (mpz_get_ui (bs) == 7 && mpz_sgn (exp[j]) > 0)
+	    mpz_set_ui (exp[j], 0);
+
+	  mpz_powm (ref[j], base[j], exp[j], mod);
+
+	  bv[j] = base[j];
+	  ev[j] = exp[j];
+	  rv[j] = res[j];
+	}
+
+      /* Every other time, compute in place over the bases.  */
+      if ((i & 1) != 0)
+	for (j = 0; j < count; j++)
+	  rv[j] = base[j];
+
+      mpz_powm_batch (rv, bv, ev, count, mod);
+
+      for (j = 0; j < count; j++)
+	{
+	  MPZ_CHECK_FORMAT (rv[j]);
+	  if (mpz_cmp (rv[j], ref[j]) != 0)
+	    {
+	      fprintf (stderr, "ERROR in test %d, element %d of %d\n",
+		       i, j, count);
+	      gmp_fprintf (stderr, "exp  = %Zx\n", exp[j]);
+	      gmp_fprintf (stderr, "mod  = %Zx\n", mod);
+	      gmp_fprintf (stderr, "want = %Zx\n", ref[j]);
+	      gmp_fprintf (stderr, "got  = %Zx\n", rv[j]);
+	      abort ();
+	    }
+	}
+    }
+
+  mpz_clear (bs);
+  mpz_clear (mod);
+  for (j = 0; j < MAXCOUNT; j++)
+    {
+      mpz_clear (base[j]);
+      mpz_clear (exp[j]);
+      mpz_clear (res[j]);
+      mpz_clear (ref[j]);
+    }
+
+  tests_end ();
+  exit (0);
+}
@@ -0,0 +1,150 @@
+/* Test mpz_prod_ui_array and the parallel product tree.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library test suite.
+
+The GNU MP Library test suite is free software; you can redistribute it
+and/or modify it under the terms of the GNU General Public License as
+published by the Free Software Foundation; either version 3 of the License,
+or (at your option) any later version.
+
+The GNU MP Library test suite is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+the GNU MP Library test suite.  If not, see https://www.gnu.org/licenses/.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gmp.h"
+#include "gmp-impl.h"
+#include "tests.h"
+
+static int  task_calls;
+
+/* Run the tasks last to first, so any dependence of one on another shows
+   up.  */
+static void
+reverse_parallel (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+  for (i = n - 1; i >= 0; i--)
+    {
+      task_calls++;
+      (*task) (data, i);
+    }
+}
+
+static void
+check_one (const unsigned long *v, size_t n)
+{
+  mpz_t r, want;
+  size_t i;
+
+  mpz_init (r);
+  mpz_init_set_ui (want, 1);
+  for (i = 0; i < n; i++)
+    mpz_mul_ui (want, want, v[i]);
+
+  mpz_prod_ui_array (r, v, n);
+  MPZ_CHECK_FORMAT (r);
+  if (mpz_cmp (r, want) != 0)
+    {
+      printf ("mpz_prod_ui_array wrong, n = %lu\n", (unsigned long) n);
+      for (i = 0; i < n; i++)
+	printf ("  v[%lu] = %#lx\n", (unsigned long) i, v[i]);
+      mpz_trace ("got ", r);
+      mpz_trace ("want", want);
+      abort ();
+    }
+  mpz_clear (r);
+  mpz_clear (want);
+}
+
+#define MAXN 2000
+
+static void
+check_random (int reps)
+{
+  gmp_randstate_ptr rands = RANDS;
+  unsigned long v[MAXN];
+  mpz_t bs;
+  size_t n, i;
+  int rep, bits;
+
+  mpz_init (bs);
+  for (rep = 0; rep < reps; rep++)
+    {
+      mpz_urandomb (bs, rands, 32);
+      n = mpz_get_ui (bs) % MAXN;
+      bits = mpz_get_ui (bs) / MAXN % BITS_PER_ULONG + 1;
+      for (i = 0; i < n; i++)
+	{
+	  mpz_rrandomb (bs, rands, bits);
+	  v[i] = mpz_get_ui (bs);
+	  if (v[i] == 0)
+	    v[i] = 1;
+	}
+      /* Sometimes a zero.  */
+      if (n != 0 && rep % 8 == 0)
+	v[rep % n] = 0;
+      check_one (v, n);
+    }
+  mpz_clear (bs);
+}
+
+/* Factorials and the like big enough for the parallel product tree, run
+   with the tasks in reverse.  */
+static void
+check_parallel (void)
+{
+  unsigned long v[MAXN];
+  mpz_t r1, r2;
+  size_t i;
+
+  mpz_init (r1);
+  mpz_init (r2);
+
+  mpz_fac_ui (r1, 200000);
+  mpz_primorial_ui (r2, 400000);
+  mp_set_parallel_function (reverse_parallel, 4);
+  task_calls = 0;
+  mpz_fac_ui (r2, 200000);
+  if (mpz_cmp (r1, r2) != 0)
+    {
+      printf ("mpz_fac_ui wrong in parallel\n");
+      abort ();
+    }
+  if (task_calls == 0)
+    {
+      printf ("parallel function not used\n");
+      abort ();
+    }
+
+  for (i = 0; i < MAXN; i++)
+    v[i] = ULONG_MAX - 2 * i;
+  check_one (v, MAXN);
+
+  mp_set_parallel_function (NULL, 0);
+  mpz_clear (r1);
+  mpz_clear (r2);
+}
+
+int
+main (int argc, char **argv)
+{
+  int reps = 200;
+
+  tests_start ();
+  TESTS_REPS (reps, argv, argc);
+
+  check_random (reps);
+  check_parallel ();
+
+  tests_end ();
+  exit (0);
+}
@@ -43,6 +43,7 @@ see https://www.gnu.org/licenses/.  */
 #include "config.h"
 
 #include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -131,6 +132,14 @@ mp_size_t  size_allocnum = 0;
 int        option_resource_usage = 0;
 long       option_seed = 123456789;
 
+#define FORMAT_CSV   1
+#define FORMAT_JSON  2
+int        option_suite = 0;
+int        option_format = FORMAT_CSV;
+char      *option_baseline = NULL;
+double     option_threshold = 5.0;
+int        option_reps = 5;
+
 struct speed_params  sp;
 
 #define COLUMN_WIDTH  13  /* for the free-form output */
@@ -1050,6 +1059,353 @@ routine_find (struct choice_t *c, const char *s_orig)
 }
 
 
+/* The standard benchmark suite, run with -S.  The sizes are fixed rather
+   than taken from the thresholds, so that results before and after a
+   threshold change can be compared directly.  The mpn_mul_n and mpn_sqr
+   sizes go from basecase through the toom ranges into FFT.  */
+
+#define SUITE_MAX_SIZES  13
+
+const struct suite_t {
+  const char  *name;
+  mp_size_t   size[SUITE_MAX_SIZES];  /* zero terminated */
+} suite[] = {
+  { "mpn_add_n",         { 1, 10, 100, 1000 } },
+  { "mpn_addmul_1.aas",  { 1, 10, 100, 1000 } },
+  { "mpn_mul_n",         { 1, 5, 10, 20, 50, 100, 200, 400, 800, 2000,
+                           5000, 20000 } },
+  { "mpn_sqr",           { 1, 5, 10, 20, 50, 100, 200, 400, 800, 2000,
+                           5000, 20000 } },
+  { "mpn_nussbaumer_mul", { 2000, 5000, 20000 } },
+  { "mpn_invert",        { 10, 100, 1000 } },
+  { "mpn_sqrtrem",       { 10, 100, 1000 } },
+  { "mpn_gcd",           { 2, 10, 50, 200, 1000, 5000 } },
+  { "mpn_gcdext",        { 2, 10, 50, 200, 1000, 5000 } },
+  { "mpn_get_str.10",    { 1, 10, 100, 1000, 10000 } },
+  { "mpn_set_str.10",    { 1, 10, 100, 1000, 10000 } },
+  { "mpz_add",           { 1, 10, 100, 1000 } },
+  { "mpz_mod",           { 10, 100, 1000 } },
+  { "mpz_powm",          { 1, 4, 16, 32, 64 } },
+  { "mpz_powm_ui",       { 1, 10, 100 } },
+  { "mpz_powm_sec",      { 4, 16, 32 } },
+  { "mpz_fac_ui",        { 100, 1000, 10000, 100000 } },
+  { "mpz_fib_ui",        { 100, 1000, 10000, 100000 } },
+};
+
+/* Baseline results read by suite_baseline_read.  */
+struct baseline_t {
+  char       name[64];
+  mp_size_t  size;
+  double     cycles_per_limb;
+} *baseline = NULL;
+int  baseline_num = 0;
+
+/* Read a file written by an earlier -S run, in either format.  Each result
+   is on a line of its own in both.  */
+void
+suite_baseline_read (const char *filename)
+{
+  char   line[1024];
+  FILE   *fp;
+  int    alloc = 0;
+  long   size;
+  struct baseline_t  b;
+
+  if ((fp = fopen (filename, "r")) == NULL)
+    {
+      fprintf (stderr, "Cannot open %s\n", filename);
+      exit (1);
+    }
+
+  while (fgets (line, sizeof (line), fp) != NULL)
+    {
+      char  *p;
+      double  cycles;
+
+      if ((p = strstr (line, "{\"routine\": \"")) != NULL)
+        {
+          if (sscanf (p, "{\"routine\": \"%63[^\"]\", \"size\": %ld, "
+                      "\"cycles\": %lf, \"cycles_per_limb\": %lf",
+                      b.name, &size, &cycles, &b.cycles_per_limb) != 4)
+            continue;
+        }
+      else if (line[0] == '#' || strncmp (line, "routine,", 8) == 0
+               || sscanf (line, "%63[^,],%ld,%lf,%lf",
+                          b.name, &size, &cycles, &b.cycles_per_limb) != 4)
+        continue;
+
+      b.size = size;
+      if (baseline_num == alloc)
+        {
+          baseline = (struct baseline_t *) __gmp_allocate_or_reallocate
+            (baseline, alloc * sizeof (baseline[0]),
+             (alloc + 100) * sizeof (baseline[0]));
+          alloc += 100;
+        }
+      baseline[baseline_num++] = b;
+    }
+  fclose (fp);
+
+  if (baseline_num == 0)
+    {
+      fprintf (stderr, "No results found in baseline %s\n", filename);
+      exit (1);
+    }
+}
+
+const struct baseline_t *
+suite_baseline_find (const char *name, mp_size_t size)
+{
+  int  i;
+  for (i = 0; i < baseline_num; i++)
+    if (baseline[i].size == size && strcmp (baseline[i].name, name) == 0)
+      return &baseline[i];
+  return NULL;
+}
+
+/* Print s as a JSON string.  */
+void
+json_string (FILE *fp, const char *s)
+{
+  putc ('"', fp);
+  for ( ; *s != '\0'; s++)
+    {
+      if (*s == '"' || *s == '\\')
+        fprintf (fp, "\\%c", *s);
+      else if ((unsigned char) *s < 0x20)
+        fprintf (fp, "\\u%04x", (unsigned char) *s);
+      else
+        putc (*s, fp);
+    }
+  putc ('"', fp);
+}
+
+/* The CPU model, from /proc/cpuinfo where that exists.  */
+void
+suite_cpu_model (char *buf, size_t len)
+{
+  char  line[256];
+  char  *p;
+  FILE  *fp;
+
+  strcpy (buf, "unknown");
+  if ((fp = fopen ("/proc/cpuinfo", "r")) == NULL)
+    return;
+  while (fgets (line, sizeof (line), fp) != NULL)
+    {
+      if ((strncmp (line, "model name", 10) == 0
+           || strncmp (line, "cpu\t", 4) == 0)
+          && (p = strchr (line, ':')) != NULL)
+        {
+          for (p++; *p == ' '; p++)
+            ;
+          p[strcspn (p, "\n")] = '\0';
+          if (strlen (p) < len)
+            strcpy (buf, p);
+          break;
+        }
+    }
+  fclose (fp);
+}
+
+void
+suite_header (FILE *fp)
+{
+  char  cpu[128];
+
+  suite_cpu_model (cpu, sizeof (cpu));
+
+  if (option_format == FORMAT_JSON)
+    {
+      fprintf (fp, "{\n");
+      fprintf (fp, "  \"gmp_version\": ");
+      json_string (fp, gmp_version);
+      fprintf (fp, ",\n  \"limb_bits\": %d,\n", GMP_LIMB_BITS);
+      fprintf (fp, "  \"nail_bits\": %d,\n", GMP_NAIL_BITS);
+      fprintf (fp, "  \"cc\": ");
+      json_string (fp, __GMP_CC);
+      fprintf (fp, ",\n  \"cflags\": ");
+      json_string (fp, __GMP_CFLAGS);
+      fprintf (fp, ",\n  \"cpu\": ");
+      json_string (fp, cpu);
+      fprintf (fp, ",\n  \"cpu_mhz\": %.2f,\n", 1e-6/speed_cycletime);
+      fprintf (fp, "  \"timer\": ");
+      json_string (fp, speed_time_string);
+      fprintf (fp, ",\n  \"reps\": %d,\n", option_reps);
+      if (option_baseline != NULL)
+        {
+          fprintf (fp, "  \"baseline\": ");
+          json_string (fp, option_baseline);
+          fprintf (fp, ",\n  \"threshold_percent\": %.2f,\n",
+                   option_threshold);
+        }
+      fprintf (fp, "  \"results\": [\n");
+    }
+  else
+    {
+      fprintf (fp, "# gmp %s, %d bit limbs, %d nail bits\n",
+               gmp_version, GMP_LIMB_BITS, GMP_NAIL_BITS);
+      fprintf (fp, "# cc %s %s\n", __GMP_CC, __GMP_CFLAGS);
+      fprintf (fp, "# cpu %s, %.2f MHz\n", cpu, 1e-6/speed_cycletime);
+      fprintf (fp, "# timer %s\n", speed_time_string);
+      fprintf (fp, "routine,size,cycles,cycles_per_limb,rel_stddev,reps");
+      if (option_baseline != NULL)
+        fprintf (fp, ",baseline_cycles_per_limb,change_percent,regression");
+      fprintf (fp, "\n");
+    }
+}
+
+/* Measure c at size option_reps times and print the result.  The fastest
+   time is reported, as speed_measure itself does, along with the relative
+   standard deviation of all the times.  Return 1 if the result is a
+   regression against the baseline, 0 if not.  */
+int
+suite_one (FILE *fp, const struct choice_t *c, mp_size_t size, int first)
+{
+  const struct baseline_t  *b;
+  double  t, min, sum, sumsq, mean, dev, cpl, change;
+  int     i, n, regression;
+  TMP_DECL;
+
+  TMP_MARK;
+  sp.size = size;
+  sp.r = c->r;
+  if ((c->p->flag & FLAG_NODATA) == 0)
+    {
+      SPEED_TMP_ALLOC_LIMBS (sp.xp, size, sp.align_xp);
+      SPEED_TMP_ALLOC_LIMBS (sp.yp, size, sp.align_yp);
+      data_fill (sp.xp, size);
+      data_fill (sp.yp, size);
+    }
+  else
+    {
+      sp.xp = NULL;
+      sp.yp = NULL;
+    }
+
+  n = 0;
+  min = sum = sumsq = 0.0;
+  for (i = 0; i < option_reps; i++)
+    {
+      t = speed_measure (c->p->fun, &sp);
+      if (t == -1.0)
+        break;
+      t /= speed_cycletime;
+      if (n == 0 || t < min)
+        min = t;
+      sum += t;
+      sumsq += t * t;
+      n++;
+    }
+  TMP_FREE;
+
+  if (n == 0)
+    {
+      fprintf (stderr, "%s at size %ld not measurable, skipped\n",
+               c->name, (long) size);
+      return 0;
+    }
+
+  mean = sum / n;
+  dev = (n > 1 && mean > 0.0
+         ? sqrt (MAX (0.0, (sumsq - n * mean * mean) / (n - 1))) / mean
+         : 0.0);
+  cpl = min / size;
+
+  b = NULL;
+  change = 0.0;
+  regression = 0;
+  if (option_baseline != NULL
+      && (b = suite_baseline_find (c->name, size)) != NULL
+      && b->cycles_per_limb > 0.0)
+    {
+      change = 100.0 * (cpl - b->cycles_per_limb) / b->cycles_per_limb;
+      regression = (change > option_threshold);
+      if (regression)
+        fprintf (stderr,
+                 "REGRESSION %s size %ld: %.4f -> %.4f cycles/limb (%+.1f%%)\n",
+                 c->name, (long) size, b->cycles_per_limb, cpl, change);
+    }
+
+  if (option_format == FORMAT_JSON)
+    {
+      fprintf (fp, "%s    {\"routine\": ", first ? "" : ",\n");
+      json_string (fp, c->name);
+      fprintf (fp, ", \"size\": %ld, \"cycles\": %.2f, "
+               "\"cycles_per_limb\": %.4f, \"rel_stddev\": %.4f, \"reps\": %d",
+               (long) size, min, cpl, dev, n);
+      if (b != NULL)
+        fprintf (fp, ", \"baseline_cycles_per_limb\": %.4f, "
+                 "\"change_percent\": %.2f, \"regression\": %s",
+                 b->cycles_per_limb, change, regression ? "true" : "false");
+      fprintf (fp, "}");
+    }
+  else
+    {
+      fprintf (fp, "%s,%ld,%.2f,%.4f,%.4f,%d", c->name, (long) size,
+               min, cpl, dev, n);
+      if (option_baseline != NULL)
+        {
+          if (b != NULL)
+            fprintf (fp, ",%.4f,%.2f,%d", b->cycles_per_limb, change,
+                     regression);
+          else
+            fprintf (fp, ",,,");
+        }
+      fprintf (fp, "\n");
+    }
+  return regression;
+}
+
+/* Run the suite, return the number of regressions.  */
+int
+run_suite (FILE *fp)
+{
+  struct choice_t  c;
+  int   i, j, first, regressions;
+  TMP_DECL;
+
+  if (option_baseline != NULL)
+    suite_baseline_read (option_baseline);
+
+  TMP_MARK;
+  SPEED_TMP_ALLOC_LIMBS (sp.xp_block, SPEED_BLOCK_SIZE, sp.align_xp);
+  SPEED_TMP_ALLOC_LIMBS (sp.yp_block, SPEED_BLOCK_SIZE, sp.align_yp);
+
+  data_fill (sp.xp_block, SPEED_BLOCK_SIZE);
+  data_fill (sp.yp_block, SPEED_BLOCK_SIZE);
+
+  suite_header (fp);
+
+  first = 1;
+  regressions = 0;
+  for (i = 0; i < numberof (suite); i++)
+    {
+      routine_find (&c, suite[i].name);
+      for (j = 0; j < SUITE_MAX_SIZES && suite[i].size[j] != 0; j++)
+        {
+          regressions += suite_one (fp, &c, suite[i].size[j], first);
+          first = 0;
+        }
+    }
+
+  if (option_format == FORMAT_JSON)
+    {
+      fprintf (fp, "\n  ]");
+      if (option_baseline != NULL)
+        fprintf (fp, ",\n  \"regressions\": %d", regressions);
+      fprintf (fp, "\n}\n");
+    }
+
+  if (option_baseline != NULL)
+    fprintf (stderr, "%d regression%s beyond %.2f%%\n", regressions,
+             regressions == 1 ? "" : "s", option_threshold);
+
+  TMP_FREE;
+  return regressions;
+}
+
+
 void
 usage (void)
 {
@@ -1058,6 +1414,7 @@ usage (void)
   speed_time_init ();
 
   printf ("Usage: speed [-options] -s size <routine>...\n");
+  printf ("       speed [-options] -S\n");
   printf ("Measure the speed of some routines.\n");
   printf ("Times are in seconds, accuracy is shown.\n");
   printf ("\n");
@@ -1076,12 +1433,21 @@ usage (void)
   printf ("   -a <type>  use given data: random(default), random2, zeros, aas, ffs, 2fd\n");
   printf ("   -x, -y, -w, -W <align>  specify data alignments, sources and dests\n");
   printf ("   -o addrs   print addresses of data blocks\n");
+  printf ("   -S         run the standard benchmark suite, in cycles\n");
+  printf ("   -O format  suite output format: csv(default), json\n");
+  printf ("   -n reps    measure each suite entry reps times (default 5)\n");
+  printf ("   -B file    compare the suite against an earlier -S output\n");
+  printf ("   -T percent regression threshold for -B (default 5)\n");
   printf ("\n");
   printf ("If both -t and -f are used, it means step by the factor or the step, whichever\n");
   printf ("is greater.\n");
   printf ("If both -C and -D are used, it means cycles per however many limbs between a\n");
   printf ("size and the previous size.\n");
   printf ("\n");
+  printf ("With -S, the fastest of the reps measurements of each entry is shown,\n");
+  printf ("with their relative standard deviation.  With -B, regressions are listed\n");
+  printf ("on stderr and the exit status is 2 if there were any.\n");
+  printf ("\n");
   printf ("After running with -P, plots can be viewed with Gnuplot or Quickplot.\n");
   printf ("\"gnuplot name.gnuplot\" (use \"set logscale xy; replot\" at the prompt for\n");
   printf ("a log/log plot).\n");
@@ -1141,7 +1507,7 @@ main (int argc, char *argv[])
 
   for (;;)
     {
-      opt = getopt(argc, argv, "a:CcDdEFf:o:p:P:rRs:t:ux:y:w:W:z");
+      opt = getopt(argc, argv, "a:B:CcDdEFf:n:o:O:p:P:rRSs:T:t:ux:y:w:W:z");
       if (opt == EOF)
         break;
 
@@ -1159,6 +1525,9 @@ main (int argc, char *argv[])
             exit (1);
           }
         break;
+      case 'B':
+        option_baseline = optarg;
+        break;
       case 'C':
         if (option_unit  != UNIT_SECONDS) goto bad_unit;
         option_unit = UNIT_CYCLESPERLIMB;
@@ -1199,9 +1568,26 @@ main (int argc, char *argv[])
             exit (1);
           }
         break;
+      case 'n':
+        option_reps = atoi (optarg);
+        if (option_reps < 1)
+          {
+            fprintf (stderr, "-n reps must be >= 1\n");
+            exit (1);
+          }
+        break;
       case 'o':
         speed_option_set (optarg);
         break;
+      case 'O':
+        if (strcmp (optarg, "csv") == 0)       option_format = FORMAT_CSV;
+        else if (strcmp (optarg, "json") == 0) option_format = FORMAT_JSON;
+        else
+          {
+            fprintf (stderr, "unrecognised output format: %s\n", optarg);
+            exit (1);
+          }
+        break;
       case 'P':
         option_gnuplot = 1;
         option_gnuplot_basename = optarg;
@@ -1217,6 +1603,9 @@ main (int argc, char *argv[])
           goto bad_cmp;
         option_cmp = CMP_RATIO;
         break;
+      case 'S':
+        option_suite = 1;
+        break;
       case 's':
         {
           char  *s;
@@ -1251,6 +1640,14 @@ main (int argc, char *argv[])
             }
         }
         break;
+      case 'T':
+        option_threshold = atof (optarg);
+        if (option_threshold < 0.0)
+          {
+            fprintf (stderr, "-T percent must be >= 0\n");
+            exit (1);
+          }
+        break;
       case 't':
         option_step = atol (optarg);
         if (option_step < 1)
@@ -1286,6 +1683,23 @@ main (int argc, char *argv[])
       }
     }
 
+  if (option_suite)
+    {
+      if (optind < argc || size_num != 0)
+        {
+          fprintf (stderr, "-S takes no sizes or routines\n");
+          exit (1);
+        }
+
+      gmp_randinit_default (__gmp_rands);
+      __gmp_rands_initialized = 1;
+      gmp_randseed_ui (__gmp_rands, option_seed);
+
+      speed_time_init ();
+      speed_cycletime_need_cycles ();
+      return run_suite (stdout) == 0 ? 0 : 2;
+    }
+
   if (optind >= argc)
     {
       usage ();
@@ -2410,16 +2410,20 @@ int speed_routine_count_zeros_setup (struct speed_params *, mp_ptr, int, int);
   {									\
     unsigned   i;							\
     mp_ptr     cp, mp, tp, ap, invp;					\
+    mp_size_t  itch;							\
     double     t;							\
     TMP_DECL;								\
 									\
     SPEED_RESTRICT_COND (s->size > 8);					\
 									\
+    /* tp is also the mpn_binvert scratch */				\
+    itch = MAX (2*s->size+1, mpn_binvert_itch (s->size));		\
+									\
     TMP_MARK;								\
     SPEED_TMP_ALLOC_LIMBS (ap, 2*s->size+1, s->align_xp);		\
     SPEED_TMP_ALLOC_LIMBS (mp, s->size,     s->align_yp);		\
     SPEED_TMP_ALLOC_LIMBS (cp, s->size,     s->align_wp);		\
-    SPEED_TMP_ALLOC_LIMBS (tp, 2*s->size+1, s->align_wp2);		\
+    SPEED_TMP_ALLOC_LIMBS (tp, itch,        s->align_wp2);		\
     SPEED_TMP_ALLOC_LIMBS (invp, s->size,   s->align_wp2); /* align? */	\
 									\
     MPN_COPY (ap,         s->xp, s->size);				\
@@ -29,10 +29,18 @@ GNU Lesser General Public License along with the GNU MP Library.  If not,
 see https://www.gnu.org/licenses/.  */
 
 
-/* Usage: tuneup [-t] [-t] [-p precision]
+/* Usage: tuneup [-t] [-t] [-p precision] [-j threads] [-w profile]
 
    -t turns on some diagnostic traces, a second -t turns on more traces.
 
+   -j tunes FFT_PARALLEL_THRESHOLD using a pool of the given number of
+   threads.  This is only available where POSIX threads are, and the value
+   is only meaningful for that thread count.
+
+   -w reads a workload profile, the operand sizes an application actually
+   uses, and weights the badness described below by it.  See "Workload
+   profiles" below.
+
    Notes:
 
    The code here isn't a vision of loveliness, mainly because it's subject
@@ -100,11 +108,42 @@ see https://www.gnu.org/licenses/.  */
    limits are recompiled though, to make them accept a bigger range of sizes
    than normal, eg. mpn_sqr_basecase to compare against mpn_toom2_sqr.
 
+   Workload profiles:
+
+   Without -w each size measured counts the same, which suits a library
+   used for all sizes.  An application may call with only a few sizes
+   though, and then only the badness at those sizes matters.  With -w the
+   badness at each size measured is weighted by the fraction of the
+   profiled calls which the threshold being tuned would decide, between that
+   size and the next measured.  The weights are 1 plus PROFILE_WEIGHT times
+   that fraction, so the plain rule above still picks the threshold among
+   sizes the application never uses.
+
+   A profile is a text file of lines
+
+       mul    UN VN COUNT     COUNT calls of mpn_mul with un=UN, vn=VN
+       mul    N COUNT         COUNT calls with N x N limbs
+       sqr    N COUNT
+       div    N COUNT         divisor size
+       gcd    N COUNT
+       powm   N COUNT         modulus size
+
+   where N can also be a range LO-HI, with the calls spread evenly over it.
+   Blank lines and lines starting with # are ignored.  The output of
+   gmp_stats_dump from a library configured with --enable-stats can be used
+   directly too, or mixed with the above.  It has no operand ratios for
+   mpn_mul, so its mpn_mul counts weight only the balanced thresholds.
+
+   The mpn_mul calls weight the MUL_TOOM thresholds by vn, and the
+   unbalanced MUL_TOOM32_TO_TOOM43 etc by vn and by un/vn, each taking only
+   the ratios where mpn_mul consults it.
+
    Limitations:
 
    The FFTs aren't subject to the same badness rule as the other thresholds,
    so each k is probably being brought on a touch early.  This isn't likely
-   to make a difference, and the simpler probing means fewer tests.
+   to make a difference, and the simpler probing means fewer tests.  For
+   the same reason a workload profile has no effect on the FFTs.
 
 */
 
@@ -115,11 +154,17 @@ see https://www.gnu.org/licenses/.  */
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
 
+#if defined (_POSIX_THREADS) && _POSIX_THREADS > 0
+#include <pthread.h>
+#define TUNE_THREADS 1
+#endif
+
 #include "gmp.h"
 #include "gmp-impl.h"
 #include "longlong.h"
@@ -142,11 +187,13 @@ mp_size_t  option_fft_max_size = 0;
 #endif
 int        option_trace = 0;
 int        option_fft_trace = 0;
+int        option_threads = 0;
 struct speed_params  s;
 
 struct dat_t {
   mp_size_t  size;
   double     d;
+  double     w;     /* weight, from the workload profile */
 } *dat = NULL;
 int  ndat = 0;
 int  allocdat = 0;
@@ -169,6 +216,7 @@ mp_size_t  mul_toom42_to_toom63_threshold = MP_SIZE_T_MAX;
 mp_size_t  mul_toom43_to_toom54_threshold = MP_SIZE_T_MAX;
 mp_size_t  mul_fft_threshold            = MP_SIZE_T_MAX;
 mp_size_t  mul_fft_modf_threshold       = MP_SIZE_T_MAX;
+mp_size_t  fft_parallel_threshold       = MP_SIZE_T_MAX;
 mp_size_t  sqr_basecase_threshold       = MP_SIZE_T_MAX;
 mp_size_t  sqr_toom2_threshold
   = (TUNE_SQR_TOOM2_MAX == 0 ? MP_SIZE_T_MAX : TUNE_SQR_TOOM2_MAX);
@@ -255,9 +303,37 @@ struct param_t {
   int               data_high;
 
   int               noprint;
+
+  int               profile_op;     /* PROFILE_MUL etc, for -w */
+  double            profile_scale;  /* threshold per measured size */
+  double            profile_ratio_lo;
+  double            profile_ratio_hi;  /* or 0 for no limit */
 };
 
 
+/* The workload profile from -w, see the notes at the start of the file.  */
+#define PROFILE_NONE  0
+#define PROFILE_MUL   1
+#define PROFILE_SQR   2
+#define PROFILE_DIV   3
+#define PROFILE_GCD   4
+#define PROFILE_POWM  5
+#define PROFILE_N     6
+
+#define PROFILE_WEIGHT  10000.0
+
+struct profile_t {
+  int        op;
+  mp_size_t  lo, hi;    /* sizes, of vn for mpn_mul */
+  double     ratio;     /* un/vn for mpn_mul, or 0 if unknown */
+  double     count;
+} *profile = NULL;
+int     nprofile = 0;
+int     allocprofile = 0;
+double  profile_total[PROFILE_N];
+const char  *option_profile = NULL;
+
+
 /* These are normally undefined when false, which suits "#if" fine.
    But give them zero values so they can be used in plain C "if"s.  */
 #ifndef UDIV_PREINV_ALWAYS
@@ -338,6 +414,7 @@ add_dat (mp_size_t size, double d)
 
   dat[ndat].size = size;
   dat[ndat].d = d;
+  dat[ndat].w = 1.0;
   ndat++;
 }
 
@@ -353,7 +430,7 @@ analyze_dat (int final)
   x = 0.0;
   for (j = 0; j < ndat; j++)
     if (dat[j].d > 0.0)
-      x += dat[j].d;
+      x += dat[j].d * dat[j].w;
 
   if (option_trace >= 2 && final)
     {
@@ -370,7 +447,7 @@ analyze_dat (int final)
   /* When stepping to the next dat[j].size, positive values are no longer
      bad (so subtracted), negative values become bad (so add the absolute
      value, meaning subtract). */
-  for (j = 0; j < ndat; x -= dat[j].d, j++)
+  for (j = 0; j < ndat; x -= dat[j].d * dat[j].w, j++)
     {
       if (option_trace >= 2 && final)
         printf ("size=%ld  x=%.4f\n", (long) dat[j].size, x);
@@ -386,6 +463,198 @@ analyze_dat (int final)
 }
 
 
+/* Add an entry to the end of the profile[] array.  */
+void
+add_profile (int op, mp_size_t lo, mp_size_t hi, double ratio, double count)
+{
+#define ALLOCPROFILE_STEP  100
+
+  if (nprofile == allocprofile)
+    {
+      profile = (struct profile_t *) __gmp_allocate_or_reallocate
+        (profile, allocprofile * sizeof(profile[0]),
+         (allocprofile+ALLOCPROFILE_STEP) * sizeof(profile[0]));
+      allocprofile += ALLOCPROFILE_STEP;
+    }
+
+  profile[nprofile].op = op;
+  profile[nprofile].lo = lo;
+  profile[nprofile].hi = hi;
+  profile[nprofile].ratio = ratio;
+  profile[nprofile].count = count;
+  nprofile++;
+  profile_total[op] += count;
+}
+
+/* Parse a size "N" or a range "LO-HI".  */
+int
+parse_profile_sizes (const char *str, mp_size_t *lo, mp_size_t *hi)
+{
+  char  *end;
+
+  *lo = strtol (str, &end, 10);
+  *hi = *lo;
+  if (*end == '-')
+    *hi = strtol (end + 1, &end, 10);
+  return *end == '\0' && *lo >= 1 && *hi >= *lo;
+}
+
+int
+parse_profile_count (const char *str, double *count)
+{
+  char  *end;
+
+  *count = strtod (str, &end);
+  return end != str && *end == '\0' && *count >= 0.0;
+}
+
+void
+read_profile (const char *filename)
+{
+  static const struct {
+    const char  *name;
+    int         op;
+  } ops[] = {
+    { "mul",         PROFILE_MUL  },
+    { "sqr",         PROFILE_SQR  },
+    { "div",         PROFILE_DIV  },
+    { "gcd",         PROFILE_GCD  },
+    { "powm",        PROFILE_POWM },
+
+    /* as printed by gmp_stats_dump */
+    { "mpn_mul",     PROFILE_MUL  },
+    { "mpn_mul_n",   PROFILE_MUL  },
+    { "mpn_sqr",     PROFILE_SQR  },
+    { "mpn_tdiv_qr", PROFILE_DIV  },
+    { "mpn_div_q",   PROFILE_DIV  },
+    { "mpn_gcd",     PROFILE_GCD  },
+    { "mpn_powm",    PROFILE_POWM },
+  };
+  char       line[1024], *tok[64], *p;
+  mp_size_t  lo, hi, un, vn;
+  double     ratio, count;
+  int        lineno, ntok, op, i, j;
+  FILE       *fp;
+
+  fp = fopen (filename, "r");
+  if (fp == NULL)
+    {
+      fprintf (stderr, "Cannot open profile %s\n", filename);
+      exit (1);
+    }
+
+  for (lineno = 1; fgets (line, sizeof (line), fp) != NULL; lineno++)
+    {
+      ntok = 0;
+      for (p = strtok (line, " \t\r\n");
+           p != NULL && ntok < numberof (tok);
+           p = strtok (NULL, " \t\r\n"))
+        tok[ntok++] = p;
+
+      /* skip blanks, comments, and the gmp_stats_dump heading */
+      if (ntok == 0 || tok[0][0] == '#' || strcmp (tok[0], "function") == 0)
+        continue;
+
+      for (i = 0; i < numberof (ops); i++)
+        if (strcmp (tok[0], ops[i].name) == 0)
+          break;
+      if (i == numberof (ops))
+        goto bad;
+      op = ops[i].op;
+
+      if (strncmp (tok[0], "mpn_", 4) == 0)
+        {
+          /* "function branch calls lo-hi:count ...".  The divrem_1 and
+             divrem_2 branches count dividend sizes and have no threshold
+             here.  */
+          if (ntok < 3)
+            goto bad;
+          if (strncmp (tok[1], "divrem_", 7) == 0)
+            continue;
+          ratio = (strcmp (tok[0], "mpn_mul") == 0 ? 0.0 : 1.0);
+          for (j = 3; j < ntok; j++)
+            {
+              p = strchr (tok[j], ':');
+              if (p == NULL)
+                goto bad;
+              *p = '\0';
+              if (! parse_profile_sizes (tok[j], &lo, &hi)
+                  || ! parse_profile_count (p + 1, &count))
+                goto bad;
+              add_profile (op, lo, hi, ratio, count);
+            }
+        }
+      else if (op == PROFILE_MUL && ntok == 4)
+        {
+          if (! parse_profile_sizes (tok[1], &un, &hi) || hi != un
+              || ! parse_profile_sizes (tok[2], &vn, &hi) || hi != vn
+              || ! parse_profile_count (tok[3], &count))
+            goto bad;
+          if (un < vn)
+            MP_SIZE_T_SWAP (un, vn);
+          add_profile (op, vn, vn, (double) un / vn, count);
+        }
+      else if (ntok == 3)
+        {
+          if (! parse_profile_sizes (tok[1], &lo, &hi)
+              || ! parse_profile_count (tok[2], &count))
+            goto bad;
+          add_profile (op, lo, hi, 1.0, count);
+        }
+      else
+        goto bad;
+    }
+  fclose (fp);
+
+  if (nprofile == 0)
+    {
+      fprintf (stderr, "Profile %s is empty\n", filename);
+      exit (1);
+    }
+  return;
+
+ bad:
+  fprintf (stderr, "%s:%d: unrecognised profile line\n", filename, lineno);
+  exit (1);
+}
+
+/* Return the weight for a measurement at size, standing for the sizes up to
+   next.  */
+double
+profile_weight (const struct param_t *param, mp_size_t size, mp_size_t next)
+{
+  const struct profile_t  *p;
+  double  scale, lo, hi, overlap, x;
+  int     i;
+
+  if (param->profile_op == PROFILE_NONE
+      || profile_total[param->profile_op] == 0.0)
+    return 1.0;
+
+  scale = (param->profile_scale == 0.0 ? 1.0 : param->profile_scale);
+  lo = size * scale;
+  hi = next * scale;
+
+  x = 0.0;
+  for (i = 0; i < nprofile; i++)
+    {
+      p = &profile[i];
+      if (p->op != param->profile_op
+          || p->ratio < param->profile_ratio_lo
+          || (param->profile_ratio_hi != 0.0
+              && p->ratio >= param->profile_ratio_hi))
+        continue;
+
+      /* the part of sizes p->lo to p->hi inclusive within [lo,hi) */
+      overlap = MIN (hi, p->hi + 1.0) - MAX (lo, (double) p->lo);
+      if (overlap > 0.0)
+        x += p->count * overlap / (p->hi + 1.0 - p->lo);
+    }
+
+  return 1.0 + PROFILE_WEIGHT * x / profile_total[param->profile_op];
+}
+
+
 /* Measuring for recompiled mpn/generic/div_qr_1.c,
  * mpn/generic/divrem_1.c, mpn/generic/mod_1.c and mpz/fac_ui.c */
 
@@ -424,6 +693,8 @@ speed_mpn_div_qr_1_tune (struct speed_params *s)
   SPEED_ROUTINE_MPN_DIV_QR_1 (mpn_div_qr_1_tune);
 }
 
+#define TUNEUP_MEASURE_TRIES  20
+
 double
 tuneup_measure (speed_function_t fun,
                 const struct param_t *param,
@@ -431,6 +702,7 @@ tuneup_measure (speed_function_t fun,
 {
   static struct param_t  dummy;
   double   t;
+  int      i;
   TMP_DECL;
 
   if (! param)
@@ -456,7 +728,16 @@ tuneup_measure (speed_function_t fun,
     break;
   }
 
-  t = speed_measure (fun, s);
+  /* speed_measure gives -1 for timings too noisy to agree, as well as for
+     a size the function can't do.  The latter comes back at once, so
+     trying again costs little, and noise on a busy or virtual machine can
+     last through several attempts.  */
+  for (i = 0; i < TUNEUP_MEASURE_TRIES; i++)
+    {
+      t = speed_measure (fun, s);
+      if (t != -1.0)
+        break;
+    }
 
   s->size -= param->size_extra;
 
@@ -590,6 +871,7 @@ one (mp_size_t *threshold, struct param_t *param)
        s.size += MAX ((mp_size_t) floor (s.size * param->step_factor), param->step))
     {
       double   ti, tiplus1, d;
+      mp_size_t  next;
 
       /*
         FIXME: check minimum size requirements are met, possibly by just
@@ -618,6 +900,10 @@ one (mp_size_t *threshold, struct param_t *param)
 
       add_dat (s.size, d);
 
+      next = s.size
+        + MAX ((mp_size_t) floor (s.size * param->step_factor), param->step);
+      dat[ndat-1].w = profile_weight (param, s.size, next);
+
       new_thresh_idx = analyze_dat (0);
 
       if (option_trace >= 2)
@@ -1197,6 +1483,47 @@ fft (struct fft_param_t *p)
 
 
 
+/* The toom thresholds in the order tune_mul_n and tune_sqr go through them,
+   with the smallest size each algorithm can do.  A threshold set to 0 gives
+   its range to the algorithm after, so the sizes above a threshold go to the
+   last of any run of 0 thresholds following it.  toom_min_size is the least
+   size those algorithms can all do, both to measure at and to give the
+   range to when making a threshold 0.  */
+struct toom_seq_t {
+  mp_size_t  *threshold;
+  mp_size_t  min_size;
+};
+
+struct toom_seq_t  mul_toom_seq[] = {
+  { &mul_toom33_threshold, MPN_TOOM33_MUL_MINSIZE },
+  { &mul_toom44_threshold, MPN_TOOM44_MUL_MINSIZE },
+  { &mul_toom6h_threshold, MPN_TOOM6H_MUL_MINSIZE },
+  { &mul_toom8h_threshold, MPN_TOOM8H_MUL_MINSIZE },
+};
+
+struct toom_seq_t  sqr_toom_seq[] = {
+  { &sqr_toom3_threshold, MPN_TOOM3_SQR_MINSIZE },
+  { &sqr_toom4_threshold, MPN_TOOM4_SQR_MINSIZE },
+  { &sqr_toom6_threshold, MPN_TOOM6_SQR_MINSIZE },
+  { &sqr_toom8_threshold, MPN_TOOM8_SQR_MINSIZE },
+};
+
+mp_size_t
+toom_min_size (const struct toom_seq_t *seq, int n, int i)
+{
+  mp_size_t  min_size = seq[i].min_size;
+
+  for (i++; i < n && *seq[i].threshold == 0; i++)
+    min_size = MAX (min_size, seq[i].min_size);
+  return min_size;
+}
+
+#define MUL_TOOM_MIN_SIZE(i) \
+  toom_min_size (mul_toom_seq, numberof (mul_toom_seq), i)
+#define SQR_TOOM_MIN_SIZE(i) \
+  toom_min_size (sqr_toom_seq, numberof (sqr_toom_seq), i)
+
+
 /* Start karatsuba from 4, since the Cray t90 ieee code is much faster at 2,
    giving wrong results.  */
 void
@@ -1207,6 +1534,7 @@ tune_mul_n (void)
   int something_changed;
 
   param.function = speed_mpn_mul_n;
+  param.profile_op = PROFILE_MUL;
 
   param.name = "MUL_TOOM22_THRESHOLD";
   param.min_size = MAX (4, MPN_TOOM22_MUL_MINSIZE);
@@ -1227,11 +1555,12 @@ tune_mul_n (void)
 	if (mul_toom33_threshold != 0)
 	  {
 	    param.name = "MUL_TOOM33_THRESHOLD";
-	    param.min_size = MAX (next_toom_start, MPN_TOOM33_MUL_MINSIZE);
+	    param.min_size = MAX (next_toom_start, MUL_TOOM_MIN_SIZE (0));
 	    param.max_size = MUL_TOOM33_THRESHOLD_LIMIT-1;
 	    one (&mul_toom33_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= mul_toom33_threshold)
+	    if (next_toom_start * 1.05 >= mul_toom33_threshold
+		&& next_toom_start >= MUL_TOOM_MIN_SIZE (0))
 	      {
 		mul_toom33_threshold = 0;
 		something_changed = 1;
@@ -1243,11 +1572,12 @@ tune_mul_n (void)
 	if (mul_toom44_threshold != 0)
 	  {
 	    param.name = "MUL_TOOM44_THRESHOLD";
-	    param.min_size = MAX (next_toom_start, MPN_TOOM44_MUL_MINSIZE);
+	    param.min_size = MAX (next_toom_start, MUL_TOOM_MIN_SIZE (1));
 	    param.max_size = MUL_TOOM44_THRESHOLD_LIMIT-1;
 	    one (&mul_toom44_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= mul_toom44_threshold)
+	    if (next_toom_start * 1.05 >= mul_toom44_threshold
+		&& next_toom_start >= MUL_TOOM_MIN_SIZE (1))
 	      {
 		mul_toom44_threshold = 0;
 		something_changed = 1;
@@ -1259,11 +1589,12 @@ tune_mul_n (void)
 	if (mul_toom6h_threshold != 0)
 	  {
 	    param.name = "MUL_TOOM6H_THRESHOLD";
-	    param.min_size = MAX (next_toom_start, MPN_TOOM6H_MUL_MINSIZE);
+	    param.min_size = MAX (next_toom_start, MUL_TOOM_MIN_SIZE (2));
 	    param.max_size = MUL_TOOM6H_THRESHOLD_LIMIT-1;
 	    one (&mul_toom6h_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= mul_toom6h_threshold)
+	    if (next_toom_start * 1.05 >= mul_toom6h_threshold
+		&& next_toom_start >= MUL_TOOM_MIN_SIZE (2))
 	      {
 		mul_toom6h_threshold = 0;
 		something_changed = 1;
@@ -1275,11 +1606,12 @@ tune_mul_n (void)
 	if (mul_toom8h_threshold != 0)
 	  {
 	    param.name = "MUL_TOOM8H_THRESHOLD";
-	    param.min_size = MAX (next_toom_start, MPN_TOOM8H_MUL_MINSIZE);
+	    param.min_size = MAX (next_toom_start, MUL_TOOM_MIN_SIZE (3));
 	    param.max_size = MUL_TOOM8H_THRESHOLD_LIMIT-1;
 	    one (&mul_toom8h_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= mul_toom8h_threshold)
+	    if (next_toom_start * 1.05 >= mul_toom8h_threshold
+		&& next_toom_start >= MUL_TOOM_MIN_SIZE (3))
 	      {
 		mul_toom8h_threshold = 0;
 		something_changed = 1;
@@ -1304,10 +1636,17 @@ tune_mul (void)
 
   param.noprint = 1;
 
+  /* For a workload profile, each threshold is weighted by the un/vn ratios
+     where mpn_mul consults it.  */
+  param.profile_op = PROFILE_MUL;
+
   param.function = speed_mpn_toom32_for_toom43_mul;
   param.function2 = speed_mpn_toom43_for_toom32_mul;
   param.name = "MUL_TOOM32_TO_TOOM43_THRESHOLD";
   param.min_size = MPN_TOOM43_MUL_MINSIZE * 24 / 17;
+  param.profile_scale = 17.0 / 24;
+  param.profile_ratio_lo = 7.0 / 6;
+  param.profile_ratio_hi = 3.0 / 2;
   one (&thres, &param);
   mul_toom32_to_toom43_threshold = thres * 17 / 24;
   print_define ("MUL_TOOM32_TO_TOOM43_THRESHOLD", mul_toom32_to_toom43_threshold);
@@ -1316,6 +1655,9 @@ tune_mul (void)
   param.function2 = speed_mpn_toom53_for_toom32_mul;
   param.name = "MUL_TOOM32_TO_TOOM53_THRESHOLD";
   param.min_size = MPN_TOOM53_MUL_MINSIZE * 30 / 19;
+  param.profile_scale = 19.0 / 30;
+  param.profile_ratio_lo = 3.0 / 2;
+  param.profile_ratio_hi = 7.0 / 4;
   one (&thres, &param);
   mul_toom32_to_toom53_threshold = thres * 19 / 30;
   print_define ("MUL_TOOM32_TO_TOOM53_THRESHOLD", mul_toom32_to_toom53_threshold);
@@ -1324,6 +1666,9 @@ tune_mul (void)
   param.function2 = speed_mpn_toom53_for_toom42_mul;
   param.name = "MUL_TOOM42_TO_TOOM53_THRESHOLD";
   param.min_size = MPN_TOOM53_MUL_MINSIZE * 20 / 11;
+  param.profile_scale = 11.0 / 20;
+  param.profile_ratio_lo = 7.0 / 4;
+  param.profile_ratio_hi = 11.0 / 6;
   one (&thres, &param);
   mul_toom42_to_toom53_threshold = thres * 11 / 20;
   print_define ("MUL_TOOM42_TO_TOOM53_THRESHOLD", mul_toom42_to_toom53_threshold);
@@ -1332,11 +1677,16 @@ tune_mul (void)
   param.function2 = speed_mpn_toom63_mul;
   param.name = "MUL_TOOM42_TO_TOOM63_THRESHOLD";
   param.min_size = MPN_TOOM63_MUL_MINSIZE * 2;
+  param.profile_scale = 1.0 / 2;
+  param.profile_ratio_lo = 11.0 / 6;
+  param.profile_ratio_hi = 0.0;
   one (&thres, &param);
   mul_toom42_to_toom63_threshold = thres / 2;
   print_define ("MUL_TOOM42_TO_TOOM63_THRESHOLD", mul_toom42_to_toom63_threshold);
 
-  /* Use ratio 5/6 when measuring, the middle of the range 2/3 to 1. */
+  /* Use ratio 5/6 when measuring, the middle of the range 2/3 to 1.  This
+     isn't used by mpn_mul, so there's nothing to weight.  */
+  param.profile_op = PROFILE_NONE;
   param.function = speed_mpn_toom43_for_toom54_mul;
   param.function2 = speed_mpn_toom54_for_toom43_mul;
   param.name = "MUL_TOOM43_TO_TOOM54_THRESHOLD";
@@ -1496,6 +1846,7 @@ tune_sqr (void)
       static struct param_t  param;
       param.name = "SQR_BASECASE_THRESHOLD";
       param.function = speed_mpn_sqr;
+      param.profile_op = PROFILE_SQR;
       param.min_size = 3;
       param.min_is_always = 1;
       param.max_size = TUNE_SQR_TOOM2_MAX;
@@ -1507,6 +1858,7 @@ tune_sqr (void)
     static struct param_t  param;
     param.name = "SQR_TOOM2_THRESHOLD";
     param.function = speed_mpn_sqr;
+    param.profile_op = PROFILE_SQR;
     param.min_size = MAX (4, MPN_TOOM2_SQR_MINSIZE);
     param.max_size = TUNE_SQR_TOOM2_MAX;
     param.noprint = 1;
@@ -1544,6 +1896,7 @@ tune_sqr (void)
     int something_changed;
 
     param.function = speed_mpn_sqr;
+    param.profile_op = PROFILE_SQR;
     param.noprint = 1;
 
   /* Threshold sequence loop.  Disable functions that would be used in a very
@@ -1557,7 +1910,7 @@ tune_sqr (void)
 
 	sqr_toom3_threshold = SQR_TOOM3_THRESHOLD_LIMIT;
 	param.name = "SQR_TOOM3_THRESHOLD";
-	param.min_size = MAX (next_toom_start, MPN_TOOM3_SQR_MINSIZE);
+	param.min_size = MAX (next_toom_start, SQR_TOOM_MIN_SIZE (0));
 	param.max_size = SQR_TOOM3_THRESHOLD_LIMIT-1;
 	one (&sqr_toom3_threshold, &param);
 
@@ -1567,11 +1920,12 @@ tune_sqr (void)
 	  {
 	    param.name = "SQR_TOOM4_THRESHOLD";
 	    sqr_toom4_threshold = SQR_TOOM4_THRESHOLD_LIMIT;
-	    param.min_size = MAX (next_toom_start, MPN_TOOM4_SQR_MINSIZE);
+	    param.min_size = MAX (next_toom_start, SQR_TOOM_MIN_SIZE (1));
 	    param.max_size = SQR_TOOM4_THRESHOLD_LIMIT-1;
 	    one (&sqr_toom4_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= sqr_toom4_threshold)
+	    if (next_toom_start * 1.05 >= sqr_toom4_threshold
+		&& next_toom_start >= SQR_TOOM_MIN_SIZE (1))
 	      {
 		sqr_toom4_threshold = 0;
 		something_changed = 1;
@@ -1584,11 +1938,12 @@ tune_sqr (void)
 	  {
 	    param.name = "SQR_TOOM6_THRESHOLD";
 	    sqr_toom6_threshold = SQR_TOOM6_THRESHOLD_LIMIT;
-	    param.min_size = MAX (next_toom_start, MPN_TOOM6_SQR_MINSIZE);
+	    param.min_size = MAX (next_toom_start, SQR_TOOM_MIN_SIZE (2));
 	    param.max_size = SQR_TOOM6_THRESHOLD_LIMIT-1;
 	    one (&sqr_toom6_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= sqr_toom6_threshold)
+	    if (next_toom_start * 1.05 >= sqr_toom6_threshold
+		&& next_toom_start >= SQR_TOOM_MIN_SIZE (2))
 	      {
 		sqr_toom6_threshold = 0;
 		something_changed = 1;
@@ -1601,11 +1956,12 @@ tune_sqr (void)
 	  {
 	    param.name = "SQR_TOOM8_THRESHOLD";
 	    sqr_toom8_threshold = SQR_TOOM8_THRESHOLD_LIMIT;
-	    param.min_size = MAX (next_toom_start, MPN_TOOM8_SQR_MINSIZE);
+	    param.min_size = MAX (next_toom_start, SQR_TOOM_MIN_SIZE (3));
 	    param.max_size = SQR_TOOM8_THRESHOLD_LIMIT-1;
 	    one (&sqr_toom8_threshold, &param);
 
-	    if (next_toom_start * 1.05 >= sqr_toom8_threshold)
+	    if (next_toom_start * 1.05 >= sqr_toom8_threshold
+		&& next_toom_start >= SQR_TOOM_MIN_SIZE (3))
 	      {
 		sqr_toom8_threshold = 0;
 		something_changed = 1;
@@ -1628,6 +1984,7 @@ tune_dc_div (void)
   {
     static struct param_t  param;
     param.name = "DC_DIV_QR_THRESHOLD";
+    param.profile_op = PROFILE_DIV;
     param.function = speed_mpn_sbpi1_div_qr;
     param.function2 = speed_mpn_dcpi1_div_qr;
     param.min_size = 6;
@@ -1636,6 +1993,7 @@ tune_dc_div (void)
   {
     static struct param_t  param;
     param.name = "DC_DIVAPPR_Q_THRESHOLD";
+    param.profile_op = PROFILE_DIV;
     param.function = speed_mpn_sbpi1_divappr_q;
     param.function2 = speed_mpn_dcpi1_divappr_q;
     param.min_size = 6;
@@ -1659,6 +2017,7 @@ tune_mu_div (void)
   {
     static struct param_t  param;
     param.name = "MU_DIV_QR_THRESHOLD";
+    param.profile_op = PROFILE_DIV;
     param.function = speed_mpn_dcpi1_div_qr;
     param.function2 = speed_mpn_mu_div_qr;
     param.min_size = mul_toom22_threshold;
@@ -1669,6 +2028,7 @@ tune_mu_div (void)
   {
     static struct param_t  param;
     param.name = "MU_DIVAPPR_Q_THRESHOLD";
+    param.profile_op = PROFILE_DIV;
     param.function = speed_mpn_dcpi1_divappr_q;
     param.function2 = speed_mpn_mu_divappr_q;
     param.min_size = mul_toom22_threshold;
@@ -1679,6 +2039,7 @@ tune_mu_div (void)
   {
     static struct param_t  param;
     param.name = "MUPI_DIV_QR_THRESHOLD";
+    param.profile_op = PROFILE_DIV;
     param.function = speed_mpn_sbordcpi1_div_qr;
     param.function2 = speed_mpn_mupi_div_qr;
     param.min_size = 6;
@@ -1787,6 +2148,7 @@ tune_redc (void)
   {
     static struct param_t  param;
     param.name = "REDC_1_TO_REDC_2_THRESHOLD";
+    param.profile_op = PROFILE_POWM;
     param.function = speed_mpn_redc_1;
     param.function2 = speed_mpn_redc_2;
     param.min_size = 1;
@@ -1799,6 +2161,7 @@ tune_redc (void)
   {
     static struct param_t  param;
     param.name = "REDC_2_TO_REDC_N_THRESHOLD";
+    param.profile_op = PROFILE_POWM;
     param.function = speed_mpn_redc_2;
     param.function2 = speed_mpn_redc_n;
     param.min_size = 16;
@@ -1814,6 +2177,7 @@ tune_redc (void)
       {
 	static struct param_t  param;
 	param.name = "REDC_1_TO_REDC_2_THRESHOLD";
+	param.profile_op = PROFILE_POWM;
 	param.function = speed_mpn_redc_1;
 	param.function2 = speed_mpn_redc_n;
 	param.min_size = 16;
@@ -1827,6 +2191,7 @@ tune_redc (void)
   {
     static struct param_t  param;
     param.name = "REDC_1_TO_REDC_N_THRESHOLD";
+    param.profile_op = PROFILE_POWM;
     param.function = speed_mpn_redc_1;
     param.function2 = speed_mpn_redc_n;
     param.min_size = 16;
@@ -1885,6 +2250,7 @@ tune_gcd_dc (void)
 {
   static struct param_t  param;
   param.name = "GCD_DC_THRESHOLD";
+  param.profile_op = PROFILE_GCD;
   param.function = speed_mpn_gcd;
   param.min_size = hgcd_threshold;
   param.max_size = 3000;
@@ -2766,6 +3132,137 @@ tune_fft_sqr (void)
   fft (&param);
 }
 
+#if TUNE_THREADS
+/* A minimal persistent thread pool to serve as the parallel function.  The
+   calling thread takes tasks too.  A nested call, from within a task, just
+   runs serially.  */
+
+static struct {
+  pthread_mutex_t  lock;
+  pthread_cond_t   work;
+  pthread_cond_t   done;
+  void             (*task) (void *, int);
+  void             *data;
+  int              n;
+  int              next;
+  int              pending;
+  int              busy;
+} tpool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+	    PTHREAD_COND_INITIALIZER };
+
+static void *
+tpool_worker (void *arg)
+{
+  void  (*task) (void *, int);
+  void  *data;
+  int   i;
+
+  pthread_mutex_lock (&tpool.lock);
+  for (;;)
+    {
+      while (tpool.next >= tpool.n)
+	pthread_cond_wait (&tpool.work, &tpool.lock);
+      i = tpool.next++;
+      task = tpool.task;
+      data = tpool.data;
+      pthread_mutex_unlock (&tpool.lock);
+
+      (*task) (data, i);
+
+      pthread_mutex_lock (&tpool.lock);
+      if (--tpool.pending == 0)
+	pthread_cond_signal (&tpool.done);
+    }
+  return NULL;
+}
+
+static void
+tpool_run (void (*task) (void *, int), void *data, int n)
+{
+  int  i;
+
+  pthread_mutex_lock (&tpool.lock);
+  if (tpool.busy)
+    {
+      pthread_mutex_unlock (&tpool.lock);
+      for (i = 0; i < n; i++)
+	(*task) (data, i);
+      return;
+    }
+  tpool.busy = 1;
+  tpool.task = task;
+  tpool.data = data;
+  tpool.next = 0;
+  tpool.pending = n;
+  tpool.n = n;
+  pthread_cond_broadcast (&tpool.work);
+
+  while (tpool.next < tpool.n)
+    {
+      i = tpool.next++;
+      pthread_mutex_unlock (&tpool.lock);
+      (*task) (data, i);
+      pthread_mutex_lock (&tpool.lock);
+      tpool.pending--;
+    }
+  while (tpool.pending != 0)
+    pthread_cond_wait (&tpool.done, &tpool.lock);
+  tpool.busy = 0;
+  pthread_mutex_unlock (&tpool.lock);
+}
+
+static void
+tpool_start (int nthreads)
+{
+  pthread_t  th;
+  int        i;
+
+  for (i = 1; i < nthreads; i++)
+    if (pthread_create (&th, NULL, tpool_worker, NULL) != 0)
+      {
+	fprintf (stderr, "Cannot create thread\n");
+	abort ();
+      }
+}
+
+/* The threshold is compared against pl, which speed_mpn_mul_fft rounds up
+   from s->size, so decide here and pass 0 or MP_SIZE_T_MAX down.  */
+double
+speed_mpn_mul_fft_parallel (struct speed_params *s)
+{
+  mp_size_t  thresh = fft_parallel_threshold;
+  double     t;
+
+  fft_parallel_threshold = (s->size >= thresh ? 0 : MP_SIZE_T_MAX);
+  t = speed_mpn_mul_fft (s);
+  fft_parallel_threshold = thresh;
+  return t;
+}
+
+void
+tune_fft_parallel (void)
+{
+  static struct param_t  param;
+
+  if (option_threads <= 1 || option_fft_max_size == 0)
+    return;
+
+  tpool_start (option_threads);
+  mp_set_parallel_function (tpool_run, option_threads);
+
+  s.r = 0;
+  param.name = "FFT_PARALLEL_THRESHOLD";
+  param.function = speed_mpn_mul_fft_parallel;
+  param.min_size = MAX (mul_fft_modf_threshold, 500);
+  param.max_size = option_fft_max_size;
+  param.step_factor = 0.1;
+  param.stop_since_change = 15;
+  one (&fft_parallel_threshold, &param);
+
+  mp_set_parallel_function (NULL, 0);
+}
+#endif
+
 void
 tune_fac_ui (void)
 {
@@ -2815,6 +3312,12 @@ all (void)
 
   fprintf (stderr, "DEFAULT_MAX_SIZE %d, fft_max_size %ld\n",
            DEFAULT_MAX_SIZE, (long) option_fft_max_size);
+  if (option_profile != NULL)
+    fprintf (stderr, "Workload profile %s, calls: %.0f mul, %.0f sqr, "
+             "%.0f div, %.0f gcd, %.0f powm\n", option_profile,
+             profile_total[PROFILE_MUL], profile_total[PROFILE_SQR],
+             profile_total[PROFILE_DIV], profile_total[PROFILE_GCD],
+             profile_total[PROFILE_POWM]);
   fprintf (stderr, "\n");
 
   time (&start_time);
@@ -2849,6 +3352,8 @@ all (void)
     printf ("system compiler */\n");
 #endif
   }
+  if (option_profile != NULL)
+    printf ("/* Weighted by the workload profile %s */\n", option_profile);
   printf ("\n");
 
   tune_divrem_1 ();
@@ -2885,6 +3390,14 @@ all (void)
   tune_fft_sqr ();
   printf ("\n");
 
+#if TUNE_THREADS
+  if (option_threads > 1)
+    {
+      tune_fft_parallel ();
+      printf ("\n");
+    }
+#endif
+
   tune_mullo ();
   tune_sqrlo ();
   printf("\n");
@@ -2942,9 +3455,17 @@ main (int argc, char *argv[])
   setbuf (stdout, NULL);
   setbuf (stderr, NULL);
 
-  while ((opt = getopt(argc, argv, "f:o:p:t")) != EOF)
+  while ((opt = getopt(argc, argv, "f:j:o:p:tw:")) != EOF)
     {
       switch (opt) {
+      case 'j':
+#if TUNE_THREADS
+        option_threads = atoi (optarg);
+#else
+        fprintf (stderr, "-j not available, no thread support\n");
+        exit (1);
+#endif
+        break;
       case 'f':
         if (optarg[0] == 't')
           option_fft_trace = 2;
@@ -2960,6 +3481,10 @@ main (int argc, char *argv[])
       case 't':
         option_trace++;
         break;
+      case 'w':
+        option_profile = optarg;
+        read_profile (optarg);
+        break;
       case '?':
         exit(1);
       }
@@ -0,0 +1,335 @@
+/* gmp_set_tuning, gmp_get_tuning, gmp_read_tuning -- change thresholds at
+   run time.
+
+Copyright 2026 Free Software Foundation, Inc.
+
+This file is part of the GNU MP Library.
+
+The GNU MP Library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 2 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The GNU MP Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the GNU MP Library.  If not,
+see https://www.gnu.org/licenses/.  */
+
+/* Get the compiled-in constants, not the __gmp_tuning fields.  */
+#define TUNING_DEFAULTS_BUILD 1
+
+#include <stdio.h>
+#include <string.h>
+#include "gmp.h"
+#include "gmp-impl.h"
+
+
+#if WANT_RUNTIME_TUNING
+
+#if ! WANT_FAT_BINARY
+#if MUL_TOOM22_THRESHOLD > MUL_TOOM22_THRESHOLD_LIMIT	\
+  || MUL_TOOM33_THRESHOLD > MUL_TOOM33_THRESHOLD_LIMIT	\
+  || SQR_TOOM3_THRESHOLD > SQR_TOOM3_THRESHOLD_LIMIT
+#error Compiled-in toom thresholds exceed the runtime tuning limits
+#endif
+#endif
+
+struct tuning_t __gmp_tuning = {
+#if ! WANT_FAT_BINARY
+  MUL_TOOM22_THRESHOLD,
+  MUL_TOOM33_THRESHOLD,
+#endif
+  MUL_TOOM44_THRESHOLD,
+  MUL_TOOM6H_THRESHOLD,
+  MUL_TOOM8H_THRESHOLD,
+  MUL_TOOM32_TO_TOOM43_THRESHOLD,
+  MUL_TOOM32_TO_TOOM53_THRESHOLD,
+  MUL_TOOM42_TO_TOOM53_THRESHOLD,
+  MUL_TOOM42_TO_TOOM63_THRESHOLD,
+  MUL_TOOM43_TO_TOOM54_THRESHOLD,
+  MUL_FFT_THRESHOLD,
+#if ! WANT_FAT_BINARY
+  SQR_TOOM3_THRESHOLD,
+#endif
+  SQR_TOOM4_THRESHOLD,
+  SQR_TOOM6_THRESHOLD,
+  SQR_TOOM8_THRESHOLD,
+  SQR_FFT_THRESHOLD,
+  DC_DIV_QR_THRESHOLD,
+  DC_DIVAPPR_Q_THRESHOLD,
+  MU_DIV_QR_THRESHOLD,
+  MU_DIVAPPR_Q_THRESHOLD,
+  MUPI_DIV_QR_THRESHOLD,
+  HGCD_THRESHOLD,
+  GCD_DC_THRESHOLD,
+  GCDEXT_DC_THRESHOLD,
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+  REDC_1_TO_REDC_2_THRESHOLD,
+  REDC_2_TO_REDC_N_THRESHOLD,
+#else
+  REDC_1_TO_REDC_N_THRESHOLD,
+#endif
+  GET_STR_DC_THRESHOLD,
+  SET_STR_DC_THRESHOLD,
+  SET_STR_PRECOMPUTE_THRESHOLD
+};
+
+/* Smallest FFT threshold.  Below MUL_FFT_MODF_THRESHOLD the FFT code falls
+   back on mpn_mul_n for the same size, which would recurse forever.  */
+#define FFT_MIN  MAX (MUL_FFT_MODF_THRESHOLD, SQR_FFT_MODF_THRESHOLD)
+
+/* Each threshold with the range of values the code can take.  The minimums
+   are the smallest sizes the algorithms accept (the same as tuneup starts
+   from), the maximums come from stack arrays sized by the threshold.  */
+static const struct {
+  const char  *name;
+  mp_size_t   *p;
+  mp_size_t   min, max;
+} tuning_table[] = {
+#if WANT_FAT_BINARY
+  { "MUL_TOOM22_THRESHOLD", &__gmpn_cpuvec.mul_toom22_threshold,
+    MAX (4, MPN_TOOM22_MUL_MINSIZE), MUL_TOOM22_THRESHOLD_LIMIT },
+  { "MUL_TOOM33_THRESHOLD", &__gmpn_cpuvec.mul_toom33_threshold,
+    MPN_TOOM33_MUL_MINSIZE, MUL_TOOM33_THRESHOLD_LIMIT },
+  { "SQR_TOOM3_THRESHOLD", &__gmpn_cpuvec.sqr_toom3_threshold,
+    MPN_TOOM3_SQR_MINSIZE, SQR_TOOM3_THRESHOLD_LIMIT },
+#else
+  { "MUL_TOOM22_THRESHOLD", &__gmp_tuning.mul_toom22_threshold,
+    MAX (4, MPN_TOOM22_MUL_MINSIZE), MUL_TOOM22_THRESHOLD_LIMIT },
+  { "MUL_TOOM33_THRESHOLD", &__gmp_tuning.mul_toom33_threshold,
+    MPN_TOOM33_MUL_MINSIZE, MUL_TOOM33_THRESHOLD_LIMIT },
+  { "SQR_TOOM3_THRESHOLD", &__gmp_tuning.sqr_toom3_threshold,
+    MPN_TOOM3_SQR_MINSIZE, SQR_TOOM3_THRESHOLD_LIMIT },
+#endif
+  { "MUL_TOOM44_THRESHOLD", &__gmp_tuning.mul_toom44_threshold,
+    MPN_TOOM44_MUL_MINSIZE, MP_SIZE_T_MAX },
+  { "MUL_TOOM6H_THRESHOLD", &__gmp_tuning.mul_toom6h_threshold,
+    MPN_TOOM6H_MUL_MINSIZE, MP_SIZE_T_MAX },
+  { "MUL_TOOM8H_THRESHOLD", &__gmp_tuning.mul_toom8h_threshold,
+    MPN_TOOM8H_MUL_MINSIZE, MP_SIZE_T_MAX },
+  { "MUL_TOOM32_TO_TOOM43_THRESHOLD",
+    &__gmp_tuning.mul_toom32_to_toom43_threshold,
+    MPN_TOOM43_MUL_MINSIZE * 24 / 17, MP_SIZE_T_MAX },
+  { "MUL_TOOM32_TO_TOOM53_THRESHOLD",
+    &__gmp_tuning.mul_toom32_to_toom53_threshold,
+    MPN_TOOM53_MUL_MINSIZE * 30 / 19, MP_SIZE_T_MAX },
+  { "MUL_TOOM42_TO_TOOM53_THRESHOLD",
+    &__gmp_tuning.mul_toom42_to_toom53_threshold,
+    MPN_TOOM53_MUL_MINSIZE * 20 / 11, MP_SIZE_T_MAX },
+  { "MUL_TOOM42_TO_TOOM63_THRESHOLD",
+    &__gmp_tuning.mul_toom42_to_toom63_threshold,
+    MPN_TOOM63_MUL_MINSIZE * 2, MP_SIZE_T_MAX },
+  { "MUL_TOOM43_TO_TOOM54_THRESHOLD",
+    &__gmp_tuning.mul_toom43_to_toom54_threshold,
+    MPN_TOOM54_MUL_MINSIZE * 6 / 5, MP_SIZE_T_MAX },
+  { "MUL_FFT_THRESHOLD", &__gmp_tuning.mul_fft_threshold,
+    FFT_MIN, MP_SIZE_T_MAX },
+  { "SQR_TOOM4_THRESHOLD", &__gmp_tuning.sqr_toom4_threshold,
+    MPN_TOOM4_SQR_MINSIZE, MP_SIZE_T_MAX },
+  { "SQR_TOOM6_THRESHOLD", &__gmp_tuning.sqr_toom6_threshold,
+    MPN_TOOM6_SQR_MINSIZE, MP_SIZE_T_MAX },
+  { "SQR_TOOM8_THRESHOLD", &__gmp_tuning.sqr_toom8_threshold,
+    MPN_TOOM8_SQR_MINSIZE, MP_SIZE_T_MAX },
+  { "SQR_FFT_THRESHOLD", &__gmp_tuning.sqr_fft_threshold,
+    FFT_MIN, MP_SIZE_T_MAX },
+  { "DC_DIV_QR_THRESHOLD", &__gmp_tuning.dc_div_qr_threshold,
+    6, MP_SIZE_T_MAX },
+  { "DC_DIVAPPR_Q_THRESHOLD", &__gmp_tuning.dc_divappr_q_threshold,
+    6, MP_SIZE_T_MAX },
+  { "MU_DIV_QR_THRESHOLD", &__gmp_tuning.mu_div_qr_threshold,
+    6, MP_SIZE_T_MAX },
+  { "MU_DIVAPPR_Q_THRESHOLD", &__gmp_tuning.mu_divappr_q_threshold,
+    6, MP_SIZE_T_MAX },
+  { "MUPI_DIV_QR_THRESHOLD", &__gmp_tuning.mupi_div_qr_threshold,
+    6, MP_SIZE_T_MAX },
+  { "HGCD_THRESHOLD", &__gmp_tuning.hgcd_threshold,
+    30, MP_SIZE_T_MAX },
+  { "GCD_DC_THRESHOLD", &__gmp_tuning.gcd_dc_threshold,
+    30, MP_SIZE_T_MAX },
+  { "GCDEXT_DC_THRESHOLD", &__gmp_tuning.gcdext_dc_threshold,
+    30, MP_SIZE_T_MAX },
+#if HAVE_NATIVE_mpn_addmul_2 || HAVE_NATIVE_mpn_redc_2
+  /* mpn_redc_2 wants at least 2 limbs */
+  { "REDC_1_TO_REDC_2_THRESHOLD", &__gmp_tuning.redc_1_to_redc_2_threshold,
+    2, MP_SIZE_T_MAX },
+  { "REDC_2_TO_REDC_N_THRESHOLD", &__gmp_tuning.redc_2_to_redc_n_threshold,
+    16, MP_SIZE_T_MAX },
+#else
+  { "REDC_1_TO_REDC_N_THRESHOLD", &__gmp_tuning.redc_1_to_redc_n_threshold,
+    16, MP_SIZE_T_MAX },
+#endif
+  /* mpn_sb_get_str has a stack buffer for GET_STR_PRECOMPUTE_THRESHOLD
+     limbs, and pieces below GET_STR_DC_THRESHOLD go to it.  */
+  { "GET_STR_DC_THRESHOLD", &__gmp_tuning.get_str_dc_threshold,
+    4, GET_STR_PRECOMPUTE_THRESHOLD },
+  { "SET_STR_DC_THRESHOLD", &__gmp_tuning.set_str_dc_threshold,
+    100, MP_SIZE_T_MAX },
+  { "SET_STR_PRECOMPUTE_THRESHOLD",
+    &__gmp_tuning.set_str_precompute_threshold,
+    100, MP_SIZE_T_MAX },
+};
+
+/* Pairs of thresholds which must be in order, the first no bigger than the
+   second, as tuneup makes them, since the toom, division and REDC code
+   expects each algorithm to take over from the one before.  A 0, which a
+   few gmp-mparam.h files use to skip an algorithm, is outside the order.
+   Names not tunable in this build are skipped.  */
+static const struct {
+  const char  *lo, *hi;
+} tuning_order[] = {
+  { "MUL_TOOM22_THRESHOLD",	  "MUL_TOOM33_THRESHOLD" },
+  { "MUL_TOOM33_THRESHOLD",	  "MUL_TOOM44_THRESHOLD" },
+  { "MUL_TOOM44_THRESHOLD",	  "MUL_TOOM6H_THRESHOLD" },
+  { "MUL_TOOM6H_THRESHOLD",	  "MUL_TOOM8H_THRESHOLD" },
+  { "SQR_TOOM3_THRESHOLD",	  "SQR_TOOM4_THRESHOLD" },
+  { "SQR_TOOM4_THRESHOLD",	  "SQR_TOOM6_THRESHOLD" },
+  { "SQR_TOOM6_THRESHOLD",	  "SQR_TOOM8_THRESHOLD" },
+  { "DC_DIV_QR_THRESHOLD",	  "MU_DIV_QR_THRESHOLD" },
+  { "DC_DIVAPPR_Q_THRESHOLD",	  "MU_DIVAPPR_Q_THRESHOLD" },
+  { "REDC_1_TO_REDC_2_THRESHOLD", "REDC_2_TO_REDC_N_THRESHOLD" },
+  { "SET_STR_DC_THRESHOLD",	  "SET_STR_PRECOMPUTE_THRESHOLD" },
+};
+
+static int
+tuning_find (const char *name)
+{
+  int  i;
+
+#if WANT_FAT_BINARY
+  /* Establish the CPU specific values first, so __gmpn_cpuvec_init doesn't
+     later overwrite what's set here.  */
+  if (! __gmpn_cpuvec_initialized)
+    __gmpn_cpuvec_init ();
+#endif
+
+  for (i = 0; i < numberof (tuning_table); i++)
+    if (strcmp (name, tuning_table[i].name) == 0)
+      return i;
+  return -1;
+}
+
+/* Check the order of the pairs with an entry marked in set[], taking
+   value[] for the marked entries and the current values for the rest.  */
+static int
+tuning_ordered (const mp_size_t *value, const char *set)
+{
+  mp_size_t  a, b;
+  int        i, l, h;
+
+  for (i = 0; i < numberof (tuning_order); i++)
+    {
+      l = tuning_find (tuning_order[i].lo);
+      h = tuning_find (tuning_order[i].hi);
+      if (l < 0 || h < 0 || ! (set[l] || set[h]))
+	continue;
+      a = set[l] ? value[l] : *tuning_table[l].p;
+      b = set[h] ? value[h] : *tuning_table[h].p;
+      if (a != 0 && b != 0 && a > b)
+	return 0;
+    }
+  return 1;
+}
+
+#endif /* WANT_RUNTIME_TUNING */
+
+
+int
+gmp_set_tuning (const char *name, long value)
+{
+#if WANT_RUNTIME_TUNING
+  mp_size_t  v[numberof (tuning_table)];
+  char       set[numberof (tuning_table)];
+  int        i;
+
+  i = tuning_find (name);
+  if (i < 0 || value < tuning_table[i].min || value > tuning_table[i].max)
+    return -1;
+
+  memset (set, 0, sizeof (set));
+  set[i] = 1;
+  v[i] = value;
+  if (! tuning_ordered (v, set))
+    return -1;
+
+  *tuning_table[i].p = value;
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+long
+gmp_get_tuning (const char *name)
+{
+#if WANT_RUNTIME_TUNING
+  int  i;
+
+  i = tuning_find (name);
+  if (i < 0)
+    return -1L;
+  return *tuning_table[i].p;
+#else
+  return -1L;
+#endif
+}
+
+/* Read "#define NAME VALUE" lines, as printed by tune/tuneup.  Everything
+   else, and thresholds which aren't runtime tunable, are ignored.  The
+   values are checked as a set, so they can move past each other, and are
+   only stored if they're all good.  */
+int
+gmp_read_tuning (FILE *fp)
+{
+#if WANT_RUNTIME_TUNING
+  mp_size_t  v[numberof (tuning_table)];
+  char       set[numberof (tuning_table)];
+  char  line[256], name[64];
+  long  value;
+  int   count, bad, whole, i;
+
+  memset (set, 0, sizeof (set));
+  bad = 0;
+  whole = 1;
+  while (fgets (line, sizeof (line), fp) != NULL)
+    {
+      /* Only look at the start of lines, not pieces of overlong ones.  */
+      if (whole
+	  && sscanf (line, " #define %63s %ld", name, &value) == 2
+	  && (i = tuning_find (name)) >= 0)
+	{
+	  if (value < tuning_table[i].min || value > tuning_table[i].max)
+	    bad = 1;
+	  set[i] = 1;
+	  v[i] = value;
+	}
+      whole = (strchr (line, '\n') != NULL);
+    }
+  if (ferror (fp) || bad || ! tuning_ordered (v, set))
+    return -1;
+
+  count = 0;
+  for (i = 0; i < numberof (tuning_table); i++)
+    if (set[i])
+      {
+	*tuning_table[i].p = v[i];
+	count++;
+      }
+  return count;
+#else
+  return -1;
+#endif
+}